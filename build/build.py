@@ -283,6 +283,26 @@ class CPPContext(Context.Context):
                                  lang=lang, path=testNode, includes=includes, defines=defines,
                                  install_path='${PREFIX}/tests/%s' % modArgs['name'])
 
+        # Benchmarks (see Benchmark.h) are built like tests; Benchmark.h is
+        # next to TestCase.h.
+        benchmarkNode = path.make_node('benchmarks')
+        if os.path.exists(benchmarkNode.abspath()) and not Options.options.libs_only:
+            benchmark_deps = listify(modArgs.get('test_deps', modArgs.get('module_deps', '')))
+
+            benchmark_deps.append(modArgs['name'])
+
+            benchmark_deps = list(['%s-%s' % (x, lang) for x in benchmark_deps + listify(modArgs.get('test_uselib_local', '')) + listify(modArgs.get('test_use',''))])
+
+            benchmark_includes = includes + listify(env['INCLUDES_UNITTEST'])
+            sourceExtension = {'c++':'.cpp', 'c':'.c'}.get(lang, 'cxx')
+            for benchmark in benchmarkNode.ant_glob('*%s' % sourceExtension):
+                benchmarkName = splitext(str(benchmark))[0]
+                self.program(env=env.derive(), name=benchmarkName, target=benchmarkName, source=str(benchmark),
+                             use=benchmark_deps,
+                             uselib=modArgs.get('test_uselib', uselib),
+                             lang=lang, path=benchmarkNode, includes=benchmark_includes, defines=defines,
+                             install_path='${PREFIX}/benchmarks/%s' % modArgs['name'])
+
 
         # Create install target for python tests
         if not Options.options.libs_only:
@@ -0,0 +1,119 @@
+#!/usr/bin/env python
+"""
+Compares two runs of the benchmarks written with Benchmark.h.
+
+Each run is either a single --json=<file> output or a directory of them (as
+written by the "run_benchmarks" target to <build>/benchmark_results).
+Benchmarks are matched by executable and name; the ratio is current/baseline
+time per iteration, so more than 1 is slower.
+
+    python compareBenchmarks.py baseline.json current.json
+    python compareBenchmarks.py --threshold=0.10 --metric=min old_results/ new_results/
+
+The exit status is 1 if anything got slower by more than the threshold (and
+by more than the noise, the larger of the two standard deviations), so this
+can be used in a CI job.
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import os
+import sys
+
+
+def loadRun(pathname):
+    """Returns ({(executable, name): benchmark}, [context]) for a file or directory."""
+    if os.path.isdir(pathname):
+        filenames = sorted(os.path.join(pathname, f) for f in os.listdir(pathname)
+                           if f.endswith('.json'))
+    else:
+        filenames = [pathname]
+
+    benchmarks = {}
+    contexts = []
+    for filename in filenames:
+        with open(filename) as f:
+            run = json.load(f)
+        context = run.get('context', {})
+        contexts.append(context)
+        executable = os.path.basename(context.get('executable', filename))
+        for benchmark in run.get('benchmarks', []):
+            benchmarks[(executable, benchmark['name'])] = benchmark
+    return benchmarks, contexts
+
+
+def warnAboutContexts(label, contexts):
+    if any(c.get('debug') for c in contexts):
+        print('WARNING: %s was run from a debug build; times may not mean much' % label)
+    if any(c.get('quick') for c in contexts):
+        print('WARNING: %s was run with --quick; times are from one iteration' % label)
+
+
+def formatTime(ns):
+    for scale, units in ((1e9, 's'), (1e6, 'ms'), (1e3, 'us')):
+        if ns >= scale:
+            return '%.2f %s' % (ns / scale, units)
+    return '%.2f ns' % ns
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Compare two runs of Benchmark.h benchmarks')
+    parser.add_argument('baseline', help='JSON file or directory of JSON files')
+    parser.add_argument('current', help='JSON file or directory of JSON files')
+    parser.add_argument('--threshold', type=float, default=0.05,
+                        help='relative slow-down that counts as a regression (default: 0.05)')
+    parser.add_argument('--metric', choices=['median', 'min', 'mean'], default='median',
+                        help='which time per iteration to compare (default: median)')
+    options = parser.parse_args(argv)
+
+    baseline, baselineContexts = loadRun(options.baseline)
+    current, currentContexts = loadRun(options.current)
+    warnAboutContexts('baseline', baselineContexts)
+    warnAboutContexts('current', currentContexts)
+
+    key = options.metric + '_ns'
+    regressions = []
+    print('%-60s %12s %12s %8s' % ('benchmark', 'baseline', 'current', 'ratio'))
+    for executable, name in sorted(set(baseline) & set(current)):
+        old = baseline[(executable, name)]
+        new = current[(executable, name)]
+        label = '%s: %s' % (executable, name)
+        if old[key] <= 0:
+            print('%-60s %12s %12s %8s' % (label, formatTime(old[key]), formatTime(new[key]), '-'))
+            continue
+
+        ratio = new[key] / old[key]
+        noise = max(old.get('stddev_ns', 0.0), new.get('stddev_ns', 0.0))
+        note = ''
+        if ratio > 1.0 + options.threshold:
+            if new[key] - old[key] > noise:
+                note = '  REGRESSION'
+                regressions.append(label)
+            else:
+                note = '  (within noise)'
+        elif ratio < 1.0 - options.threshold:
+            note = '  faster'
+        print('%-60s %12s %12s %8.3f%s' % (label, formatTime(old[key]), formatTime(new[key]),
+                                           ratio, note))
+
+    missing = sorted(set(baseline) - set(current))
+    added = sorted(set(current) - set(baseline))
+    if missing:
+        print('\nOnly in baseline:')
+        for executable, name in missing:
+            print('    %s: %s' % (executable, name))
+    if added:
+        print('\nOnly in current:')
+        for executable, name in added:
+            print('    %s: %s' % (executable, name))
+
+    if regressions:
+        print('\n%d regression(s) of more than %g%%' % (len(regressions), options.threshold * 100))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
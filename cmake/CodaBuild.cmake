@@ -357,12 +357,15 @@ endfunction()
 # Option arguments:
 #   UNITTEST        - If present, the test will be added to the CTest suite for
 #                     automated running.
+#   BENCHMARK       - If present, the tests are benchmarks (see Benchmark.h):
+#                     they're built by the "benchmarks" target, run by
+#                     "run_benchmarks", and run once with --quick by CTest.
 #
 function(coda_add_tests)
     if (CODA_BUILD_TESTS)
         cmake_parse_arguments(
             ARG                         # prefix
-            "UNITTEST"                  # options
+            "UNITTEST;BENCHMARK"        # options
             "MODULE_NAME;DIRECTORY"     # single args
             "DEPS;SOURCES;ARGS;FILTER_LIST"  # multi args
             "${ARGN}"
@@ -397,6 +400,12 @@ function(coda_add_tests)
         endif()
 
         list(APPEND ARG_DEPS ${ARG_MODULE_NAME}-${TARGET_LANGUAGE} TestCase)
+        if (ARG_BENCHMARK)
+            list(APPEND ARG_DEPS Benchmark)
+            if (NOT TARGET benchmarks)
+                add_custom_target(benchmarks)
+            endif()
+        endif()
 
         # get all interface libraries and include directories from the dependencies
         foreach(dep ${ARG_DEPS})
@@ -433,6 +442,14 @@ function(coda_add_tests)
                 add_test(NAME ${test_target} COMMAND ${test_target} ${ARG_ARGS})
             endif()
 
+            # benchmarks are only smoke-tested by CTest
+            if (${ARG_BENCHMARK})
+                add_dependencies(benchmarks ${test_target})
+                set_property(GLOBAL APPEND PROPERTY CODA_BENCHMARK_TARGETS ${test_target})
+                add_test(NAME ${test_target} COMMAND ${test_target} --quick ${ARG_ARGS})
+                set_tests_properties(${test_target} PROPERTIES LABELS benchmark)
+            endif()
+
             if (CODA_INSTALL_TESTS)
                 # Install [unit]tests to separate subtrees
                 install(TARGETS ${test_target}
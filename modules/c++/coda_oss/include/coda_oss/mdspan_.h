@@ -25,6 +25,8 @@
 #include <assert.h>
 
 #include <array>
+#include <initializer_list>
+#include <type_traits>
 
 #include "coda_oss/span.h"
 
@@ -32,25 +34,38 @@
 // https://en.cppreference.com/w/cpp/container/mdspan
 //
 // Why? Our (current) needs are much more limited than all the use-cases for `std::mdspan`:
-// dynamic (not static) extents, rank of 2 (rows  cols), contiguous memory, ...
+// dynamic (not static) extents, row-major (`layout_right`) contiguous memory, ...
 // By the time we really need more features, maybe we'll be using C++23? 
 namespace coda_oss
 {
 namespace details
 {
+constexpr bool all_of_(std::initializer_list<bool> values) noexcept
+{
+    for (auto&& value : values)
+    {
+        if (!value)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
  // https://en.cppreference.com/w/cpp/container/mdspan/extents
 template<typename IndexType, size_t Rank>
 struct dextents final // this is actually supposed to be an alias template with all dynamic extents
 {
-    static_assert(Rank == 2, "Rank must have a value of 2");
+    static_assert(Rank > 0, "Rank must be at least 1");
     using index_type = IndexType;
     using size_type = index_type;
     using rank_type = size_t;
 
     constexpr dextents() = default;
     
-    // These are supposed to be templates, but we don't need that complication right now.
-    constexpr dextents(index_type i0, index_type i1) noexcept : exts_{i0, i1}
+    template <typename... IndexTypes,
+              typename = std::enable_if_t<(sizeof...(IndexTypes) == Rank) && all_of_({std::is_integral<IndexTypes>::value...})>>
+    constexpr dextents(IndexTypes... exts) noexcept : exts_{{static_cast<index_type>(exts)...}}
     {
     }
     constexpr explicit dextents(const std::array<index_type, Rank>& exts) noexcept : exts_(exts)
@@ -73,7 +88,7 @@ struct dextents final // this is actually supposed to be an alias template with
     }
 
 private:
-    std::array<index_type, Rank> exts_;
+    std::array<index_type, Rank> exts_{};
 };
 
 template<typename T, typename TExtents>
@@ -86,7 +101,12 @@ class mdspan final
     template <typename IndexType, size_t Rank>
     static size_t area(const dextents<IndexType, Rank>& exts)
     {
-        return exts.extent(0) * exts.extent(1);
+        size_t retval = 1;
+        for (size_t r = 0; r < Rank; r++)
+        {
+            retval *= exts.extent(r);
+        }
+        return retval;
     }
 
 public:
@@ -101,7 +121,7 @@ public:
     mdspan(data_handle_type p, const extents_type& ext) noexcept : s_(p, area(ext)), ext_(ext)
     {
     }
-    mdspan(data_handle_type p, const std::array<size_type, 2>& dims) noexcept : mdspan(p, extents_type(dims))
+    mdspan(data_handle_type p, const std::array<size_type, extents_type::rank()>& dims) noexcept : mdspan(p, extents_type(dims))
     {
     }
 
@@ -120,9 +140,16 @@ public:
         assert(idx < size());  // prevents "constexpr" in C++11
         return data_handle()[idx];
     }
-    /*constexpr*/ reference operator()(size_t r, size_t c) const noexcept
+    template <typename... IndexTypes>
+    /*constexpr*/ reference operator()(IndexTypes... indices) const noexcept
     {
-        const auto offset = (r * extent(1)) + c;
+        static_assert(sizeof...(IndexTypes) == extents_type::rank(), "wrong number of indices");
+        const std::array<size_t, sizeof...(IndexTypes)> idx{{static_cast<size_t>(indices)...}};
+        size_t offset = 0; // row-major: the last index varies fastest
+        for (size_t r = 0; r < idx.size(); r++)
+        {
+            offset = (offset * extent(r)) + idx[r];
+        }
         return (*this)[offset];
     }
 
@@ -148,4 +175,3 @@ public:
 };
 }
 }
-
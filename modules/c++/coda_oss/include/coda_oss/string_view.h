@@ -0,0 +1,54 @@
+/* =========================================================================
+ * This file is part of coda_oss-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * coda_oss-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_coda_oss_string_view_h_INCLUDED_
+#define CODA_OSS_coda_oss_string_view_h_INCLUDED_
+
+#include "coda_oss/CPlusPlus.h"
+
+// always compile; it's in a details namespace
+#include "coda_oss/string_view_.h"
+
+// This logic needs to be here rather than <std/string_view> so that `coda_oss::string_view` will
+// be the same as `std::string_view`.
+#ifndef CODA_OSS_HAVE_std_string_view_
+    #define CODA_OSS_HAVE_std_string_view_ 0  // assume no <string_view>
+#endif
+#if CODA_OSS_cpp17 // C++17 for `__has_include()`
+    #if __has_include(<string_view>)
+        #include <string_view>
+        #undef CODA_OSS_HAVE_std_string_view_
+        #define CODA_OSS_HAVE_std_string_view_ 1  // provided by the implementation, probably C++17
+    #endif
+#endif // CODA_OSS_cpp17
+
+namespace coda_oss
+{
+    #if CODA_OSS_HAVE_std_string_view_
+        using std::string_view;
+    #else
+        using details::string_view;
+    #endif 
+}
+
+#endif  // CODA_OSS_coda_oss_string_view_h_INCLUDED_
@@ -0,0 +1,231 @@
+/* =========================================================================
+ * This file is part of coda_oss-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * coda_oss-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_coda_oss_string_view__h_INCLUDED_
+#define CODA_OSS_coda_oss_string_view__h_INCLUDED_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+// Simple version of std::string_view since that doesn't exist until C++17.
+// https://en.cppreference.com/w/cpp/string/basic_string_view
+//
+// Unlike std::string_view, this converts from std::basic_string itself (there's
+// no std::basic_string::operator basic_string_view() to do it); and converting
+// back is explicit, so `std::string(view)` works either way.
+
+namespace coda_oss
+{
+namespace details
+{
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_string_view final
+{
+    const CharT* data_ = nullptr;
+    size_t size_ = 0;
+
+    bool contains(CharT ch) const noexcept
+    {
+        // usually just one or two characters, e.g., path delimiters
+        for (size_t i = 0; i < size_; ++i)
+        {
+            if (Traits::eq(data_[i], ch))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    using traits_type = Traits;
+    using value_type = CharT;
+    using const_pointer = const CharT*;
+    using const_reference = const CharT&;
+    using const_iterator = const CharT*;
+    using iterator = const_iterator;
+    using size_type = size_t;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    constexpr basic_string_view() noexcept = default;
+    constexpr basic_string_view(const CharT* s, size_type count) noexcept : data_(s), size_(count) { }
+    basic_string_view(const CharT* s) noexcept : data_(s), size_(Traits::length(s)) { }
+    template <typename Allocator>
+    basic_string_view(const std::basic_string<CharT, Traits, Allocator>& s) noexcept : data_(s.data()), size_(s.size()) { }
+
+    template <typename Allocator>
+    explicit operator std::basic_string<CharT, Traits, Allocator>() const
+    {
+        return std::basic_string<CharT, Traits, Allocator>(data_, size_);
+    }
+
+    constexpr const_iterator begin() const noexcept { return data_; }
+    constexpr const_iterator end() const noexcept { return data_ + size_; }
+    constexpr const_reference operator[](size_type pos) const noexcept { return data_[pos]; }
+    constexpr const_reference front() const noexcept { return data_[0]; }
+    constexpr const_reference back() const noexcept { return data_[size_ - 1]; }
+    constexpr const_pointer data() const noexcept { return data_; }
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr size_type length() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    void remove_prefix(size_type n) noexcept
+    {
+        data_ += n;
+        size_ -= n;
+    }
+    void remove_suffix(size_type n) noexcept
+    {
+        size_ -= n;
+    }
+
+    basic_string_view substr(size_type pos = 0, size_type count = npos) const
+    {
+        if (pos > size_)
+        {
+            throw std::out_of_range("basic_string_view::substr()");
+        }
+        return basic_string_view(data_ + pos, std::min(count, size_ - pos));
+    }
+
+    int compare(basic_string_view v) const noexcept
+    {
+        const auto result = Traits::compare(data_, v.data_, std::min(size_, v.size_));
+        if (result != 0)
+        {
+            return result;
+        }
+        return size_ == v.size_ ? 0 : (size_ < v.size_ ? -1 : 1);
+    }
+
+    size_type find(CharT ch, size_type pos = 0) const noexcept
+    {
+        if (pos >= size_)
+        {
+            return npos;
+        }
+        const auto p = Traits::find(data_ + pos, size_ - pos, ch);
+        return p == nullptr ? npos : static_cast<size_type>(p - data_);
+    }
+    size_type find(basic_string_view v, size_type pos = 0) const noexcept
+    {
+        if (v.size_ > size_)
+        {
+            return npos;
+        }
+        for (; pos <= size_ - v.size_; ++pos)
+        {
+            if (Traits::compare(data_ + pos, v.data_, v.size_) == 0)
+            {
+                return pos;
+            }
+        }
+        return npos;
+    }
+    size_type rfind(CharT ch, size_type pos = npos) const noexcept
+    {
+        for (auto i = size_ == 0 ? 0 : std::min(pos, size_ - 1) + 1; i > 0; --i)
+        {
+            if (Traits::eq(data_[i - 1], ch))
+            {
+                return i - 1;
+            }
+        }
+        return npos;
+    }
+
+    size_type find_first_of(basic_string_view v, size_type pos = 0) const noexcept
+    {
+        for (; pos < size_; ++pos)
+        {
+            if (v.contains(data_[pos]))
+            {
+                return pos;
+            }
+        }
+        return npos;
+    }
+    size_type find_first_not_of(basic_string_view v, size_type pos = 0) const noexcept
+    {
+        for (; pos < size_; ++pos)
+        {
+            if (!v.contains(data_[pos]))
+            {
+                return pos;
+            }
+        }
+        return npos;
+    }
+    size_type find_last_of(basic_string_view v, size_type pos = npos) const noexcept
+    {
+        for (auto i = size_ == 0 ? 0 : std::min(pos, size_ - 1) + 1; i > 0; --i)
+        {
+            if (v.contains(data_[i - 1]))
+            {
+                return i - 1;
+            }
+        }
+        return npos;
+    }
+    size_type find_last_not_of(basic_string_view v, size_type pos = npos) const noexcept
+    {
+        for (auto i = size_ == 0 ? 0 : std::min(pos, size_ - 1) + 1; i > 0; --i)
+        {
+            if (!v.contains(data_[i - 1]))
+            {
+                return i - 1;
+            }
+        }
+        return npos;
+    }
+
+    // "hidden friends" so that `view == "literal"` and `view == str` work
+    friend bool operator==(basic_string_view lhs, basic_string_view rhs) noexcept
+    {
+        return (lhs.size_ == rhs.size_) && (lhs.compare(rhs) == 0);
+    }
+    friend bool operator!=(basic_string_view lhs, basic_string_view rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+    friend bool operator<(basic_string_view lhs, basic_string_view rhs) noexcept
+    {
+        return lhs.compare(rhs) < 0;
+    }
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, basic_string_view v)
+    {
+        return os.write(v.data_, static_cast<std::streamsize>(v.size_));
+    }
+};
+template <typename CharT, typename Traits>
+constexpr typename basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::npos;
+
+using string_view = basic_string_view<char>;
+}
+}
+
+#endif  // CODA_OSS_coda_oss_string_view__h_INCLUDED_
@@ -0,0 +1,78 @@
+/* =========================================================================
+ * This file is part of coda_oss-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * coda_oss-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "coda_oss_TestCase.h"
+
+#include <array>
+#include <numeric>
+#include <vector>
+
+#include "coda_oss/mdspan.h"
+
+namespace
+{
+TEST_CASE(test_mdspan_2D)
+{
+    std::vector<int> data_(3 * 4);
+    std::iota(data_.begin(), data_.end(), 0);
+    const coda_oss::mdspan<int, coda_oss::dextents<size_t, 2>> data(data_.data(), std::array<size_t, 2>{3, 4});
+    static_assert(decltype(data)::rank() == 2, "wrong rank()");
+    TEST_ASSERT_EQ(data.size(), data_.size());
+    TEST_ASSERT_EQ(data.extent(0), 3);
+    TEST_ASSERT_EQ(data.extent(1), 4);
+    TEST_ASSERT_EQ(data(0, 0), 0);
+    TEST_ASSERT_EQ(data(1, 2), 6);
+    TEST_ASSERT_EQ(data(2, 3), 11);
+}
+
+TEST_CASE(test_mdspan_3D)
+{
+    std::vector<int> data_(2 * 3 * 4);
+    std::iota(data_.begin(), data_.end(), 0);
+    const coda_oss::mdspan<int, coda_oss::dextents<size_t, 3>> data(data_.data(), std::array<size_t, 3>{2, 3, 4});
+    static_assert(decltype(data)::rank() == 3, "wrong rank()");
+    TEST_ASSERT_EQ(data.size(), data_.size());
+    TEST_ASSERT_EQ(data.extent(2), 4);
+    for (size_t i = 0; i < data.extent(0); i++)
+    {
+        for (size_t j = 0; j < data.extent(1); j++)
+        {
+            for (size_t k = 0; k < data.extent(2); k++)
+            {
+                TEST_ASSERT_EQ(static_cast<size_t>(data(i, j, k)), (i * 3 + j) * 4 + k);
+            }
+        }
+    }
+
+    const coda_oss::dextents<size_t, 1> exts(24);
+    const coda_oss::mdspan<const int, coda_oss::dextents<size_t, 1>> flat(data_.data(), exts);
+    TEST_ASSERT_EQ(flat.size(), data_.size());
+    TEST_ASSERT_EQ(flat(23), 23);
+}
+}
+
+int main(int /*argc*/, char** /*argv*/)
+{
+    TEST_CHECK(test_mdspan_2D);
+    TEST_CHECK(test_mdspan_3D);
+    return 0;
+}
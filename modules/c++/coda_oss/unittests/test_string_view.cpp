@@ -0,0 +1,85 @@
+/* =========================================================================
+ * This file is part of coda_oss-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * coda_oss-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "coda_oss_TestCase.h"
+
+#include <sstream>
+#include <string>
+
+#include "coda_oss/string_view.h"
+
+// The results should be the same as std::string's
+template<typename TStringView>
+static void testStringView_(const std::string& testName)
+{
+    const std::string str = "/data//nitf/file.ntf";
+    const TStringView view = str;
+    TEST_ASSERT_EQ(view.size(), str.size());
+    TEST_ASSERT_EQ(view.data(), str.data());
+    TEST_ASSERT(view == str);
+    TEST_ASSERT(view == "/data//nitf/file.ntf");
+    TEST_ASSERT(view != "/data");
+    TEST_ASSERT(TStringView("abc") < TStringView("abd"));
+    TEST_ASSERT(TStringView("ab") < TStringView("abc"));
+    TEST_ASSERT(TStringView().empty());
+
+    for (const auto pos : { size_t(0), size_t(1), size_t(6), size_t(11), str.size() - 1, str.size(), TStringView::npos })
+    {
+        TEST_ASSERT_EQ(view.find('/', pos), str.find('/', pos));
+        TEST_ASSERT_EQ(view.find("nitf", pos), str.find("nitf", pos));
+        TEST_ASSERT_EQ(view.rfind('/', pos), str.rfind('/', pos));
+        TEST_ASSERT_EQ(view.find_first_of("/.", pos), str.find_first_of("/.", pos));
+        TEST_ASSERT_EQ(view.find_first_not_of("/", pos), str.find_first_not_of("/", pos));
+        TEST_ASSERT_EQ(view.find_last_of("/", pos), str.find_last_of("/", pos));
+        TEST_ASSERT_EQ(view.find_last_not_of("/", pos), str.find_last_not_of("/", pos));
+    }
+    TEST_ASSERT_EQ(view.find('x'), std::string::npos);
+    TEST_ASSERT_EQ(TStringView().rfind('x'), std::string::npos);
+    TEST_ASSERT_EQ(TStringView().find_last_of("x"), std::string::npos);
+
+    TEST_ASSERT(view.substr(7, 4) == "nitf");
+    TEST_ASSERT(view.substr(12) == "file.ntf");
+    auto copy = view;
+    copy.remove_prefix(1);
+    copy.remove_suffix(4);
+    TEST_ASSERT(copy == "data//nitf/file");
+    TEST_ASSERT_EQ(std::string(copy), "data//nitf/file");
+
+    std::ostringstream os;
+    os << copy;
+    TEST_ASSERT_EQ(os.str(), "data//nitf/file");
+}
+TEST_CASE(test_details_string_view)
+{
+    testStringView_<coda_oss::details::string_view>(testName);
+}
+TEST_CASE(test_coda_oss_string_view)
+{
+    testStringView_<coda_oss::string_view>(testName);
+}
+
+int main(int /*argc*/, char** /*argv*/)
+{
+    TEST_CHECK(test_details_string_view);
+    TEST_CHECK(test_coda_oss_string_view);
+    return 0;
+}
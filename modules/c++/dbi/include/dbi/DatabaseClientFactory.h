@@ -37,7 +37,8 @@ enum DatabaseType
 {
     PGSQL = 0,
     MYSQL = 1,
-    ORACLE = 2
+    ORACLE = 2,
+    MOCK = 3 //!< MockConnection, for testing without a server
 };
 
 /*!
@@ -24,6 +24,8 @@
 #ifndef __DBI_DATABASECONNECTION_H__
 #define __DBI_DATABASECONNECTION_H__
 
+#include <stddef.h>
+
 #include <vector>
 #include <map>
 #include <string>
@@ -305,6 +307,289 @@ protected:
 
 typedef std::unique_ptr< ResultSet > pResultSet;
 
+/*!
+ *  \class Columns
+ *  \brief The names, types and sizes of the columns of a result
+ *
+ *  Unlike Row, this is built once per result (or prepared statement)
+ *  and shared by every row a Cursor fetches.
+ */
+class Columns
+{
+public:
+    /*!
+     *  Function adding a column
+     *  \param name The name of the column
+     *  \param type The (database-specific) type of the column
+     *  \param size The size of the column
+     */
+    void add(const std::string& name, int type, unsigned int size);
+
+    /*!
+     *  Function gets the number of columns
+     *  \return The number of columns
+     */
+    size_t size() const
+    {
+        return mNames.size();
+    }
+
+    /*!
+     *  Function for finding a column by name
+     *  \param name The column name
+     *  \return The index of the column
+     *  \throw SQLException if there is no such column
+     */
+    size_t getIndex(const std::string& name) const;
+
+    const std::string& getName(size_t index) const
+    {
+        return mNames.at(index);
+    }
+    int getType(size_t index) const
+    {
+        return mTypes.at(index);
+    }
+    unsigned int getSize(size_t index) const
+    {
+        return mSizes.at(index);
+    }
+
+private:
+    std::vector<std::string> mNames;
+    std::vector<int> mTypes;
+    std::vector<unsigned int> mSizes;
+    std::map<std::string, size_t> mIndex;
+};
+
+/*!
+ *  \class Cursor
+ *  \brief Streams the rows of a result, one at a time
+ *
+ *  Rather than returning a new Row (with copies of the field names) for
+ *  every row, a Cursor has one row buffer that next() overwrites, so
+ *  reading a large result doesn't allocate per row.  Depending on the
+ *  backend, rows may also be read from the server as they're needed
+ *  rather than all at once; the connection can't be used for anything
+ *  else until the Cursor is done (or destroyed).
+ *
+ *  \code
+        auto cursor = connection->openCursor("SELECT id, name FROM images");
+        while (cursor->next())
+        {
+            const auto id = cursor->get<int>(0);
+            const std::string& name = cursor->getString(1);
+        }
+ *  \endcode
+ */
+class Cursor
+{
+public:
+    Cursor() = default;
+    Cursor(const Cursor&) = delete;
+    Cursor& operator=(const Cursor&) = delete;
+    virtual ~Cursor()
+    {}
+
+    /*!
+     *  Function fetches the next row into the row buffer
+     *  \return True if there is a row, False at the end of the result
+     *  \throw SQLException on error
+     */
+    virtual bool next() = 0;
+
+    /*!
+     *  Function for the columns of the result; there are none if the
+     *  statement doesn't return rows (e.g., INSERT)
+     *  \return The columns
+     */
+    const Columns& getColumns() const
+    {
+        return *mColumns;
+    }
+
+    size_t getNumFields() const
+    {
+        return mValues.size();
+    }
+
+    //! Whether the field in the current row is NULL
+    bool isNull(size_t index) const
+    {
+        return mNulls.at(index) != 0;
+    }
+
+    /*!
+     *  Function for the text of a field in the current row; it's
+     *  overwritten by the next call to next().  NULL is an empty string.
+     *  \param index The index of the field
+     *  \return The field data
+     */
+    const std::string& getString(size_t index) const
+    {
+        return mValues.at(index);
+    }
+    const std::string& getString(const std::string& name) const
+    {
+        return getString(getColumns().getIndex(name));
+    }
+
+    /*!
+     *  Function converts a field in the current row
+     *  \param index The index (or name) of the field
+     *  \return The converted field data
+     */
+    template <typename T>
+    T get(size_t index) const
+    {
+        return str::toType<T>(getString(index));
+    }
+    template <typename T>
+    T get(const std::string& name) const
+    {
+        return get<T>(getColumns().getIndex(name));
+    }
+
+protected:
+    //! Set the columns and size the row buffer to match
+    void setColumns(std::shared_ptr<const Columns> columns);
+
+    //! Set a field of the row buffer, reusing its memory
+    void setField(size_t index, const char* data, size_t length)
+    {
+        mValues[index].assign(data, length);
+        mNulls[index] = 0;
+    }
+    void setNull(size_t index)
+    {
+        mValues[index].clear();
+        mNulls[index] = 1;
+    }
+
+private:
+    std::shared_ptr<const Columns> mColumns = std::make_shared<Columns>();
+    std::vector<std::string> mValues;
+    std::vector<char> mNulls;
+};
+
+typedef std::unique_ptr< Cursor > pCursor;
+
+/*!
+ *  \class PreparedStatement
+ *  \brief A statement that is parsed once and then executed with
+ *   different parameters
+ *
+ *  Parameters are 0-based and written in the SQL the way the database
+ *  expects: $1, $2, ... for PostgreSQL and ? for MySQL.  Every parameter
+ *  must be bound before execute() or addBatch(); values are sent as text,
+ *  the same as they would be in a query() string, but without any quoting
+ *  or escaping.
+ *
+ *  addBatch() queues the bound parameters as a row; executeBatch() then
+ *  executes every queued row, in as few round trips as the backend allows.
+ *
+ *  \code
+        auto insert = connection->prepare("INSERT INTO images VALUES ($1, $2)");
+        for (const auto& image : images)
+        {
+            insert->bind(0, image.id);
+            insert->bind(1, image.name);
+            insert->addBatch();
+        }
+        insert->executeBatch();
+ *  \endcode
+ */
+class PreparedStatement
+{
+public:
+    /*!
+     *  Constructor
+     *  \param numParameters The number of parameters in the statement
+     */
+    explicit PreparedStatement(size_t numParameters);
+    PreparedStatement(const PreparedStatement&) = delete;
+    PreparedStatement& operator=(const PreparedStatement&) = delete;
+    virtual ~PreparedStatement()
+    {}
+
+    size_t getNumParameters() const
+    {
+        return mNumParameters;
+    }
+
+    /*!
+     *  Functions bind a parameter for the next execute() or addBatch()
+     *  \param index The 0-based index of the parameter
+     *  \param value The value of the parameter; bindNull() for NULL
+     */
+    void bind(size_t index, const std::string& value);
+    void bind(size_t index, const char* value);
+    template <typename T>
+    void bind(size_t index, const T& value)
+    {
+        bind(index, str::toString(value));
+    }
+    void bindNull(size_t index);
+
+    /*!
+     *  Function executes the statement with the bound parameters, which
+     *  stay bound for the next execute()
+     *  \return The result, if any
+     *  \throw SQLException on error or if a parameter isn't bound
+     */
+    pCursor execute();
+
+    /*!
+     *  Function queues the bound parameters as a row for executeBatch();
+     *  every parameter has to be bound again for the next row
+     *  \throw SQLException if a parameter isn't bound
+     */
+    void addBatch();
+
+    //! The number of rows queued by addBatch()
+    size_t getBatchSize() const
+    {
+        return mNumBatchRows;
+    }
+
+    /*!
+     *  Function executes the statement once for every queued row, and then
+     *  clears the queue (even if there's an error)
+     *  \throw SQLException on error
+     */
+    void executeBatch();
+
+protected:
+    /*!
+     *  Function for a bound parameter
+     *  \param row The row of parameters; execute() uses getBatchSize()
+     *  \param index The index of the parameter
+     *  \return The parameter, or nullptr for NULL
+     */
+    const std::string* getParameter(size_t row, size_t index) const;
+
+    //! Execute the statement with one row of parameters
+    virtual pCursor executeRow(size_t row) = 0;
+
+    //! Execute rows [0, numRows); by default, one executeRow() at a time
+    virtual void executeRows(size_t numRows);
+
+private:
+    void checkBound(size_t row) const;
+    size_t slot(size_t row, size_t index) const;
+
+    size_t mNumParameters;
+    size_t mNumBatchRows = 0;
+
+    // getNumParameters() values per row; the last row is the one being
+    // bound.  The strings are reused from batch to batch.
+    std::vector<std::string> mValues;
+    enum State : char { Unbound, Value, Null };
+    std::vector<State> mStates;
+};
+
+typedef std::unique_ptr< PreparedStatement > pPreparedStatement;
+
 /*!
  * \class DatabaseConnection
  * \brief Abstract database interface
@@ -356,6 +641,23 @@ public:
      */
     virtual pResultSet query(const std::string& q) = 0;
 
+    /*!
+     *  Send a command to the database, streaming the results
+     *  The default implementation reads the results of query().
+     *  \param q  The command as a string
+     *  \return A cursor over the result set of the command
+     *  \throw SQLException on error
+     */
+    virtual pCursor openCursor(const std::string& q);
+
+    /*!
+     *  Prepare a statement to be executed (many times) with parameters
+     *  \param sql  The statement, with parameters; see PreparedStatement
+     *  \return The prepared statement, which must not outlive this
+     *  \throw SQLException on error, or if the database isn't supported
+     */
+    virtual pPreparedStatement prepare(const std::string& sql);
+
     /*!
      *  Get the last connection error message
      *  \return The error message
@@ -0,0 +1,133 @@
+/* =========================================================================
+ * This file is part of dbi-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * dbi-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_dbi_MockConnection_h_INCLUDED_
+#define CODA_OSS_dbi_MockConnection_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dbi/DatabaseConnection.h"
+
+/*!
+ * \file MockConnection.h
+ * \brief In-process stand-in for a database connection
+ *
+ */
+namespace dbi
+{
+/*!
+ * \class MockConnection
+ * \brief In-process stand-in for a database, for testing without a server
+ *
+ * Nothing is parsed or stored.  Every statement that's executed is logged;
+ * one whose SQL is exactly what was given to setResult() returns those rows,
+ * everything else returns no rows.  Both ? and $1, $2, ... are recognized
+ * as parameters in prepare().
+ */
+class MockConnection : public DatabaseConnection
+{
+public:
+    MockConnection() = default;
+    ~MockConnection() = default;
+
+    bool connect(const std::string& database,
+                 const std::string& user = "",
+                 const std::string& pass = "",
+                 const std::string& host = "localhost",
+                 unsigned int port = 0) override;
+    void disconnect() override;
+    pResultSet query(const std::string& q) override;
+    pCursor openCursor(const std::string& q) override;
+    pPreparedStatement prepare(const std::string& sql) override;
+    const std::string getLastErrorMessage() override;
+
+    /*!
+     *  Set the rows returned by statements with the given SQL
+     *  \param sql  The statement, exactly as it will be executed
+     *  \param columnNames  The names of the columns
+     *  \param rows  The rows, each with a value for every column
+     */
+    void setResult(const std::string& sql,
+                   const std::vector<std::string>& columnNames,
+                   const std::vector<std::vector<std::string> >& rows);
+
+    /*!
+     *  Make statements with the given SQL throw an SQLException
+     *  \param sql  The statement, exactly as it will be executed
+     *  \param message  The error message
+     */
+    void setError(const std::string& sql, const std::string& message);
+
+    /*!
+     *  The statements executed so far: one entry per query() or execution
+     *  of a prepared statement (one per row of a batch).  Parameters are
+     *  appended, e.g., "INSERT INTO t VALUES (?, ?) ['a', NULL]".
+     */
+    const std::vector<std::string>& getLog() const
+    {
+        return mLog;
+    }
+
+    /*!
+     *  The number of times the "server" was contacted: once per query(),
+     *  prepare() and execute(), but only once per executeBatch().
+     */
+    size_t getNumRoundTrips() const
+    {
+        return mNumRoundTrips;
+    }
+
+    void clearLog()
+    {
+        mLog.clear();
+        mNumRoundTrips = 0;
+    }
+
+private:
+    friend class MockPreparedStatement;
+
+    struct Result
+    {
+        std::shared_ptr<const Columns> columns = std::make_shared<Columns>();
+        std::vector<std::vector<std::string> > rows;
+    };
+
+    //! Log a statement and return its results
+    const Result& execute(const std::string& sql, const std::string& logEntry);
+
+    bool mConnected = false;
+    std::string mLastError;
+    std::map<std::string, Result> mResults;
+    std::map<std::string, std::string> mErrors;
+    const Result mNoResult{};
+    std::vector<std::string> mLog;
+    size_t mNumRoundTrips = 0;
+};
+}
+
+#endif  // CODA_OSS_dbi_MockConnection_h_INCLUDED_
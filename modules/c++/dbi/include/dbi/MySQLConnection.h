@@ -139,6 +139,25 @@ public:
      */
     pResultSet query(const std::string& q);
 
+    /*!
+     *  Send a command to the database, streaming the results from the
+     *  server (mysql_use_result) rather than reading them all at once
+     *  \param q  The command as a string
+     *  \return A cursor over the result set of the command
+     *  \throw SQLException on error
+     */
+    pCursor openCursor(const std::string& q);
+
+    /*!
+     *  Prepare a statement with ? parameters.  MySQL has no way to
+     *  send more than one row of parameters at a time, so a batch is
+     *  executed one row at a time.
+     *  \param sql  The statement
+     *  \return The prepared statement
+     *  \throw SQLException on error
+     */
+    pPreparedStatement prepare(const std::string& sql);
+
     /*!
      *  Get the last connection error message
      *  \return The error message
@@ -139,6 +139,27 @@ public:
      */
     pResultSet query(const std::string& q);
 
+    /*!
+     *  Send a command to the database, streaming the results one row
+     *  at a time (single-row mode) rather than reading them all at once
+     *  \param q  The command as a string
+     *  \return A cursor over the result set of the command
+     *  \throw SQLException on error
+     */
+    pCursor openCursor(const std::string& q);
+
+    /*!
+     *  Prepare a statement with $1, $2, ... parameters.  A batch is sent
+     *  in pipeline mode (if libpq has it), so it's one round trip and
+     *  is applied all-or-nothing.  If the batch can't be sent at all
+     *  (PQpipelineSync() fails), the connection is left in pipeline mode
+     *  and has to be reset or reconnected.
+     *  \param sql  The statement
+     *  \return The prepared statement
+     *  \throw SQLException on error
+     */
+    pPreparedStatement prepare(const std::string& sql);
+
     /*!
      *  Get the last connection error message
      *  \return The error message
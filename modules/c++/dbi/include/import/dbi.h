@@ -29,5 +29,6 @@
  */
 
 #include "dbi/DatabaseClientFactory.h"
+#include "dbi/MockConnection.h"
 
 #endif
@@ -24,6 +24,7 @@
 #include "dbi/MySQLConnection.h"
 #include "dbi/PgSQLConnection.h"
 #include "dbi/OracleConnection.h"
+#include "dbi/MockConnection.h"
 #include "config/compiler_extensions.h"
 CODA_OSS_disable_warning_push
 CODA_OSS_DISABLE_UNREACHABLE_CODE
@@ -69,6 +70,11 @@ dbi::DatabaseConnection * dbi::DatabaseClientFactory::create(const std::string&
     }
 #   endif
 
+    if (mType == dbi::MOCK)
+    {
+        connection = new dbi::MockConnection();
+    }
+
     std::string message("");
 
     if (connection && connection->connect(database, user, pass, host, port))
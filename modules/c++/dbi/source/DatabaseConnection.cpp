@@ -0,0 +1,208 @@
+/* =========================================================================
+ * This file is part of dbi-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * dbi-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "dbi/DatabaseConnection.h"
+
+#include <algorithm>
+#include <utility>
+
+void dbi::Columns::add(const std::string& name, int type, unsigned int size)
+{
+    mIndex[name] = mNames.size();
+    mNames.push_back(name);
+    mTypes.push_back(type);
+    mSizes.push_back(size);
+}
+
+size_t dbi::Columns::getIndex(const std::string& name) const
+{
+    const auto it = mIndex.find(name);
+    if (it == mIndex.end())
+    {
+        throw dbi::SQLException(Ctxt("No column named '" + name + "'"));
+    }
+    return it->second;
+}
+
+void dbi::Cursor::setColumns(std::shared_ptr<const Columns> columns)
+{
+    mColumns = std::move(columns);
+    mValues.resize(mColumns->size());
+    mNulls.assign(mColumns->size(), 1);
+}
+
+dbi::PreparedStatement::PreparedStatement(size_t numParameters) :
+    mNumParameters(numParameters),
+    mValues(numParameters),
+    mStates(numParameters, Unbound)
+{
+}
+
+size_t dbi::PreparedStatement::slot(size_t row, size_t index) const
+{
+    if (index >= mNumParameters)
+    {
+        throw dbi::SQLException(Ctxt("Parameter " + std::to_string(index) +
+                                     " is out of range; there are " +
+                                     std::to_string(mNumParameters)));
+    }
+    return row * mNumParameters + index;
+}
+
+void dbi::PreparedStatement::bind(size_t index, const std::string& value)
+{
+    const auto i = slot(mNumBatchRows, index);
+    mValues[i] = value;
+    mStates[i] = Value;
+}
+void dbi::PreparedStatement::bind(size_t index, const char* value)
+{
+    if (value == nullptr)
+    {
+        bindNull(index);
+        return;
+    }
+    const auto i = slot(mNumBatchRows, index);
+    mValues[i] = value;
+    mStates[i] = Value;
+}
+void dbi::PreparedStatement::bindNull(size_t index)
+{
+    const auto i = slot(mNumBatchRows, index);
+    mValues[i].clear();
+    mStates[i] = Null;
+}
+
+const std::string* dbi::PreparedStatement::getParameter(size_t row, size_t index) const
+{
+    const auto i = slot(row, index);
+    return mStates[i] == Null ? nullptr : &(mValues[i]);
+}
+
+void dbi::PreparedStatement::checkBound(size_t row) const
+{
+    for (size_t index = 0; index < mNumParameters; ++index)
+    {
+        if (mStates[slot(row, index)] == Unbound)
+        {
+            throw dbi::SQLException(Ctxt("Parameter " + std::to_string(index) + " isn't bound"));
+        }
+    }
+}
+
+dbi::pCursor dbi::PreparedStatement::execute()
+{
+    checkBound(mNumBatchRows);
+    return executeRow(mNumBatchRows);
+}
+
+void dbi::PreparedStatement::addBatch()
+{
+    checkBound(mNumBatchRows);
+    ++mNumBatchRows;
+
+    // The strings for the next row are kept from an earlier batch, if any.
+    const auto size = (mNumBatchRows + 1) * mNumParameters;
+    if (mValues.size() < size)
+    {
+        mValues.resize(size);
+        mStates.resize(size);
+    }
+    std::fill(mStates.begin() + mNumBatchRows * mNumParameters, mStates.begin() + size, Unbound);
+}
+
+void dbi::PreparedStatement::executeBatch()
+{
+    const auto numRows = mNumBatchRows;
+    mNumBatchRows = 0;
+    try
+    {
+        executeRows(numRows);
+    }
+    catch (...)
+    {
+        std::fill(mStates.begin(), mStates.begin() + mNumParameters, Unbound);
+        throw;
+    }
+    std::fill(mStates.begin(), mStates.begin() + mNumParameters, Unbound);
+}
+
+void dbi::PreparedStatement::executeRows(size_t numRows)
+{
+    for (size_t row = 0; row < numRows; ++row)
+    {
+        executeRow(row);
+    }
+}
+
+namespace
+{
+// Adapts the Rows of a ResultSet for DatabaseConnection::openCursor()
+class ResultSetCursor final : public dbi::Cursor
+{
+    dbi::pResultSet mResults;
+    unsigned int mNumRows = 0;
+    unsigned int mRowIndex = 0;
+
+public:
+    ResultSetCursor(dbi::pResultSet results) : mResults(std::move(results))
+    {
+        mNumRows = mResults->getNumRows();
+    }
+
+    bool next() override
+    {
+        if (mRowIndex >= mNumRows)
+        {
+            return false;
+        }
+        mRowIndex++;
+
+        auto row = mResults->fetchRow();
+        if (mRowIndex == 1)
+        {
+            auto columns = std::make_shared<dbi::Columns>();
+            for (int i = 0; i < row.getNumFields(); i++)
+            {
+                columns->add(row.getFieldName(i), row.getFieldType(i), row.getFieldSize(i));
+            }
+            setColumns(std::move(columns));
+        }
+        for (int i = 0; i < row.getNumFields(); i++)
+        {
+            const auto data = row[i].getData<std::string>();
+            setField(static_cast<size_t>(i), data.c_str(), data.size());
+        }
+        return true;
+    }
+};
+}
+
+dbi::pCursor dbi::DatabaseConnection::openCursor(const std::string& q)
+{
+    return dbi::pCursor(new ResultSetCursor(query(q)));
+}
+
+dbi::pPreparedStatement dbi::DatabaseConnection::prepare(const std::string&)
+{
+    throw dbi::SQLException(Ctxt("Prepared statements aren't supported for this database"));
+}
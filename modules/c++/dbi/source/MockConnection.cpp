@@ -0,0 +1,256 @@
+/* =========================================================================
+ * This file is part of dbi-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * dbi-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "dbi/MockConnection.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace dbi
+{
+namespace
+{
+class MockCursor final : public Cursor
+{
+    const std::vector<std::vector<std::string> >& mRows;
+    size_t mRowIndex = 0;
+
+public:
+    MockCursor(std::shared_ptr<const Columns> columns,
+               const std::vector<std::vector<std::string> >& rows) :
+        mRows(rows)
+    {
+        setColumns(std::move(columns));
+    }
+
+    bool next() override
+    {
+        if (mRowIndex >= mRows.size())
+        {
+            return false;
+        }
+        const auto& row = mRows[mRowIndex++];
+        for (size_t i = 0; i < row.size(); i++)
+        {
+            setField(i, row[i].c_str(), row[i].size());
+        }
+        return true;
+    }
+};
+
+class MockResultSet final : public ResultSet
+{
+    std::shared_ptr<const Columns> mColumns;
+    const std::vector<std::vector<std::string> >& mRows;
+    unsigned int mRowIndex = 0;
+
+public:
+    MockResultSet(std::shared_ptr<const Columns> columns,
+                  const std::vector<std::vector<std::string> >& rows) :
+        mColumns(std::move(columns)), mRows(rows)
+    {
+    }
+
+    Row fetchRow() override
+    {
+        if (mRowIndex >= mRows.size())
+        {
+            throw SQLException(Ctxt("Cannot retrieve any more rows"));
+        }
+        const auto& values = mRows[mRowIndex++];
+        Row row;
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            row.addField(mColumns->getName(i), mColumns->getType(i),
+                         static_cast<int>(values[i].size()), values[i]);
+        }
+        return row;
+    }
+
+    unsigned int getNumRows() override
+    {
+        return static_cast<unsigned int>(mRows.size());
+    }
+};
+
+// The number of parameters: the number of ?s, or the largest $n
+size_t countParameters(const std::string& sql)
+{
+    size_t numQuestionMarks = 0;
+    size_t maxDollar = 0;
+    for (size_t i = 0; i < sql.size(); i++)
+    {
+        if (sql[i] == '?')
+        {
+            numQuestionMarks++;
+        }
+        else if (sql[i] == '$' && i + 1 < sql.size() && isdigit(sql[i + 1]))
+        {
+            maxDollar = std::max(maxDollar, static_cast<size_t>(strtoul(sql.c_str() + i + 1, nullptr, 10)));
+        }
+    }
+    return std::max(numQuestionMarks, maxDollar);
+}
+}
+
+class MockPreparedStatement final : public PreparedStatement
+{
+    MockConnection& mConnection;
+    std::string mSQL;
+    std::string mLogEntry;
+
+    const MockConnection::Result& executeOne(size_t row)
+    {
+        mLogEntry = mSQL;
+        if (getNumParameters() > 0)
+        {
+            for (size_t i = 0; i < getNumParameters(); i++)
+            {
+                const auto value = getParameter(row, i);
+                mLogEntry += (i == 0) ? " [" : ", ";
+                mLogEntry += (value == nullptr) ? "NULL" : "'" + *value + "'";
+            }
+            mLogEntry += "]";
+        }
+        return mConnection.execute(mSQL, mLogEntry);
+    }
+
+public:
+    MockPreparedStatement(MockConnection& connection, const std::string& sql) :
+        PreparedStatement(countParameters(sql)), mConnection(connection), mSQL(sql)
+    {
+    }
+
+protected:
+    pCursor executeRow(size_t row) override
+    {
+        mConnection.mNumRoundTrips++;
+        const auto& result = executeOne(row);
+        return pCursor(new MockCursor(result.columns, result.rows));
+    }
+
+    void executeRows(size_t numRows) override
+    {
+        // the whole batch is sent at once
+        mConnection.mNumRoundTrips++;
+        for (size_t row = 0; row < numRows; row++)
+        {
+            executeOne(row);
+        }
+    }
+};
+
+bool MockConnection::connect(const std::string&, const std::string&,
+                             const std::string&, const std::string&,
+                             unsigned int)
+{
+    mConnected = true;
+    return true;
+}
+
+void MockConnection::disconnect()
+{
+    mConnected = false;
+}
+
+const MockConnection::Result& MockConnection::execute(const std::string& sql,
+                                                      const std::string& logEntry)
+{
+    if (!mConnected)
+    {
+        mLastError = "Not connected";
+        throw SQLException(Ctxt(mLastError));
+    }
+    mLog.push_back(logEntry);
+
+    const auto error = mErrors.find(sql);
+    if (error != mErrors.end())
+    {
+        mLastError = error->second;
+        throw SQLException(Ctxt(mLastError));
+    }
+
+    const auto result = mResults.find(sql);
+    return result == mResults.end() ? mNoResult : result->second;
+}
+
+pResultSet MockConnection::query(const std::string& q)
+{
+    mNumRoundTrips++;
+    const auto& result = execute(q, q);
+    return pResultSet(new MockResultSet(result.columns, result.rows));
+}
+
+pCursor MockConnection::openCursor(const std::string& q)
+{
+    mNumRoundTrips++;
+    const auto& result = execute(q, q);
+    return pCursor(new MockCursor(result.columns, result.rows));
+}
+
+pPreparedStatement MockConnection::prepare(const std::string& sql)
+{
+    if (!mConnected)
+    {
+        mLastError = "Not connected";
+        throw SQLException(Ctxt(mLastError));
+    }
+    mNumRoundTrips++;
+    return pPreparedStatement(new MockPreparedStatement(*this, sql));
+}
+
+const std::string MockConnection::getLastErrorMessage()
+{
+    return mLastError;
+}
+
+void MockConnection::setResult(const std::string& sql,
+                               const std::vector<std::string>& columnNames,
+                               const std::vector<std::vector<std::string> >& rows)
+{
+    auto columns = std::make_shared<Columns>();
+    for (const auto& name : columnNames)
+    {
+        columns->add(name, 0, 0);
+    }
+    for (const auto& row : rows)
+    {
+        if (row.size() != columnNames.size())
+        {
+            throw SQLException(Ctxt("Every row needs a value for each column"));
+        }
+    }
+
+    Result result;
+    result.columns = std::move(columns);
+    result.rows = rows;
+    mResults[sql] = std::move(result);
+}
+
+void MockConnection::setError(const std::string& sql, const std::string& message)
+{
+    mErrors[sql] = message;
+}
+}
@@ -24,6 +24,9 @@
 #if defined(USE_MYSQL)
 
 #include "dbi/MySQLConnection.h"
+#include <memory>
+#include <type_traits>
+#include <utility>
 #include <import/sys.h>
 
 bool dbi::MySQLConnection::connect(const std::string& database,
@@ -121,4 +124,269 @@ dbi::Row dbi::MySQLResultSet::fetchRow()
     return row;
 }
 
+namespace
+{
+// my_bool in older versions of the client library, bool in newer ones
+typedef std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type MySQLBool;
+
+// The length and NULL indicator a MYSQL_BIND points to
+struct BindData
+{
+    unsigned long length = 0;
+    MySQLBool isNull = 0;
+};
+
+std::shared_ptr<dbi::Columns> makeColumns(MYSQL_RES* results)
+{
+    auto columns = std::make_shared<dbi::Columns>();
+    const unsigned int numFields = mysql_num_fields(results);
+    for (unsigned int i = 0; i < numFields; i++)
+    {
+        const MYSQL_FIELD* field = mysql_fetch_field_direct(results, i);
+        columns->add(field->name, field->type, field->length);
+    }
+    return columns;
+}
+
+// Rows of a text query, read from the server as they're needed
+class MySQLCursor final : public dbi::Cursor
+{
+public:
+    MySQLCursor(MYSQL* connection, MYSQL_RES* results) :
+        mConnection(connection), mResults(results)
+    {
+        if (mResults)
+        {
+            setColumns(makeColumns(mResults));
+        }
+    }
+
+    ~MySQLCursor()
+    {
+        // this also reads (and discards) any rows still on the server
+        if (mResults) mysql_free_result(mResults);
+    }
+
+    bool next() override
+    {
+        if (!mResults)
+        {
+            return false;
+        }
+
+        MYSQL_ROW row = mysql_fetch_row(mResults);
+        if (!row)
+        {
+            if (mysql_errno(mConnection))
+            {
+                throw dbi::SQLException(Ctxt(mysql_error(mConnection)));
+            }
+            return false;
+        }
+
+        const unsigned long* lengths = mysql_fetch_lengths(mResults);
+        for (size_t i = 0; i < getNumFields(); i++)
+        {
+            if (!row[i])
+            {
+                setNull(i);
+            }
+            else
+            {
+                setField(i, row[i], lengths[i]);
+            }
+        }
+        return true;
+    }
+
+private:
+    MYSQL* mConnection;
+    MYSQL_RES* mResults;
+};
+
+/*
+ * Rows of a prepared statement.  Every column is fetched as a string into
+ * a buffer that's grown (and re-bound) when a value doesn't fit.
+ */
+class MySQLStatementCursor final : public dbi::Cursor
+{
+public:
+    MySQLStatementCursor(MYSQL_STMT* statement, MYSQL_RES* metadata) :
+        mStatement(statement)
+    {
+        if (!metadata) // e.g., INSERT
+        {
+            return;
+        }
+        setColumns(makeColumns(metadata));
+        mysql_free_result(metadata);
+
+        const size_t numFields = getNumFields();
+        mBinds.resize(numFields);
+        mBindData.resize(numFields);
+        mBuffers.resize(numFields);
+        for (size_t i = 0; i < numFields; i++)
+        {
+            mBuffers[i].resize(256);
+            mBinds[i].buffer_type = MYSQL_TYPE_STRING;
+            mBinds[i].length = &mBindData[i].length;
+            mBinds[i].is_null = &mBindData[i].isNull;
+        }
+        bindResult();
+    }
+
+    ~MySQLStatementCursor()
+    {
+        mysql_stmt_free_result(mStatement);
+    }
+
+    bool next() override
+    {
+        if (mBinds.empty())
+        {
+            return false;
+        }
+
+        const int status = mysql_stmt_fetch(mStatement);
+        if (status == MYSQL_NO_DATA)
+        {
+            return false;
+        }
+        if (status == MYSQL_DATA_TRUNCATED)
+        {
+            for (unsigned int i = 0; i < mBinds.size(); i++)
+            {
+                if (!mBindData[i].isNull && mBindData[i].length > mBuffers[i].size())
+                {
+                    mBuffers[i].resize(mBindData[i].length);
+                    mBinds[i].buffer = mBuffers[i].data();
+                    mBinds[i].buffer_length = mBuffers[i].size();
+                    if (mysql_stmt_fetch_column(mStatement, &mBinds[i], i, 0))
+                    {
+                        throw dbi::SQLException(Ctxt(mysql_stmt_error(mStatement)));
+                    }
+                }
+            }
+            bindResult();
+        }
+        else if (status != 0)
+        {
+            throw dbi::SQLException(Ctxt(mysql_stmt_error(mStatement)));
+        }
+
+        for (size_t i = 0; i < mBinds.size(); i++)
+        {
+            if (mBindData[i].isNull)
+            {
+                setNull(i);
+            }
+            else
+            {
+                setField(i, mBuffers[i].data(), mBindData[i].length);
+            }
+        }
+        return true;
+    }
+
+private:
+    void bindResult()
+    {
+        for (size_t i = 0; i < mBinds.size(); i++)
+        {
+            mBinds[i].buffer = mBuffers[i].data();
+            mBinds[i].buffer_length = mBuffers[i].size();
+        }
+        if (mysql_stmt_bind_result(mStatement, mBinds.data()))
+        {
+            throw dbi::SQLException(Ctxt(mysql_stmt_error(mStatement)));
+        }
+    }
+
+    MYSQL_STMT* mStatement;
+    std::vector<MYSQL_BIND> mBinds;
+    std::vector<BindData> mBindData;
+    std::vector<std::vector<char> > mBuffers;
+};
+
+class MySQLPreparedStatement final : public dbi::PreparedStatement
+{
+public:
+    explicit MySQLPreparedStatement(MYSQL_STMT* statement) :
+        dbi::PreparedStatement(mysql_stmt_param_count(statement)),
+        mStatement(statement),
+        mBinds(getNumParameters()),
+        mBindData(getNumParameters())
+    {
+    }
+
+    ~MySQLPreparedStatement()
+    {
+        mysql_stmt_close(mStatement);
+    }
+
+protected:
+    dbi::pCursor executeRow(size_t row) override
+    {
+        // The parameters are sent as strings; the server converts them.
+        for (size_t i = 0; i < mBinds.size(); i++)
+        {
+            const std::string* value = getParameter(row, i);
+            MYSQL_BIND& bind = mBinds[i];
+            bind.buffer_type = MYSQL_TYPE_STRING;
+            bind.buffer = value ? const_cast<char*>(value->data()) : nullptr;
+            bind.buffer_length = value ? value->size() : 0;
+            mBindData[i].length = bind.buffer_length;
+            mBindData[i].isNull = value ? 0 : 1;
+            bind.length = &mBindData[i].length;
+            bind.is_null = &mBindData[i].isNull;
+        }
+
+        if ((!mBinds.empty() && mysql_stmt_bind_param(mStatement, mBinds.data())) ||
+            mysql_stmt_execute(mStatement))
+        {
+            throw dbi::SQLException(Ctxt(mysql_stmt_error(mStatement)));
+        }
+        return dbi::pCursor(new MySQLStatementCursor(mStatement,
+                                                     mysql_stmt_result_metadata(mStatement)));
+    }
+
+private:
+    MYSQL_STMT* mStatement;
+    std::vector<MYSQL_BIND> mBinds;
+    std::vector<BindData> mBindData;
+};
+}
+
+dbi::pCursor dbi::MySQLConnection::openCursor(const std::string& q)
+{
+    if (mysql_real_query(&mDBHandle, q.c_str(), q.size()))
+    {
+        throw dbi::SQLException(Ctxt(mysql_error(&mDBHandle)));
+    }
+
+    // Unlike mysql_store_result(), rows are read as they're fetched.
+    MYSQL_RES* results = mysql_use_result(&mDBHandle);
+    if (!results && mysql_field_count(&mDBHandle) != 0)
+    {
+        throw dbi::SQLException(Ctxt(mysql_error(&mDBHandle)));
+    }
+    return dbi::pCursor(new MySQLCursor(&mDBHandle, results));
+}
+
+dbi::pPreparedStatement dbi::MySQLConnection::prepare(const std::string& sql)
+{
+    MYSQL_STMT* statement = mysql_stmt_init(&mDBHandle);
+    if (!statement)
+    {
+        throw dbi::SQLException(Ctxt(mysql_error(&mDBHandle)));
+    }
+    if (mysql_stmt_prepare(statement, sql.c_str(), sql.size()))
+    {
+        const std::string errorMessage = mysql_stmt_error(statement);
+        mysql_stmt_close(statement);
+        throw dbi::SQLException(Ctxt(errorMessage));
+    }
+    return dbi::pPreparedStatement(new MySQLPreparedStatement(statement));
+}
+
 #endif
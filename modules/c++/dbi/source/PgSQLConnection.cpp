@@ -24,7 +24,9 @@
 #if defined(USE_PGSQL)
 
 #include "dbi/PgSQLConnection.h"
+#include <atomic>
 #include <sstream>
+#include <utility>
 #include <import/sys.h>
 
 bool dbi::PgSQLConnection::connect(const std::string& database,
@@ -121,4 +123,303 @@ dbi::Row dbi::PgSQLResultSet::fetchRow()
     return row;
 }
 
+namespace
+{
+// Throws (and clears the result) unless the command succeeded
+void checkResult(PGconn* connection, PGresult* result)
+{
+    if (!result)
+    {
+        throw dbi::SQLException(Ctxt(PQerrorMessage(connection)));
+    }
+    const ExecStatusType status = PQresultStatus(result);
+    if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK)
+    {
+        const std::string errorMessage = PQresultErrorMessage(result);
+        PQclear(result);
+        throw dbi::SQLException(Ctxt(errorMessage));
+    }
+}
+
+/*
+ * Reads either a complete PGresult, or the results of a command sent in
+ * single-row mode, where every row is a PGresult of its own.
+ */
+class PgSQLCursor final : public dbi::Cursor
+{
+public:
+    // Streams the results of the command just sent
+    explicit PgSQLCursor(PGconn* connection) : mConnection(connection)
+    {
+        // Get the first row now, so that errors are reported by openCursor()
+        fetchResult();
+    }
+
+    explicit PgSQLCursor(PGresult* result) : mResult(result)
+    {
+        setColumnsFrom(result);
+    }
+
+    ~PgSQLCursor()
+    {
+        if (mResult) PQclear(mResult);
+        drain();
+    }
+
+    bool next() override
+    {
+        while (!mResult || mRowIndex >= PQntuples(mResult))
+        {
+            if (!mConnection)
+            {
+                return false;
+            }
+            fetchResult();
+        }
+
+        const int numFields = PQnfields(mResult);
+        for (int i = 0; i < numFields; i++)
+        {
+            if (PQgetisnull(mResult, mRowIndex, i))
+            {
+                setNull(i);
+            }
+            else
+            {
+                setField(i, PQgetvalue(mResult, mRowIndex, i),
+                         PQgetlength(mResult, mRowIndex, i));
+            }
+        }
+        mRowIndex++;
+        return true;
+    }
+
+private:
+    void setColumnsFrom(const PGresult* result)
+    {
+        if (mHaveColumns)
+        {
+            return;
+        }
+        auto columns = std::make_shared<dbi::Columns>();
+        const int numFields = PQnfields(result);
+        for (int i = 0; i < numFields; i++)
+        {
+            columns->add(PQfname(result, i), PQftype(result, i), PQfsize(result, i));
+        }
+        setColumns(std::move(columns));
+        mHaveColumns = true;
+    }
+
+    // Replace mResult with the next row, if any
+    void fetchResult()
+    {
+        if (mResult) PQclear(mResult);
+        mResult = nullptr;
+        mRowIndex = 0;
+
+        while (mConnection)
+        {
+            PGresult* result = PQgetResult(mConnection);
+            if (!result)
+            {
+                mConnection = nullptr;
+                return;
+            }
+
+            switch (PQresultStatus(result))
+            {
+            case PGRES_SINGLE_TUPLE:
+                setColumnsFrom(result);
+                mResult = result;
+                return;
+
+            case PGRES_TUPLES_OK: // the end of the rows; has the columns
+                setColumnsFrom(result);
+                PQclear(result);
+                break;
+
+            case PGRES_COMMAND_OK:
+                PQclear(result);
+                break;
+
+            default:
+            {
+                const std::string errorMessage = PQresultErrorMessage(result);
+                PQclear(result);
+                drain();
+                throw dbi::SQLException(Ctxt(errorMessage));
+            }
+            }
+        }
+    }
+
+    // The connection can't be used again until every result is read.
+    void drain()
+    {
+        while (mConnection)
+        {
+            PGresult* result = PQgetResult(mConnection);
+            if (!result)
+            {
+                mConnection = nullptr;
+            }
+            PQclear(result);
+        }
+    }
+
+    PGconn* mConnection = nullptr;
+    PGresult* mResult = nullptr;
+    int mRowIndex = 0;
+    bool mHaveColumns = false;
+};
+
+class PgSQLPreparedStatement final : public dbi::PreparedStatement
+{
+public:
+    PgSQLPreparedStatement(PGconn* connection, const std::string& name, size_t numParameters) :
+        dbi::PreparedStatement(numParameters),
+        mConnection(connection),
+        mName(name),
+        mParameters(numParameters)
+    {
+    }
+
+    ~PgSQLPreparedStatement()
+    {
+        PQclear(PQexec(mConnection, ("DEALLOCATE " + mName).c_str()));
+    }
+
+protected:
+    dbi::pCursor executeRow(size_t row) override
+    {
+        setParameters(row);
+        PGresult* result = PQexecPrepared(mConnection, mName.c_str(),
+                                          static_cast<int>(mParameters.size()),
+                                          mParameters.data(), nullptr, nullptr, 0);
+        checkResult(mConnection, result);
+        return dbi::pCursor(new PgSQLCursor(result));
+    }
+
+#ifdef LIBPQ_HAS_PIPELINING
+    void executeRows(size_t numRows) override
+    {
+        if (numRows < 2)
+        {
+            dbi::PreparedStatement::executeRows(numRows);
+            return;
+        }
+
+        // Send every row, then one sync: a single round trip, and the rows
+        // are an implicit transaction, so an error applies none of them.
+        if (!PQenterPipelineMode(mConnection))
+        {
+            throw dbi::SQLException(Ctxt(PQerrorMessage(mConnection)));
+        }
+
+        std::string errorMessage;
+        for (size_t row = 0; row < numRows && errorMessage.empty(); row++)
+        {
+            setParameters(row);
+            if (!PQsendQueryPrepared(mConnection, mName.c_str(),
+                                     static_cast<int>(mParameters.size()),
+                                     mParameters.data(), nullptr, nullptr, 0))
+            {
+                errorMessage = PQerrorMessage(mConnection);
+            }
+        }
+        if (!PQpipelineSync(mConnection))
+        {
+            // Nothing more can be sent, so there's no sync to wait for:
+            // reading the queued results could block forever, and the
+            // pipeline can't be left until they're read.  The connection is
+            // unusable until it's reset (PQreset()) or reconnected.
+            if (errorMessage.empty()) errorMessage = PQerrorMessage(mConnection);
+            throw dbi::SQLException(Ctxt("Can't send the batch; the connection must be reset: " + errorMessage));
+        }
+
+        // Each command's results end with a nullptr; after the last
+        // one comes the sync.  Two nullptrs in a row means trouble.
+        bool previousWasNull = false;
+        while (true)
+        {
+            PGresult* result = PQgetResult(mConnection);
+            if (!result)
+            {
+                if (previousWasNull)
+                {
+                    if (errorMessage.empty()) errorMessage = PQerrorMessage(mConnection);
+                    break;
+                }
+                previousWasNull = true;
+                continue;
+            }
+            previousWasNull = false;
+
+            const ExecStatusType status = PQresultStatus(result);
+            if (status == PGRES_FATAL_ERROR && errorMessage.empty())
+            {
+                errorMessage = PQresultErrorMessage(result);
+            }
+            PQclear(result);
+            if (status == PGRES_PIPELINE_SYNC)
+            {
+                break;
+            }
+        }
+        if (!PQexitPipelineMode(mConnection) && errorMessage.empty())
+        {
+            errorMessage = PQerrorMessage(mConnection);
+        }
+
+        if (!errorMessage.empty())
+        {
+            throw dbi::SQLException(Ctxt(errorMessage));
+        }
+    }
+#endif
+
+private:
+    void setParameters(size_t row)
+    {
+        for (size_t i = 0; i < mParameters.size(); i++)
+        {
+            const std::string* value = getParameter(row, i);
+            mParameters[i] = value ? value->c_str() : nullptr;
+        }
+    }
+
+    PGconn* mConnection;
+    const std::string mName;
+    std::vector<const char*> mParameters;
+};
+}
+
+dbi::pCursor dbi::PgSQLConnection::openCursor(const std::string& q)
+{
+    if (!PQsendQuery(mDBHandle, q.c_str()))
+    {
+        throw dbi::SQLException(Ctxt(PQerrorMessage(mDBHandle)));
+    }
+    PQsetSingleRowMode(mDBHandle);
+    return dbi::pCursor(new PgSQLCursor(mDBHandle));
+}
+
+dbi::pPreparedStatement dbi::PgSQLConnection::prepare(const std::string& sql)
+{
+    static std::atomic<size_t> numStatements(0);
+    const std::string name = "dbi_statement_" + std::to_string(++numStatements);
+
+    // Let the server infer the parameter types, then ask how many there are
+    PGresult* prepared = PQprepare(mDBHandle, name.c_str(), sql.c_str(), 0, nullptr);
+    checkResult(mDBHandle, prepared);
+    PQclear(prepared);
+    PGresult* description = PQdescribePrepared(mDBHandle, name.c_str());
+    checkResult(mDBHandle, description);
+    const size_t numParameters = PQnparams(description);
+    PQclear(description);
+
+    return dbi::pPreparedStatement(new PgSQLPreparedStatement(mDBHandle, name, numParameters));
+}
+
 #endif
@@ -0,0 +1,188 @@
+/* =========================================================================
+ * This file is part of dbi-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * dbi-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include <import/dbi.h>
+
+#include "TestCase.h"
+
+static std::unique_ptr<dbi::MockConnection> connect()
+{
+    std::unique_ptr<dbi::MockConnection> retval(new dbi::MockConnection());
+    retval->connect("test");
+    retval->setResult("SELECT id, name FROM images",
+                      { "id", "name" },
+                      { { "1", "one" }, { "2", "two" }, { "3", "three" } });
+    return retval;
+}
+
+TEST_CASE(testCursor)
+{
+    auto connection = connect();
+    auto cursor = connection->openCursor("SELECT id, name FROM images");
+    TEST_ASSERT_EQ(cursor->getColumns().size(), static_cast<size_t>(2));
+    TEST_ASSERT_EQ(cursor->getColumns().getIndex("name"), static_cast<size_t>(1));
+    TEST_THROWS(cursor->getColumns().getIndex("size"));
+
+    std::vector<int> ids;
+    std::string names;
+    while (cursor->next())
+    {
+        TEST_ASSERT_FALSE(cursor->isNull(0));
+        ids.push_back(cursor->get<int>(0));
+        names += cursor->getString("name");
+    }
+    TEST_ASSERT(ids == std::vector<int>({ 1, 2, 3 }));
+    TEST_ASSERT_EQ(names, "onetwothree");
+    TEST_ASSERT_FALSE(cursor->next());
+
+    // a statement without rows
+    cursor = connection->openCursor("DELETE FROM images");
+    TEST_ASSERT_EQ(cursor->getColumns().size(), static_cast<size_t>(0));
+    TEST_ASSERT_FALSE(cursor->next());
+}
+
+TEST_CASE(testQuery)
+{
+    auto connection = connect();
+    auto results = connection->query("SELECT id, name FROM images");
+    TEST_ASSERT_EQ(results->getNumRows(), static_cast<unsigned int>(3));
+    auto row = results->fetchRow();
+    TEST_ASSERT_EQ(row["name"].getData<std::string>(), "one");
+
+    // DatabaseConnection::openCursor() adapts query()
+    auto cursor = connection->dbi::DatabaseConnection::openCursor("SELECT id, name FROM images");
+    TEST_ASSERT(cursor->next());
+    TEST_ASSERT(cursor->next());
+    TEST_ASSERT_EQ(cursor->get<int>("id"), 2);
+    TEST_ASSERT_EQ(cursor->getString(1), "two");
+    TEST_ASSERT(cursor->next());
+    TEST_ASSERT_FALSE(cursor->next());
+}
+
+TEST_CASE(testPreparedStatement)
+{
+    auto connection = connect();
+    auto statement = connection->prepare("UPDATE images SET name = $2 WHERE id = $1");
+    TEST_ASSERT_EQ(statement->getNumParameters(), static_cast<size_t>(2));
+    TEST_THROWS(statement->bind(2, "three"));
+
+    statement->bind(0, 1);
+    TEST_THROWS(statement->execute()); // $2 isn't bound
+    statement->bind(1, "uno");
+    statement->execute();
+    statement->bindNull(1);
+    statement->execute(); // $1 is still bound
+    statement->bind(1, static_cast<const char*>(nullptr));
+    statement->bind(0, 2.5);
+    statement->execute();
+
+    const auto& log = connection->getLog();
+    TEST_ASSERT_EQ(log.size(), static_cast<size_t>(3));
+    TEST_ASSERT_EQ(log[0], "UPDATE images SET name = $2 WHERE id = $1 ['1', 'uno']");
+    TEST_ASSERT_EQ(log[1], "UPDATE images SET name = $2 WHERE id = $1 ['1', NULL]");
+    TEST_ASSERT_EQ(log[2], "UPDATE images SET name = $2 WHERE id = $1 ['2.5', NULL]");
+    TEST_ASSERT_EQ(connection->getNumRoundTrips(), static_cast<size_t>(4));
+
+    // results come back through the cursor
+    auto select = connection->prepare("SELECT id, name FROM images");
+    TEST_ASSERT_EQ(select->getNumParameters(), static_cast<size_t>(0));
+    auto cursor = select->execute();
+    TEST_ASSERT(cursor->next());
+    TEST_ASSERT_EQ(cursor->getString("name"), "one");
+}
+
+TEST_CASE(testBatch)
+{
+    auto connection = connect();
+    auto insert = connection->prepare("INSERT INTO images VALUES (?, ?)");
+    connection->clearLog();
+
+    for (int i = 0; i < 3; i++)
+    {
+        insert->bind(0, i);
+        if (i != 1)
+        {
+            insert->bind(1, "image" + std::to_string(i));
+        }
+        else
+        {
+            insert->bindNull(1);
+        }
+        insert->addBatch();
+    }
+    TEST_ASSERT_EQ(insert->getBatchSize(), static_cast<size_t>(3));
+
+    // every parameter has to be bound again for the next row
+    insert->bind(0, 3);
+    TEST_THROWS(insert->addBatch());
+
+    insert->executeBatch();
+    TEST_ASSERT_EQ(insert->getBatchSize(), static_cast<size_t>(0));
+    TEST_ASSERT_EQ(connection->getNumRoundTrips(), static_cast<size_t>(1));
+    const auto& log = connection->getLog();
+    TEST_ASSERT_EQ(log.size(), static_cast<size_t>(3));
+    TEST_ASSERT_EQ(log[0], "INSERT INTO images VALUES (?, ?) ['0', 'image0']");
+    TEST_ASSERT_EQ(log[1], "INSERT INTO images VALUES (?, ?) ['1', NULL]");
+    TEST_ASSERT_EQ(log[2], "INSERT INTO images VALUES (?, ?) ['2', 'image2']");
+
+    // the buffers are reused for the next batch
+    connection->clearLog();
+    insert->bind(0, 4);
+    insert->bind(1, "four");
+    insert->addBatch();
+    insert->executeBatch();
+    TEST_ASSERT_EQ(log.size(), static_cast<size_t>(1));
+    TEST_ASSERT_EQ(log[0], "INSERT INTO images VALUES (?, ?) ['4', 'four']");
+}
+
+TEST_CASE(testErrors)
+{
+    auto connection = connect();
+    connection->setError("DROP TABLE images", "permission denied");
+    TEST_EXCEPTION(connection->query("DROP TABLE images"));
+    TEST_ASSERT_EQ(connection->getLastErrorMessage(), "permission denied");
+    TEST_EXCEPTION(connection->openCursor("DROP TABLE images"));
+
+    auto statement = connection->prepare("DROP TABLE images");
+    statement->addBatch();
+    TEST_EXCEPTION(statement->executeBatch());
+    TEST_ASSERT_EQ(statement->getBatchSize(), static_cast<size_t>(0));
+
+    connection->disconnect();
+    TEST_EXCEPTION(connection->query("SELECT id, name FROM images"));
+
+    dbi::DatabaseClientFactory factory(dbi::MOCK);
+    auto created = factory.create("test");
+    TEST_ASSERT_NOT_NULL(created);
+    factory.destroy(created);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testCursor);
+    TEST_CHECK(testQuery);
+    TEST_CHECK(testPreparedStatement);
+    TEST_CHECK(testBatch);
+    TEST_CHECK(testErrors);
+    )
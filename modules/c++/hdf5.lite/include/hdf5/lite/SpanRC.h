@@ -31,8 +31,12 @@ namespace hdf5
 namespace lite
 {
 
+// Row-major N-dimensional data, i.e., the memory layout of an HDF5 dataset.
+template<typename T, size_t Rank>
+using SpanN = coda_oss::mdspan<T, coda_oss::dextents<size_t, Rank>>;
+
 template<typename T>
-using SpanRC = coda_oss::mdspan<T, coda_oss::dextents<size_t, 2>>;
+using SpanRC = SpanN<T, 2>;
 
 }
 }
@@ -29,15 +29,46 @@
  * \brief Utility routines for using HighFive
  */
 
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <complex>
 #include <string>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
+#include "types/Complex.h"
 #include "types/RowCol.h"
+#include "mem/ComplexView.h"
 
 #include "H5_.h"
 #include "SpanRC.h"
 
+namespace hdf5
+{
+namespace lite
+{
+namespace details
+{
+// HighFive stores std::complex<T> as a compound type with "r" and "i" members;
+// do the same for types::Complex<T>.
+template <typename T>
+inline HighFive::DataType createComplexDataType()
+{
+    static_assert(sizeof(types::Complex<T>) == 2 * sizeof(T), "types::Complex<T> should be two T values");
+    return HighFive::CompoundType({{"r", HighFive::create_datatype<T>(), 0}, {"i", HighFive::create_datatype<T>(), sizeof(T)}},
+                                  sizeof(types::Complex<T>));
+}
+}
+}
+}
+HIGHFIVE_REGISTER_TYPE(types::Complex<int8_t>, hdf5::lite::details::createComplexDataType<int8_t>)
+HIGHFIVE_REGISTER_TYPE(types::Complex<int16_t>, hdf5::lite::details::createComplexDataType<int16_t>)
+HIGHFIVE_REGISTER_TYPE(types::Complex<int32_t>, hdf5::lite::details::createComplexDataType<int32_t>)
+HIGHFIVE_REGISTER_TYPE(types::Complex<int64_t>, hdf5::lite::details::createComplexDataType<int64_t>)
+
 namespace hdf5
 {
 namespace lite
@@ -49,56 +80,493 @@ inline auto v_load(const H5Easy::File& file, const std::string& dataset_name)
 {
     return H5Easy::load<std::vector<T>>(file, dataset_name);
 }
+// Prefer loadDataSet(), which doesn't make a vector for every row.
 template <typename T>
 inline auto vv_load(const H5Easy::File& file, const std::string& dataset_name)
 {
     return H5Easy::load<std::vector<std::vector<T>>>(file, dataset_name);
 }
 
+// HDF5 can be built without zlib, in which case there's no deflate filter.
+inline bool isDeflateAvailable()
+{
+    return H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0;
+}
+
+/*!
+ * Creation properties for a chunked dataset, which is needed for compression
+ * and lets readers get at part of a dataset without reading all of it.
+ * Compression is deflate, preceded by the shuffle filter (which usually
+ * helps quite a bit with numeric data).
+ *
+ * \param chunkDims  Size of each chunk; no bigger than the dataset
+ * \param deflateLevel  0 (no compression) to 9 (most compression); see
+ *        isDeflateAvailable()
+ * \param shuffle  Shuffle bytes before deflating
+ */
+template <size_t Rank>
+inline HighFive::DataSetCreateProps makeChunkedCreateProps(const std::array<size_t, Rank>& chunkDims,
+                                                           unsigned deflateLevel = 0, bool shuffle = true)
+{
+    if (std::find(chunkDims.begin(), chunkDims.end(), 0) != chunkDims.end())
+    {
+        throw std::invalid_argument("'chunkDims' must be non-zero.");
+    }
+    if (deflateLevel > 9)
+    {
+        throw std::invalid_argument("'deflateLevel' must be 0-9.");
+    }
+
+    HighFive::DataSetCreateProps retval;
+    retval.add(HighFive::Chunking(std::vector<hsize_t>(chunkDims.begin(), chunkDims.end())));
+    if (deflateLevel > 0)
+    {
+        if (shuffle)
+        {
+            retval.add(HighFive::Shuffle()); // filters are applied in order
+        }
+        retval.add(HighFive::Deflate(deflateLevel));
+    }
+    return retval;
+}
+inline HighFive::DataSetCreateProps makeChunkedCreateProps(const types::RowCol<size_t>& chunkDims,
+                                                           unsigned deflateLevel = 0, bool shuffle = true)
+{
+    return makeChunkedCreateProps(std::array<size_t, 2>{chunkDims.row, chunkDims.col}, deflateLevel, shuffle);
+}
+
+namespace details
+{
+template <typename T, size_t Rank>
+inline std::array<size_t, Rank> getExtents(SpanN<T, Rank> data)
+{
+    std::array<size_t, Rank> retval;
+    for (size_t r = 0; r < Rank; r++)
+    {
+        retval[r] = data.extent(r);
+    }
+    return retval;
+}
+
+// How complex data with T real and imaginary parts is stored.
+template <typename T>
+using complex_t = std::conditional_t<std::is_floating_point<T>::value, std::complex<T>, types::Complex<T>>;
+}
+
+// Create an N-D dataset to be written in pieces with writeDataSet(dataSet, offset, window).
+template <typename T, size_t Rank>
+inline HighFive::DataSet createDataSet(H5Easy::File& file, const std::string& dataset_name, const std::array<size_t, Rank>& dims,
+                                       const HighFive::DataSetCreateProps& createProps = HighFive::DataSetCreateProps::Default())
+{
+    const HighFive::DataSpace dataspace{std::vector<size_t>(dims.begin(), dims.end())};
+    return file.createDataSet<T>(dataset_name, dataspace, createProps);
+}
 template <typename T>
-inline HighFive::DataSet writeDataSet(H5Easy::File& file, const std::string& dataset_name, SpanRC<T> data /*, TODO ...*/)
+inline HighFive::DataSet createDataSet(H5Easy::File& file, const std::string& dataset_name, const types::RowCol<size_t>& dims,
+                                       const HighFive::DataSetCreateProps& createProps = HighFive::DataSetCreateProps::Default())
 {
-    const std::vector<size_t> dims{data.extent(0), data.extent(1)};
-    const HighFive::DataSpace dataspace{dims};
-    auto retval = file.createDataSet<T>(dataset_name, dataspace);
+    return createDataSet<T>(file, dataset_name, std::array<size_t, 2>{dims.row, dims.col}, createProps);
+}
+
+// Write N-D data (e.g., SpanRC<T>) straight from caller memory; T can also be
+// std::complex<float>, std::complex<double> or types::Complex<int16_t>.
+template <typename T, size_t Rank>
+inline HighFive::DataSet writeDataSet(H5Easy::File& file, const std::string& dataset_name, SpanN<T, Rank> data,
+                                      const HighFive::DataSetCreateProps& createProps = HighFive::DataSetCreateProps::Default())
+{
+    auto retval = createDataSet<std::remove_const_t<T>>(file, dataset_name, details::getExtents(data), createProps);
     retval.write_raw(data.data_handle());
     return retval;
 }
 
 template<typename T>
-inline HighFive::DataSet writeDataSet(const H5Easy::File& file, const std::string& dataset_name, const T& values /*, TODO ...*/)
+inline HighFive::DataSet writeDataSet(const H5Easy::File& file, const std::string& dataset_name, const T& values,
+                                      const HighFive::DataSetCreateProps& createProps = HighFive::DataSetCreateProps::Default())
 { 
-    auto dataset = file.createDataSet<T>(dataset_name, HighFive::DataSpace::From(values));
+    auto dataset = file.createDataSet<T>(dataset_name, HighFive::DataSpace::From(values), createProps);
     dataset.write(values);
     return dataset;
 }
 
-// This loads 2D data into one large block of contiguous memory.
-// (HighFive::DataSet::read() uses a vector of vectors).
-template <typename T>
-inline SpanRC<T> readDataSet(const HighFive::DataSet& dataSet, std::vector<T>& result /*, TODO ...*/)
+namespace details
+{
+// 1D datasets are treated as a single column.
+inline types::RowCol<size_t> getDimensions(const std::vector<size_t>& dimensions)
 {
-    const auto dimensions = dataSet.getSpace().getDimensions();
-    if (dimensions.size() > 2)
+    if (dimensions.empty() || (dimensions.size() > 2))
     {
         throw std::invalid_argument("'dataSet' has unexpected dimensions.");
     }
     const auto col = dimensions.size() == 2 ? dimensions[1] : 1;
-    const types::RowCol<size_t> dims(dimensions[0], col);
+    return types::RowCol<size_t>(dimensions[0], col);
+}
+
+// As above, a 1D dataset can be treated as a single column.
+template <size_t Rank>
+inline std::array<size_t, Rank> getExtents(const std::vector<size_t>& dimensions)
+{
+    std::array<size_t, Rank> retval;
+    if (dimensions.size() == Rank)
+    {
+        std::copy(dimensions.begin(), dimensions.end(), retval.begin());
+    }
+    else if ((Rank == 2) && (dimensions.size() == 1))
+    {
+        retval.fill(1);
+        retval[0] = dimensions[0];
+    }
+    else
+    {
+        throw std::invalid_argument("'dataSet' has unexpected dimensions.");
+    }
+    return retval;
+}
 
-    result.resize(dims.area());
+template <size_t Rank>
+inline HighFive::Selection select(const HighFive::DataSet& dataSet,
+                                  const std::array<size_t, Rank>& offset, const std::array<size_t, Rank>& dims)
+{
+    const auto dimensions = dataSet.getDimensions();
+    const auto extents = getExtents<Rank>(dimensions);
+    for (size_t r = 0; r < Rank; r++)
+    {
+        if (offset[r] + dims[r] > extents[r])
+        {
+            throw std::invalid_argument("window is outside of 'dataSet'.");
+        }
+    }
+    const auto rank = dimensions.size(); // might be 1 when Rank is 2
+    return dataSet.select(std::vector<size_t>(offset.begin(), offset.begin() + rank),
+                          std::vector<size_t>(dims.begin(), dims.begin() + rank));
+}
+inline HighFive::Selection select(const HighFive::DataSet& dataSet,
+                                  const types::RowCol<size_t>& offset, const types::RowCol<size_t>& dims)
+{
+    return select(dataSet, std::array<size_t, 2>{offset.row, offset.col}, std::array<size_t, 2>{dims.row, dims.col});
+}
+
+// A memory type for just the real (index 0) or imaginary (index 1) part of a
+// complex dataset, so that reading or writing touches only that member.
+template <typename T>
+inline HighFive::CompoundType getComplexMemberType(const HighFive::DataSet& dataSet, size_t index)
+{
+    const auto dataType = dataSet.getDataType();
+    if (dataType.getClass() != HighFive::DataTypeClass::Compound)
+    {
+        throw std::invalid_argument("'dataSet' is not complex.");
+    }
+    const HighFive::CompoundType compoundType(HighFive::DataType{dataType});
+    const auto& members = compoundType.getMembers();
+    if (members.size() != 2)
+    {
+        throw std::invalid_argument("'dataSet' is not complex.");
+    }
+    // Use the names from the file: "r" and "i" from HighFive or h5py, but maybe "real" and "imag".
+    return HighFive::CompoundType({{members[index].name, HighFive::create_datatype<T>(), 0}}, sizeof(T));
+}
+
+template <typename T>
+inline void readComplex(const HighFive::DataSet& dataSet, T* reals, T* imags)
+{
+    dataSet.read(reals, getComplexMemberType<T>(dataSet, 0));
+    dataSet.read(imags, getComplexMemberType<T>(dataSet, 1));
+}
+
+inline size_t nextPrime(size_t n)
+{
+    for (;; ++n)
+    {
+        bool isPrime = n > 1;
+        for (size_t d = 2; isPrime && (d * d <= n); ++d)
+        {
+            isPrime = (n % d) != 0;
+        }
+        if (isPrime)
+        {
+            return n;
+        }
+    }
+}
+}
+
+//! Dimensions of a 1D or 2D dataset; 1D is treated as a single column.
+inline types::RowCol<size_t> getDimensions(const HighFive::DataSet& dataSet)
+{
+    return details::getDimensions(dataSet.getDimensions());
+}
+
+//! Dimensions of an N-D dataset; as above, a 1D dataset can be read as 2D.
+template <size_t Rank>
+inline std::array<size_t, Rank> getDimensions(const HighFive::DataSet& dataSet)
+{
+    return details::getExtents<Rank>(dataSet.getDimensions());
+}
+
+//! Chunk dimensions of a 1D or 2D dataset; 0x0 if it isn't chunked.
+inline types::RowCol<size_t> getChunkDimensions(const HighFive::DataSet& dataSet)
+{
+    auto createProps = dataSet.getCreatePropertyList();
+    if (H5Pget_layout(createProps.getId()) != H5D_CHUNKED)
+    {
+        return types::RowCol<size_t>(0, 0);
+    }
+    const HighFive::Chunking chunking(createProps);
+    const auto& dims = chunking.getDimensions();
+    return details::getDimensions(std::vector<size_t>(dims.begin(), dims.end()));
+}
+
+/*!
+ * Access properties with a chunk cache that holds a full row of chunks.
+ * Reading in row-order (as BlockReader does) then decompresses each chunk
+ * only once; HDF5's default 1 MiB cache is often smaller than a single row
+ * of chunks, in which case every chunk is decompressed once per read.
+ */
+inline HighFive::DataSetAccessProps makeChunkCacheAccessProps(const types::RowCol<size_t>& dims,
+                                                              const types::RowCol<size_t>& chunkDims, size_t elementSize)
+{
+    if (chunkDims.area() == 0)
+    {
+        throw std::invalid_argument("'chunkDims' must be non-zero.");
+    }
+    const auto chunksPerRow = (dims.col + chunkDims.col - 1) / chunkDims.col;
+    const auto cacheSize = chunksPerRow * chunkDims.area() * elementSize;
+    const auto numSlots = details::nextPrime(chunksPerRow * 100); // HDF5 suggests ~100x the number of chunks
+
+    HighFive::DataSetAccessProps retval;
+    retval.add(HighFive::Caching(numSlots, cacheSize, 1.0 /*w0: evict fully read chunks first*/));
+    return retval;
+}
+
+//! Open a dataset; if it's chunked, use makeChunkCacheAccessProps().
+inline HighFive::DataSet openDataSet(const H5Easy::File& file, const std::string& dataset_name)
+{
+    auto retval = file.getDataSet(dataset_name);
+    const auto chunkDims = getChunkDimensions(retval);
+    if (chunkDims.area() == 0)
+    {
+        return retval;
+    }
+    const auto accessProps = makeChunkCacheAccessProps(getDimensions(retval), chunkDims, retval.getDataType().getSize());
+    return file.getDataSet(dataset_name, accessProps);
+}
+
+// Read an entire N-D dataset into caller-provided memory of the same dimensions.
+template <typename T, size_t Rank>
+inline void readDataSet(const HighFive::DataSet& dataSet, SpanN<T, Rank> result)
+{
+    if (getDimensions<Rank>(dataSet) != details::getExtents(result))
+    {
+        throw std::invalid_argument("'result' is not the same size as 'dataSet'.");
+    }
+    dataSet.read(result.data_handle());
+}
+
+// This loads N-D data into one large block of contiguous memory.
+// (HighFive::DataSet::read() uses nested vectors).
+template <size_t Rank, typename T>
+inline SpanN<T, Rank> readDataSet(const HighFive::DataSet& dataSet, std::vector<T>& result)
+{
+    const auto dims = getDimensions<Rank>(dataSet);
+
+    result.resize(dataSet.getElementCount());
     dataSet.read(result.data());
 
-    return SpanRC<T>(result.data(), std::array<size_t, 2>{dims.row, dims.col});
+    return SpanN<T, Rank>(result.data(), dims);
+}
+template <typename T>
+inline SpanRC<T> readDataSet(const HighFive::DataSet& dataSet, std::vector<T>& result)
+{
+    return readDataSet<2>(dataSet, result);
+}
+
+// Read the part of a dataset starting at 'offset' into 'window', which is
+// caller-provided memory; only the chunks overlapping the window are read.
+template <typename T, size_t Rank>
+inline void readDataSet(const HighFive::DataSet& dataSet, const std::array<size_t, Rank>& offset, SpanN<T, Rank> window)
+{
+    details::select(dataSet, offset, details::getExtents(window)).read(window.data_handle());
+}
+template <typename T>
+inline void readDataSet(const HighFive::DataSet& dataSet, const types::RowCol<size_t>& offset, SpanRC<T> window)
+{
+    readDataSet(dataSet, std::array<size_t, 2>{offset.row, offset.col}, window);
 }
 
+// Write 'window' into a dataset (e.g., from createDataSet()) starting at 'offset'.
+template <typename T, size_t Rank>
+inline void writeDataSet(const HighFive::DataSet& dataSet, const std::array<size_t, Rank>& offset, SpanN<T, Rank> window)
+{
+    details::select(dataSet, offset, details::getExtents(window)).write_raw(window.data_handle());
+}
 template <typename T>
-inline SpanRC<T> loadDataSet(const H5Easy::File& file, const std::string& dataset_name, std::vector<T>& result /*, TODO ...*/)
+inline void writeDataSet(const HighFive::DataSet& dataSet, const types::RowCol<size_t>& offset, SpanRC<T> window)
+{
+    writeDataSet(dataSet, std::array<size_t, 2>{offset.row, offset.col}, window);
+}
+
+template <size_t Rank, typename T>
+inline SpanN<T, Rank> loadDataSet(const H5Easy::File& file, const std::string& dataset_name, std::vector<T>& result)
 {
     auto dataSet = file.getDataSet(dataset_name);
-    return readDataSet(dataSet, result);
+    return readDataSet<Rank>(dataSet, result);
+}
+template <typename T>
+inline SpanRC<T> loadDataSet(const H5Easy::File& file, const std::string& dataset_name, std::vector<T>& result)
+{
+    return loadDataSet<2>(file, dataset_name, result);
+}
+
+/*!
+ * Read a complex dataset (e.g., written from std::complex<float> or
+ * types::Complex<int16_t>) into separate real and imaginary planes, which is
+ * what mem::ComplexParallelView looks at.  HDF5 extracts each part as it
+ * reads; there's no interleaved copy.  T needn't match the type in the file,
+ * e.g., complex<float> data can be read into double planes.
+ */
+template <typename T, size_t Rank>
+inline void readComplexDataSet(const HighFive::DataSet& dataSet, SpanN<T, Rank> reals, SpanN<T, Rank> imags)
+{
+    const auto dims = getDimensions<Rank>(dataSet);
+    if ((details::getExtents(reals) != dims) || (details::getExtents(imags) != dims))
+    {
+        throw std::invalid_argument("'reals' and 'imags' must be the same size as 'dataSet'.");
+    }
+    details::readComplex(dataSet, reals.data_handle(), imags.data_handle());
+}
+
+// Load a complex dataset of any rank into 'reals' and 'imags'; see readComplexDataSet().
+template <typename T>
+inline mem::ComplexParallelView<T> loadComplexDataSet(const H5Easy::File& file, const std::string& dataset_name,
+                                                      std::vector<T>& reals, std::vector<T>& imags)
+{
+    const auto dataSet = file.getDataSet(dataset_name);
+    const auto size = dataSet.getElementCount();
+    reals.resize(size);
+    imags.resize(size);
+    details::readComplex(dataSet, reals.data(), imags.data());
+    return mem::ComplexParallelView<T>(reals.data(), imags.data(), size);
 }
 
+/*!
+ * Write separate real and imaginary planes as a single complex dataset:
+ * std::complex<T> for floating-point T, otherwise types::Complex<T>.
+ * Each plane is written directly; there's no interleaved copy.
+ */
+template <typename T, size_t Rank>
+inline HighFive::DataSet writeComplexDataSet(H5Easy::File& file, const std::string& dataset_name, SpanN<T, Rank> reals, SpanN<T, Rank> imags,
+                                             const HighFive::DataSetCreateProps& createProps = HighFive::DataSetCreateProps::Default())
+{
+    const auto dims = details::getExtents(reals);
+    if (details::getExtents(imags) != dims)
+    {
+        throw std::invalid_argument("'reals' and 'imags' must be the same size.");
+    }
+    using value_type = std::remove_const_t<T>;
+    auto retval = createDataSet<details::complex_t<value_type>>(file, dataset_name, dims, createProps);
+    retval.write_raw(reals.data_handle(), details::getComplexMemberType<value_type>(retval, 0));
+    retval.write_raw(imags.data_handle(), details::getComplexMemberType<value_type>(retval, 1));
+    return retval;
+}
+
+/*!
+ * \class BlockReader
+ * \brief Reads a 1D or 2D dataset a block at a time
+ *
+ * Blocks are read in row-major order, so a dataset much larger than memory
+ * can be processed with a single block-sized buffer.  Block dimensions are
+ * rounded up to a multiple of the chunk dimensions so that no chunk is split
+ * between blocks; by default, a block is one full-width row of chunks.
+ * Open the dataset with openDataSet() so that HDF5 caches a row of chunks.
+ *
+ * \code
+ *   hdf5::lite::BlockReader<float> reader(hdf5::lite::openDataSet(file, "/image"));
+ *   types::RowCol<size_t> offset;
+ *   hdf5::lite::SpanRC<float> block;
+ *   while (reader.next(offset, block)) { ... }
+ * \endcode
+ */
+template <typename T>
+class BlockReader final
+{
+    HighFive::DataSet mDataSet;
+    types::RowCol<size_t> mDims;
+    types::RowCol<size_t> mBlockDims;
+    types::RowCol<size_t> mOffset{0, 0};
+    std::vector<T> mBuffer;
+
+public:
+    /*!
+     * \param dataSet  1D or 2D dataset to read
+     * \param blockDims  Requested block size; 0x0 for the default.
+     */
+    explicit BlockReader(const HighFive::DataSet& dataSet,
+                         const types::RowCol<size_t>& blockDims = types::RowCol<size_t>(0, 0)) :
+        mDataSet(dataSet), mDims(getDimensions(dataSet)), mBlockDims(blockDims)
+    {
+        auto chunkDims = getChunkDimensions(dataSet);
+        if (chunkDims.area() == 0)
+        {
+            // Contiguous data: full-width blocks of about 4 MiB
+            chunkDims.row = 1;
+            chunkDims.col = mDims.col;
+            if (mBlockDims.area() == 0)
+            {
+                const auto rows = (4 * 1024 * 1024) / (sizeof(T) * std::max<size_t>(mDims.col, 1));
+                mBlockDims = types::RowCol<size_t>(std::max<size_t>(rows, 1), mDims.col);
+            }
+        }
+        else if (mBlockDims.area() == 0)
+        {
+            mBlockDims = types::RowCol<size_t>(chunkDims.row, mDims.col);
+        }
+
+        // Round up to whole chunks, but no bigger than the dataset
+        mBlockDims.row = std::min(mDims.row, (mBlockDims.row + chunkDims.row - 1) / chunkDims.row * chunkDims.row);
+        mBlockDims.col = std::min(mDims.col, (mBlockDims.col + chunkDims.col - 1) / chunkDims.col * chunkDims.col);
+        if ((mDims.area() != 0) && (mBlockDims.area() == 0))
+        {
+            throw std::invalid_argument("'blockDims' must be non-zero.");
+        }
+    }
+
+    const types::RowCol<size_t>& getBlockDimensions() const
+    {
+        return mBlockDims;
+    }
+
+    /*!
+     * Read the next block.
+     *
+     * \param offset  Set to where the block starts in the dataset
+     * \param block  Set to the block's data; this is memory owned by the
+     *        reader, only valid until the next call.  Blocks at the bottom
+     *        or right edge of the dataset may be smaller.
+     * \return false once the whole dataset has been read
+     */
+    bool next(types::RowCol<size_t>& offset, SpanRC<T>& block)
+    {
+        if ((mOffset.row >= mDims.row) || (mDims.area() == 0))
+        {
+            return false;
+        }
+
+        const types::RowCol<size_t> dims(std::min(mBlockDims.row, mDims.row - mOffset.row),
+                                         std::min(mBlockDims.col, mDims.col - mOffset.col));
+        mBuffer.resize(dims.area());
+        block = SpanRC<T>(mBuffer.data(), std::array<size_t, 2>{dims.row, dims.col});
+        readDataSet(mDataSet, mOffset, block);
+        offset = mOffset;
+
+        mOffset.col += dims.col;
+        if (mOffset.col >= mDims.col)
+        {
+            mOffset.col = 0;
+            mOffset.row += dims.row;
+        }
+        return true;
+    }
+};
+
 // Wrapper around HighFive::Attribute::read() to fix problems bug with reading strings
 template <typename T>
 inline void read(const HighFive::Attribute& attribute, T& array)
@@ -458,6 +458,223 @@ TEST_CASE(test_highfive_write)
     }
 }
 
+TEST_CASE(test_highfive_chunked)
+{
+    static const auto path_ = find_unittest_file("example.h5");
+    static const auto path = path_.parent_path() / "TEST_highfive_chunked_TMP.h5";
+
+    const types::RowCol<size_t> dims{100, 70};
+    const types::RowCol<size_t> chunkDims{16, 32};
+    std::vector<double> data_(dims.area());
+    for (size_t i = 0; i < data_.size(); i++)
+    {
+        data_[i] = static_cast<double>(i);
+    }
+    const hdf5::lite::SpanRC<const double> data(data_.data(), std::array<size_t, 2>{dims.row, dims.col});
+    {
+        H5Easy::File file(path.string(), H5Easy::File::Overwrite);
+        const unsigned deflateLevel = hdf5::lite::isDeflateAvailable() ? 6 : 0;
+        const auto ds = hdf5::lite::writeDataSet(file, "DS1", data, hdf5::lite::makeChunkedCreateProps(chunkDims, deflateLevel));
+        TEST_ASSERT(hdf5::lite::getChunkDimensions(ds) == chunkDims);
+        if (deflateLevel > 0)
+        {
+            TEST_ASSERT(ds.getStorageSize() < dims.area() * sizeof(double));
+        }
+
+        // write a dataset in pieces
+        const auto ds2 = hdf5::lite::createDataSet<double>(file, "DS2", dims, hdf5::lite::makeChunkedCreateProps(chunkDims));
+        const types::RowCol<size_t> half(dims.row / 2, dims.col);
+        const hdf5::lite::SpanRC<const double> top(data_.data(), std::array<size_t, 2>{half.row, half.col});
+        const hdf5::lite::SpanRC<const double> bottom(data_.data() + half.area(), std::array<size_t, 2>{half.row, half.col});
+        hdf5::lite::writeDataSet(ds2, types::RowCol<size_t>(half.row, 0), bottom);
+        hdf5::lite::writeDataSet(ds2, types::RowCol<size_t>(0, 0), top);
+    }
+
+    const H5Easy::File file(path.string());
+    for (const auto& name : {"/DS1", "/DS2"})
+    {
+        std::vector<double> result;
+        std::ignore = hdf5::lite::loadDataSet(file, name, result);
+        TEST_ASSERT(result == data_);
+    }
+
+    // read a window into caller-provided memory
+    const auto ds = hdf5::lite::openDataSet(file, "/DS1");
+    const types::RowCol<size_t> offset{10, 20};
+    std::vector<double> window_(30 * 25);
+    const hdf5::lite::SpanRC<double> window(window_.data(), std::array<size_t, 2>{30, 25});
+    hdf5::lite::readDataSet(ds, offset, window);
+    for (size_t r = 0; r < window.extent(0); r++)
+    {
+        for (size_t c = 0; c < window.extent(1); c++)
+        {
+            TEST_ASSERT_EQ(window(r, c), data(offset.row + r, offset.col + c));
+        }
+    }
+    TEST_THROWS(hdf5::lite::readDataSet(ds, types::RowCol<size_t>(80, 0), window));
+
+    // stream the whole dataset, a chunk-aligned block at a time
+    for (const auto& blockDims : {types::RowCol<size_t>(0, 0), types::RowCol<size_t>(20, 40)})
+    {
+        hdf5::lite::BlockReader<double> reader(ds, blockDims);
+        const auto actualBlockDims = reader.getBlockDimensions();
+        TEST_ASSERT_EQ(actualBlockDims.row % chunkDims.row, 0);
+        TEST_ASSERT((actualBlockDims.col % chunkDims.col == 0) || (actualBlockDims.col == dims.col));
+
+        size_t count = 0;
+        types::RowCol<size_t> blockOffset;
+        hdf5::lite::SpanRC<double> block;
+        while (reader.next(blockOffset, block))
+        {
+            TEST_ASSERT_EQ(blockOffset.row % actualBlockDims.row, 0);
+            TEST_ASSERT_EQ(blockOffset.col % actualBlockDims.col, 0);
+            for (size_t r = 0; r < block.extent(0); r++)
+            {
+                for (size_t c = 0; c < block.extent(1); c++)
+                {
+                    TEST_ASSERT_EQ(block(r, c), data(blockOffset.row + r, blockOffset.col + c));
+                }
+            }
+            count += block.size();
+        }
+        TEST_ASSERT_EQ(count, dims.area());
+    }
+}
+
+TEST_CASE(test_highfive_nd)
+{
+    static const auto path_ = find_unittest_file("example.h5");
+    static const auto path = path_.parent_path() / "TEST_highfive_nd_TMP.h5";
+
+    const std::array<size_t, 3> dims{4, 5, 6};
+    std::vector<float> data_(dims[0] * dims[1] * dims[2]);
+    std::iota(data_.begin(), data_.end(), 0.0f);
+    const hdf5::lite::SpanN<const float, 3> data(data_.data(), dims);
+    {
+        H5Easy::File file(path.string(), H5Easy::File::Overwrite);
+        const auto ds = hdf5::lite::writeDataSet(file, "DS3", data);
+        TEST_ASSERT_EQ(ds.getDimensions().size(), 3);
+        TEST_ASSERT(hdf5::lite::getDimensions<3>(ds) == dims);
+    }
+
+    const H5Easy::File file(path.string());
+    const auto ds = file.getDataSet("/DS3");
+    {
+        std::vector<float> result_(data_.size());
+        const hdf5::lite::SpanN<float, 3> result(result_.data(), dims);
+        hdf5::lite::readDataSet(ds, result);
+        TEST_ASSERT(result_ == data_);
+
+        const hdf5::lite::SpanN<float, 3> wrongSize(result_.data(), std::array<size_t, 3>{4, 6, 5});
+        TEST_THROWS(hdf5::lite::readDataSet(ds, wrongSize));
+        TEST_THROWS(hdf5::lite::getDimensions<2>(ds));
+    }
+    {
+        std::vector<float> result;
+        const auto rc = hdf5::lite::loadDataSet<3>(file, "/DS3", result);
+        static_assert(decltype(rc)::rank() == 3, "wrong rank()");
+        TEST_ASSERT_EQ(rc.extent(2), dims[2]);
+        TEST_ASSERT(result == data_);
+    }
+
+    // read a window into caller-provided memory
+    const std::array<size_t, 3> offset{1, 2, 3};
+    std::vector<float> window_(2 * 3 * 3);
+    const hdf5::lite::SpanN<float, 3> window(window_.data(), std::array<size_t, 3>{2, 3, 3});
+    hdf5::lite::readDataSet(ds, offset, window);
+    for (size_t i = 0; i < window.extent(0); i++)
+    {
+        for (size_t j = 0; j < window.extent(1); j++)
+        {
+            for (size_t k = 0; k < window.extent(2); k++)
+            {
+                TEST_ASSERT_EQ(window(i, j, k), data(offset[0] + i, offset[1] + j, offset[2] + k));
+            }
+        }
+    }
+    TEST_THROWS(hdf5::lite::readDataSet(ds, std::array<size_t, 3>{3, 0, 0}, window));
+}
+
+TEST_CASE(test_highfive_complex)
+{
+    static const auto path_ = find_unittest_file("example.h5");
+    static const auto path = path_.parent_path() / "TEST_highfive_complex_TMP.h5";
+
+    const std::array<size_t, 2> dims{10, 20};
+    std::vector<std::complex<float>> zfloat_(dims[0] * dims[1]);
+    std::vector<types::Complex<int16_t>> zint16_(zfloat_.size());
+    std::vector<double> reals_(zfloat_.size()), imags_(zfloat_.size());
+    for (size_t i = 0; i < zfloat_.size(); i++)
+    {
+        zfloat_[i] = std::complex<float>(static_cast<float>(i), -static_cast<float>(i));
+        zint16_[i] = types::Complex<int16_t>(static_cast<int16_t>(i), static_cast<int16_t>(i * 2));
+        reals_[i] = static_cast<double>(i) / 2.0;
+        imags_[i] = static_cast<double>(i) * 2.0;
+    }
+    {
+        H5Easy::File file(path.string(), H5Easy::File::Overwrite);
+        const hdf5::lite::SpanRC<const std::complex<float>> zfloat(zfloat_.data(), dims);
+        auto ds = hdf5::lite::writeDataSet(file, "zfloat", zfloat);
+        TEST_ASSERT(ds.getDataType().getClass() == HighFive::DataTypeClass::Compound);
+
+        const hdf5::lite::SpanRC<const types::Complex<int16_t>> zint16(zint16_.data(), dims);
+        ds = hdf5::lite::writeDataSet(file, "zint16", zint16);
+        TEST_ASSERT_EQ(ds.getDataType().getSize(), sizeof(types::Complex<int16_t>));
+
+        // write split planes as a single complex dataset
+        const hdf5::lite::SpanRC<const double> reals(reals_.data(), dims);
+        const hdf5::lite::SpanRC<const double> imags(imags_.data(), dims);
+        ds = hdf5::lite::writeComplexDataSet(file, "zdouble", reals, imags);
+        TEST_ASSERT_EQ(ds.getDataType().getSize(), sizeof(std::complex<double>));
+    }
+
+    const H5Easy::File file(path.string());
+    {
+        std::vector<std::complex<float>> result_(zfloat_.size());
+        hdf5::lite::readDataSet(file.getDataSet("/zfloat"), hdf5::lite::SpanRC<std::complex<float>>(result_.data(), dims));
+        TEST_ASSERT(result_ == zfloat_);
+
+        std::vector<types::Complex<int16_t>> zint16(zint16_.size());
+        hdf5::lite::readDataSet(file.getDataSet("/zint16"), hdf5::lite::SpanRC<types::Complex<int16_t>>(zint16.data(), dims));
+        TEST_ASSERT(zint16 == zint16_);
+
+        std::vector<std::complex<double>> zdouble(reals_.size());
+        hdf5::lite::readDataSet(file.getDataSet("/zdouble"), hdf5::lite::SpanRC<std::complex<double>>(zdouble.data(), dims));
+        for (size_t i = 0; i < zdouble.size(); i++)
+        {
+            TEST_ASSERT_EQ(zdouble[i].real(), reals_[i]);
+            TEST_ASSERT_EQ(zdouble[i].imag(), imags_[i]);
+        }
+    }
+    {
+        // complex<float> into double planes
+        std::vector<double> reals_result(zfloat_.size()), imags_result(zfloat_.size());
+        hdf5::lite::readComplexDataSet(file.getDataSet("/zfloat"), hdf5::lite::SpanRC<double>(reals_result.data(), dims),
+                                       hdf5::lite::SpanRC<double>(imags_result.data(), dims));
+        for (size_t i = 0; i < zfloat_.size(); i++)
+        {
+            TEST_ASSERT_EQ(reals_result[i], zfloat_[i].real());
+            TEST_ASSERT_EQ(imags_result[i], zfloat_[i].imag());
+        }
+    }
+    {
+        std::vector<int16_t> reals, imags;
+        const auto cx_view = hdf5::lite::loadComplexDataSet(file, "/zint16", reals, imags);
+        TEST_ASSERT_EQ(cx_view.size(), zint16_.size());
+        for (size_t i = 0; i < cx_view.size(); i++)
+        {
+            TEST_ASSERT_EQ(cx_view.real(i), zint16_[i].real());
+            TEST_ASSERT_EQ(cx_view.imag(i), zint16_[i].imag());
+        }
+    }
+
+    // not complex
+    const auto lat = H5Easy::File(find_unittest_file("example.h5").string()).getDataSet("/g4/lat");
+    std::vector<double> reals(lat.getElementCount()), imags(lat.getElementCount());
+    TEST_THROWS(hdf5::lite::readComplexDataSet(lat, hdf5::lite::SpanN<double, 1>(reals.data(), std::array<size_t, 1>{reals.size()}),
+                                               hdf5::lite::SpanN<double, 1>(imags.data(), std::array<size_t, 1>{imags.size()})));
+}
+
 TEST_CASE(test_highfive_getDataType)
 {
     static const auto path = find_unittest_file("example.h5");
@@ -563,6 +780,9 @@ TEST_MAIN(
 
     TEST_CHECK(test_highfive_dump);
     TEST_CHECK(test_highfive_write);
+    TEST_CHECK(test_highfive_chunked);
+    TEST_CHECK(test_highfive_nd);
+    TEST_CHECK(test_highfive_complex);
 
     TEST_CHECK(test_highfive_getDataType);
     TEST_CHECK(test_highfive_getAttribute);
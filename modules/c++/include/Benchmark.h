@@ -0,0 +1,459 @@
+/* =========================================================================
+ * This file is part of CODA-OSS
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * CODA-OSS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_Benchmark_h_INCLUDED_
+#define CODA_OSS_Benchmark_h_INCLUDED_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <except/Throwable.h>
+
+/*!
+ * \file Benchmark.h
+ * \brief A small harness for micro-benchmarks, in the spirit of TestCase.h
+ *
+ * Each benchmark calls State::run() with the code to time.  That code is
+ * run in batches of iterations, the batch size chosen so that a batch takes
+ * at least --min-time; after --warmup untimed batches, --repetitions batches
+ * are timed.  The min/median/mean/stddev of the time per iteration is
+ * printed and, with --json=<file>, saved for build/scripts/compareBenchmarks.py
+ * to compare against another run.
+ *
+ * \code
+    BENCHMARK_CASE(byteSwap)
+    {
+        std::vector<uint32_t> values(1000000);
+        state.setBytesPerIteration(values.size() * sizeof(values[0]));
+        state.run("uint32", [&]() {
+            sys::byteSwap(values.data(), sizeof(values[0]), values.size());
+            benchmark::doNotOptimize(values);
+        });
+    }
+
+    BENCHMARK_MAIN(
+        BENCHMARK_CHECK(byteSwap);
+        )
+ * \endcode
+ *
+ * Options: --filter=<substring of the name> --repetitions=<n> (10)
+ * --warmup=<n> (2) --min-time=<seconds per batch> (0.01) --json=<file>
+ * --quick (one iteration of everything, to check that it runs)
+ */
+namespace benchmark
+{
+//! Keep the compiler from optimizing away the computation of "value"
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__ __volatile__("" : : "m"(value) : "memory");
+#else
+    const volatile char* const p = reinterpret_cast<const volatile char*>(&value);
+    static_cast<void>(*p);
+#endif
+}
+
+struct Options final
+{
+    std::string filter;
+    size_t repetitions = 10;
+    size_t warmup = 2;
+    double minTime = 0.01; //!< seconds per timed batch
+    std::string jsonPathname;
+    bool quick = false;
+};
+
+struct Result final
+{
+    std::string name;
+    size_t iterations = 0; //!< per repetition
+    std::vector<double> samples; //!< nanoseconds per iteration, one per repetition
+    double itemsPerIteration = 0.0;
+    double bytesPerIteration = 0.0;
+
+    double min() const
+    {
+        return *std::min_element(samples.begin(), samples.end());
+    }
+    double max() const
+    {
+        return *std::max_element(samples.begin(), samples.end());
+    }
+    double median() const
+    {
+        auto sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        const auto mid = sorted.size() / 2;
+        return (sorted.size() % 2 == 1) ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2.0;
+    }
+    double mean() const
+    {
+        double sum = 0.0;
+        for (const auto sample : samples)
+        {
+            sum += sample;
+        }
+        return sum / static_cast<double>(samples.size());
+    }
+    double stddev() const
+    {
+        if (samples.size() < 2)
+        {
+            return 0.0;
+        }
+        const auto average = mean();
+        double sum = 0.0;
+        for (const auto sample : samples)
+        {
+            sum += (sample - average) * (sample - average);
+        }
+        return std::sqrt(sum / static_cast<double>(samples.size() - 1));
+    }
+};
+
+namespace details
+{
+inline std::string formatTime(double ns)
+{
+    char buffer[32];
+    if (ns < 1.0e3)
+        snprintf(buffer, sizeof(buffer), "%.2f ns", ns);
+    else if (ns < 1.0e6)
+        snprintf(buffer, sizeof(buffer), "%.2f us", ns / 1.0e3);
+    else if (ns < 1.0e9)
+        snprintf(buffer, sizeof(buffer), "%.2f ms", ns / 1.0e6);
+    else
+        snprintf(buffer, sizeof(buffer), "%.2f s", ns / 1.0e9);
+    return buffer;
+}
+
+inline std::string formatRate(double perSecond, const char* units)
+{
+    char buffer[48];
+    if (perSecond >= 1.0e9)
+        snprintf(buffer, sizeof(buffer), "%.2f G%s/s", perSecond / 1.0e9, units);
+    else if (perSecond >= 1.0e6)
+        snprintf(buffer, sizeof(buffer), "%.2f M%s/s", perSecond / 1.0e6, units);
+    else if (perSecond >= 1.0e3)
+        snprintf(buffer, sizeof(buffer), "%.2f k%s/s", perSecond / 1.0e3, units);
+    else
+        snprintf(buffer, sizeof(buffer), "%.2f %s/s", perSecond, units);
+    return buffer;
+}
+
+inline void writeJSONString(FILE* file, const std::string& s)
+{
+    fputc('"', file);
+    for (const char ch : s)
+    {
+        if (ch == '"' || ch == '\\')
+            fprintf(file, "\\%c", ch);
+        else if (static_cast<unsigned char>(ch) < 0x20)
+            fprintf(file, "\\u%04x", static_cast<unsigned>(ch));
+        else
+            fputc(ch, file);
+    }
+    fputc('"', file);
+}
+}
+
+/*!
+ *  \class State
+ *  \brief What a BENCHMARK_CASE uses to time code
+ */
+class State final
+{
+public:
+    State(std::string name, const Options& options, std::vector<Result>& results) :
+        mName(std::move(name)), mOptions(options), mResults(results)
+    {
+    }
+    State(const State&) = delete;
+    State& operator=(const State&) = delete;
+
+    const std::string& getName() const
+    {
+        return mName;
+    }
+
+    //! For the throughput of the following run()s
+    void setItemsPerIteration(double items)
+    {
+        mItemsPerIteration = items;
+    }
+    void setBytesPerIteration(double bytes)
+    {
+        mBytesPerIteration = bytes;
+    }
+
+    /*!
+     *  Time func(), which is one iteration; the result is named
+     *  "<case>/<label>", or just "<case>" without a label.
+     */
+    template <typename Func>
+    void run(const std::string& label, Func&& func)
+    {
+        Result result;
+        result.name = label.empty() ? mName : mName + "/" + label;
+        if (result.name.find(mOptions.filter) == std::string::npos)
+        {
+            return;
+        }
+        result.itemsPerIteration = mItemsPerIteration;
+        result.bytesPerIteration = mBytesPerIteration;
+
+        if (mOptions.quick)
+        {
+            result.iterations = 1;
+            result.samples.push_back(timeBatch(func, 1) * 1.0e9);
+        }
+        else
+        {
+            // Grow the batch until it takes long enough to time reliably.
+            size_t iterations = 1;
+            while (true)
+            {
+                const auto seconds = timeBatch(func, iterations);
+                if (seconds >= mOptions.minTime || iterations >= (static_cast<size_t>(1) << 30))
+                {
+                    break;
+                }
+                const auto scale = seconds > 0.0 ? std::min(10.0, 1.2 * mOptions.minTime / seconds) : 10.0;
+                iterations = std::max(iterations + 1, static_cast<size_t>(static_cast<double>(iterations) * scale));
+            }
+
+            for (size_t ii = 0; ii < mOptions.warmup; ++ii)
+            {
+                timeBatch(func, iterations);
+            }
+            result.iterations = iterations;
+            for (size_t ii = 0; ii < std::max(mOptions.repetitions, static_cast<size_t>(1)); ++ii)
+            {
+                result.samples.push_back(timeBatch(func, iterations) * 1.0e9 / static_cast<double>(iterations));
+            }
+        }
+
+        print(result);
+        mResults.push_back(std::move(result));
+    }
+    template <typename Func>
+    void run(Func&& func)
+    {
+        run(std::string(), std::forward<Func>(func));
+    }
+
+private:
+    template <typename Func>
+    static double timeBatch(Func& func, size_t iterations)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t ii = 0; ii < iterations; ++ii)
+        {
+            func();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    static void print(const Result& result)
+    {
+        const auto median = result.median();
+        std::string throughput;
+        if (result.bytesPerIteration > 0.0)
+        {
+            throughput = details::formatRate(result.bytesPerIteration * 1.0e9 / median, "B");
+        }
+        else if (result.itemsPerIteration > 0.0)
+        {
+            throughput = details::formatRate(result.itemsPerIteration * 1.0e9 / median, " items");
+        }
+        printf("%-44s %11zu %12s %12s %12s %7.1f%%  %s\n", result.name.c_str(), result.iterations,
+               details::formatTime(result.min()).c_str(), details::formatTime(median).c_str(),
+               details::formatTime(result.mean()).c_str(), 100.0 * result.stddev() / result.mean(),
+               throughput.c_str());
+        fflush(stdout);
+    }
+
+    const std::string mName;
+    const Options& mOptions;
+    std::vector<Result>& mResults;
+    double mItemsPerIteration = 0.0;
+    double mBytesPerIteration = 0.0;
+};
+
+/*!
+ *  \class Runner
+ *  \brief Parses the command line, runs the BENCHMARK_CHECK()s and
+ *   writes the results
+ */
+class Runner final
+{
+public:
+    Runner(int argc, char** argv)
+    {
+        mExecutable = argc > 0 ? argv[0] : "";
+        for (int ii = 1; ii < argc; ++ii)
+        {
+            const std::string arg = argv[ii];
+            const auto equals = arg.find('=');
+            const auto key = arg.substr(0, equals);
+            const auto value = (equals == std::string::npos) ? std::string() : arg.substr(equals + 1);
+            if (key == "--filter")
+                mOptions.filter = value;
+            else if (key == "--repetitions")
+                mOptions.repetitions = strtoul(value.c_str(), nullptr, 10);
+            else if (key == "--warmup")
+                mOptions.warmup = strtoul(value.c_str(), nullptr, 10);
+            else if (key == "--min-time")
+                mOptions.minTime = strtod(value.c_str(), nullptr);
+            else if (key == "--json")
+                mOptions.jsonPathname = value;
+            else if (key == "--quick")
+                mOptions.quick = true;
+            else
+            {
+                fprintf(stderr,
+                        "Usage: %s [--filter=<substring>] [--repetitions=<n>] [--warmup=<n>]\n"
+                        "          [--min-time=<seconds>] [--json=<file>] [--quick]\n",
+                        mExecutable.c_str());
+                exit(arg == "--help" ? 0 : 1);
+            }
+        }
+
+        printf("%-44s %11s %12s %12s %12s %8s  %s\n", "benchmark", "iterations", "min", "median",
+               "mean", "cv", "throughput");
+    }
+    Runner(const Runner&) = delete;
+    Runner& operator=(const Runner&) = delete;
+
+    template <typename Func>
+    void run(const char* name, Func&& benchmark)
+    {
+        try
+        {
+            State state(name, mOptions, mResults);
+            benchmark(state);
+        }
+        catch (const except::Throwable& ex)
+        {
+            fprintf(stderr, "%s: FAILED: %s\n", name, ex.toString().c_str());
+            mFailed = true;
+        }
+        catch (const std::exception& ex)
+        {
+            fprintf(stderr, "%s: FAILED: %s\n", name, ex.what());
+            mFailed = true;
+        }
+        catch (...)
+        {
+            fprintf(stderr, "%s: FAILED\n", name);
+            mFailed = true;
+        }
+    }
+
+    //! \return the exit code for main()
+    int finish()
+    {
+        if (!mOptions.jsonPathname.empty() && !writeJSON())
+        {
+            fprintf(stderr, "Can't write %s\n", mOptions.jsonPathname.c_str());
+            return 1;
+        }
+        return mFailed ? 1 : 0;
+    }
+
+private:
+    bool writeJSON() const
+    {
+        FILE* const file = fopen(mOptions.jsonPathname.c_str(), "w");
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        char date[32] = "";
+        const auto now = time(nullptr);
+        if (const auto utc = gmtime(&now))
+        {
+            strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", utc);
+        }
+#ifdef NDEBUG
+        const char* const debug = "false";
+#else
+        const char* const debug = "true";
+#endif
+
+        fprintf(file, "{\n  \"context\": {\n    \"executable\": ");
+        details::writeJSONString(file, mExecutable);
+        fprintf(file, ",\n    \"date\": \"%s\",\n    \"debug\": %s,\n", date, debug);
+        fprintf(file, "    \"repetitions\": %zu,\n    \"warmup\": %zu,\n    \"min_time\": %g,\n    \"quick\": %s\n  },\n",
+                mOptions.repetitions, mOptions.warmup, mOptions.minTime, mOptions.quick ? "true" : "false");
+        fprintf(file, "  \"benchmarks\": [");
+        for (size_t ii = 0; ii < mResults.size(); ++ii)
+        {
+            const auto& result = mResults[ii];
+            fprintf(file, "%s\n    {\n      \"name\": ", ii == 0 ? "" : ",");
+            details::writeJSONString(file, result.name);
+            fprintf(file, ",\n      \"iterations\": %zu,\n", result.iterations);
+            fprintf(file, "      \"min_ns\": %.6g,\n      \"median_ns\": %.6g,\n      \"mean_ns\": %.6g,\n",
+                    result.min(), result.median(), result.mean());
+            fprintf(file, "      \"stddev_ns\": %.6g,\n      \"max_ns\": %.6g,\n", result.stddev(), result.max());
+            fprintf(file, "      \"items_per_iteration\": %.6g,\n      \"bytes_per_iteration\": %.6g,\n",
+                    result.itemsPerIteration, result.bytesPerIteration);
+            fprintf(file, "      \"samples_ns\": [");
+            for (size_t jj = 0; jj < result.samples.size(); ++jj)
+            {
+                fprintf(file, "%s%.6g", jj == 0 ? "" : ", ", result.samples[jj]);
+            }
+            fprintf(file, "]\n    }");
+        }
+        fprintf(file, "\n  ]\n}\n");
+        return fclose(file) == 0;
+    }
+
+    std::string mExecutable;
+    Options mOptions;
+    std::vector<Result> mResults;
+    bool mFailed = false;
+};
+}
+
+//! A benchmark; "state" is the benchmark::State
+#define BENCHMARK_CASE(X) void X(benchmark::State& state)
+#define BENCHMARK_CHECK(X) coda_oss_benchmark_runner_.run(#X, X)
+#define BENCHMARK_MAIN(X) int main(int argc, char** argv) { \
+    benchmark::Runner coda_oss_benchmark_runner_(argc, argv); X; return coda_oss_benchmark_runner_.finish(); }
+
+#endif  // CODA_OSS_Benchmark_h_INCLUDED_
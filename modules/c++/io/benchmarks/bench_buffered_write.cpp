@@ -0,0 +1,117 @@
+/* =========================================================================
+ * This file is part of io-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * io-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Users guide
+
+    Compares small writes to a file straight through io::FileOutputStream
+    (one write() system call each) with the same writes through an
+    io::BufferedOutputStream, and a header + payload written with two
+    write() calls vs. one writev().  The files are temporaries in the
+    current directory.
+
+    ./bench_buffered_write [--filter=<name>] [--json=<file>] [--quick] ...
+
+*/
+
+/*  Results (-O3, a 1-CPU VM, ext4 on a virtual disk), median per iteration:
+                        unbuffered / write    buffered / writev
+    smallWrites          6.76 ms  1.5 M/s      311 us  32 M/s
+    headerAndPayload     6.80 ms  612 MB/s     7.06 ms 589 MB/s
+*/
+
+#include <vector>
+
+#include <io/BufferedOutputStream.h>
+#include <io/FileOutputStream.h>
+#include <io/TempFile.h>
+
+#include "Benchmark.h"
+
+static constexpr size_t numWrites = 10000;
+static constexpr size_t writeSize = 8;
+static constexpr size_t numRecords = 1000;
+
+static void runSmallWrites(benchmark::State& state, const std::string& label, io::OutputStream& output)
+{
+    const std::vector<char> data(writeSize, 'x');
+    state.setItemsPerIteration(static_cast<double>(numWrites));
+    state.run(label, [&]() {
+        for (size_t ii = 0; ii < numWrites; ++ii)
+        {
+            output.write(data.data(), data.size());
+        }
+        output.flush();
+    });
+}
+
+static void runHeaderAndPayload(benchmark::State& state, const std::string& label, bool gather)
+{
+    const std::vector<char> header(64, 'h'), payload(4096, 'p');
+    const io::OutputStream::ConstBuffer buffers[] = {
+        coda_oss::as_bytes(coda_oss::span<const char>(header.data(), header.size())),
+        coda_oss::as_bytes(coda_oss::span<const char>(payload.data(), payload.size())) };
+
+    const io::TempFile tempFile;
+    io::FileOutputStream output(tempFile.pathname());
+    state.setBytesPerIteration(static_cast<double>(numRecords * (header.size() + payload.size())));
+    state.run(label, [&]() {
+        for (size_t ii = 0; ii < numRecords; ++ii)
+        {
+            if (gather)
+            {
+                output.writev(buffers);
+            }
+            else
+            {
+                output.write(header.data(), header.size());
+                output.write(payload.data(), payload.size());
+            }
+        }
+        output.flush();
+    });
+}
+
+BENCHMARK_CASE(smallWrites)
+{
+    {
+        const io::TempFile tempFile;
+        io::FileOutputStream output(tempFile.pathname());
+        runSmallWrites(state, "unbuffered", output);
+    }
+    {
+        const io::TempFile tempFile;
+        io::FileOutputStream file(tempFile.pathname());
+        io::BufferedOutputStream output(file);
+        runSmallWrites(state, "buffered", output);
+    }
+}
+
+BENCHMARK_CASE(headerAndPayload)
+{
+    runHeaderAndPayload(state, "write", false);
+    runHeaderAndPayload(state, "writev", true);
+}
+
+BENCHMARK_MAIN(
+    BENCHMARK_CHECK(smallWrites);
+    BENCHMARK_CHECK(headerAndPayload);
+    )
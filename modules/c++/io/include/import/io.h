@@ -54,7 +54,9 @@
 
 #include <io/BidirectionalStream.h>
 #include <io/BufferViewStream.h>
+#include <io/BufferedOutputStream.h>
 #include <io/ByteStream.h>
+#include <io/ChunkedByteStream.h>
 #include <io/DataStream.h>
 #include <io/DbgStream.h>
 #include <io/InputStream.h>
@@ -0,0 +1,115 @@
+/* =========================================================================
+ * This file is part of io-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * io-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_io_BufferedOutputStream_h_INCLUDED_
+#define CODA_OSS_io_BufferedOutputStream_h_INCLUDED_
+
+#include <memory>
+#include <vector>
+
+#include "config/Exports.h"
+#include "coda_oss/span.h"
+#include "coda_oss/cstddef.h"
+#include "io/OutputStream.h"
+#include "sys/MemoryAccounting.h"
+
+/*!
+ * \file BufferedOutputStream.h
+ * \brief Collect small writes into fewer, larger ones
+ */
+
+namespace io
+{
+/*!
+ * \class BufferedOutputStream
+ * \brief Buffers writes to another OutputStream
+ *
+ * Small writes (a header field, one byte-swapped element, a formatted
+ * number) are copied into a fixed-size buffer that is written out when
+ * full; nothing is allocated once the stream is constructed.  A write
+ * that doesn't fit goes out together with what's already buffered in one
+ * writev() call, so large payloads aren't copied (past 63 buffers, the
+ * rest go in a second call).
+ *
+ * Call flush() or close() to write what's left and see any errors; the
+ * destructor also writes anything left, but can't report a failure.
+ *
+ * With memory accounting enabled, the buffer counts toward
+ * "io::BufferedOutputStream".
+ */
+struct CODA_OSS_API BufferedOutputStream final : public OutputStream
+{
+    static constexpr size_t defaultBufferSize = 64 * 1024;
+
+    //! Writes to 'output', which must outlive this object
+    explicit BufferedOutputStream(OutputStream& output, size_t bufferSize = defaultBufferSize);
+    //! Takes ownership of 'output'
+    explicit BufferedOutputStream(std::unique_ptr<OutputStream>&& output,
+                                  size_t bufferSize = defaultBufferSize);
+
+    ~BufferedOutputStream();
+    BufferedOutputStream(const BufferedOutputStream&) = delete;
+    BufferedOutputStream& operator=(const BufferedOutputStream&) = delete;
+
+    using OutputStream::write;
+
+    void write(const void* buffer, size_t len) override;
+    void writev(coda_oss::span<const ConstBuffer> buffers) override;
+
+    //! Write out the buffer, then flush the underlying stream
+    void flush() override;
+
+    //! Write out the buffer, then close the underlying stream
+    void close() override;
+
+    //! Write out the buffer without flushing the underlying stream
+    void flushBuffer();
+
+    size_t getBufferSize() const noexcept
+    {
+        return mBuffer.size();
+    }
+
+    //! Bytes written to this stream, but not yet to the underlying one
+    size_t getPending() const noexcept
+    {
+        return mPending;
+    }
+
+private:
+    //! "io::BufferedOutputStream"
+    static sys::MemoryCategory& getMemoryCategory();
+
+    void append(const coda_oss::byte* buffer, size_t len) noexcept;
+
+    std::unique_ptr<OutputStream> mOwned;
+    OutputStream& mOutput;
+    std::vector<coda_oss::byte> mBuffer;
+    sys::AccountedBytes mAccounted;
+    size_t mPending = 0;
+    static constexpr size_t maxGather = 64; // the iovecs sys::File::writeFrom() sends at once
+    std::vector<ConstBuffer> mGather; // reserved up front, reused by writev()
+};
+}
+
+#endif  // CODA_OSS_io_BufferedOutputStream_h_INCLUDED_
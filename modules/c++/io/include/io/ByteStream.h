@@ -26,7 +26,10 @@
 #include <vector>
 
 #include "config/Exports.h"
+#include "coda_oss/span.h"
+#include "coda_oss/cstddef.h"
 #include "sys/Conf.h"
+#include "sys/MemoryAccounting.h"
 #include "except/Error.h"
 #include "except/Exception.h"
 #include "io/SeekableStreams.h"
@@ -57,6 +60,9 @@ namespace io
  *  C++ to handle this.  However, for binary transfers, arbitrary
  *  0's can be anywhere (Null-bytes) making it impossible to use
  *  strings as containers.  
+ *
+ *  With memory accounting enabled, the buffer's capacity counts toward
+ *  "io::ByteStream"; see sys/MemoryAccounting.h.
  */
 struct CODA_OSS_API ByteStream : public SeekableInputStream, public SeekableOutputStream
 {
@@ -65,6 +71,13 @@ struct CODA_OSS_API ByteStream : public SeekableInputStream, public SeekableOutp
     ByteStream(sys::Size_T len) :
         mData(len)
     {
+        mAccounted.set(mData.capacity());
+    }
+    //! Take over 'data' without copying it; reading starts at the beginning
+    explicit ByteStream(std::vector<sys::ubyte>&& data) :
+        mData(std::move(data))
+    {
+        mAccounted.set(mData.capacity());
     }
 
     virtual
@@ -117,6 +130,39 @@ struct CODA_OSS_API ByteStream : public SeekableInputStream, public SeekableOutp
         return mData.empty() ? nullptr : &mData[0];
     }
 
+    /*!
+     * Make room for 'capacity' bytes so that writing up to that many
+     * doesn't reallocate (and copy) the internal buffer.
+     */
+    void reserve(size_t capacity)
+    {
+        mData.reserve(capacity);
+        mAccounted.set(mData.capacity());
+    }
+
+    /*!
+     * The unread bytes: from the current position to the end.  Like get(),
+     * these aren't valid after a seek, write, or reset.
+     */
+    coda_oss::span<const coda_oss::byte> span() const;
+    const sys::ubyte* data() const
+    {
+        return reinterpret_cast<const sys::ubyte*>(span().data());
+    }
+
+    /*!
+     * Read up to 'len' bytes without copying them: returns a view of
+     * them (valid as for span()) and advances the position past them.
+     * \return the bytes "read"; empty at the end
+     */
+    coda_oss::span<const coda_oss::byte> consume(size_t len);
+
+    /*!
+     * Move the internal buffer out (all of it, not just the unread bytes);
+     * the stream is left empty.
+     */
+    std::vector<sys::ubyte> release();
+
     auto size() const
     {
         return mData.size();    
@@ -138,8 +184,12 @@ protected:
     virtual sys::SSize_T readImpl(void* buffer, size_t len) override;
 
 private:
+    //! "io::ByteStream"
+    static sys::MemoryCategory& getMemoryCategory();
+
     std::vector<sys::ubyte> mData;
     sys::Off_T mPosition = 0;
+    sys::AccountedBytes mAccounted{ getMemoryCategory() };
 };
 }
 
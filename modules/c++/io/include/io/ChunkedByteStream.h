@@ -0,0 +1,115 @@
+/* =========================================================================
+ * This file is part of io-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * io-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_io_ChunkedByteStream_h_INCLUDED_
+#define CODA_OSS_io_ChunkedByteStream_h_INCLUDED_
+
+#include <deque>
+#include <vector>
+
+#include "config/Exports.h"
+#include "sys/Conf.h"
+#include "coda_oss/span.h"
+#include "io/BidirectionalStream.h"
+
+/*!
+ *  \file
+ *  \brief  An in-memory FIFO of bytes stored as a "rope" of chunks
+ */
+namespace io
+{
+/*!
+ *  \class ChunkedByteStream
+ *  \brief  Staging buffer that never moves bytes once written
+ *
+ *  Unlike ByteStream, which keeps everything in one std::vector (so
+ *  growing it reallocates and copies), writes are appended to fixed-size
+ *  chunks; a write bigger than a chunk gets a chunk of its own.  Reads,
+ *  and consume(), take bytes off the front.  buffers() returns views of
+ *  the unread bytes suitable for OutputStream::writev(), e.g., to send
+ *  everything that has been serialized without copying it again.
+ *
+ *  There's no seeking; use ByteStream for that.
+ */
+struct CODA_OSS_API ChunkedByteStream final : public BidirectionalStream
+{
+    static constexpr size_t defaultChunkSize = 64 * 1024;
+
+    explicit ChunkedByteStream(size_t chunkSize = defaultChunkSize);
+    ChunkedByteStream(const ChunkedByteStream&) = delete;
+    ChunkedByteStream& operator=(const ChunkedByteStream&) = delete;
+    ChunkedByteStream(ChunkedByteStream&&) = default;
+    ChunkedByteStream& operator=(ChunkedByteStream&&) = default;
+
+    //! The number of unread bytes
+    sys::Off_T available() override
+    {
+        return static_cast<sys::Off_T>(mSize);
+    }
+    size_t size() const noexcept
+    {
+        return mSize;
+    }
+
+    using OutputStream::write;
+
+    /*!
+     *  Append to the stream; views from buffers() remain valid.
+     */
+    void write(const void* buffer, size_t size) override;
+
+    /*!
+     *  Views of all of the unread bytes, in order; they're valid until
+     *  the bytes are read or consumed.
+     */
+    std::vector<ConstBuffer> buffers() const;
+
+    /*!
+     *  Discard up to 'len' bytes from the front, e.g., after sending them.
+     *  \return the number of bytes discarded
+     */
+    size_t consume(size_t len);
+
+    /*!
+     *  All of the unread bytes in one vector (the only copy); the stream
+     *  is left empty.
+     */
+    std::vector<sys::ubyte> release();
+
+    void clear();
+
+protected:
+    sys::SSize_T readImpl(void* buffer, size_t len) override;
+
+private:
+    void popFront();
+
+    size_t mChunkSize;
+    std::deque<std::vector<sys::ubyte> > mChunks; // size() is what's written, capacity() is fixed
+    size_t mOffset = 0; // bytes already read from mChunks.front()
+    size_t mSize = 0;
+    std::vector<sys::ubyte> mSpare; // a chunk to reuse rather than allocate
+};
+}
+
+#endif  // CODA_OSS_io_ChunkedByteStream_h_INCLUDED_
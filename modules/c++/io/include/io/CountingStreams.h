@@ -54,6 +54,15 @@ struct CODA_OSS_API CountingOutputStream : public ProxyOutputStream
         mByteCount += len;
     }
 
+    virtual void writev(coda_oss::span<const ConstBuffer> buffers) override
+    {
+        ProxyOutputStream::writev(buffers);
+        for (const auto& buffer : buffers)
+        {
+            mByteCount += buffer.size();
+        }
+    }
+
     sys::Off_T getCount() const
     {
         return mByteCount;
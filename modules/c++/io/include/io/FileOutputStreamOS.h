@@ -118,6 +118,9 @@ public:
      * \throw IoException
      */
     virtual void write(const void* buffer, size_t len) override;
+
+    //! All of the buffers go out in one writev() call (on POSIX)
+    void writev(coda_oss::span<const ConstBuffer> buffers) override;
 };
 }
 
@@ -117,6 +117,22 @@ struct CODA_OSS_API OutputStream
         write(coda_oss::span<const T>(buffer.data(), buffer.size()));
     }
 
+    /*!
+     * Write several buffers, in order, as if by calling write() for each;
+     * e.g., a header and its payload.  Streams that can (files) do this
+     * with a single OS call (writev()) rather than one per buffer.
+     * \param buffers The byte arrays to write to the stream
+     * \throw IOException
+     */
+    using ConstBuffer = coda_oss::span<const coda_oss::byte>;
+    virtual void writev(coda_oss::span<const ConstBuffer> buffers)
+    {
+        for (const auto& buffer : buffers)
+        {
+            write(buffer.data(), buffer.size());
+        }
+    }
+
     /*!
      *  Flush the stream if needed
      */
@@ -98,6 +98,11 @@ struct CODA_OSS_API ProxyOutputStream : public OutputStream
         mProxy->write(buffer, len);
     }
 
+    virtual void writev(coda_oss::span<const ConstBuffer> buffers) override
+    {
+        mProxy->writev(buffers);
+    }
+
     virtual void flush() override
     {
         mProxy->flush();
@@ -48,6 +48,12 @@ struct CODA_OSS_API RotatingFileOutputStream : public CountingOutputStream
 
     virtual void write(const void* buffer, size_t len) override;
 
+    //! Each buffer is a write(), so a rollover can happen between them
+    virtual void writev(coda_oss::span<const ConstBuffer> buffers) override
+    {
+        OutputStream::writev(buffers);
+    }
+
 protected:
     std::string mFilename;
     unsigned long mMaxBytes;
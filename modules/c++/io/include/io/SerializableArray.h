@@ -23,14 +23,50 @@
 #ifndef __IO_SERIALIZABLE_ARRAY_H__
 #define __IO_SERIALIZABLE_ARRAY_H__
 
+#include <string.h>
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+
 #include "io/Serializable.h"
 #include <import/sys.h>
+#include <sys/Parallel.h>
 
 namespace io
 {
+namespace details
+{
+// Byte-swap a buffer in place, splitting large ones across threads; c.f.,
+// mt::ThreadedByteSwap (which can't be used here as mt uses io).
+inline void byteSwap(sys::byte* buffer, size_t elemSize, size_t numElems, size_t numThreads)
+{
+    const size_t minimumPerThread = 64 * 1024; // elements
+    sys::parallelFor(numElems, numThreads, minimumPerThread, [=](size_t begin, size_t end) {
+        sys::byteSwap(buffer + begin * elemSize, elemSize, end - begin);
+    });
+}
+
+// std::complex<T> is swapped as two T values
+template <typename T>
+inline constexpr size_t byteSwapSize(const T*)
+{
+    return sizeof(T);
+}
+template <typename T>
+inline constexpr size_t byteSwapSize(const std::complex<T>*)
+{
+    return sizeof(T);
+}
+}
 
 /**
  * Serialize an array to/from a stream.
+ *
+ * Data can optionally be byte-swapped on the way; see setByteSwap().  When
+ * elements have to be touched (swapping, or a stride), they go through a
+ * reusable buffer a chunk at a time, so there's one read or write per
+ * chunk rather than one per element.
  */
 template<typename T>
 class SerializableArray : public Serializable
@@ -62,41 +98,113 @@ public:
     {
     }
 
-    void serialize(io::OutputStream& os)
+    /**
+     * Byte-swap elements as they're serialized and deserialized; the
+     * array itself is never modified by serialize().
+     *
+     * \param swap        whether to swap
+     * \param numThreads  threads to swap large chunks with
+     */
+    void setByteSwap(bool swap, size_t numThreads = 1)
     {
-        T* buf = (T*) (mBuf + mOffset);
-        if (mSkip == 0)
-            os.write((sys::byte*) buf, sizeof(T) * mLength);
-        else
+        mSwap = swap;
+        mNumThreads = std::max<size_t>(numThreads, 1);
+    }
+
+    /**
+     * \param chunkSize  bytes to read or write at a time when elements
+     *                   have to be copied (at least one element)
+     */
+    void setChunkSize(size_t chunkSize)
+    {
+        mChunkElems = std::max<size_t>(chunkSize / sizeof(T), 1);
+    }
+
+    void serialize(io::OutputStream& os) override
+    {
+        const T* buf = mBuf + mOffset;
+        if (mSkip == 0 && !mSwap)
         {
-            sys::Size_T skip = mSkip + 1;
-            for (sys::Size_T i = 0; i < mLength; i += skip, buf += skip)
-                os.write((sys::byte*) buf, sizeof(T));
+            os.write((const sys::byte*) buf, sizeof(T) * mLength);
+            return;
+        }
+
+        // Every (mSkip + 1)th element, a chunk at a time
+        const sys::Size_T skip = mSkip + 1;
+        const size_t numElems = (mLength + skip - 1) / skip;
+        T* const chunk = getChunk(std::min(numElems, mChunkElems));
+        for (size_t begin = 0; begin < numElems; begin += mChunkElems)
+        {
+            const size_t count = std::min(mChunkElems, numElems - begin);
+            if (skip == 1)
+            {
+                memcpy(chunk, buf + begin, count * sizeof(T));
+            }
+            else
+            {
+                for (size_t ii = 0; ii < count; ++ii)
+                {
+                    chunk[ii] = buf[(begin + ii) * skip];
+                }
+            }
+            swap(chunk, count);
+            os.write((const sys::byte*) chunk, count * sizeof(T));
         }
     }
 
-    void deserialize(io::InputStream& is)
+    void deserialize(io::InputStream& is) override
     {
-        T* buf = (T*) (mBuf + mOffset);
+        T* buf = mBuf + mOffset;
         if (mSkip == 0)
+        {
+            // Straight into the array, then swap it there
             is.read((sys::byte*) buf, sizeof(T) * mLength);
-        else
+            swap(buf, mLength);
+            return;
+        }
+
+        // Read mLength elements, keeping every (mSkip + 1)th one
+        const sys::Size_T skip = mSkip + 1;
+        T* const chunk = getChunk(std::min<size_t>(mLength, mChunkElems));
+        T* const kept = buf;
+        for (size_t begin = 0; begin < mLength; begin += mChunkElems)
         {
-            sys::Size_T skip = mSkip + 1;
-            sys::byte bytes[sizeof(T)];
-            for (sys::Size_T i = 0; i < mLength; ++i)
+            const size_t count = std::min(mChunkElems, mLength - begin);
+            is.read((sys::byte*) chunk, count * sizeof(T));
+            for (size_t ii = (skip - begin % skip) % skip; ii < count; ii += skip)
             {
-                if (i % skip == 0)
-                    is.read((sys::byte*) buf++, sizeof(T));
-                else
-                    is.read(bytes, sizeof(T));
+                *buf++ = chunk[ii];
             }
         }
+        swap(kept, static_cast<size_t>(buf - kept));
     }
 
 protected:
     T* mBuf;
     sys::Size_T mOffset, mLength, mSkip;
+    bool mSwap = false;
+    size_t mNumThreads = 1;
+    size_t mChunkElems = (1024 * 1024 + sizeof(T) - 1) / sizeof(T);
+    std::vector<T> mChunk;
+
+private:
+    T* getChunk(size_t numElems)
+    {
+        if (mChunk.size() < numElems)
+        {
+            mChunk.resize(numElems);
+        }
+        return mChunk.data();
+    }
+
+    void swap(T* buffer, size_t numElems) const
+    {
+        if (mSwap)
+        {
+            const size_t elemSize = details::byteSwapSize(buffer);
+            details::byteSwap((sys::byte*) buffer, elemSize, numElems * sizeof(T) / elemSize, mNumThreads);
+        }
+    }
 };
 }
 
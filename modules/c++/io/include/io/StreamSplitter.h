@@ -28,6 +28,7 @@
 
 #include "config/Exports.h"
 #include "sys/Conf.h"
+#include "sys/MemoryAccounting.h"
 #include "io/InputStream.h"
 
 namespace io
@@ -36,6 +37,7 @@ namespace io
  * StreamSplitter splits the bytes from a stream into substrings separated by a
  * specified delimiter string. It uses buffered stream reads internally for
  * better efficiency than InputStream::readln for reading large amounts of data.
+ * With memory accounting enabled, the buffer counts toward "io::StreamSplitter".
  */
 struct CODA_OSS_API StreamSplitter
 {
@@ -97,6 +99,9 @@ struct CODA_OSS_API StreamSplitter
     size_t getNumBytesProcessed() const;
 
 private:
+    //! "io::StreamSplitter"
+    static sys::MemoryCategory& getMemoryCategory();
+
     /*!
      * \brief Append the buffer section from mBufferBegin to bufferSegmentEnd
      *        to the substring and remove it from the buffer.
@@ -119,6 +124,7 @@ private:
     std::vector<sys::byte> mBufferStorage;
     const sys::SSize_T mBufferCapacity;
     sys::byte* const mBuffer;
+    sys::AccountedBytes mAccounted;
     io::InputStream& mInputStream;
     bool mStreamEmpty;
 };
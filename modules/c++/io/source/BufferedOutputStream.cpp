@@ -0,0 +1,153 @@
+/* =========================================================================
+ * This file is part of io-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * io-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "io/BufferedOutputStream.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <numeric>
+
+sys::MemoryCategory& io::BufferedOutputStream::getMemoryCategory()
+{
+    static sys::MemoryCategory& category = sys::getMemoryCategory("io::BufferedOutputStream");
+    return category;
+}
+
+io::BufferedOutputStream::BufferedOutputStream(OutputStream& output, size_t bufferSize) :
+    mOutput(output), mBuffer(bufferSize), mAccounted(getMemoryCategory())
+{
+    mAccounted.set(mBuffer.size());
+    mGather.reserve(maxGather);
+}
+
+io::BufferedOutputStream::BufferedOutputStream(std::unique_ptr<OutputStream>&& output, size_t bufferSize) :
+    mOwned(std::move(output)), mOutput(*mOwned), mBuffer(bufferSize), mAccounted(getMemoryCategory())
+{
+    mAccounted.set(mBuffer.size());
+    mGather.reserve(maxGather);
+}
+
+io::BufferedOutputStream::~BufferedOutputStream()
+{
+    try
+    {
+        flushBuffer();
+    }
+    catch (...)
+    {
+        // Don't throw from a destructor; call flush() to see errors.
+    }
+}
+
+void io::BufferedOutputStream::append(const coda_oss::byte* buffer, size_t len) noexcept
+{
+    if (len > 0)
+    {
+        memcpy(mBuffer.data() + mPending, buffer, len);
+        mPending += len;
+    }
+}
+
+void io::BufferedOutputStream::write(const void* buffer, size_t len)
+{
+    const auto bytes = static_cast<const coda_oss::byte*>(buffer);
+    if (len <= mBuffer.size() - mPending)
+    {
+        append(bytes, len);
+        return;
+    }
+    if (len < mBuffer.size())
+    {
+        flushBuffer();
+        append(bytes, len);
+        return;
+    }
+
+    // Too big to buffer: send it with what's buffered in one call.
+    const ConstBuffer buffers[] = { ConstBuffer(mBuffer.data(), mPending), ConstBuffer(bytes, len) };
+    if (mPending > 0)
+    {
+        mOutput.writev(buffers);
+    }
+    else
+    {
+        mOutput.write(bytes, len);
+    }
+    mPending = 0;
+}
+
+void io::BufferedOutputStream::writev(coda_oss::span<const ConstBuffer> buffers)
+{
+    const auto total = std::accumulate(buffers.begin(), buffers.end(), static_cast<size_t>(0),
+                                       [](size_t sum, const ConstBuffer& b) { return sum + b.size(); });
+    if (total <= mBuffer.size() - mPending)
+    {
+        for (const auto& buffer : buffers)
+        {
+            append(buffer.data(), buffer.size());
+        }
+        return;
+    }
+
+    if (mPending == 0)
+    {
+        mOutput.writev(buffers);
+        return;
+    }
+
+    // What's buffered goes first, with as many as fit in mGather; any more
+    // are a call of their own, as they would be for sys::File anyway.
+    const auto numFirst = std::min(buffers.size(), maxGather - 1);
+    mGather.clear();
+    mGather.push_back(ConstBuffer(mBuffer.data(), mPending));
+    mGather.insert(mGather.end(), buffers.begin(), buffers.begin() + numFirst);
+    mOutput.writev(mGather);
+    mPending = 0;
+    if (numFirst < buffers.size())
+    {
+        mOutput.writev(buffers.subspan(numFirst));
+    }
+}
+
+void io::BufferedOutputStream::flushBuffer()
+{
+    if (mPending > 0)
+    {
+        // If the write throws, the data is dropped rather than written again.
+        const auto pending = mPending;
+        mPending = 0;
+        mOutput.write(mBuffer.data(), pending);
+    }
+}
+
+void io::BufferedOutputStream::flush()
+{
+    flushBuffer();
+    mOutput.flush();
+}
+
+void io::BufferedOutputStream::close()
+{
+    flushBuffer();
+    mOutput.close();
+}
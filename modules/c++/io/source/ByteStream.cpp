@@ -20,10 +20,18 @@
  *
  */
 
+#include <algorithm>
+
 #include <std/span>
 
 #include "io/ByteStream.h"
 
+sys::MemoryCategory& io::ByteStream::getMemoryCategory()
+{
+    static sys::MemoryCategory& category = sys::getMemoryCategory("io::ByteStream");
+    return category;
+}
+
 sys::Off_T io::ByteStream::seek(sys::Off_T offset, Whence whence)
 {
     if (mPosition < 0)
@@ -75,13 +83,22 @@ void io::ByteStream::write(const void* buffer, sys::Size_T size)
     // when mPosition is still 0
     if (size > 0)
     {
-        sys::Size_T newPos = mPosition + size;
-        if (newPos >= mData.size())
-            mData.resize(newPos);
-
         const auto bufferPtr = static_cast<const sys::ubyte*>(buffer);
-        std::copy(bufferPtr, bufferPtr + size, &mData[gsl::narrow<size_t>(mPosition)]);
+        const auto position = gsl::narrow<size_t>(mPosition);
+        sys::Size_T newPos = position + size;
+        if (position == mData.size())
+        {
+            // Appending (the usual case): no need to zero-fill first
+            mData.insert(mData.end(), bufferPtr, bufferPtr + size);
+        }
+        else
+        {
+            if (newPos >= mData.size())
+                mData.resize(newPos);
+            std::copy(bufferPtr, bufferPtr + size, &mData[position]);
+        }
         mPosition = static_cast<sys::Off_T>(newPos);
+        mAccounted.set(mData.capacity());
     }
 }
 
@@ -101,3 +118,34 @@ sys::SSize_T io::ByteStream::readImpl(void* buffer, size_t len)
     return static_cast<sys::SSize_T>(len);
 }
 
+
+coda_oss::span<const coda_oss::byte> io::ByteStream::span() const
+{
+    if ((mPosition < 0) || (mPosition >= std::ssize(mData)))
+    {
+        return coda_oss::span<const coda_oss::byte>();
+    }
+    const void* const pData = mData.data() + mPosition;
+    return coda_oss::span<const coda_oss::byte>(static_cast<const coda_oss::byte*>(pData),
+                                                mData.size() - static_cast<size_t>(mPosition));
+}
+
+coda_oss::span<const coda_oss::byte> io::ByteStream::consume(size_t len)
+{
+    if (mPosition < 0)
+        throw except::Exception(Ctxt("Invalid read on eof"));
+
+    auto retval = span();
+    retval = retval.first(std::min(len, retval.size()));
+    mPosition += retval.size();
+    return retval;
+}
+
+std::vector<sys::ubyte> io::ByteStream::release()
+{
+    std::vector<sys::ubyte> retval;
+    retval.swap(mData);
+    mPosition = 0;
+    mAccounted.set(0);
+    return retval;
+}
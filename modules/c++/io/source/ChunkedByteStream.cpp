@@ -0,0 +1,164 @@
+/* =========================================================================
+ * This file is part of io-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * io-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "io/ChunkedByteStream.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+io::ChunkedByteStream::ChunkedByteStream(size_t chunkSize) :
+    mChunkSize(std::max<size_t>(chunkSize, 1))
+{
+}
+
+void io::ChunkedByteStream::write(const void* buffer, size_t size)
+{
+    auto bufferPtr = static_cast<const sys::ubyte*>(buffer);
+    while (size > 0)
+    {
+        if (mChunks.empty() || (mChunks.back().size() == mChunks.back().capacity()))
+        {
+            std::vector<sys::ubyte> chunk;
+            if ((size <= mChunkSize) && (mSpare.capacity() > 0))
+            {
+                chunk.swap(mSpare);
+            }
+            else
+            {
+                // A big write gets a chunk of its own, so it's still one buffer.
+                chunk.reserve(std::max(size, mChunkSize));
+            }
+            mChunks.push_back(std::move(chunk));
+        }
+
+        // Never grows past capacity(), so bytes already written don't move.
+        auto& back = mChunks.back();
+        const auto count = std::min(size, back.capacity() - back.size());
+        back.insert(back.end(), bufferPtr, bufferPtr + count);
+        bufferPtr += count;
+        size -= count;
+        mSize += count;
+    }
+}
+
+std::vector<io::OutputStream::ConstBuffer> io::ChunkedByteStream::buffers() const
+{
+    std::vector<ConstBuffer> retval;
+    retval.reserve(mChunks.size());
+    size_t offset = mOffset;
+    for (const auto& chunk : mChunks)
+    {
+        const void* const pData = chunk.data() + offset;
+        retval.push_back(ConstBuffer(static_cast<const coda_oss::byte*>(pData), chunk.size() - offset));
+        offset = 0;
+    }
+    return retval;
+}
+
+void io::ChunkedByteStream::popFront()
+{
+    auto& front = mChunks.front();
+    if (front.capacity() == mChunkSize)
+    {
+        front.clear();
+        mSpare.swap(front);
+    }
+    mChunks.pop_front();
+    mOffset = 0;
+}
+
+size_t io::ChunkedByteStream::consume(size_t len)
+{
+    size_t retval = 0;
+    while ((len > 0) && !mChunks.empty())
+    {
+        const auto count = std::min(len, mChunks.front().size() - mOffset);
+        mOffset += count;
+        len -= count;
+        retval += count;
+
+        // Keep a partly-written last chunk: there's room for more.
+        const auto& front = mChunks.front();
+        if ((mOffset == front.size()) && ((mChunks.size() > 1) || (front.size() == front.capacity())))
+        {
+            popFront();
+        }
+        else if (count == 0)
+        {
+            break;
+        }
+    }
+    mSize -= retval;
+    return retval;
+}
+
+sys::SSize_T io::ChunkedByteStream::readImpl(void* buffer, size_t len)
+{
+    if (mSize == 0)
+    {
+        return io::InputStream::IS_END;
+    }
+
+    auto bufferPtr = static_cast<sys::ubyte*>(buffer);
+    size_t offset = mOffset;
+    for (auto it = mChunks.begin(); (it != mChunks.end()) && (len > 0); ++it, offset = 0)
+    {
+        const auto count = std::min(len, it->size() - offset);
+        memcpy(bufferPtr, it->data() + offset, count);
+        bufferPtr += count;
+        len -= count;
+    }
+    const auto retval = static_cast<size_t>(bufferPtr - static_cast<sys::ubyte*>(buffer));
+    consume(retval);
+    return static_cast<sys::SSize_T>(retval);
+}
+
+std::vector<sys::ubyte> io::ChunkedByteStream::release()
+{
+    std::vector<sys::ubyte> retval;
+    if ((mChunks.size() == 1) && (mOffset == 0))
+    {
+        retval.swap(mChunks.front()); // nothing to copy
+    }
+    else
+    {
+        retval.reserve(mSize);
+        for (const auto& b : buffers())
+        {
+            const void* const pData = b.data();
+            const auto p = static_cast<const sys::ubyte*>(pData);
+            retval.insert(retval.end(), p, p + b.size());
+        }
+    }
+    clear();
+    return retval;
+}
+
+void io::ChunkedByteStream::clear()
+{
+    while (!mChunks.empty())
+    {
+        popFront();
+    }
+    mSize = 0;
+}
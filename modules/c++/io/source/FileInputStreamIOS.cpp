@@ -21,6 +21,7 @@
  */
 
 #include "io/FileInputStreamIOS.h"
+#include "sys/Trace.h"
 
 #if defined(USE_IO_STREAMS)
 
@@ -104,6 +105,7 @@ void io::FileInputStreamIOS::close()
 
 sys::SSize_T io::FileInputStreamIOS::readImpl(void* buffer, size_t len)
 {
+    CODA_OSS_TRACE_ZONE("io::FileInputStream::read");
     ::memset(buffer, 0, len);
     sys::Off_T avail = available();
     if (mFStream.eof() || avail <= 0) return io::InputStream::IS_EOF;
@@ -21,6 +21,7 @@
  */
 
 #include "io/FileInputStreamOS.h"
+#include "sys/Trace.h"
 
 #if !defined(USE_IO_STREAMS)
 
@@ -45,6 +46,7 @@ sys::Off_T io::FileInputStreamOS::available()
 
 sys::SSize_T io::FileInputStreamOS::readImpl(void* buffer, size_t len)
 {
+    CODA_OSS_TRACE_ZONE("io::FileInputStream::read");
     ::memset(buffer, 0, len);
     sys::Off_T avail = available();
     if (!avail)
@@ -21,6 +21,7 @@
  */
 
 #include "io/FileOutputStreamIOS.h"
+#include "sys/Trace.h"
 
 #if defined(USE_IO_STREAMS)
 
@@ -77,6 +78,7 @@ void io::FileOutputStreamIOS::close()
 
 void io::FileOutputStreamIOS::write(const void* buffer, size_t len)
 {
+    CODA_OSS_TRACE_ZONE("io::FileOutputStream::write");
     mFStream.write((const char*)buffer, len);
 }
 
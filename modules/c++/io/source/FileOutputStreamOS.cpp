@@ -21,6 +21,7 @@
  */
 
 #include "io/FileOutputStreamOS.h"
+#include "sys/Trace.h"
 
 #if !defined(USE_IO_STREAMS)
 
@@ -44,9 +45,16 @@ void io::FileOutputStreamOS::create(const path& str_,
 
 void io::FileOutputStreamOS::write(const void* buffer, size_t len)
 {
+    CODA_OSS_TRACE_ZONE("io::FileOutputStream::write");
     mFile.writeFrom(buffer, len);
 }
 
+void io::FileOutputStreamOS::writev(coda_oss::span<const ConstBuffer> buffers)
+{
+    CODA_OSS_TRACE_ZONE("io::FileOutputStream::write");
+    mFile.writeFrom(buffers);
+}
+
 void io::FileOutputStreamOS::flush()
 {
     mFile.flush();
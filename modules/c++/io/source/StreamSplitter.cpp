@@ -29,6 +29,12 @@
 
 namespace io
 {
+sys::MemoryCategory& StreamSplitter::getMemoryCategory()
+{
+    static sys::MemoryCategory& category = sys::getMemoryCategory("io::StreamSplitter");
+    return category;
+}
+
 StreamSplitter::StreamSplitter(io::InputStream& inputStream,
                                const std::string& delimiter,
                                size_t bufferSize) :
@@ -41,9 +47,11 @@ StreamSplitter::StreamSplitter(io::InputStream& inputStream,
     mBufferStorage(bufferSize),
     mBufferCapacity(mBufferStorage.size()),
     mBuffer(mBufferStorage.empty() ? nullptr : &mBufferStorage[0]),
+    mAccounted(getMemoryCategory()),
     mInputStream(inputStream),
     mStreamEmpty(false)
 {
+    mAccounted.set(mBufferStorage.size());
     if (delimiter.empty())
     {
         throw except::InvalidArgumentException(
@@ -0,0 +1,196 @@
+/* =========================================================================
+ * This file is part of io-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * io-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include <sys/File.h>
+#include <io/BufferedOutputStream.h>
+#include <io/CountingStreams.h>
+#include <io/FileOutputStream.h>
+#include <io/StringStream.h>
+#include <io/TempFile.h>
+#include "TestCase.h"
+
+namespace
+{
+// Remembers what was written, and how
+struct RecordingOutputStream final : public io::OutputStream
+{
+    std::string bytes;
+    size_t writes = 0;
+    size_t writevs = 0;
+    bool flushed = false;
+
+    using OutputStream::write;
+    void write(const void* buffer, size_t len) override
+    {
+        bytes.append(static_cast<const char*>(buffer), len);
+        ++writes;
+    }
+    void writev(coda_oss::span<const ConstBuffer> buffers) override
+    {
+        for (const auto& buffer : buffers)
+        {
+            bytes.append(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+        }
+        ++writevs;
+    }
+    void flush() override
+    {
+        flushed = true;
+    }
+};
+
+io::OutputStream::ConstBuffer asBuffer(const std::string& s)
+{
+    return coda_oss::as_bytes(coda_oss::span<const char>(s.data(), s.size()));
+}
+}
+
+TEST_CASE(testSmallWrites)
+{
+    RecordingOutputStream output;
+    std::string expected;
+    {
+        io::BufferedOutputStream buffered(output, 100);
+        TEST_ASSERT_EQ(buffered.getBufferSize(), static_cast<size_t>(100));
+        for (int ii = 0; ii < 95; ++ii)
+        {
+            const auto s = std::to_string(ii);
+            buffered.write(s);
+            expected += s;
+        }
+        // 180 bytes through a 100 byte buffer: only one write so far
+        TEST_ASSERT_EQ(output.writes, static_cast<size_t>(1));
+        TEST_ASSERT_EQ(output.bytes.size() + buffered.getPending(), expected.size());
+
+        buffered.flush();
+        TEST_ASSERT_EQ(buffered.getPending(), static_cast<size_t>(0));
+        TEST_ASSERT_TRUE(output.flushed);
+        TEST_ASSERT_EQ(output.bytes, expected);
+
+        buffered.write("left over");
+        expected += "left over";
+    }
+    // The destructor writes what's left
+    TEST_ASSERT_EQ(output.bytes, expected);
+    TEST_ASSERT_EQ(output.writevs, static_cast<size_t>(0));
+}
+
+TEST_CASE(testLargeWrites)
+{
+    RecordingOutputStream output;
+    io::BufferedOutputStream buffered(output, 16);
+
+    buffered.write("header");
+    const std::string payload(1000, 'x');
+    buffered.write(payload);
+    // What's buffered goes out with the payload, not before it
+    TEST_ASSERT_EQ(output.writes, static_cast<size_t>(0));
+    TEST_ASSERT_EQ(output.writevs, static_cast<size_t>(1));
+    TEST_ASSERT_EQ(output.bytes, "header" + payload);
+
+    // Nothing buffered: just a write()
+    buffered.write(payload);
+    TEST_ASSERT_EQ(output.writes, static_cast<size_t>(1));
+    TEST_ASSERT_EQ(output.bytes, "header" + payload + payload);
+}
+
+TEST_CASE(testGatherWrites)
+{
+    RecordingOutputStream output;
+    io::BufferedOutputStream buffered(output, 32);
+
+    const std::string header = "HDR:", body = "0123456789";
+    std::vector<io::OutputStream::ConstBuffer> buffers{ asBuffer(header), asBuffer(body) };
+    buffered.writev(buffers); // fits
+    TEST_ASSERT_EQ(buffered.getPending(), header.size() + body.size());
+    TEST_ASSERT_EQ(output.bytes, "");
+
+    buffered.writev(buffers); // fits, just
+    buffered.writev(buffers); // doesn't
+    TEST_ASSERT_EQ(output.writevs, static_cast<size_t>(1));
+    TEST_ASSERT_EQ(buffered.getPending(), static_cast<size_t>(0));
+    TEST_ASSERT_EQ(output.bytes, header + body + header + body + header + body);
+
+    // Nothing buffered: the buffers are passed straight through
+    const std::string payload(40, 'x');
+    const std::vector<io::OutputStream::ConstBuffer> large{ asBuffer(header), asBuffer(payload) };
+    buffered.writev(large);
+    TEST_ASSERT_EQ(output.writevs, static_cast<size_t>(2));
+    TEST_ASSERT_EQ(output.bytes, header + body + header + body + header + body + header + payload);
+
+    // What's buffered and the first 63 buffers, then the rest
+    buffered.write(header);
+    const std::vector<io::OutputStream::ConstBuffer> many(100, asBuffer(body));
+    buffered.writev(many);
+    TEST_ASSERT_EQ(output.writevs, static_cast<size_t>(4));
+    std::string expected = header + body + header + body + header + body + header + payload + header;
+    for (size_t ii = 0; ii < many.size(); ++ii)
+    {
+        expected += body;
+    }
+    TEST_ASSERT_EQ(output.bytes, expected);
+
+    // The default writev() just calls write()
+    io::StringStream stream;
+    io::CountingOutputStream counter(&stream);
+    counter.writev(buffers);
+    TEST_ASSERT_EQ(counter.getCount(), static_cast<sys::Off_T>(header.size() + body.size()));
+    TEST_ASSERT_EQ(stream.stream().str(), header + body);
+}
+
+TEST_CASE(testFileGatherWrites)
+{
+    // More buffers than are sent to writev() at once, some empty
+    std::vector<std::string> strings;
+    std::string expected;
+    for (size_t ii = 0; ii < 200; ++ii)
+    {
+        strings.push_back(ii % 7 == 0 ? "" : std::to_string(ii * ii));
+        expected += strings.back();
+    }
+    std::vector<io::OutputStream::ConstBuffer> buffers;
+    for (const auto& s : strings)
+    {
+        buffers.push_back(asBuffer(s));
+    }
+
+    const io::TempFile tempFile;
+    {
+        io::FileOutputStream output(tempFile.pathname());
+        output.writev(buffers);
+        output.close();
+    }
+    sys::File file(tempFile.pathname());
+    std::string actual(static_cast<size_t>(file.length()), ' ');
+    file.readInto(&actual[0], actual.size());
+    TEST_ASSERT_EQ(actual, expected);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testSmallWrites);
+    TEST_CHECK(testLargeWrites);
+    TEST_CHECK(testGatherWrites);
+    TEST_CHECK(testFileGatherWrites);
+    )
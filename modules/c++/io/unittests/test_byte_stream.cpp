@@ -0,0 +1,168 @@
+/* =========================================================================
+ * This file is part of io-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * io-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include <io/ByteStream.h>
+#include <io/ChunkedByteStream.h>
+#include <io/StringStream.h>
+#include <sys/MemoryAccounting.h>
+#include "TestCase.h"
+
+static std::string toString(coda_oss::span<const coda_oss::byte> s)
+{
+    const void* const pData = s.data();
+    return std::string(static_cast<const char*>(pData), s.size());
+}
+
+TEST_CASE(testByteStreamViews)
+{
+    io::ByteStream stream;
+    stream.reserve(100);
+    stream.write("Hello");
+    const auto pData = stream.get();
+    stream.write(", world");
+    TEST_ASSERT(stream.get() == pData); // reserve()d, so no reallocation
+    TEST_ASSERT_TRUE(stream.span().empty()); // position is at the end
+
+    stream.seek(0, io::Seekable::START);
+    TEST_ASSERT_EQ(toString(stream.span()), "Hello, world");
+    TEST_ASSERT(static_cast<const void*>(stream.data()) == stream.get());
+
+    const auto hello = stream.consume(5); // TEST_ASSERT_EQ() might evaluate more than once
+    TEST_ASSERT_EQ(toString(hello), "Hello");
+    TEST_ASSERT_EQ(stream.tell(), 5);
+    TEST_ASSERT_EQ(toString(stream.span()), ", world");
+    const auto world = stream.consume(100);
+    TEST_ASSERT_EQ(toString(world), ", world");
+    const auto nothing = stream.consume(1);
+    TEST_ASSERT_TRUE(nothing.empty());
+
+    const auto bytes = stream.release();
+    TEST_ASSERT_EQ(std::string(bytes.begin(), bytes.end()), "Hello, world");
+    TEST_ASSERT_EQ(stream.size(), static_cast<size_t>(0));
+    TEST_ASSERT_EQ(stream.tell(), 0);
+
+    // ... and back in without a copy
+    auto moved = bytes;
+    const auto pMoved = moved.data();
+    io::ByteStream adopted(std::move(moved));
+    TEST_ASSERT(adopted.get() == pMoved);
+    TEST_ASSERT_EQ(toString(adopted.span()), "Hello, world");
+
+    // overwriting in the middle still works
+    adopted.seek(7, io::Seekable::START);
+    adopted.write("there, world");
+    adopted.seek(0, io::Seekable::START);
+    TEST_ASSERT_EQ(toString(adopted.span()), "Hello, there, world");
+}
+
+TEST_CASE(testChunkedByteStream)
+{
+    io::ChunkedByteStream stream(8);
+    std::string expected;
+    for (int ii = 0; ii < 20; ++ii)
+    {
+        const auto s = std::to_string(ii * 37);
+        stream.write(s);
+        expected += s;
+    }
+    const std::string big(50, 'b'); // bigger than a chunk
+    stream.write(big);
+    expected += big;
+    TEST_ASSERT_EQ(stream.size(), expected.size());
+    TEST_ASSERT_EQ(stream.available(), static_cast<sys::Off_T>(expected.size()));
+
+    auto buffers = stream.buffers();
+    TEST_ASSERT_EQ(buffers.back().size(), big.size());
+    const auto firstChunk = buffers.front().data();
+    std::string actual;
+    for (const auto& b : buffers)
+    {
+        TEST_ASSERT(b.size() <= big.size());
+        actual += toString(b);
+    }
+    TEST_ASSERT_EQ(actual, expected);
+
+    // writes don't move what's already there
+    stream.write("more");
+    expected += "more";
+    TEST_ASSERT(stream.buffers().front().data() == firstChunk);
+
+    const auto consumed = stream.consume(10);
+    TEST_ASSERT_EQ(consumed, static_cast<size_t>(10));
+    TEST_ASSERT_EQ(toString(stream.buffers().front()), expected.substr(10, 6));
+
+    char buf[20];
+    auto bytesRead = stream.read(buf, sizeof(buf));
+    TEST_ASSERT_EQ(bytesRead, static_cast<sys::SSize_T>(sizeof(buf)));
+    TEST_ASSERT_EQ(std::string(buf, sizeof(buf)), expected.substr(10, sizeof(buf)));
+    expected = expected.substr(30);
+
+    io::StringStream output;
+    output.writev(stream.buffers());
+    TEST_ASSERT_EQ(output.stream().str(), expected);
+
+    const auto bytes = stream.release();
+    TEST_ASSERT_EQ(std::string(bytes.begin(), bytes.end()), expected);
+    TEST_ASSERT_EQ(stream.size(), static_cast<size_t>(0));
+    bytesRead = stream.read(buf, sizeof(buf));
+    TEST_ASSERT_EQ(bytesRead, static_cast<sys::SSize_T>(io::InputStream::IS_END));
+
+    // reading everything, then writing more
+    stream.write("abc");
+    bytesRead = stream.read(buf, 3);
+    TEST_ASSERT_EQ(bytesRead, static_cast<sys::SSize_T>(3));
+    stream.write("def");
+    bytesRead = stream.read(buf, sizeof(buf));
+    TEST_ASSERT_EQ(bytesRead, static_cast<sys::SSize_T>(3));
+    TEST_ASSERT_EQ(std::string(buf, 3), "def");
+}
+
+TEST_CASE(testByteStreamMemoryAccounting)
+{
+    sys::enableMemoryAccounting();
+    auto& category = sys::getMemoryCategory("io::ByteStream");
+    const auto before = category.getUsage().currentBytes;
+    {
+        io::ByteStream stream;
+        stream.reserve(1000);
+        TEST_ASSERT(category.getUsage().currentBytes >= before + 1000);
+        stream.write(std::string(5000, 'x'));
+        TEST_ASSERT(category.getUsage().currentBytes >= before + 5000);
+
+        const auto data = stream.release();
+        TEST_ASSERT_EQ(data.size(), static_cast<size_t>(5000));
+        TEST_ASSERT_EQ(category.getUsage().currentBytes, before);
+        stream.write("abc");
+    }
+    TEST_ASSERT_EQ(category.getUsage().currentBytes, before);
+    TEST_ASSERT(category.getUsage().peakBytes >= before + 5000);
+    sys::enableMemoryAccounting(false);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testByteStreamViews);
+    TEST_CHECK(testChunkedByteStream);
+    TEST_CHECK(testByteStreamMemoryAccounting);
+    )
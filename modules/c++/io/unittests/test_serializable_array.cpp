@@ -0,0 +1,155 @@
+/* =========================================================================
+ * This file is part of io-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * io-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <complex>
+#include <vector>
+
+#include <sys/ByteSwap.h>
+#include <io/ByteStream.h>
+#include <io/SerializableArray.h>
+#include "TestCase.h"
+
+namespace
+{
+struct WriteCountingStream final : public io::OutputStream
+{
+    io::ByteStream bytes;
+    size_t writes = 0;
+
+    using OutputStream::write;
+    void write(const void* buffer, size_t len) override
+    {
+        bytes.write(buffer, len);
+        ++writes;
+    }
+};
+
+template <typename T>
+std::vector<T> makeData(size_t count)
+{
+    std::vector<T> retval(count);
+    for (size_t ii = 0; ii < count; ++ii)
+    {
+        retval[ii] = static_cast<T>(ii * 1000003 + 7);
+    }
+    return retval;
+}
+}
+
+TEST_CASE(testSerializeSwapped)
+{
+    auto data = makeData<uint32_t>(100000);
+    const auto original = data;
+
+    WriteCountingStream output;
+    io::SerializableArray<uint32_t> array(data.data(), data.size());
+    array.setByteSwap(true, 4);
+    array.setChunkSize(64 * 1024);
+    array.serialize(output);
+    TEST_ASSERT(data == original); // not modified
+    TEST_ASSERT_EQ(output.writes, static_cast<size_t>(7)); // 400,000 bytes in 64K chunks
+
+    std::vector<uint32_t> serialized(data.size());
+    output.bytes.seek(0, io::Seekable::START);
+    output.bytes.read(serialized.data(), serialized.size() * sizeof(uint32_t));
+    for (size_t ii = 0; ii < data.size(); ++ii)
+    {
+        TEST_ASSERT_EQ(serialized[ii], sys::byteSwap(data[ii]));
+    }
+
+    // ... and back
+    std::vector<uint32_t> roundTrip(data.size());
+    output.bytes.seek(0, io::Seekable::START);
+    io::SerializableArray<uint32_t> in(roundTrip.data(), roundTrip.size());
+    in.setByteSwap(true);
+    in.deserialize(output.bytes);
+    TEST_ASSERT(roundTrip == original);
+}
+
+TEST_CASE(testSerializeStrided)
+{
+    auto data = makeData<uint64_t>(1001);
+    for (const bool swap : { false, true })
+    {
+        WriteCountingStream output;
+        io::SerializableArray<uint64_t> array(data.data(), 1, 1000, 2); // every 3rd, after the first
+        array.setByteSwap(swap);
+        array.setChunkSize(100 * sizeof(uint64_t));
+        array.serialize(output);
+        TEST_ASSERT_EQ(output.writes, static_cast<size_t>(4)); // 334 elements
+
+        std::vector<uint64_t> expected;
+        for (size_t ii = 1; ii < 1001; ii += 3)
+        {
+            expected.push_back(swap ? sys::byteSwap(data[ii]) : data[ii]);
+        }
+        std::vector<uint64_t> serialized(expected.size());
+        output.bytes.seek(0, io::Seekable::START);
+        output.bytes.read(serialized.data(), serialized.size() * sizeof(uint64_t));
+        TEST_ASSERT(serialized == expected);
+
+        // Deserializing reads 'length' elements, keeping every 3rd
+        std::vector<uint64_t> stream = makeData<uint64_t>(1000);
+        io::ByteStream input;
+        input.write(stream.data(), stream.size() * sizeof(uint64_t));
+        input.seek(0, io::Seekable::START);
+        std::vector<uint64_t> kept(334);
+        io::SerializableArray<uint64_t> in(kept.data(), 0, 1000, 2);
+        in.setByteSwap(swap);
+        in.setChunkSize(128 * sizeof(uint64_t)); // not a multiple of the stride
+        in.deserialize(input);
+        for (size_t ii = 0; ii < kept.size(); ++ii)
+        {
+            const auto value = stream[ii * 3];
+            TEST_ASSERT_EQ(kept[ii], swap ? sys::byteSwap(value) : value);
+        }
+    }
+}
+
+TEST_CASE(testSerializeComplex)
+{
+    // each component is swapped on its own
+    std::vector<std::complex<float>> data{ { 1.0f, -2.0f }, { 3.5f, 0.25f } };
+    io::ByteStream output;
+    io::SerializableArray<std::complex<float>> array(data.data(), data.size());
+    array.setByteSwap(true);
+    array.serialize(output);
+
+    // compare bits: a swapped float might not be a valid one
+    std::vector<uint32_t> serialized(4), expected(4);
+    output.seek(0, io::Seekable::START);
+    output.read(serialized.data(), serialized.size() * sizeof(uint32_t));
+    memcpy(expected.data(), data.data(), expected.size() * sizeof(uint32_t));
+    for (size_t ii = 0; ii < expected.size(); ++ii)
+    {
+        TEST_ASSERT_EQ(serialized[ii], sys::byteSwap(expected[ii]));
+    }
+}
+
+TEST_MAIN(
+    TEST_CHECK(testSerializeSwapped);
+    TEST_CHECK(testSerializeStrided);
+    TEST_CHECK(testSerializeComplex);
+    )
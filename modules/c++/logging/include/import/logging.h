@@ -41,5 +41,6 @@
 #include "logging/StreamHandler.h"
 #include "logging/XMLFormatter.h"
 #include "logging/ExceptionLogger.h"
+#include "logging/MemoryUsageLogger.h"
 
 #endif
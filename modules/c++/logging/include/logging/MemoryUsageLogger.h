@@ -0,0 +1,78 @@
+/* =========================================================================
+ * This file is part of logging-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * logging-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_logging_MemoryUsageLogger_h_INCLUDED_
+#define CODA_OSS_logging_MemoryUsageLogger_h_INCLUDED_
+
+#include <chrono>
+#include <sstream>
+#include <vector>
+
+#include <sys/MemoryAccounting.h>
+
+#include "logging/Logger.h"
+
+namespace logging
+{
+/*!
+ * \class MemoryUsageLogger
+ *
+ * \brief Logs sys::getMemoryUsage() (current and peak bytes per category,
+ * and the process-wide total) every so often, and once more when it's
+ * destroyed.  Nothing is counted until sys::enableMemoryAccounting() is
+ * called; see sys/MemoryAccounting.h.
+ */
+class MemoryUsageLogger final
+{
+public:
+    //! The logger must outlive this object.
+    MemoryUsageLogger(Logger& logger, std::chrono::milliseconds period,
+                      LogLevel logLevel = LogLevel::LOG_INFO) :
+        mReporter(period,
+                  [&logger, logLevel](const std::vector<sys::MemoryUsage>& usage)
+                  {
+                      std::ostringstream os;
+                      os << "Memory usage:\n";
+                      sys::writeMemoryUsage(os, usage);
+                      auto message = os.str();
+                      message.pop_back(); // the handler adds its own newline
+                      logger.log(logLevel, message);
+                  })
+    {
+    }
+
+    MemoryUsageLogger(const MemoryUsageLogger&) = delete;
+    MemoryUsageLogger& operator=(const MemoryUsageLogger&) = delete;
+
+    //! Log the usage now.
+    void log()
+    {
+        mReporter.report();
+    }
+
+private:
+    sys::MemoryUsageReporter mReporter;
+};
+}
+
+#endif  // CODA_OSS_logging_MemoryUsageLogger_h_INCLUDED_
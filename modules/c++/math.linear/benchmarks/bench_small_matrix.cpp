@@ -0,0 +1,248 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Users guide
+
+    Compares the unrolled 2x2, 3x3 and 4x4 MatrixMxN/VectorN code (and
+    transformPoints()) against the generic loops and LU decomposition,
+    over 10000 matrices (and 100000 points) per iteration.
+
+    ./bench_small_matrix [--filter=<name>] [--json=<file>] [--quick] ...
+
+*/
+
+/*  Results (-O3, a 1-CPU VM, x86-64 baseline SSE2), median per iteration:
+                          generic / LU   unrolled
+    multiply 2x2          18.6 us        14.7 us
+    multiply 3x3          67.9 us        61.1 us
+    multiply 4x4          148 us         167 us
+    matrixVector 3x3      35.6 us        23.7 us
+    matrixVector 4x4      58.7 us        43.6 us
+    determinant 3x3       407 us         20.4 us
+    determinant 4x4       740 us         100 us
+    inverse 4x4           1.14 ms        268 us
+    transformPoints       generic 265 us, VectorN 315 us, xyz 219 us
+*/
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <math/linear/MatrixMxN.h>
+#include <math/linear/VectorN.h>
+#include <math/linear/TransformPoints.h>
+
+#include "Benchmark.h"
+
+using math::linear::MatrixMxN;
+using math::linear::VectorN;
+
+static constexpr size_t numMatrices = 10000;
+
+template <size_t N>
+static std::vector<MatrixMxN<N, N>> makeMatrices(size_t numToMake, double seed)
+{
+    std::vector<MatrixMxN<N, N>> retval(numToMake);
+    for (size_t m = 0; m < numToMake; ++m)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t j = 0; j < N; ++j)
+            {
+                retval[m](i, j) = std::sin(seed + m * 0.01 + i * 1.3 + j * 0.7) + (i == j ? 2.0 : 0.0);
+            }
+        }
+    }
+    return retval;
+}
+
+template <size_t N>
+static std::vector<VectorN<N>> makeVectors(size_t numVectors)
+{
+    std::vector<VectorN<N>> retval(numVectors);
+    for (size_t v = 0; v < numVectors; ++v)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            retval[v][i] = std::cos(v * 0.1 + i);
+        }
+    }
+    return retval;
+}
+
+template <size_t N>
+static std::string getLabel(const char* kind)
+{
+    return std::to_string(N) + "x" + std::to_string(N) + "/" + kind;
+}
+
+template <size_t N>
+static void runMultiply(benchmark::State& state)
+{
+    const auto a = makeMatrices<N>(numMatrices, 0.1);
+    const auto b = makeMatrices<N>(numMatrices, 2.3);
+    std::vector<MatrixMxN<N, N>> c(numMatrices);
+    state.run(getLabel<N>("generic"), [&]() {
+        for (size_t i = 0; i < numMatrices; ++i)
+        {
+            c[i] = math::linear::details::multiply<N, N, N, double>(a[i], b[i]);
+        }
+        benchmark::doNotOptimize(c);
+    });
+    state.run(getLabel<N>("unrolled"), [&]() {
+        for (size_t i = 0; i < numMatrices; ++i)
+        {
+            c[i] = a[i] * b[i];
+        }
+        benchmark::doNotOptimize(c);
+    });
+}
+
+template <size_t N>
+static void runMatrixVector(benchmark::State& state)
+{
+    const auto a = makeMatrices<N>(numMatrices, 0.1);
+    const auto v = makeVectors<N>(numMatrices);
+    std::vector<VectorN<N>> out(numMatrices);
+    state.run(getLabel<N>("generic"), [&]() {
+        for (size_t i = 0; i < numMatrices; ++i)
+        {
+            out[i] = math::linear::details::multiply<N, N, 1, double>(a[i], v[i].matrix());
+        }
+        benchmark::doNotOptimize(out);
+    });
+    state.run(getLabel<N>("unrolled"), [&]() {
+        for (size_t i = 0; i < numMatrices; ++i)
+        {
+            out[i] = a[i] * v[i];
+        }
+        benchmark::doNotOptimize(out);
+    });
+}
+
+template <size_t N>
+static void runDeterminant(benchmark::State& state)
+{
+    const auto a = makeMatrices<N>(numMatrices, 0.1);
+    std::vector<double> out(numMatrices);
+    state.run(getLabel<N>("LU"), [&]() {
+        for (size_t i = 0; i < numMatrices; ++i)
+        {
+            out[i] = math::linear::determinantLU(a[i]);
+        }
+        benchmark::doNotOptimize(out);
+    });
+    state.run(getLabel<N>("unrolled"), [&]() {
+        for (size_t i = 0; i < numMatrices; ++i)
+        {
+            out[i] = math::linear::determinant(a[i]);
+        }
+        benchmark::doNotOptimize(out);
+    });
+}
+
+BENCHMARK_CASE(multiply)
+{
+    state.setItemsPerIteration(static_cast<double>(numMatrices));
+    runMultiply<2>(state);
+    runMultiply<3>(state);
+    runMultiply<4>(state);
+}
+
+BENCHMARK_CASE(matrixVector)
+{
+    state.setItemsPerIteration(static_cast<double>(numMatrices));
+    runMatrixVector<3>(state);
+    runMatrixVector<4>(state);
+}
+
+BENCHMARK_CASE(determinant)
+{
+    state.setItemsPerIteration(static_cast<double>(numMatrices));
+    runDeterminant<3>(state);
+    runDeterminant<4>(state);
+}
+
+BENCHMARK_CASE(inverse)
+{
+    const auto m4 = makeMatrices<4>(numMatrices, 0.1);
+    std::vector<MatrixMxN<4, 4>> inverses(numMatrices);
+    state.setItemsPerIteration(static_cast<double>(numMatrices));
+    state.run(getLabel<4>("LU"), [&]() {
+        for (size_t i = 0; i < numMatrices; ++i)
+        {
+            inverses[i] = math::linear::inverseLU(m4[i]);
+        }
+        benchmark::doNotOptimize(inverses);
+    });
+    state.run(getLabel<4>("unrolled"), [&]() {
+        for (size_t i = 0; i < numMatrices; ++i)
+        {
+            inverses[i] = math::linear::inverse(m4[i]);
+        }
+        benchmark::doNotOptimize(inverses);
+    });
+}
+
+BENCHMARK_CASE(transformPoints)
+{
+    // One rotation applied to many points: a matrix-vector product per
+    // point vs. transformPoints() on VectorNs and on separate x, y, z
+    const auto numPoints = numMatrices * 10;
+    const auto R = makeMatrices<3>(1, 0.5)[0];
+    const auto points = makeVectors<3>(numPoints);
+    std::vector<VectorN<3>> transformed(numPoints);
+    std::vector<double> x(numPoints), y(numPoints), z(numPoints);
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+        x[i] = points[i][0];
+        y[i] = points[i][1];
+        z[i] = points[i][2];
+    }
+    std::vector<double> outX(numPoints), outY(numPoints), outZ(numPoints);
+    const VectorN<3> zero(0.0);
+
+    state.setItemsPerIteration(static_cast<double>(numPoints));
+    state.run("generic", [&]() {
+        for (size_t i = 0; i < numPoints; ++i)
+        {
+            transformed[i] = math::linear::details::multiply<3, 3, 1, double>(R, points[i].matrix());
+        }
+        benchmark::doNotOptimize(transformed);
+    });
+    state.run("VectorN", [&]() {
+        math::linear::transformPoints(R, points, transformed);
+        benchmark::doNotOptimize(transformed);
+    });
+    state.run("xyz", [&]() {
+        math::linear::transformPoints(R, zero, x, y, z, outX, outY, outZ);
+        benchmark::doNotOptimize(outX);
+    });
+}
+
+BENCHMARK_MAIN(
+    BENCHMARK_CHECK(multiply);
+    BENCHMARK_CHECK(matrixVector);
+    BENCHMARK_CHECK(determinant);
+    BENCHMARK_CHECK(inverse);
+    BENCHMARK_CHECK(transformPoints);
+    )
@@ -27,6 +27,7 @@
 #include "math/linear/VectorN.h"
 #include "math/linear/Matrix2D.h"
 #include "math/linear/Vector.h"
+#include "math/linear/TransformPoints.h"
 
 #endif  // __MATH_LINEAR_H__
 
@@ -27,6 +27,8 @@
 #include <limits>
 #include <complex>
 #include <iomanip> // std::setw()
+#include <utility> // std::swap()
+#include <vector>
 
 #include <import/sys.h>
 
@@ -85,6 +87,21 @@ bool almostZero(const T& value)
     return (std::abs(value) < std::numeric_limits<T>::epsilon());
 }
 
+template <size_t _MD, size_t _ND, typename _T> class MatrixMxN;
+namespace details
+{
+// Matrix multiply: generic loops, and fully unrolled for the common small sizes
+// (2x2, 3x3 and 4x4 transforms and their matrix-vector products).
+template<size_t _MD, size_t _ND, size_t _PD, typename _T>
+MatrixMxN<_MD, _PD, _T> multiply(const MatrixMxN<_MD, _ND, _T>&, const MatrixMxN<_ND, _PD, _T>&) noexcept;
+template<typename _T> MatrixMxN<2, 2, _T> multiply(const MatrixMxN<2, 2, _T>&, const MatrixMxN<2, 2, _T>&) noexcept;
+template<typename _T> MatrixMxN<3, 3, _T> multiply(const MatrixMxN<3, 3, _T>&, const MatrixMxN<3, 3, _T>&) noexcept;
+template<typename _T> MatrixMxN<4, 4, _T> multiply(const MatrixMxN<4, 4, _T>&, const MatrixMxN<4, 4, _T>&) noexcept;
+template<typename _T> MatrixMxN<2, 1, _T> multiply(const MatrixMxN<2, 2, _T>&, const MatrixMxN<2, 1, _T>&) noexcept;
+template<typename _T> MatrixMxN<3, 1, _T> multiply(const MatrixMxN<3, 3, _T>&, const MatrixMxN<3, 1, _T>&) noexcept;
+template<typename _T> MatrixMxN<4, 1, _T> multiply(const MatrixMxN<4, 4, _T>&, const MatrixMxN<4, 1, _T>&) noexcept;
+}
+
 /*!
  *  \class MatrixMxN
  *  \brief Compile-time fixed size Matrix template
@@ -211,16 +228,7 @@ public:
           MatrixMxN<3, 3> At(A.transpose());
      *  \endcode
      */
-    MatrixMxN(const MatrixMxN& mx)
-    {
-        for (size_t i = 0; i < rows(); i++)
-        {
-            for (size_t j = 0; j < cols(); j++)
-            {
-                mRaw[i][j] = mx.mRaw[i][j];
-            }
-        }
-    }
+    MatrixMxN(const MatrixMxN& mx) = default; // trivially copyable: memcpy() and pass-in-registers
     /*!
      *  Assign a matrix from a 1D raw M*N pointer.
      *  Assumes that the pointer is of correct size.
@@ -272,18 +280,7 @@ public:
      *  \param mx The source matrix
      *  \return this (the copy)
      */
-    MatrixMxN& operator=(const MatrixMxN& mx)
-    {
-        if (this != &mx)
-        for (size_t i = 0; i < rows(); i++)
-        {
-            for (size_t j = 0; j < cols(); j++)
-            {
-                mRaw[i][j] = mx.mRaw[i][j];
-            }
-        }
-        return *this;
-    }
+    MatrixMxN& operator=(const MatrixMxN& mx) = default;
 
     /*!
      *  Set a matrix (each element) to the contents
@@ -691,8 +688,10 @@ public:
      *  This function accesses the inner arrays for
      *  (potential, though slight) performance reasons.
      *
-     *  One would hope that the compiler will unroll these
-     *  loops since they are of constant size.
+     *  2x2, 3x3 and 4x4 matrices (and matrix-vector products
+     *  with them) are explicitly unrolled; other sizes are
+     *  loops, which one would hope that the compiler will
+     *  unroll since they are of constant size.
      *
      *  \param mx An NxP matrix
      *  \return An MxP matrix
@@ -709,21 +708,7 @@ public:
     template<size_t _PD> MatrixMxN<_MD, _PD, _T>
         multiply(const MatrixMxN<_ND, _PD, _T>& mx) const
     {
-        MatrixMxN<_MD, _PD, _T> newM{};
-
-        for (size_t i = 0; i < rows(); i++)
-        {
-            for (size_t j = 0; j < _PD; j++)
-            {
-                newM.mRaw[i][j] = 0;
-                for (size_t k = 0; k < cols(); k++)
-                {
-                    newM.mRaw[i][j] += mRaw[i][k] * mx.mRaw[k][j];
-                }
-            }
-        }
-        return newM;
-
+        return details::multiply(*this, mx);
     }
 
 
@@ -1194,6 +1179,106 @@ public:
 
 };
 
+namespace details
+{
+template<size_t _MD, size_t _ND, size_t _PD, typename _T>
+inline MatrixMxN<_MD, _PD, _T> multiply(const MatrixMxN<_MD, _ND, _T>& a, const MatrixMxN<_ND, _PD, _T>& b) noexcept
+{
+    MatrixMxN<_MD, _PD, _T> c{};
+    for (size_t i = 0; i < _MD; i++)
+    {
+        for (size_t j = 0; j < _PD; j++)
+        {
+            for (size_t k = 0; k < _ND; k++)
+            {
+                c.mRaw[i][j] += a.mRaw[i][k] * b.mRaw[k][j];
+            }
+        }
+    }
+    return c;
+}
+
+// The unrolled versions sum in the same order as the loops above, so results are identical.
+template<typename _T>
+inline MatrixMxN<2, 2, _T> multiply(const MatrixMxN<2, 2, _T>& a_, const MatrixMxN<2, 2, _T>& b_) noexcept
+{
+    const auto& a = a_.mRaw;
+    const auto& b = b_.mRaw;
+    MatrixMxN<2, 2, _T> c_;
+    auto& c = c_.mRaw;
+    c[0][0] = a[0][0] * b[0][0] + a[0][1] * b[1][0];
+    c[0][1] = a[0][0] * b[0][1] + a[0][1] * b[1][1];
+    c[1][0] = a[1][0] * b[0][0] + a[1][1] * b[1][0];
+    c[1][1] = a[1][0] * b[0][1] + a[1][1] * b[1][1];
+    return c_;
+}
+template<typename _T>
+inline MatrixMxN<3, 3, _T> multiply(const MatrixMxN<3, 3, _T>& a_, const MatrixMxN<3, 3, _T>& b_) noexcept
+{
+    const auto& a = a_.mRaw;
+    const auto& b = b_.mRaw;
+    MatrixMxN<3, 3, _T> c_;
+    auto& c = c_.mRaw;
+    for (size_t i = 0; i < 3; i++)
+    {
+        c[i][0] = a[i][0] * b[0][0] + a[i][1] * b[1][0] + a[i][2] * b[2][0];
+        c[i][1] = a[i][0] * b[0][1] + a[i][1] * b[1][1] + a[i][2] * b[2][1];
+        c[i][2] = a[i][0] * b[0][2] + a[i][1] * b[1][2] + a[i][2] * b[2][2];
+    }
+    return c_;
+}
+template<typename _T>
+inline MatrixMxN<4, 4, _T> multiply(const MatrixMxN<4, 4, _T>& a_, const MatrixMxN<4, 4, _T>& b_) noexcept
+{
+    const auto& a = a_.mRaw;
+    const auto& b = b_.mRaw;
+    MatrixMxN<4, 4, _T> c_;
+    auto& c = c_.mRaw;
+    for (size_t i = 0; i < 4; i++)
+    {
+        c[i][0] = a[i][0] * b[0][0] + a[i][1] * b[1][0] + a[i][2] * b[2][0] + a[i][3] * b[3][0];
+        c[i][1] = a[i][0] * b[0][1] + a[i][1] * b[1][1] + a[i][2] * b[2][1] + a[i][3] * b[3][1];
+        c[i][2] = a[i][0] * b[0][2] + a[i][1] * b[1][2] + a[i][2] * b[2][2] + a[i][3] * b[3][2];
+        c[i][3] = a[i][0] * b[0][3] + a[i][1] * b[1][3] + a[i][2] * b[2][3] + a[i][3] * b[3][3];
+    }
+    return c_;
+}
+
+template<typename _T>
+inline MatrixMxN<2, 1, _T> multiply(const MatrixMxN<2, 2, _T>& a_, const MatrixMxN<2, 1, _T>& v_) noexcept
+{
+    const auto& a = a_.mRaw;
+    const auto& v = v_.mRaw;
+    MatrixMxN<2, 1, _T> c;
+    c.mRaw[0][0] = a[0][0] * v[0][0] + a[0][1] * v[1][0];
+    c.mRaw[1][0] = a[1][0] * v[0][0] + a[1][1] * v[1][0];
+    return c;
+}
+template<typename _T>
+inline MatrixMxN<3, 1, _T> multiply(const MatrixMxN<3, 3, _T>& a_, const MatrixMxN<3, 1, _T>& v_) noexcept
+{
+    const auto& a = a_.mRaw;
+    const auto& v = v_.mRaw;
+    MatrixMxN<3, 1, _T> c;
+    c.mRaw[0][0] = a[0][0] * v[0][0] + a[0][1] * v[1][0] + a[0][2] * v[2][0];
+    c.mRaw[1][0] = a[1][0] * v[0][0] + a[1][1] * v[1][0] + a[1][2] * v[2][0];
+    c.mRaw[2][0] = a[2][0] * v[0][0] + a[2][1] * v[1][0] + a[2][2] * v[2][0];
+    return c;
+}
+template<typename _T>
+inline MatrixMxN<4, 1, _T> multiply(const MatrixMxN<4, 4, _T>& a_, const MatrixMxN<4, 1, _T>& v_) noexcept
+{
+    const auto& a = a_.mRaw;
+    const auto& v = v_.mRaw;
+    MatrixMxN<4, 1, _T> c;
+    c.mRaw[0][0] = a[0][0] * v[0][0] + a[0][1] * v[1][0] + a[0][2] * v[2][0] + a[0][3] * v[3][0];
+    c.mRaw[1][0] = a[1][0] * v[0][0] + a[1][1] * v[1][0] + a[1][2] * v[2][0] + a[1][3] * v[3][0];
+    c.mRaw[2][0] = a[2][0] * v[0][0] + a[2][1] * v[1][0] + a[2][2] * v[2][0] + a[2][3] * v[3][0];
+    c.mRaw[3][0] = a[3][0] * v[0][0] + a[3][1] * v[1][0] + a[3][2] * v[2][0] + a[3][3] * v[3][0];
+    return c;
+}
+}
+
 // A = LU
 // A*x = b(piv,:)
 // A<M, N>, x<N, P>, b<M, P>
@@ -1319,8 +1404,151 @@ template<size_t _ND, typename _T> inline
 }
 
 /*!
- *  Generalized inverse function.  This function is specialized for 2x2s
- *  and 3x3s for type double and float.
+ *  Generalized determinant method using LU decomposition
+ *
+ *  \param mx A square matrix
+ *
+ *  \code
+         double d = determinantLU<3, double>(A);
+ *  \endcode
+ *
+ */
+template<size_t _ND, typename _T> inline
+    _T determinantLU(const MatrixMxN<_ND, _ND, _T>& mx)
+{
+    std::vector<size_t> pivots(_ND);
+    const auto lu = mx.decomposeLU(pivots);
+
+    _T retval(1);
+    for (size_t i = 0; i < _ND; i++)
+    {
+        retval *= lu(i, i);
+    }
+
+    // Each row swap in the pivots flips the sign
+    for (size_t i = 0; i < _ND; i++)
+    {
+        while (pivots[i] != i)
+        {
+            std::swap(pivots[i], pivots[pivots[i]]);
+            retval = -retval;
+        }
+    }
+    return retval;
+}
+
+namespace details
+{
+template<size_t _ND, typename _T>
+inline _T determinant(const MatrixMxN<_ND, _ND, _T>& mx)
+{
+    return determinantLU<_ND, _T>(mx);
+}
+template<typename _T>
+inline _T determinant(const MatrixMxN<2, 2, _T>& mx) noexcept
+{
+    return mx[0][0] * mx[1][1] - mx[0][1] * mx[1][0];
+}
+template<typename _T>
+inline _T determinant(const MatrixMxN<3, 3, _T>& mx) noexcept
+{
+    const auto& m = mx.mRaw;
+    return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+           m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+           m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+}
+
+// 2x2 minors of the top two and bottom two rows; shared by determinant() and inverse()
+template<typename _T>
+struct Minors4x4 final
+{
+    _T s[6];
+    _T c[6];
+    explicit Minors4x4(const MatrixMxN<4, 4, _T>& mx) noexcept
+    {
+        const auto& m = mx.mRaw;
+        s[0] = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+        s[1] = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+        s[2] = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+        s[3] = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+        s[4] = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+        s[5] = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+        c[5] = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+        c[4] = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+        c[3] = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+        c[2] = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+        c[1] = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+        c[0] = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+    }
+    _T determinant() const noexcept
+    {
+        return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+    }
+};
+template<typename _T>
+inline _T determinant(const MatrixMxN<4, 4, _T>& mx) noexcept
+{
+    return Minors4x4<_T>(mx).determinant();
+}
+
+template<typename _T>
+inline MatrixMxN<4, 4, _T> inverse(const MatrixMxN<4, 4, _T>& mx)
+{
+    const Minors4x4<_T> minors(mx);
+    const auto determinant = minors.determinant();
+    if (math::linear::almostZero(determinant))
+    {
+        throw except::Exception(Ctxt("Non-invertible matrix!"));
+    }
+
+    const auto& m = mx.mRaw;
+    const auto& s = minors.s;
+    const auto& c = minors.c;
+    MatrixMxN<4, 4, _T> inv;
+    inv[0][0] =  m[1][1] * c[5] - m[1][2] * c[4] + m[1][3] * c[3];
+    inv[0][1] = -m[0][1] * c[5] + m[0][2] * c[4] - m[0][3] * c[3];
+    inv[0][2] =  m[3][1] * s[5] - m[3][2] * s[4] + m[3][3] * s[3];
+    inv[0][3] = -m[2][1] * s[5] + m[2][2] * s[4] - m[2][3] * s[3];
+
+    inv[1][0] = -m[1][0] * c[5] + m[1][2] * c[2] - m[1][3] * c[1];
+    inv[1][1] =  m[0][0] * c[5] - m[0][2] * c[2] + m[0][3] * c[1];
+    inv[1][2] = -m[3][0] * s[5] + m[3][2] * s[2] - m[3][3] * s[1];
+    inv[1][3] =  m[2][0] * s[5] - m[2][2] * s[2] + m[2][3] * s[1];
+
+    inv[2][0] =  m[1][0] * c[4] - m[1][1] * c[2] + m[1][3] * c[0];
+    inv[2][1] = -m[0][0] * c[4] + m[0][1] * c[2] - m[0][3] * c[0];
+    inv[2][2] =  m[3][0] * s[4] - m[3][1] * s[2] + m[3][3] * s[0];
+    inv[2][3] = -m[2][0] * s[4] + m[2][1] * s[2] - m[2][3] * s[0];
+
+    inv[3][0] = -m[1][0] * c[3] + m[1][1] * c[1] - m[1][2] * c[0];
+    inv[3][1] =  m[0][0] * c[3] - m[0][1] * c[1] + m[0][2] * c[0];
+    inv[3][2] = -m[3][0] * s[3] + m[3][1] * s[1] - m[3][2] * s[0];
+    inv[3][3] =  m[2][0] * s[3] - m[2][1] * s[1] + m[2][2] * s[0];
+
+    inv.scale(static_cast<_T>(1) / determinant);
+    return inv;
+}
+}
+
+/*!
+ *  Determinant of a square matrix.  2x2, 3x3 and 4x4 matrices
+ *  are computed directly (cofactor expansion); other sizes
+ *  use LU decomposition.
+ *
+ *  \code
+         double d = determinant(A);
+ *  \endcode
+ */
+template<size_t _ND, typename _T> inline
+    _T determinant(const MatrixMxN<_ND, _ND, _T>& mx)
+{
+    return details::determinant(mx);
+}
+
+/*!
+ *  Generalized inverse function.  This function is specialized for 2x2s,
+ *  3x3s and 4x4s for type double and float.
  *
  *  \code      
          Matrix<3, 3> Ainv = inverse<3, double>(A);
@@ -1356,6 +1584,18 @@ template<> inline
 template<> inline
     MatrixMxN<3, 3, float> inverse<3, float>(const MatrixMxN<3, 3, float>& mx);
 
+template<> inline
+    MatrixMxN<4, 4, double> inverse<4, double>(const MatrixMxN<4, 4, double>& mx)
+{
+    return details::inverse(mx);
+}
+
+template<> inline
+    MatrixMxN<4, 4, float> inverse<4, float>(const MatrixMxN<4, 4, float>& mx)
+{
+    return details::inverse(mx);
+}
+
 /*!
  *  Could possibly be more clever here, and template the actual matrix
  */
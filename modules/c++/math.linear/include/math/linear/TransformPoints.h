@@ -0,0 +1,150 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_math_linear_TransformPoints_h_INCLUDED_
+#define CODA_OSS_math_linear_TransformPoints_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <algorithm>
+
+#include "coda_oss/span.h"
+#include "except/Exception.h"
+#include "math/linear/MatrixMxN.h"
+#include "math/linear/VectorN.h"
+
+namespace math
+{
+namespace linear
+{
+namespace details
+{
+template<typename T> struct identity final { using type = T; }; // stop template argument deduction
+
+// The structure-of-arrays loop: no dependencies between points, so it vectorizes.
+template<typename _T>
+inline void transformPoints(const MatrixMxN<3, 3, _T>& mx, const VectorN<3, _T>& translation,
+                            const _T* x, const _T* y, const _T* z,
+                            _T* outX, _T* outY, _T* outZ, size_t n) noexcept
+{
+    const auto m00 = mx[0][0], m01 = mx[0][1], m02 = mx[0][2];
+    const auto m10 = mx[1][0], m11 = mx[1][1], m12 = mx[1][2];
+    const auto m20 = mx[2][0], m21 = mx[2][1], m22 = mx[2][2];
+    const auto t0 = translation[0], t1 = translation[1], t2 = translation[2];
+    for (size_t i = 0; i < n; i++)
+    {
+        const auto x_ = x[i], y_ = y[i], z_ = z[i]; // outputs may be the inputs
+        outX[i] = m00 * x_ + m01 * y_ + m02 * z_ + t0;
+        outY[i] = m10 * x_ + m11 * y_ + m12 * z_ + t1;
+        outZ[i] = m20 * x_ + m21 * y_ + m22 * z_ + t2;
+    }
+}
+
+inline void checkSizes(size_t expected, size_t actual)
+{
+    if (expected != actual)
+    {
+        throw except::Exception(Ctxt("Points and output must be the same size"));
+    }
+}
+}
+
+/*!
+ *  Apply one 3x3 matrix (e.g., an ECEF to ENU rotation) and an
+ *  optional translation to many points stored as x, y and z arrays:
+ *    out[i] = mx * (x[i], y[i], z[i]) + translation
+ *
+ *  This is the fast layout: the loop vectorizes.  The outputs may be
+ *  the same arrays as the inputs.
+ *
+ *  \throw except::Exception if the arrays aren't all the same size
+ */
+template<typename _T>
+inline void transformPoints(const MatrixMxN<3, 3, _T>& mx, const VectorN<3, _T>& translation,
+                            coda_oss::span<const typename details::identity<_T>::type> x,
+                            coda_oss::span<const typename details::identity<_T>::type> y,
+                            coda_oss::span<const typename details::identity<_T>::type> z,
+                            coda_oss::span<typename details::identity<_T>::type> outX,
+                            coda_oss::span<typename details::identity<_T>::type> outY,
+                            coda_oss::span<typename details::identity<_T>::type> outZ)
+{
+    details::checkSizes(x.size(), y.size());
+    details::checkSizes(x.size(), z.size());
+    details::checkSizes(x.size(), outX.size());
+    details::checkSizes(x.size(), outY.size());
+    details::checkSizes(x.size(), outZ.size());
+    details::transformPoints(mx, translation, x.data(), y.data(), z.data(),
+                             outX.data(), outY.data(), outZ.data(), x.size());
+}
+
+/*!
+ *  As above, but for VectorN<3> points: out[i] = mx * points[i] + translation.
+ *
+ *  Points are copied (a block at a time) into x, y and z arrays, transformed
+ *  and copied back, which is faster than a matrix-vector product per point.
+ *  points and out may be the same.
+ *
+ *  \throw except::Exception if points and out aren't the same size
+ */
+template<typename _T>
+inline void transformPoints(const MatrixMxN<3, 3, _T>& mx, const VectorN<3, _T>& translation,
+                            coda_oss::span<const VectorN<3, typename details::identity<_T>::type>> points,
+                            coda_oss::span<VectorN<3, typename details::identity<_T>::type>> out)
+{
+    details::checkSizes(points.size(), out.size());
+
+    constexpr size_t blockSize = 256; // 3 * 256 * sizeof(double) is 6K; stays in L1
+    _T x[blockSize], y[blockSize], z[blockSize];
+    for (size_t begin = 0; begin < points.size(); begin += blockSize)
+    {
+        const auto n = std::min(blockSize, points.size() - begin);
+        const auto pPoints = points.data() + begin;
+        for (size_t i = 0; i < n; i++)
+        {
+            x[i] = pPoints[i][0];
+            y[i] = pPoints[i][1];
+            z[i] = pPoints[i][2];
+        }
+
+        details::transformPoints(mx, translation, x, y, z, x, y, z, n);
+
+        const auto pOut = out.data() + begin;
+        for (size_t i = 0; i < n; i++)
+        {
+            pOut[i][0] = x[i];
+            pOut[i][1] = y[i];
+            pOut[i][2] = z[i];
+        }
+    }
+}
+template<typename _T>
+inline void transformPoints(const MatrixMxN<3, 3, _T>& mx,
+                            coda_oss::span<const VectorN<3, typename details::identity<_T>::type>> points,
+                            coda_oss::span<VectorN<3, typename details::identity<_T>::type>> out)
+{
+    transformPoints(mx, VectorN<3, _T>(static_cast<_T>(0)), points, out);
+}
+}
+}
+
+#endif  // CODA_OSS_math_linear_TransformPoints_h_INCLUDED_
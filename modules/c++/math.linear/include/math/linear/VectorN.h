@@ -69,10 +69,7 @@ public:
      *  Copy a vector from another vector
      *
      */
-    VectorN(const VectorN& v)
-    {
-        mRaw = v.mRaw;
-    }
+    VectorN(const VectorN& v) = default;
 
     /*!
      *  Initialize from a one dimensional
@@ -126,14 +123,7 @@ public:
     /*!
      *  Assignment operator from a VectorN
      */
-    VectorN& operator=(const VectorN& v)
-    {
-        if (this != &v)
-        {
-            mRaw = v.mRaw;
-        }
-        return *this;
-    }
+    VectorN& operator=(const VectorN& v) = default;
 
     /*!
      *  Assign a single scalar value into
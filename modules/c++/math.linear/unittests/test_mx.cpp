@@ -603,6 +603,115 @@ TEST_CASE(testArithmeticMxN)
     
 }
 
+template<size_t N>
+static math::linear::MatrixMxN<N, N> makeMatrix(double seed)
+{
+    math::linear::MatrixMxN<N, N> retval;
+    foreach_ij(N, N)
+    {
+        retval(i, j) = std::sin(seed + i * 1.3 + j * 0.7) * 10.0 + (i == j ? 5.0 : 0.0);
+    }
+    return retval;
+}
+
+template<size_t N>
+static void testSmallMultiply(const std::string& testName)
+{
+    using namespace math::linear;
+    const auto A = makeMatrix<N>(0.1);
+    const auto B = makeMatrix<N>(2.3);
+
+    // the unrolled code sums in the same order as the loops, so exactly equal
+    const MatrixMxN<N, N> C = A * B;
+    const auto expected = details::multiply<N, N, N, double>(A, B);
+    foreach_ij(N, N)
+    {
+        TEST_ASSERT_EQ(C(i, j), expected(i, j));
+    }
+
+    VectorN<N> v;
+    for (size_t i = 0; i < N; i++)
+    {
+        v[i] = i * 2.5 - 1.0;
+    }
+    const VectorN<N> Av = A * v;
+    const auto expectedV = details::multiply<N, N, 1, double>(A, v.matrix());
+    for (size_t i = 0; i < N; i++)
+    {
+        TEST_ASSERT_EQ(Av[i], expectedV(i, 0));
+    }
+}
+TEST_CASE(testMultiplySmall)
+{
+    testSmallMultiply<2>(testName);
+    testSmallMultiply<3>(testName);
+    testSmallMultiply<4>(testName);
+    testSmallMultiply<5>(testName);
+}
+
+template<size_t N>
+static void testDeterminant_(const std::string& testName)
+{
+    using namespace math::linear;
+    const auto A = makeMatrix<N>(0.4);
+    const auto det = determinant(A);
+    TEST_ASSERT_ALMOST_EQ_EPS(det, determinantLU(A), std::abs(det) * 1e-12);
+    TEST_ASSERT_ALMOST_EQ_EPS(determinant(A * A), det * det, std::abs(det * det) * 1e-12);
+
+    const auto Ainv = inverse(A);
+    TEST_ASSERT_ALMOST_EQ_EPS(determinant(Ainv), 1.0 / det, std::abs(1.0 / det) * 1e-12);
+    const auto I = identityMatrix<N, double>();
+    const MatrixMxN<N, N> AAinv = A * Ainv;
+    foreach_ij(N, N)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(AAinv(i, j), I(i, j), 1e-12);
+    }
+}
+TEST_CASE(testDeterminant)
+{
+    using namespace math::linear;
+    testDeterminant_<2>(testName);
+    testDeterminant_<3>(testName);
+    testDeterminant_<4>(testName);
+    testDeterminant_<5>(testName);
+
+    double m[] =
+    {
+        1, 2, 3, 4,
+        0, 1, 2, 3,
+        2, 0, 1, 5,
+        1, 1, 0, 1
+    };
+    const Matrix4x4 M(m);
+    TEST_ASSERT_ALMOST_EQ(determinant(M), 9.0);
+    TEST_ASSERT_ALMOST_EQ(determinantLU(M), 9.0);
+
+    // swapping two rows flips the sign
+    Matrix4x4 swapped(M);
+    swapped.row(0, M.row(3));
+    swapped.row(3, M.row(0));
+    TEST_ASSERT_ALMOST_EQ(determinant(swapped), -9.0);
+    TEST_ASSERT_ALMOST_EQ(determinantLU(swapped), -9.0);
+}
+
+TEST_CASE(testInvert4x4Singular)
+{
+    using namespace math::linear;
+    double m[] =
+    {
+        1, 2, 3, 4,
+        0, 1, 2, 3,
+        0, 1, 2, 3,
+        1, 1, 0, 1
+    };
+    TEST_THROWS(inverse(Matrix4x4(m)));
+
+    const MatrixMxN<4, 4, float> F(1.0f);
+    TEST_THROWS(inverse(F));
+    const auto I = identityMatrix<4, float>();
+    TEST_ASSERT_EQ(inverse(I), I);
+}
+
 TEST_MAIN(
     TEST_CHECK(testIdentityMxN);
     TEST_CHECK(testScaleMultiplyMxN);
@@ -622,4 +731,7 @@ TEST_MAIN(
     TEST_CHECK(testOrthoTranspose5x5);
     TEST_CHECK(testNegateMxN);
     TEST_CHECK(testNegate);
+    TEST_CHECK(testMultiplySmall);
+    TEST_CHECK(testDeterminant);
+    TEST_CHECK(testInvert4x4Singular);
     )
@@ -0,0 +1,129 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "math/linear/TransformPoints.h"
+#include "TestCase.h"
+
+using Vector3 = math::linear::VectorN<3>;
+using Matrix3x3 = math::linear::MatrixMxN<3, 3>;
+
+static Matrix3x3 makeRotation()
+{
+    // ECEF to ENU at (lat, lon)
+    const double lat = 0.6, lon = -1.3;
+    const double sinLat = std::sin(lat), cosLat = std::cos(lat);
+    const double sinLon = std::sin(lon), cosLon = std::cos(lon);
+    const double m[] =
+    {
+        -sinLon,          cosLon,          0.0,
+        -sinLat * cosLon, -sinLat * sinLon, cosLat,
+         cosLat * cosLon,  cosLat * sinLon, sinLat
+    };
+    return Matrix3x3(m);
+}
+
+static std::vector<Vector3> makePoints(size_t n)
+{
+    std::vector<Vector3> retval(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        retval[i][0] = 6378137.0 + i * 3.0;
+        retval[i][1] = -1000.0 * std::cos(i * 0.1);
+        retval[i][2] = 20.0 * i - 5000.0;
+    }
+    return retval;
+}
+
+TEST_CASE(testTransformPoints)
+{
+    const auto R = makeRotation();
+    Vector3 t;
+    t[0] = 1.0; t[1] = -2.0; t[2] = 3.5;
+
+    // more than one block, and a partial block
+    for (const size_t n : {0, 1, 7, 256, 1000})
+    {
+        const auto points = makePoints(n);
+        std::vector<Vector3> out(n);
+        math::linear::transformPoints(R, t, points, out);
+        for (size_t i = 0; i < n; i++)
+        {
+            const Vector3 expected = R * points[i] + t;
+            for (size_t j = 0; j < 3; j++)
+            {
+                TEST_ASSERT_ALMOST_EQ_EPS(out[i][j], expected[j], 1e-8);
+            }
+        }
+
+        // in-place, no translation
+        auto inPlace = points;
+        math::linear::transformPoints(R, inPlace, inPlace);
+        for (size_t i = 0; i < n; i++)
+        {
+            const Vector3 expected = R * points[i];
+            for (size_t j = 0; j < 3; j++)
+            {
+                TEST_ASSERT_ALMOST_EQ_EPS(inPlace[i][j], expected[j], 1e-8);
+            }
+        }
+    }
+}
+
+TEST_CASE(testTransformPointsSoA)
+{
+    const auto R = makeRotation();
+    Vector3 t;
+    t[0] = 10.0; t[1] = 20.0; t[2] = 30.0;
+
+    const auto points = makePoints(301);
+    std::vector<double> x, y, z;
+    for (const auto& p : points)
+    {
+        x.push_back(p[0]);
+        y.push_back(p[1]);
+        z.push_back(p[2]);
+    }
+    std::vector<Vector3> expected(points.size());
+    math::linear::transformPoints(R, t, points, expected);
+
+    std::vector<double> outX(x.size()), outY(y.size()), outZ(z.size());
+    math::linear::transformPoints(R, t, x, y, z, outX, outY, outZ);
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        TEST_ASSERT_EQ(outX[i], expected[i][0]);
+        TEST_ASSERT_EQ(outY[i], expected[i][1]);
+        TEST_ASSERT_EQ(outZ[i], expected[i][2]);
+    }
+
+    outZ.pop_back();
+    TEST_THROWS(math::linear::transformPoints(R, t, x, y, z, outX, outY, outZ));
+    std::vector<Vector3> tooSmall(points.size() - 1);
+    TEST_THROWS(math::linear::transformPoints(R, points, tooSmall));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testTransformPoints);
+    TEST_CHECK(testTransformPointsSoA);
+    )
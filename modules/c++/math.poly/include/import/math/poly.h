@@ -28,5 +28,6 @@
 #include "math/poly/Fixed1D.h"
 #include "math/poly/Fixed2D.h"
 #include "math/poly/Fit.h"
+#include "math/poly/Fitter.h"
 
 #endif  // __MATH_POLY_H__
@@ -0,0 +1,581 @@
+/* =========================================================================
+ * This file is part of math.poly-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * math.poly-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_math_poly_Fitter_h_INCLUDED_
+#define CODA_OSS_math_poly_Fitter_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <sstream>
+#include <vector>
+
+#include "coda_oss/span.h"
+#include "except/Exception.h"
+#include "sys/Parallel.h"
+#include "math/poly/OneD.h"
+#include "math/poly/TwoD.h"
+
+namespace math
+{
+namespace poly
+{
+namespace details
+{
+/*!
+ *  The weighted normal equations (A' W A) c = A' W b for a least-squares
+ *  fit with P terms, accumulated a block of observations at a time so that
+ *  millions of observations never need an explicit design matrix.  Two
+ *  accumulations (e.g., from different threads) add with merge().
+ */
+class NormalEquations final
+{
+    size_t mTerms = 0;
+    std::vector<double> mAtA; // P x P, only the upper triangle is used
+    std::vector<double> mAtb; // P
+    size_t mCount = 0; // observations with a non-zero weight
+
+public:
+    explicit NormalEquations(size_t terms) : mTerms(terms), mAtA(terms * terms), mAtb(terms)
+    {
+    }
+
+    size_t terms() const noexcept
+    {
+        return mTerms;
+    }
+    size_t count() const noexcept
+    {
+        return mCount;
+    }
+
+    /*!
+     *  Add n observations.  columns is P x n: term p of observation i is
+     *  columns[p * n + i].  weights is either n values or nullptr (all 1).
+     */
+    void add(const double* columns, const double* b, const double* weights, size_t n)
+    {
+        std::vector<double> weighted(n);
+        for (size_t p = 0; p < mTerms; p++)
+        {
+            const auto colP = columns + p * n;
+            for (size_t i = 0; i < n; i++)
+            {
+                weighted[i] = weights == nullptr ? colP[i] : colP[i] * weights[i];
+            }
+
+            // dot products of contiguous arrays: these loops vectorize
+            for (size_t q = p; q < mTerms; q++)
+            {
+                const auto colQ = columns + q * n;
+                double sum = 0.0;
+                for (size_t i = 0; i < n; i++)
+                {
+                    sum += weighted[i] * colQ[i];
+                }
+                mAtA[p * mTerms + q] += sum;
+            }
+
+            double sum = 0.0;
+            for (size_t i = 0; i < n; i++)
+            {
+                sum += weighted[i] * b[i];
+            }
+            mAtb[p] += sum;
+        }
+
+        if (weights == nullptr)
+        {
+            mCount += n;
+        }
+        else
+        {
+            mCount += std::count_if(weights, weights + n, [](double w) { return w != 0.0; });
+        }
+    }
+
+    void merge(const NormalEquations& other)
+    {
+        if (other.mTerms != mTerms)
+        {
+            throw except::Exception(Ctxt("Can't merge fits with different orders"));
+        }
+        std::transform(mAtA.begin(), mAtA.end(), other.mAtA.begin(), mAtA.begin(), std::plus<double>());
+        std::transform(mAtb.begin(), mAtb.end(), other.mAtb.begin(), mAtb.begin(), std::plus<double>());
+        mCount += other.mCount;
+    }
+
+    /*!
+     *  Solve with a Cholesky factorization, A' W A = L L'.  Unlike forming
+     *  the inverse, this is backward stable for the (symmetric, positive
+     *  definite) normal equations.
+     *
+     *  \throw except::Exception if there are fewer observations than terms,
+     *  or the system is singular (e.g., all the points are on a line)
+     */
+    std::vector<double> solve() const
+    {
+        if (mCount < mTerms)
+        {
+            std::ostringstream excSS;
+            excSS << "Not enough points for a unique fit solution (" << mCount
+                  << " points for a " << mTerms << "-coefficient fit)!";
+            throw except::Exception(Ctxt(excSS));
+        }
+
+        // L is lower-triangular, row-major; A' W A is the upper triangle of mAtA.
+        const auto P = mTerms;
+        std::vector<double> L(P * P);
+        for (size_t j = 0; j < P; j++)
+        {
+            double d = mAtA[j * P + j];
+            for (size_t k = 0; k < j; k++)
+            {
+                d -= L[j * P + k] * L[j * P + k];
+            }
+            // relative to the diagonal: the columns are normalized, so this is a condition number check
+            if (!(d > mAtA[j * P + j] * 1e-14))
+            {
+                throw except::Exception(Ctxt("Singular system; the points don't determine a unique fit"));
+            }
+            const auto Ljj = std::sqrt(d);
+            L[j * P + j] = Ljj;
+
+            for (size_t i = j + 1; i < P; i++)
+            {
+                double s = mAtA[j * P + i];
+                for (size_t k = 0; k < j; k++)
+                {
+                    s -= L[i * P + k] * L[j * P + k];
+                }
+                L[i * P + j] = s / Ljj;
+            }
+        }
+
+        // L y = A' W b, then L' c = y
+        std::vector<double> c(mAtb);
+        for (size_t i = 0; i < P; i++)
+        {
+            for (size_t k = 0; k < i; k++)
+            {
+                c[i] -= L[i * P + k] * c[k];
+            }
+            c[i] /= L[i * P + i];
+        }
+        for (size_t i = P; i-- > 0;)
+        {
+            for (size_t k = i + 1; k < P; k++)
+            {
+                c[i] -= L[k * P + i] * c[k];
+            }
+            c[i] /= L[i * P + i];
+        }
+        return c;
+    }
+};
+
+inline void checkSizes(size_t expected, size_t actual)
+{
+    if (expected != actual)
+    {
+        throw except::Exception(Ctxt("Observation arrays must be equally sized"));
+    }
+}
+
+// Observations are accumulated this many at a time.
+constexpr size_t fitBlockSize = 256;
+
+// Mean and 1/RMS about the mean; the same normalization as fit().
+inline void meanAndScale(coda_oss::span<const double> x, double& mean, double& scale)
+{
+    mean = std::accumulate(x.begin(), x.end(), 0.0) / static_cast<double>(x.size());
+    double sumSq = 0.0;
+    for (const auto v : x)
+    {
+        sumSq += (v - mean) * (v - mean);
+    }
+    scale = sumSq > 0.0 ? 1.0 / std::sqrt(sumSq / static_cast<double>(x.size())) : 1.0;
+}
+}
+
+/*!
+ *  \class OneDFitter
+ *  \brief Incremental (weighted) least-squares fit of a OneD polynomial
+ *
+ *  Observations can be added a few at a time, e.g., while reading tie-points,
+ *  and fitters that saw different observations can be combined with merge().
+ *  Only the (order+1) x (order+1) normal equations are kept; they're solved
+ *  with a Cholesky factorization rather than an explicit inverse.
+ *
+ *  For good conditioning, x is used as (x - center) * scale internally; fit()
+ *  uses the mean and 1/RMS.  The returned polynomial is in terms of x.
+ *
+ *  \code
+        math::poly::OneDFitter fitter(3, center, scale);
+        fitter.add(x, y);
+        fitter.add(moreX, moreY, moreWeights);
+        const math::poly::OneD<double> poly = fitter.solve();
+ *  \endcode
+ */
+class OneDFitter final
+{
+    size_t mOrder;
+    double mCenter;
+    double mScale;
+    details::NormalEquations mEquations;
+
+public:
+    OneDFitter(size_t order, double center = 0.0, double scale = 1.0) :
+        mOrder(order), mCenter(center), mScale(scale), mEquations(order + 1)
+    {
+    }
+
+    size_t order() const noexcept
+    {
+        return mOrder;
+    }
+
+    //! The number of observations (with a non-zero weight) added so far
+    size_t size() const noexcept
+    {
+        return mEquations.count();
+    }
+
+    //! Add one observation y = f(x) with an optional weight (e.g., 1/variance)
+    void add(double x, double y, double weight = 1.0)
+    {
+        add(coda_oss::span<const double>(&x, 1), coda_oss::span<const double>(&y, 1),
+            coda_oss::span<const double>(&weight, 1));
+    }
+
+    /*!
+     *  Add observations y[i] = f(x[i]) with weights[i]; weights may be empty
+     *  for all 1.
+     *
+     *  \throw except::Exception if the arrays aren't the same size
+     */
+    void add(coda_oss::span<const double> x, coda_oss::span<const double> y,
+             coda_oss::span<const double> weights = coda_oss::span<const double>())
+    {
+        details::checkSizes(x.size(), y.size());
+        if (!weights.empty())
+        {
+            details::checkSizes(x.size(), weights.size());
+        }
+
+        const auto P = mOrder + 1;
+        std::vector<double> columns(P * details::fitBlockSize);
+        for (size_t begin = 0; begin < x.size(); begin += details::fitBlockSize)
+        {
+            const auto n = std::min(details::fitBlockSize, x.size() - begin);
+            for (size_t i = 0; i < n; i++)
+            {
+                const auto u = (x[begin + i] - mCenter) * mScale;
+                double uacc = 1.0;
+                for (size_t p = 0; p < P; p++)
+                {
+                    columns[p * n + i] = uacc;
+                    uacc *= u;
+                }
+            }
+            mEquations.add(columns.data(), y.data() + begin,
+                           weights.empty() ? nullptr : weights.data() + begin, n);
+        }
+    }
+
+    /*!
+     *  Combine the observations from another fitter, e.g., one per thread.
+     *
+     *  \throw except::Exception if the order or normalization differs
+     */
+    void merge(const OneDFitter& other)
+    {
+        if ((other.mCenter != mCenter) || (other.mScale != mScale))
+        {
+            throw except::Exception(Ctxt("Can't merge fits with different normalizations"));
+        }
+        mEquations.merge(other.mEquations);
+    }
+
+    /*!
+     *  The least-squares polynomial for the observations so far.
+     *
+     *  \throw except::Exception if there aren't enough observations
+     */
+    OneD<double> solve() const
+    {
+        const auto c = mEquations.solve();
+
+        // Remove the normalization scaling ...
+        OneD<double> poly(mOrder);
+        double uacc = 1.0;
+        for (size_t i = 0; i <= mOrder; i++)
+        {
+            poly[i] = c[i] * uacc;
+            uacc *= mScale;
+        }
+
+        // ... and shift the polynomial back from its centered offset
+        OneD<double> shift(1);
+        shift[0] = -mCenter;
+        shift[1] = 1;
+        return poly.transformInput(shift);
+    }
+};
+
+/*!
+ *  \class TwoDFitter
+ *  \brief Incremental (weighted) least-squares fit of a TwoD polynomial
+ *
+ *  As OneDFitter, for z = f(x, y) with orders nx and ny; the normal equations
+ *  are (nx+1)(ny+1) square.
+ */
+class TwoDFitter final
+{
+    size_t mOrderX;
+    size_t mOrderY;
+    double mCenterX;
+    double mScaleX;
+    double mCenterY;
+    double mScaleY;
+    details::NormalEquations mEquations;
+
+public:
+    TwoDFitter(size_t nx, size_t ny, double centerX = 0.0, double scaleX = 1.0,
+               double centerY = 0.0, double scaleY = 1.0) :
+        mOrderX(nx), mOrderY(ny), mCenterX(centerX), mScaleX(scaleX), mCenterY(centerY), mScaleY(scaleY),
+        mEquations((nx + 1) * (ny + 1))
+    {
+    }
+
+    size_t orderX() const noexcept
+    {
+        return mOrderX;
+    }
+    size_t orderY() const noexcept
+    {
+        return mOrderY;
+    }
+
+    //! The number of observations (with a non-zero weight) added so far
+    size_t size() const noexcept
+    {
+        return mEquations.count();
+    }
+
+    //! Add one observation z = f(x, y) with an optional weight
+    void add(double x, double y, double z, double weight = 1.0)
+    {
+        add(coda_oss::span<const double>(&x, 1), coda_oss::span<const double>(&y, 1),
+            coda_oss::span<const double>(&z, 1), coda_oss::span<const double>(&weight, 1));
+    }
+
+    /*!
+     *  Add observations z[i] = f(x[i], y[i]) with weights[i]; weights may be
+     *  empty for all 1.
+     *
+     *  \throw except::Exception if the arrays aren't the same size
+     */
+    void add(coda_oss::span<const double> x, coda_oss::span<const double> y, coda_oss::span<const double> z,
+             coda_oss::span<const double> weights = coda_oss::span<const double>())
+    {
+        details::checkSizes(x.size(), y.size());
+        details::checkSizes(x.size(), z.size());
+        if (!weights.empty())
+        {
+            details::checkSizes(x.size(), weights.size());
+        }
+
+        const auto P = (mOrderX + 1) * (mOrderY + 1);
+        std::vector<double> columns(P * details::fitBlockSize);
+        for (size_t begin = 0; begin < x.size(); begin += details::fitBlockSize)
+        {
+            const auto n = std::min(details::fitBlockSize, x.size() - begin);
+            for (size_t i = 0; i < n; i++)
+            {
+                // Same term order as fit(): p = k * (ny + 1) + l for x^k y^l
+                const auto u = (x[begin + i] - mCenterX) * mScaleX;
+                const auto v = (y[begin + i] - mCenterY) * mScaleY;
+                size_t p = 0;
+                double uacc = 1.0;
+                for (size_t k = 0; k <= mOrderX; k++)
+                {
+                    double vacc = 1.0;
+                    for (size_t l = 0; l <= mOrderY; l++, p++)
+                    {
+                        columns[p * n + i] = uacc * vacc;
+                        vacc *= v;
+                    }
+                    uacc *= u;
+                }
+            }
+            mEquations.add(columns.data(), z.data() + begin,
+                           weights.empty() ? nullptr : weights.data() + begin, n);
+        }
+    }
+
+    /*!
+     *  Combine the observations from another fitter, e.g., one per thread.
+     *
+     *  \throw except::Exception if the orders or normalization differ
+     */
+    void merge(const TwoDFitter& other)
+    {
+        if ((other.mOrderX != mOrderX) || (other.mCenterX != mCenterX) || (other.mScaleX != mScaleX) ||
+            (other.mCenterY != mCenterY) || (other.mScaleY != mScaleY))
+        {
+            throw except::Exception(Ctxt("Can't merge fits with different orders or normalizations"));
+        }
+        mEquations.merge(other.mEquations);
+    }
+
+    /*!
+     *  The least-squares polynomial for the observations so far.
+     *
+     *  \throw except::Exception if there aren't enough observations
+     */
+    TwoD<double> solve() const
+    {
+        const auto c = mEquations.solve();
+
+        // Remove the normalization scaling ...
+        TwoD<double> coeffs(mOrderX, mOrderY);
+        double xacc = 1.0;
+        size_t p = 0;
+        for (size_t i = 0; i <= mOrderX; i++)
+        {
+            double yacc = 1.0;
+            for (size_t j = 0; j <= mOrderY; j++, p++)
+            {
+                coeffs[i][j] = c[p] * (xacc * yacc);
+                yacc *= mScaleY;
+            }
+            xacc *= mScaleX;
+        }
+
+        // ... and shift the polynomial back from its centered offset
+        TwoD<double> xShift(1, 1);
+        TwoD<double> yShift(1, 1);
+        xShift[0][0] = -mCenterX;
+        xShift[1][0] = 1;
+        yShift[0][0] = -mCenterY;
+        yShift[0][1] = 1;
+        return coeffs.transformInput(xShift, yShift);
+    }
+};
+
+namespace details
+{
+/*!
+ *  Split [0, n) with sys::splitForThreads(), add(fitter, begin, count) into
+ *  a copy of empty for each piece (in sys::parallel()), then merge the
+ *  pieces in order so that the result doesn't depend on thread timing.
+ */
+template <typename TFitter, typename TFunc>
+TFitter fit_par(size_t n, size_t numThreads, const TFitter& empty, TFunc add)
+{
+    constexpr size_t minimumPerThread = 16 * fitBlockSize; // not worth starting a thread for less
+    const auto pieces = sys::splitForThreads(n, numThreads, minimumPerThread);
+
+    std::vector<TFitter> fitters(pieces.size(), empty);
+    sys::parallel(pieces.size(), [&](size_t ii) {
+        add(fitters[ii], pieces[ii].first, pieces[ii].second - pieces[ii].first);
+    });
+
+    auto retval = std::move(fitters[0]);
+    for (size_t ii = 1; ii < fitters.size(); ++ii)
+    {
+        retval.merge(fitters[ii]);
+    }
+    return retval;
+}
+}
+
+/*!
+ *  Weighted least-squares fit of y = f(x) split across threads: each thread
+ *  accumulates a OneDFitter over part of the data, and the results are
+ *  merged and solved.  x is normalized by its mean and RMS, as with fit().
+ *
+ *  \param weights Per-observation weights, or empty for all 1
+ *  \param numThreads Number of threads; 0 (the default) for the number of CPUs
+ *  \throw except::Exception if the arrays aren't equally sized or there
+ *  aren't enough points
+ */
+inline OneD<double> fit_par(coda_oss::span<const double> x, coda_oss::span<const double> y,
+                            coda_oss::span<const double> weights, size_t order, size_t numThreads = 0)
+{
+    details::checkSizes(x.size(), y.size());
+    if (!weights.empty())
+    {
+        details::checkSizes(x.size(), weights.size());
+    }
+
+    double center = 0.0, scale = 1.0;
+    if (!x.empty())
+    {
+        details::meanAndScale(x, center, scale);
+    }
+
+    const OneDFitter empty(order, center, scale);
+    const auto fitters = details::fit_par(x.size(), numThreads, empty, [&](OneDFitter& fitter, size_t begin, size_t n) {
+        fitter.add(x.subspan(begin, n), y.subspan(begin, n), weights.empty() ? weights : weights.subspan(begin, n));
+    });
+    return fitters.solve();
+}
+
+/*!
+ *  Weighted least-squares fit of z = f(x, y) split across threads; see
+ *  fit_par() for OneD.
+ */
+inline TwoD<double> fit_par(coda_oss::span<const double> x, coda_oss::span<const double> y,
+                            coda_oss::span<const double> z, coda_oss::span<const double> weights,
+                            size_t nx, size_t ny, size_t numThreads = 0)
+{
+    details::checkSizes(x.size(), y.size());
+    details::checkSizes(x.size(), z.size());
+    if (!weights.empty())
+    {
+        details::checkSizes(x.size(), weights.size());
+    }
+
+    double centerX = 0.0, scaleX = 1.0, centerY = 0.0, scaleY = 1.0;
+    if (!x.empty())
+    {
+        details::meanAndScale(x, centerX, scaleX);
+        details::meanAndScale(y, centerY, scaleY);
+    }
+
+    const TwoDFitter empty(nx, ny, centerX, scaleX, centerY, scaleY);
+    const auto fitters = details::fit_par(x.size(), numThreads, empty, [&](TwoDFitter& fitter, size_t begin, size_t n) {
+        fitter.add(x.subspan(begin, n), y.subspan(begin, n), z.subspan(begin, n),
+                   weights.empty() ? weights : weights.subspan(begin, n));
+    });
+    return fitters.solve();
+}
+}
+}
+
+#endif  // CODA_OSS_math_poly_Fitter_h_INCLUDED_
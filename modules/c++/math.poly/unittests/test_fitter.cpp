@@ -0,0 +1,205 @@
+/* =========================================================================
+ * This file is part of math.poly-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * math.poly-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <import/math/poly.h>
+#include "TestCase.h"
+
+namespace
+{
+std::vector<double> makeX(size_t n, double offset, double spacing)
+{
+    std::vector<double> retval(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        retval[i] = offset + spacing * i + std::sin(i * 1.7); // not quite a grid
+    }
+    return retval;
+}
+
+TEST_CASE(testOneDFitter)
+{
+    const double coeffs[] = { 5, -4, 3, -1 };
+    const math::poly::OneD<double> truth(3, coeffs);
+
+    const auto x = makeX(100000, -5.0, 1e-4);
+    std::vector<double> y(x.size());
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        y[i] = truth(x[i]);
+    }
+
+    // serial, and in pieces that are merged
+    math::poly::OneDFitter fitter(3, 0.0, 0.2);
+    fitter.add(x, y);
+    TEST_ASSERT_EQ(fitter.size(), x.size());
+    math::poly::OneDFitter first(3, 0.0, 0.2), second(3, 0.0, 0.2);
+    const coda_oss::span<const double> x_(x.data(), x.size()), y_(y.data(), y.size());
+    first.add(x_.subspan(0, 1000), y_.subspan(0, 1000));
+    second.add(x_.subspan(1000), y_.subspan(1000));
+    first.merge(second);
+
+    const auto poly = fitter.solve();
+    const auto merged = first.solve();
+    const auto parallel = math::poly::fit_par(x, y, {}, 3, 4);
+    TEST_ASSERT_EQ(poly.order(), static_cast<size_t>(3));
+    for (size_t i = 0; i <= 3; i++)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(poly[i], coeffs[i], 1e-8);
+        TEST_ASSERT_ALMOST_EQ_EPS(merged[i], coeffs[i], 1e-8);
+        TEST_ASSERT_ALMOST_EQ_EPS(parallel[i], coeffs[i], 1e-8);
+    }
+
+    // the same answer as fit() for the example in the documentation
+    const double xObs[] = { 1, -1, 2, -2 };
+    const double yObs[] = { 3, 13, 1, 33 };
+    const auto expected = math::poly::fit(4, xObs, yObs, 3);
+    const auto actual = math::poly::fit_par(xObs, yObs, {}, 3);
+    for (size_t i = 0; i <= 3; i++)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(actual[i], expected[i], 1e-10);
+    }
+
+    math::poly::OneDFitter other(3, 1.0, 0.2);
+    TEST_EXCEPTION(fitter.merge(other));
+}
+
+TEST_CASE(testOneDFitterWeights)
+{
+    // a straight line, plus outliers that are given no weight
+    std::vector<double> x, y, weights;
+    for (int i = 0; i < 20; i++)
+    {
+        x.push_back(i);
+        y.push_back(2.0 * i + 1.0);
+        weights.push_back(1.0);
+        if (i % 5 == 0)
+        {
+            x.push_back(i + 0.5);
+            y.push_back(1000.0);
+            weights.push_back(0.0);
+        }
+    }
+    const auto line = math::poly::fit_par(x, y, weights, 1);
+    TEST_ASSERT_ALMOST_EQ_EPS(line[0], 1.0, 1e-10);
+    TEST_ASSERT_ALMOST_EQ_EPS(line[1], 2.0, 1e-10);
+
+    math::poly::OneDFitter fitter(1);
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        fitter.add(x[i], y[i], weights[i]);
+    }
+    TEST_ASSERT_EQ(fitter.size(), static_cast<size_t>(20)); // zero weights don't count
+    TEST_ASSERT_ALMOST_EQ_EPS(fitter.solve()[1], 2.0, 1e-10);
+
+    // weighting pulls the fit toward the heavily weighted points
+    const double xs[] = { 0, 1, 2 };
+    const double ys[] = { 0, 1, 0 };
+    const double heavy[] = { 1, 100, 1 };
+    const auto flat = math::poly::fit_par(xs, ys, {}, 0);
+    const auto pulled = math::poly::fit_par(xs, ys, heavy, 0);
+    TEST_ASSERT_ALMOST_EQ_EPS(flat[0], 1.0 / 3.0, 1e-12);
+    TEST_ASSERT_ALMOST_EQ_EPS(pulled[0], 100.0 / 102.0, 1e-12);
+}
+
+TEST_CASE(testOneDFitterErrors)
+{
+    const std::vector<double> x{1, 2, 3, 4}, y{1, 2, 3, 4}, tooShort{1, 2, 3};
+    TEST_EXCEPTION(math::poly::fit_par(x, tooShort, {}, 1));
+    TEST_EXCEPTION(math::poly::fit_par(x, y, tooShort, 1));
+    TEST_EXCEPTION(math::poly::fit_par(x, y, {}, 4)); // not enough points
+
+    const std::vector<double> same{2, 2, 2, 2};
+    TEST_EXCEPTION(math::poly::fit_par(same, y, {}, 1)); // singular
+
+    math::poly::OneDFitter fitter(2);
+    TEST_EXCEPTION(fitter.solve());
+    TEST_EXCEPTION(fitter.add(x, tooShort));
+}
+
+TEST_CASE(testTwoDFitter)
+{
+    // the same polynomial and (far from the origin) sampling as test2DPolyfitLarge
+    const double coeffs[] =
+    {
+        -1.021e-12, 7.5,    2.2,   5.5,
+         0.88,      4.825,  .52,   .69,
+         5.5,       1.0,    .62,   1.01,
+         .012,      6.32,   1.56,  .376
+    };
+    const math::poly::TwoD<double> truth(3, 3, coeffs);
+
+    const size_t gridSize = 30;
+    std::vector<double> x, y, z;
+    math::linear::Matrix2D<double> xm(gridSize, gridSize), ym(gridSize, gridSize), zm(gridSize, gridSize);
+    for (size_t i = 0; i < gridSize; i++)
+    {
+        for (size_t j = 0; j < gridSize; j++)
+        {
+            xm(i, j) = 25000.0 + i * 2134.0;
+            ym(i, j) = 42000.0 + j * 3214.0;
+            zm(i, j) = truth(i, j);
+            x.push_back(xm(i, j));
+            y.push_back(ym(i, j));
+            z.push_back(zm(i, j));
+        }
+    }
+
+    // z is as large as 1e8
+    const auto tolerance = 1e-12 * *std::max_element(z.begin(), z.end());
+    const auto expected = math::poly::fit(xm, ym, zm, 3, 3);
+    const auto actual = math::poly::fit_par(x, y, z, {}, 3, 3, 4);
+    TEST_ASSERT_EQ(actual.orderX(), static_cast<size_t>(3));
+    TEST_ASSERT_EQ(actual.orderY(), static_cast<size_t>(3));
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(actual(x[i], y[i]), z[i], tolerance);
+        TEST_ASSERT_ALMOST_EQ_EPS(expected(x[i], y[i]), z[i], tolerance);
+    }
+
+    // incrementally, one observation at a time
+    math::poly::TwoDFitter fitter(3, 3, 50000.0, 1e-4, 90000.0, 1e-4);
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        fitter.add(x[i], y[i], z[i]);
+    }
+    const auto incremental = fitter.solve();
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(incremental(x[i], y[i]), z[i], tolerance);
+    }
+
+    TEST_EXCEPTION(math::poly::fit_par(x, y, z, {}, 30, 30)); // not enough points
+    z.pop_back();
+    TEST_EXCEPTION(math::poly::fit_par(x, y, z, {}, 3, 3));
+}
+}
+
+TEST_MAIN(
+    TEST_CHECK(testOneDFitter);
+    TEST_CHECK(testOneDFitterWeights);
+    TEST_CHECK(testOneDFitterErrors);
+    TEST_CHECK(testTwoDFitter);
+    )
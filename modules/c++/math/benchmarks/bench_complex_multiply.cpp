@@ -0,0 +1,268 @@
+/* =========================================================================
+ * This file is part of math-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Users guide
+
+    Compares scaling std::complex<float> values by a (varying) real factor
+    as complex numbers and as separate real and imaginary parts, for 1000
+    to 1000000 values; "single pass" goes over that many values once,
+    "multi-pass" goes over the first 1000 again and again, so the data
+    stays in the cache.  Then compares the mem/ComplexKernels.h kernels on
+    100000 interleaved (std::complex<float>) and split (real and imaginary
+    arrays) values, with plain loops and with SIMD, against
+    std::complex<float> code.
+
+    ./bench_complex_multiply [--filter=<name>] [--json=<file>] [--quick] ...
+
+*/
+
+/*  Results (-O3, a 1-CPU VM), median per iteration:
+    scale            single pass                  multi-pass
+                     complex   real and imag.     complex   real and imag.
+    1000             1.09 us   1.04 us            1.12 us   1.19 us
+    10000            10.5 us   10.2 us            10.6 us   10.4 us
+    100000           99.1 us   104 us             114 us    113 us
+    1000000          1.07 ms   1.06 ms            1.09 ms   1.13 ms
+    The two are the same within the noise, in both modes and at every size.
+
+                     std::complex  interleaved          split
+                                   plain     SIMD       plain     SIMD
+    conjMultiply     188 us        79.3 us   67.1 us    72.0 us   81.9 us
+    power            21.5 us       20.8 us   17.1 us    15.0 us   14.9 us
+    magnitude        393 us        108 us    27.1 us    108 us    27.3 us
+    phase            1.21 ms       1.21 ms   100 us     2.38 ms   114 us
+    scaleAccumulate  45.3 us       43.5 us   30.1 us    31.5 us   27.5 us
+    interleave       49.4 us       43.1 us   41.5 us    27.2 us   24.9 us
+*/
+
+#include <complex>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mem/ComplexKernels.h>
+
+#include "Benchmark.h"
+
+static constexpr size_t numValues = 100000;
+
+namespace
+{
+// The old complexMultiplyBenchmark's "size growth count [loop]" sweep:
+// 1000 to 1000000 values, either in one pass over that many values or in
+// repeated passes over the first 1000 (which stay in the cache).
+const std::vector<size_t> sweepSizes{ 1000, 10000, 100000, 1000000 };
+
+/*
+ *  Time each of the variants, which process the first n values once, on
+ *  every size in the sweep in both modes.
+ */
+void runSizeSweep(benchmark::State& state,
+                  const std::vector<std::pair<std::string, std::function<void(size_t)> > >& variants)
+{
+    for (const bool multiPass : { false, true })
+    {
+        for (const size_t numItems : sweepSizes)
+        {
+            const size_t passSize = multiPass ? sweepSizes.front() : numItems;
+            state.setItemsPerIteration(static_cast<double>(numItems));
+            for (const auto& variant : variants)
+            {
+                const auto label = std::string(multiPass ? "multi-pass/" : "single pass/") +
+                                   std::to_string(numItems) + "/" + variant.first;
+                state.run(label, [&]() {
+                    for (size_t done = 0; done < numItems; done += passSize)
+                    {
+                        variant.second(passSize);
+                    }
+                });
+            }
+        }
+    }
+}
+}
+
+BENCHMARK_CASE(scale)
+{
+    std::vector<std::complex<float> > in(sweepSizes.back()), out(sweepSizes.back());
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        in[i] = std::complex<float>(static_cast<float>(i % 100), static_cast<float>(i % 37));
+    }
+
+    runSizeSweep(state, {
+        { "complex", [&](size_t n) {
+            double dblFactor = 1.23486;
+            for (size_t i = 0; i < n; ++i)
+            {
+                out[i] = in[i] * static_cast<float>(dblFactor);
+                dblFactor += .0000001;
+            }
+            benchmark::doNotOptimize(out);
+        } },
+        { "real and imaginary", [&](size_t n) {
+            double dblFactor = 1.23486;
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto factor = static_cast<float>(dblFactor);
+                out[i] = std::complex<float>(in[i].real() * factor, in[i].imag() * factor);
+                dblFactor += .0000001;
+            }
+            benchmark::doNotOptimize(out);
+        } } });
+}
+
+namespace
+{
+// Inputs and outputs for the kernels in both layouts
+struct Data final
+{
+    Data() :
+        a(numValues), b(numValues), outI(numValues), accumI(numValues),
+        aReals(numValues), aImags(numValues), bReals(numValues), bImags(numValues),
+        outReals(numValues), outImags(numValues), accumReals(numValues), accumImags(numValues), detected(numValues)
+    {
+        for (size_t i = 0; i < numValues; ++i)
+        {
+            a[i] = std::complex<float>(static_cast<float>(i % 100) - 50.0f, static_cast<float>(i % 37) - 18.5f);
+            b[i] = std::complex<float>(static_cast<float>(i % 23) - 11.5f, static_cast<float>(i % 61) - 30.0f);
+            aReals[i] = a[i].real();
+            aImags[i] = a[i].imag();
+            bReals[i] = b[i].real();
+            bImags[i] = b[i].imag();
+        }
+    }
+
+    mem::ComplexInterleavedView<float> aI() const
+    {
+        return mem::make_ComplexInterleavedView(a);
+    }
+    mem::ComplexInterleavedView<float> bI() const
+    {
+        return mem::make_ComplexInterleavedView(b);
+    }
+    mem::ComplexParallelView<float> aS() const
+    {
+        return mem::make_ComplexParallelView(aReals, aImags);
+    }
+    mem::ComplexParallelView<float> bS() const
+    {
+        return mem::make_ComplexParallelView(bReals, bImags);
+    }
+
+    std::vector<std::complex<float> > a, b, outI, accumI;
+    std::vector<float> aReals, aImags, bReals, bImags;
+    std::vector<float> outReals, outImags, accumReals, accumImags, detected;
+};
+
+/*
+ *  Time std::complex<float> code, then the interleaved and split kernels
+ *  with plain loops and with SIMD (if the CPU has it).
+ */
+void runKernels(benchmark::State& state,
+                const std::function<void()>& complexCode,
+                const std::function<void()>& interleaved,
+                const std::function<void()>& split)
+{
+    state.setItemsPerIteration(static_cast<double>(numValues));
+    state.run("std::complex", complexCode);
+
+    const auto simd = mem::details::getComplexKernelsInstructionSet();
+    for (const auto& layout : { std::make_pair("interleaved", interleaved), std::make_pair("split", split) })
+    {
+        mem::details::setComplexKernelsInstructionSet(sys::SIMDInstructionSet::Disabled);
+        state.run(std::string(layout.first) + "/plain", layout.second);
+        if (simd != sys::SIMDInstructionSet::Disabled)
+        {
+            mem::details::setComplexKernelsInstructionSet(simd);
+            state.run(std::string(layout.first) + "/SIMD", layout.second);
+        }
+    }
+    mem::details::setComplexKernelsInstructionSet(simd);
+}
+}
+
+BENCHMARK_CASE(conjMultiply)
+{
+    Data d;
+    runKernels(state,
+        [&]() { for (size_t i = 0; i < numValues; ++i) { d.outI[i] = d.a[i] * std::conj(d.b[i]); } },
+        [&]() { mem::conjMultiply(d.aI(), d.bI(), d.outI); },
+        [&]() { mem::conjMultiply(d.aS(), d.bS(), d.outReals, d.outImags); });
+}
+
+BENCHMARK_CASE(power)
+{
+    Data d;
+    runKernels(state,
+        [&]() { for (size_t i = 0; i < numValues; ++i) { d.detected[i] = std::norm(d.a[i]); } },
+        [&]() { mem::power(d.aI(), d.detected); },
+        [&]() { mem::power(d.aS(), d.detected); });
+}
+
+BENCHMARK_CASE(magnitude)
+{
+    Data d;
+    runKernels(state,
+        [&]() { for (size_t i = 0; i < numValues; ++i) { d.detected[i] = std::abs(d.a[i]); } },
+        [&]() { mem::magnitude(d.aI(), d.detected); },
+        [&]() { mem::magnitude(d.aS(), d.detected); });
+}
+
+BENCHMARK_CASE(phase)
+{
+    Data d;
+    runKernels(state,
+        [&]() { for (size_t i = 0; i < numValues; ++i) { d.detected[i] = std::arg(d.a[i]); } },
+        [&]() { mem::phase(d.aI(), d.detected); },
+        [&]() { mem::phase(d.aS(), d.detected); });
+}
+
+BENCHMARK_CASE(scaleAccumulate)
+{
+    Data d;
+    runKernels(state,
+        [&]() { for (size_t i = 0; i < numValues; ++i) { d.accumI[i] += 0.5f * d.a[i]; } },
+        [&]() { mem::scaleAccumulate(d.aI(), 0.5f, d.accumI); },
+        [&]() { mem::scaleAccumulate(d.aS(), 0.5f, d.accumReals, d.accumImags); });
+}
+
+BENCHMARK_CASE(interleave)
+{
+    // deinterleave() for interleaved data, interleave() for split
+    Data d;
+    runKernels(state,
+        [&]() { for (size_t i = 0; i < numValues; ++i) { d.outReals[i] = d.a[i].real(); d.outImags[i] = d.a[i].imag(); } },
+        [&]() { mem::deinterleave(d.aI(), d.outReals, d.outImags); },
+        [&]() { mem::interleave(d.aS(), d.outI); });
+}
+
+BENCHMARK_MAIN(
+    BENCHMARK_CHECK(scale);
+    BENCHMARK_CHECK(conjMultiply);
+    BENCHMARK_CHECK(power);
+    BENCHMARK_CHECK(magnitude);
+    BENCHMARK_CHECK(phase);
+    BENCHMARK_CHECK(scaleAccumulate);
+    BENCHMARK_CHECK(interleave);
+    )
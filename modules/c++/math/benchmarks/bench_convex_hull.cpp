@@ -0,0 +1,95 @@
+/* =========================================================================
+ * This file is part of math-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * math-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Users guide
+
+    Times math::ConvexHull() on 1000 to 1000000 points in a "blob" (normally
+    distributed, so most are well inside the hull and get filtered out), with
+    one thread and with one per CPU.  The time should grow (about) linearly
+    with the number of points.
+
+    ./bench_convex_hull [--filter=<name>] [--json=<file>] [--quick] ...
+
+*/
+
+/*  Results (-O3, a 1-CPU VM), median per iteration:
+                 1 thread    all CPUs
+    1000         32.8 us     35.2 us
+    10000         255 us      270 us
+    100000       3.64 ms     3.17 ms
+    1000000      35.8 ms     34.7 ms
+*/
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <except/Exception.h>
+#include <math/ConvexHull.h>
+#include <sys/Conf.h>
+
+#include "Benchmark.h"
+
+namespace
+{
+std::vector<types::RowCol<double> > makePoints(size_t numPoints)
+{
+    std::mt19937 engine(0);
+    std::normal_distribution<double> distribution(0.0, 1000.0);
+    std::vector<types::RowCol<double> > retval(numPoints);
+    for (auto& point : retval)
+    {
+        point.row = distribution(engine);
+        point.col = distribution(engine);
+    }
+    return retval;
+}
+}
+
+BENCHMARK_CASE(blob)
+{
+    for (const size_t numPoints : { 1000, 10000, 100000, 1000000 })
+    {
+        const auto points = makePoints(numPoints);
+        const coda_oss::span<const types::RowCol<double> > view(points.data(), points.size());
+        std::vector<types::RowCol<double> > hull;
+
+        state.setItemsPerIteration(static_cast<double>(numPoints));
+        for (const size_t numThreads : { 1, 0 })
+        {
+            const auto label = std::to_string(numPoints) + (numThreads == 1 ? "/1 thread" : "/all CPUs");
+            state.run(label, [&]() {
+                math::ConvexHull<double>(view, hull, numThreads);
+                benchmark::doNotOptimize(hull);
+            });
+            if (hull.size() <= 3)
+            {
+                throw except::Exception(Ctxt("Only " + std::to_string(hull.size()) + " points on the hull of " +
+                                             std::to_string(numPoints)));
+            }
+        }
+    }
+}
+
+BENCHMARK_MAIN(
+    BENCHMARK_CHECK(blob);
+)
@@ -26,6 +26,7 @@
 #include <cstddef>
 
 #include "config/Exports.h"
+#include "coda_oss/span.h"
 
 namespace math
 {
@@ -49,6 +50,26 @@ CODA_OSS_API double besselIOrderOne(double x);
  * Modified Bessel function of the first kind, order n > 1
  */
 CODA_OSS_API double besselIOrderN(size_t order, double x);
+
+/*!
+ * Batch versions of the above: result[i] = besselI(order, x[i]).
+ * Orders 0 and 1 use SIMD (AVX2) when the CPU has it, with the same
+ * polynomials, so results match the scalar functions to within rounding.
+ * Order n > 1 is a per-value recurrence and is evaluated one value at a time.
+ *
+ * \throw std::invalid_argument if x and result aren't the same size
+ */
+CODA_OSS_API void besselI(size_t order, coda_oss::span<const double> x, coda_oss::span<double> result);
+CODA_OSS_API void besselIOrderZero(coda_oss::span<const double> x, coda_oss::span<double> result);
+CODA_OSS_API void besselIOrderOne(coda_oss::span<const double> x, coda_oss::span<double> result);
+
+/*!
+ * As above, but split across threads for large arrays.
+ *
+ * \param numThreads Number of threads; 0 (the default) for the number of CPUs
+ */
+CODA_OSS_API void besselI_par(size_t order, coda_oss::span<const double> x, coda_oss::span<double> result,
+                              size_t numThreads = 0);
 }
 
 #endif
@@ -24,10 +24,14 @@
 #define __MATH_CONVEX_HULL_H__
 
 #include <algorithm>
+#include <iterator>
+#include <utility>
 #include <vector>
 #include <limits>
 
 #include <sys/Conf.h>
+#include <sys/Parallel.h>
+#include <coda_oss/span.h>
 
 #include <str/Convert.h>
 
@@ -72,6 +76,11 @@ struct MustBeSignedType<true>
  *  sample code at: http://marknelson.us/2007/08/22/convex.
  *  The article also appeared in a Dr. Dobb's article on 9/13/2007:
  *  http://www.ddj.com/architect/201806315.
+ *
+ *  Before sorting, points strictly inside the octagon formed by the extreme
+ *  points (min/max of col, row, col+row and col-row) are discarded since
+ *  they can't be on the hull (the Akl-Toussaint heuristic); for large,
+ *  "blobby" point sets that's nearly all of them.
  */
 template <typename T>
 class ConvexHull
@@ -85,28 +94,44 @@ public:
      *  As per convention, the last point will always be the first point
      *  repeated.
      *
-     *  \param rawPoints Input points.  Destructive to input (sorts in
-     *                   place to avoid a copy).
+     *  \param points Input points; not modified
      *  \param convexHull [output] Convex hull points
+     *  \param numThreads Threads for filtering and sorting large inputs,
+     *                    0 for the number of CPUs; the hull is the same
+     *                    regardless
      *
      */
-    ConvexHull(std::vector<RowCol>& rawPoints,
-               std::vector<RowCol>& convexHull)
+    ConvexHull(coda_oss::span<const RowCol> points,
+               std::vector<RowCol>& convexHull,
+               size_t numThreads = 1)
     {
-        if (rawPoints.size() < 2)
+        if (points.size() < 2)
         {
             throw except::Exception(Ctxt(
                 "ConvexHull constructor error: must use at least 2 input "
-                "points but " + std::to_string(rawPoints.size()) + " were used"));
+                "points but " + std::to_string(points.size()) + " were used"));
         }
 
         // Enforce (at compile time) that T is a signed type
         MustBeSignedType<std::numeric_limits<T>::is_signed>::confirm();
 
-        partitionPoints(rawPoints);
+        std::vector<RowCol> candidates = filterPoints(points, numThreads);
+        sortPoints(candidates, numThreads);
+        partitionPoints(candidates);
         buildHull(convexHull);
     }
 
+    /*!
+     *  As above.  rawPoints used to be sorted in place; now it isn't
+     *  modified, and only the points that could be on the hull are copied.
+     */
+    ConvexHull(std::vector<RowCol>& rawPoints,
+               std::vector<RowCol>& convexHull) :
+        ConvexHull(coda_oss::span<const RowCol>(rawPoints.data(), rawPoints.size()),
+                   convexHull)
+    {
+    }
+
 private:
     ConvexHull(const ConvexHull& );
     const ConvexHull& operator=(const ConvexHull& );
@@ -165,12 +190,155 @@ private:
         }
     }
 
-    void partitionPoints(std::vector<RowCol> &rawPoints)
+    typedef sys::ParallelPiece Piece; // [begin, end)
+
+    // Split [0, n) into (at most) numThreads pieces worth a thread each
+    static std::vector<Piece> split(size_t n, size_t numThreads)
+    {
+        return sys::splitForThreads(n, numThreads, 64 * 1024);
+    }
+
+    // The points with the extreme values of col, col+row, row, col-row, ...
+    // these are in order around the hull.
+    struct Octagon
+    {
+        RowCol vertices[8];
+
+        explicit Octagon(const RowCol& p)
+        {
+            std::fill(std::begin(vertices), std::end(vertices), p);
+        }
+
+        void add(const RowCol& p)
+        {
+            RowCol* const v = vertices;
+            if (p.col < v[0].col) v[0] = p;
+            if (p.col + p.row < v[1].col + v[1].row) v[1] = p;
+            if (p.row < v[2].row) v[2] = p;
+            if (p.col - p.row > v[3].col - v[3].row) v[3] = p;
+            if (p.col > v[4].col) v[4] = p;
+            if (p.col + p.row > v[5].col + v[5].row) v[5] = p;
+            if (p.row > v[6].row) v[6] = p;
+            if (p.col - p.row < v[7].col - v[7].row) v[7] = p;
+        }
+    };
+
+    // The sign says which side of the line from a to b p is on; 0 is on the line.
+    static T cross(const RowCol& a, const RowCol& b, const RowCol& p) noexcept
+    {
+        return (b.col - a.col) * (p.row - a.row) - (b.row - a.row) * (p.col - a.col);
+    }
+
+    /*!
+     *  Akl-Toussaint: only the points not strictly inside the octagon of
+     *  extreme points can be on the hull.  Points on the octagon's edges
+     *  are kept, so the hull is exactly the same as without filtering.
+     */
+    static std::vector<RowCol> filterPoints(coda_oss::span<const RowCol> points,
+                                            size_t numThreads)
+    {
+        const std::vector<Piece> pieces = split(points.size(), numThreads);
+
+        std::vector<Octagon> octagons(pieces.size(), Octagon(points[0]));
+        sys::parallel(pieces.size(), [&](size_t ii) {
+            for (size_t jj = pieces[ii].first; jj < pieces[ii].second; ++jj)
+            {
+                octagons[ii].add(points[jj]);
+            }
+        });
+        for (size_t ii = 1; ii < octagons.size(); ++ii)
+        {
+            for (const auto& vertex : octagons[ii].vertices)
+            {
+                octagons[0].add(vertex);
+            }
+        }
+
+        // Drop repeated vertices (e.g., one point is both the top and the
+        // top-right); the remaining edges all have a length.
+        std::vector<RowCol> polygon;
+        for (const auto& vertex : octagons[0].vertices)
+        {
+            if (polygon.empty() || !(vertex == polygon.back()))
+            {
+                polygon.push_back(vertex);
+            }
+        }
+        while (polygon.size() > 1 && polygon.front() == polygon.back())
+        {
+            polygon.pop_back();
+        }
+
+        // Twice the signed area; its sign is the orientation of the polygon.
+        T area(0);
+        for (size_t ii = 1; ii + 1 < polygon.size(); ++ii)
+        {
+            area += cross(polygon[0], polygon[ii], polygon[ii + 1]);
+        }
+        if (polygon.size() < 3 || area == 0)
+        {
+            // e.g., all the points are on a line
+            return std::vector<RowCol>(points.begin(), points.end());
+        }
+        const bool positive = area > 0;
+
+        std::vector<std::vector<RowCol> > kept(pieces.size());
+        sys::parallel(pieces.size(), [&](size_t ii) {
+            for (size_t jj = pieces[ii].first; jj < pieces[ii].second; ++jj)
+            {
+                const RowCol& point = points[jj];
+                bool inside = true;
+                for (size_t kk = 0; inside && kk < polygon.size(); ++kk)
+                {
+                    const T c = cross(polygon[kk], polygon[(kk + 1) % polygon.size()], point);
+                    inside = positive ? c > 0 : c < 0;
+                }
+                if (!inside)
+                {
+                    kept[ii].push_back(point);
+                }
+            }
+        });
+
+        std::vector<RowCol> retval = std::move(kept[0]);
+        for (size_t ii = 1; ii < kept.size(); ++ii)
+        {
+            retval.insert(retval.end(), kept[ii].begin(), kept[ii].end());
+        }
+        return retval;
+    }
+
+    /*!
+     *  Sort on col, then row; for large inputs, pieces are sorted on their
+     *  own threads, then merged (in parallel) a pair at a time.
+     */
+    static void sortPoints(std::vector<RowCol>& points, size_t numThreads)
+    {
+        const std::vector<Piece> pieces = split(points.size(), numThreads);
+        const auto begin = points.begin();
+        sys::parallel(pieces.size(), [&](size_t ii) {
+            std::sort(begin + pieces[ii].first, begin + pieces[ii].second, SortRowCol());
+        });
+
+        for (size_t width = 1; width < pieces.size(); width *= 2)
+        {
+            const size_t numMerges = (pieces.size() - width + 2 * width - 1) / (2 * width);
+            sys::parallel(numMerges, [&](size_t ii) {
+                const size_t first = ii * 2 * width;
+                const size_t last = std::min(first + 2 * width, pieces.size()) - 1;
+                std::inplace_merge(begin + pieces[first].first,
+                                   begin + pieces[first + width].first,
+                                   begin + pieces[last].second,
+                                   SortRowCol());
+            });
+        }
+    }
+
+    void partitionPoints(const std::vector<RowCol>& rawPoints)
     {
-        // Sort the raw points
+        // The raw points are sorted
         // This is done to get the far left and far right points of the
         // hull as well as to add the partitioned points in sorted order.
-        std::sort(rawPoints.begin(), rawPoints.end(), SortRowCol());
 
         // Save off the far left and far right points
         mLeft = rawPoints.front();
@@ -204,7 +372,7 @@ private:
      *
      * \param factor 1 for the lower hull, -1 for the upper hull
      * \param input Sorted list of points in one of the two halfs.
-     *              This vector will be destroyed.
+     *              The right point is appended to it.
      * \param output [output] The points in the corresponding convex hull
      *
      */
@@ -222,14 +390,13 @@ private:
         output.push_back(mLeft);
 
         // The construction loop runs until the input is exhausted
-        while (!input.empty())
+        for (const auto& point : input)
         {
             // Repeatedly add the leftmost point to the hull, then test to
             // see if a convexity violation has occurred.  If it has, fix
             // things up by removing the next-to-last point in the output
             // sequence until convexity is restored.
-            output.push_back(input.front());
-            input.erase(input.begin());
+            output.push_back(point);
 
             while (output.size() >= 3)
             {
@@ -264,8 +431,8 @@ private:
         // this information to the building routine as the first
         // parameter, which is either -1 or 1.
 
-        /// @note  This destroys 'mLowerPartitionPoints' and
-        ///        'mUpperPartitionPoints
+        /// @note  This appends to 'mLowerPartitionPoints' and
+        ///        'mUpperPartitionPoints'
         std::vector<RowCol> lowerHull;
         buildHalfHull(1, mLowerPartitionPoints, lowerHull);
 
@@ -0,0 +1,55 @@
+/* =========================================================================
+ * This file is part of math-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * math-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_math_KaiserWindow_h_INCLUDED_
+#define CODA_OSS_math_KaiserWindow_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "config/Exports.h"
+#include "coda_oss/span.h"
+
+namespace math
+{
+/*!
+ * Fill in a Kaiser window of window.size() samples:
+ *   w[n] = I0(beta * sqrt(1 - (2n/(N-1) - 1)^2)) / I0(beta)
+ * using the batch besselIOrderZero().  A one-sample window is {1}.
+ *
+ * \param beta Shape parameter; 0 is a rectangular window
+ */
+CODA_OSS_API void kaiserWindow(double beta, coda_oss::span<double> window);
+
+/*!
+ * As above, but the window is computed once and cached by (length, beta);
+ * every caller asking for the same window shares the same (immutable) data.
+ * Thread-safe.  Only the most recently created windows are kept, so holding
+ * on to the returned pointer is cheaper than asking again in a loop.
+ */
+CODA_OSS_API std::shared_ptr<const std::vector<double>> kaiserWindow(size_t length, double beta);
+}
+
+#endif  // CODA_OSS_math_KaiserWindow_h_INCLUDED_
@@ -29,6 +29,7 @@
 
 #include <sys/Conf.h>
 #include "config/Exports.h"
+#include "coda_oss/span.h"
 
 namespace math
 {
@@ -69,6 +70,27 @@ CODA_OSS_API void SinCos(float angle, float& sin, float& cos) noexcept;
 CODA_OSS_API void SinCos(double angle, double& sin, double& cos) noexcept;
 CODA_OSS_API void SinCos(long double angle, long double& sin, long double& cos) noexcept;
 
+/*!
+ * Batch versions of the above, e.g., for phase ramps: sin[i] and cos[i] of
+ * angles[i].  SIMD (AVX2) is used when the CPU has it; results are within an
+ * ULP or two of std::sin() and std::cos().  Angles larger than about 1e8
+ * radians are computed one at a time.
+ *
+ * \throw std::invalid_argument if the spans aren't the same size
+ */
+CODA_OSS_API void SinCos(coda_oss::span<const float> angles, coda_oss::span<float> sin, coda_oss::span<float> cos);
+CODA_OSS_API void SinCos(coda_oss::span<const double> angles, coda_oss::span<double> sin, coda_oss::span<double> cos);
+
+/*!
+ * As above, but split across threads for large arrays.
+ *
+ * \param numThreads Number of threads; 0 (the default) for the number of CPUs
+ */
+CODA_OSS_API void SinCos_par(coda_oss::span<const float> angles, coda_oss::span<float> sin, coda_oss::span<float> cos,
+                             size_t numThreads = 0);
+CODA_OSS_API void SinCos_par(coda_oss::span<const double> angles, coda_oss::span<double> sin, coda_oss::span<double> cos,
+                             size_t numThreads = 0);
+
 /*
  * Calculate the binomial coefficient
  * Be wary of the possibility of overflow from integer arithmetic.
@@ -0,0 +1,377 @@
+/* =========================================================================
+ * This file is part of math-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * math-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Batch (span-in, span-out) versions of math::besselI() and math::SinCos().
+
+#include <math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "sys/OS.h"
+#include "sys/Parallel.h"
+#include "math/Bessel.h"
+#include "math/Utilities.h"
+
+#if CODA_OSS_ENABLE_SIMD && (defined(__x86_64__) || defined(_M_X64))
+    #define CODA_OSS_math_Batch_AVX2 1
+    #include <immintrin.h>
+    #if defined(__GNUC__) || defined(__clang__)
+        // Compile just these functions for AVX2; they're only called if the CPU has it.
+        #define CODA_OSS_math_target_avx2 __attribute__((target("avx2")))
+    #else
+        #define CODA_OSS_math_target_avx2 // MSVC allows AVX2 intrinsics anywhere
+    #endif
+#else
+    #define CODA_OSS_math_Batch_AVX2 0
+#endif
+
+namespace
+{
+void checkSize(size_t expected, size_t actual)
+{
+    if (expected != actual)
+    {
+        throw std::invalid_argument("batch inputs and outputs must be the same size.");
+    }
+}
+
+bool haveAVX2()
+{
+#if CODA_OSS_math_Batch_AVX2
+    static const auto retval = []() {
+        const auto instructionSet = sys::OS().getSIMDInstructionSet();
+        return (instructionSet == sys::SIMDInstructionSet::AVX2) || (instructionSet == sys::SIMDInstructionSet::AVX512F);
+    }();
+    return retval;
+#else
+    return false;
+#endif
+}
+
+// Run f(begin, end) on pieces of [0, n), each worth a thread
+template <typename TFunc>
+void parallel(size_t n, size_t numThreads, TFunc f)
+{
+    constexpr size_t minimumPerThread = 16 * 1024; // not worth starting a thread for less
+    sys::parallelFor(n, numThreads, minimumPerThread, f);
+}
+
+#if CODA_OSS_math_Batch_AVX2
+namespace avx2
+{
+CODA_OSS_math_target_avx2 inline __m256d abs(__m256d x)
+{
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+}
+CODA_OSS_math_target_avx2 inline __m256d polevl(__m256d x, const double* coef, size_t n)
+{
+    auto retval = _mm256_set1_pd(coef[0]);
+    for (size_t i = 1; i <= n; i++)
+    {
+        retval = _mm256_add_pd(_mm256_mul_pd(retval, x), _mm256_set1_pd(coef[i]));
+    }
+    return retval;
+}
+
+// Cephes exp(); callers ensure |x| <= 708 so that the result is a normal number.
+CODA_OSS_math_target_avx2 inline __m256d exp(__m256d x)
+{
+    static const double P[] = {1.26177193074810590878E-4, 3.02994407707441961300E-2, 9.99999999999999999910E-1};
+    static const double Q[] = {3.00198505138664455042E-6, 2.52448340349684104192E-3, 2.27265548208155028766E-1, 2.00000000000000000009E0};
+
+    // exp(x) = 2^k * exp(r), |r| <= ln(2)/2
+    const auto k = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(1.4426950408889634073599)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    auto r = _mm256_sub_pd(x, _mm256_mul_pd(k, _mm256_set1_pd(6.93145751953125E-1)));
+    r = _mm256_sub_pd(r, _mm256_mul_pd(k, _mm256_set1_pd(1.42860682030941723212E-6)));
+
+    const auto rr = _mm256_mul_pd(r, r);
+    const auto px = _mm256_mul_pd(r, polevl(rr, P, 2));
+    auto e = _mm256_div_pd(px, _mm256_sub_pd(polevl(rr, Q, 3), px));
+    e = _mm256_add_pd(_mm256_set1_pd(1.0), _mm256_add_pd(e, e));
+
+    // 2^k by building the exponent bits
+    const auto k32 = _mm_add_epi32(_mm256_cvtpd_epi32(k), _mm_set1_epi32(1023));
+    const auto pow2k = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_cvtepi32_epi64(k32), 52));
+    return _mm256_mul_pd(e, pow2k);
+}
+
+// true if any lane is > limit or NaN; those blocks are done with the scalar code.
+CODA_OSS_math_target_avx2 inline bool outOfRange(__m256d ax, double limit)
+{
+    return _mm256_movemask_pd(_mm256_cmp_pd(ax, _mm256_set1_pd(limit), _CMP_NLE_UQ)) != 0;
+}
+
+// Same polynomials (and evaluation order) as besselIOrderZero() and besselIOrderOne()
+CODA_OSS_math_target_avx2 void besselIOrderZero(const double* x, double* result, size_t n)
+{
+    static const double small[] = {0.45813e-2, 0.360768e-1, 0.2659732, 1.2067492, 3.0899424, 3.5156229, 1.0};
+    static const double large[] = {0.392377e-2, -0.1647633e-1, 0.2635537e-1, -0.2057706e-1, 0.916281e-2,
+                                   -0.157565e-2, 0.225319e-2, 0.1328592e-1, 0.39894228};
+    const auto limit = _mm256_set1_pd(3.75);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const auto x_ = _mm256_loadu_pd(x + i);
+        const auto ax = abs(x_);
+        if (outOfRange(ax, 700.0))
+        {
+            for (size_t j = i; j < i + 4; j++)
+            {
+                result[j] = math::besselIOrderZero(x[j]);
+            }
+            continue;
+        }
+
+        auto y = _mm256_div_pd(x_, limit);
+        const auto ansSmall = polevl(_mm256_mul_pd(y, y), small, 6);
+
+        y = _mm256_div_pd(limit, ax);
+        const auto ansLarge = _mm256_mul_pd(_mm256_div_pd(exp(ax), _mm256_sqrt_pd(ax)), polevl(y, large, 8));
+
+        _mm256_storeu_pd(result + i, _mm256_blendv_pd(ansLarge, ansSmall, _mm256_cmp_pd(ax, limit, _CMP_LT_OQ)));
+    }
+    for (; i < n; i++)
+    {
+        result[i] = math::besselIOrderZero(x[i]);
+    }
+}
+CODA_OSS_math_target_avx2 void besselIOrderOne(const double* x, double* result, size_t n)
+{
+    static const double small[] = {0.32411e-3, 0.301532e-2, 0.2658733e-1, 0.15084934, 0.51498869, 0.87890594, 0.5};
+    const auto limit = _mm256_set1_pd(3.75);
+    const auto signMask = _mm256_set1_pd(-0.0);
+    const auto zero = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const auto x_ = _mm256_loadu_pd(x + i);
+        const auto ax = abs(x_);
+        if (outOfRange(ax, 700.0))
+        {
+            for (size_t j = i; j < i + 4; j++)
+            {
+                result[j] = math::besselIOrderOne(x[j]);
+            }
+            continue;
+        }
+
+        auto y = _mm256_div_pd(x_, limit);
+        const auto ansSmall = _mm256_mul_pd(ax, polevl(_mm256_mul_pd(y, y), small, 6));
+
+        y = _mm256_div_pd(limit, ax);
+        // 0.2282967e-1 + y * (-0.2895312e-1 + y * (0.1787654e-1 - y * 0.420059e-2))
+        auto ans = _mm256_sub_pd(_mm256_set1_pd(0.1787654e-1), _mm256_mul_pd(y, _mm256_set1_pd(0.420059e-2)));
+        ans = _mm256_add_pd(_mm256_set1_pd(-0.2895312e-1), _mm256_mul_pd(y, ans));
+        ans = _mm256_add_pd(_mm256_set1_pd(0.2282967e-1), _mm256_mul_pd(y, ans));
+        static const double outer[] = {0.163801e-2, -0.362018e-2, -0.3988024e-1, 0.39894228};
+        ans = _mm256_add_pd(_mm256_set1_pd(-0.1031555e-1), _mm256_mul_pd(y, ans));
+        ans = _mm256_add_pd(_mm256_set1_pd(outer[0]), _mm256_mul_pd(y, ans));
+        ans = _mm256_add_pd(_mm256_set1_pd(outer[1]), _mm256_mul_pd(y, ans));
+        ans = _mm256_add_pd(_mm256_set1_pd(outer[2]), _mm256_mul_pd(y, ans));
+        ans = _mm256_add_pd(_mm256_set1_pd(outer[3]), _mm256_mul_pd(y, ans));
+        const auto ansLarge = _mm256_mul_pd(ans, _mm256_div_pd(exp(ax), _mm256_sqrt_pd(ax)));
+
+        ans = _mm256_blendv_pd(ansLarge, ansSmall, _mm256_cmp_pd(ax, limit, _CMP_LT_OQ));
+        ans = _mm256_xor_pd(ans, _mm256_and_pd(signMask, _mm256_cmp_pd(x_, zero, _CMP_LT_OQ))); // x < 0.0 ? -ans : ans
+        _mm256_storeu_pd(result + i, ans);
+    }
+    for (; i < n; i++)
+    {
+        result[i] = math::besselIOrderOne(x[i]);
+    }
+}
+
+// Cephes sin() and cos(), reducing by multiples of pi/2 to [-pi/4, pi/4].
+CODA_OSS_math_target_avx2 inline void sincos(__m256d x, __m256d& sin, __m256d& cos)
+{
+    static const double sincof[] = {1.58962301576546568060E-10, -2.50507477628578072866E-8, 2.75573136213857245213E-6,
+                                    -1.98412698295895385996E-4, 8.33333333332211858878E-3, -1.66666666666666307295E-1};
+    static const double coscof[] = {-1.13585365213876817300E-11, 2.08757008419747316778E-9, -2.75573141792967388112E-7,
+                                    2.48015872888517045348E-5, -1.38888888888730564116E-3, 4.16666666666665929218E-2};
+
+    const auto q = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(0.63661977236758134308)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    auto z = _mm256_sub_pd(x, _mm256_mul_pd(q, _mm256_set1_pd(1.57079625129699707031)));
+    z = _mm256_sub_pd(z, _mm256_mul_pd(q, _mm256_set1_pd(7.54978941586159635336E-8)));
+    z = _mm256_sub_pd(z, _mm256_mul_pd(q, _mm256_set1_pd(5.39030285815811905290E-15)));
+
+    const auto zz = _mm256_mul_pd(z, z);
+    const auto s = _mm256_add_pd(z, _mm256_mul_pd(_mm256_mul_pd(z, zz), polevl(zz, sincof, 5)));
+    const auto c = _mm256_add_pd(_mm256_sub_pd(_mm256_set1_pd(1.0), _mm256_mul_pd(_mm256_set1_pd(0.5), zz)),
+                                 _mm256_mul_pd(_mm256_mul_pd(zz, zz), polevl(zz, coscof, 5)));
+
+    // x = q*pi/2 + z: sin(x) is s, c, -s, -c and cos(x) is c, -s, -c, s for q mod 4 = 0, 1, 2, 3
+    const auto quadrant = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(q));
+    const auto one = _mm256_set1_epi64x(1), two = _mm256_set1_epi64x(2);
+    const auto swap = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(quadrant, one), one));
+    const auto negateSin = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(quadrant, two), 62));
+    const auto negateCos = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(_mm256_add_epi64(quadrant, one), two), 62));
+    sin = _mm256_xor_pd(_mm256_blendv_pd(s, c, swap), negateSin);
+    cos = _mm256_xor_pd(_mm256_blendv_pd(c, s, swap), negateCos);
+}
+
+CODA_OSS_math_target_avx2 void SinCos(const double* angles, double* sin, double* cos, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const auto x = _mm256_loadu_pd(angles + i);
+        if (outOfRange(abs(x), 1e8))
+        {
+            for (size_t j = i; j < i + 4; j++)
+            {
+                math::SinCos(angles[j], sin[j], cos[j]);
+            }
+            continue;
+        }
+        __m256d s, c;
+        sincos(x, s, c);
+        _mm256_storeu_pd(sin + i, s);
+        _mm256_storeu_pd(cos + i, c);
+    }
+    for (; i < n; i++)
+    {
+        math::SinCos(angles[i], sin[i], cos[i]);
+    }
+}
+CODA_OSS_math_target_avx2 void SinCos(const float* angles, float* sin, float* cos, size_t n)
+{
+    // Computing in double and rounding is simpler than a separate float kernel.
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const auto x = _mm256_cvtps_pd(_mm_loadu_ps(angles + i));
+        if (outOfRange(abs(x), 1e8))
+        {
+            for (size_t j = i; j < i + 4; j++)
+            {
+                math::SinCos(angles[j], sin[j], cos[j]);
+            }
+            continue;
+        }
+        __m256d s, c;
+        sincos(x, s, c);
+        _mm_storeu_ps(sin + i, _mm256_cvtpd_ps(s));
+        _mm_storeu_ps(cos + i, _mm256_cvtpd_ps(c));
+    }
+    for (; i < n; i++)
+    {
+        math::SinCos(angles[i], sin[i], cos[i]);
+    }
+}
+}
+#endif // CODA_OSS_math_Batch_AVX2
+
+template <typename T>
+void SinCos_(const T* angles, T* sin, T* cos, size_t n)
+{
+#if CODA_OSS_math_Batch_AVX2
+    if (haveAVX2())
+    {
+        return avx2::SinCos(angles, sin, cos, n);
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+    {
+        math::SinCos(angles[i], sin[i], cos[i]);
+    }
+}
+}
+
+void math::besselIOrderZero(coda_oss::span<const double> x, coda_oss::span<double> result)
+{
+    checkSize(x.size(), result.size());
+#if CODA_OSS_math_Batch_AVX2
+    if (haveAVX2())
+    {
+        return avx2::besselIOrderZero(x.data(), result.data(), x.size());
+    }
+#endif
+    std::transform(x.begin(), x.end(), result.begin(), [](double v) { return besselIOrderZero(v); });
+}
+
+void math::besselIOrderOne(coda_oss::span<const double> x, coda_oss::span<double> result)
+{
+    checkSize(x.size(), result.size());
+#if CODA_OSS_math_Batch_AVX2
+    if (haveAVX2())
+    {
+        return avx2::besselIOrderOne(x.data(), result.data(), x.size());
+    }
+#endif
+    std::transform(x.begin(), x.end(), result.begin(), [](double v) { return besselIOrderOne(v); });
+}
+
+void math::besselI(size_t order, coda_oss::span<const double> x, coda_oss::span<double> result)
+{
+    switch (order)
+    {
+    case 0:
+        return besselIOrderZero(x, result);
+    case 1:
+        return besselIOrderOne(x, result);
+    default:
+        checkSize(x.size(), result.size());
+        std::transform(x.begin(), x.end(), result.begin(), [&](double v) { return besselIOrderN(order, v); });
+    }
+}
+
+void math::besselI_par(size_t order, coda_oss::span<const double> x, coda_oss::span<double> result, size_t numThreads)
+{
+    checkSize(x.size(), result.size());
+    parallel(x.size(), numThreads, [&](size_t begin, size_t end) {
+        besselI(order, x.subspan(begin, end - begin), result.subspan(begin, end - begin));
+    });
+}
+
+void math::SinCos(coda_oss::span<const float> angles, coda_oss::span<float> sin, coda_oss::span<float> cos)
+{
+    checkSize(angles.size(), sin.size());
+    checkSize(angles.size(), cos.size());
+    SinCos_(angles.data(), sin.data(), cos.data(), angles.size());
+}
+void math::SinCos(coda_oss::span<const double> angles, coda_oss::span<double> sin, coda_oss::span<double> cos)
+{
+    checkSize(angles.size(), sin.size());
+    checkSize(angles.size(), cos.size());
+    SinCos_(angles.data(), sin.data(), cos.data(), angles.size());
+}
+
+template <typename T>
+static void SinCos_par_(coda_oss::span<const T> angles, coda_oss::span<T> sin, coda_oss::span<T> cos, size_t numThreads)
+{
+    checkSize(angles.size(), sin.size());
+    checkSize(angles.size(), cos.size());
+    parallel(angles.size(), numThreads, [&](size_t begin, size_t end) {
+        SinCos_(angles.data() + begin, sin.data() + begin, cos.data() + begin, end - begin);
+    });
+}
+void math::SinCos_par(coda_oss::span<const float> angles, coda_oss::span<float> sin, coda_oss::span<float> cos, size_t numThreads)
+{
+    SinCos_par_(angles, sin, cos, numThreads);
+}
+void math::SinCos_par(coda_oss::span<const double> angles, coda_oss::span<double> sin, coda_oss::span<double> cos, size_t numThreads)
+{
+    SinCos_par_(angles, sin, cos, numThreads);
+}
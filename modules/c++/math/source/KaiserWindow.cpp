@@ -0,0 +1,111 @@
+/* =========================================================================
+ * This file is part of math-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * math-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "math/KaiserWindow.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+#include "math/Bessel.h"
+
+void math::kaiserWindow(double beta, coda_oss::span<double> window)
+{
+    const auto length = window.size();
+    if (length == 1)
+    {
+        window[0] = 1.0;
+        return;
+    }
+
+    const auto denominator = static_cast<double>(length - 1);
+    for (size_t n = 0; n < length; n++)
+    {
+        const auto ratio = 2.0 * static_cast<double>(n) / denominator - 1.0;
+        window[n] = beta * std::sqrt(std::max(0.0, 1.0 - ratio * ratio));
+    }
+    besselIOrderZero(window, window);
+
+    const auto scale = 1.0 / besselIOrderZero(beta);
+    for (auto& w : window)
+    {
+        w *= scale;
+    }
+}
+
+namespace
+{
+struct KaiserWindowCache final
+{
+    using key_t = std::pair<size_t, double>;
+    using value_t = std::shared_ptr<const std::vector<double>>;
+
+    value_t get(size_t length, double beta)
+    {
+        const key_t key(length, beta);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& entry : entries)
+            {
+                if (entry.first == key)
+                {
+                    return entry.second;
+                }
+            }
+        }
+
+        // Compute without holding the lock; if two threads race, both windows are the same.
+        auto window = std::make_shared<std::vector<double>>(length);
+        math::kaiserWindow(beta, *window);
+        value_t retval = std::move(window);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& entry : entries)
+        {
+            if (entry.first == key)
+            {
+                return entry.second; // another thread won
+            }
+        }
+        if (entries.size() >= maxEntries)
+        {
+            entries.pop_front();
+        }
+        entries.emplace_back(key, retval);
+        return retval;
+    }
+
+private:
+    static constexpr size_t maxEntries = 32; // few distinct windows in practice; a linear search is fine
+    std::mutex mutex;
+    std::deque<std::pair<key_t, value_t>> entries;
+};
+constexpr size_t KaiserWindowCache::maxEntries;
+}
+
+std::shared_ptr<const std::vector<double>> math::kaiserWindow(size_t length, double beta)
+{
+    static KaiserWindowCache cache;
+    return cache.get(length, beta);
+}
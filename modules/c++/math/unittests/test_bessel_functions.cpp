@@ -20,9 +20,26 @@
  *
  */
 
+#include <cmath>
+#include <vector>
+
 #include <TestCase.h>
 #include <math/Bessel.h>
 
+static std::vector<double> make_x()
+{
+    // both sides of the 3.75 polynomial switch, negatives, zero and a partial SIMD block
+    std::vector<double> retval;
+    for (double x = -20.0; x <= 20.0; x += 0.0625)
+    {
+        retval.push_back(x);
+    }
+    retval.push_back(3.75);
+    retval.push_back(-0.0);
+    retval.push_back(705.0); // too big for the SIMD exp()
+    return retval;
+}
+
 TEST_CASE(orderZero)
 {
     TEST_ASSERT_ALMOST_EQ(math::besselI(0, 1), 1.266065878);
@@ -44,9 +61,31 @@ TEST_CASE(orderFive)
     TEST_ASSERT_ALMOST_EQ(math::besselI(5, 1), 2.71463156e-4);
 }
 
+TEST_CASE(batch)
+{
+    const auto x = make_x();
+    std::vector<double> result(x.size()), result_par(x.size());
+    for (const size_t order : {0, 1, 5})
+    {
+        math::besselI(order, x, result);
+        math::besselI_par(order, x, result_par, 3);
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            const auto expected = math::besselI(order, x[i]);
+            TEST_ASSERT_ALMOST_EQ_EPS(result[i], expected, std::abs(expected) * 1e-14);
+            TEST_ASSERT_EQ(result_par[i], result[i]);
+        }
+    }
+
+    std::vector<double> tooSmall(x.size() - 1);
+    TEST_THROWS(math::besselI(0, x, tooSmall));
+    TEST_THROWS(math::besselI_par(1, x, tooSmall));
+}
+
 TEST_MAIN(
     TEST_CHECK(orderZero);
     TEST_CHECK(orderOne);
     TEST_CHECK(orderFive);
+    TEST_CHECK(batch);
     )
 
@@ -20,6 +20,8 @@
  *
  */
 
+#include <random>
+
 #include <math/ConvexHull.h>
 #include <sys/Conf.h>
 #include "TestCase.h"
@@ -50,7 +52,7 @@ TEST_CASE(testConvexHull)
     inputPoints.push_back(types::RowCol<sys::Int64_T>(45, 38));
 
     // Compute the convex hull
-    /// @note  This is destructive to input points
+    const auto original = inputPoints;
     std::vector<types::RowCol<sys::Int64_T> > convexHull;
     math::ConvexHull<sys::Int64_T>(inputPoints, convexHull);
 
@@ -73,8 +75,123 @@ TEST_CASE(testConvexHull)
         TEST_ASSERT_EQ(convexHull[ii].row, expectedConvexHull[ii].row);
         TEST_ASSERT_EQ(convexHull[ii].col, expectedConvexHull[ii].col);
     }
+    TEST_ASSERT(inputPoints == original); // no longer sorted in place
+}
+
+// A "blob" of points: most are well inside the hull
+template <typename T>
+static std::vector<types::RowCol<T> > makePoints(size_t count, unsigned seed)
+{
+    std::mt19937 engine(seed);
+    std::normal_distribution<double> distribution(0.0, 1000.0);
+    std::vector<types::RowCol<T> > retval(count);
+    for (auto& point : retval)
+    {
+        point.row = static_cast<T>(distribution(engine));
+        point.col = static_cast<T>(distribution(engine));
+    }
+    return retval;
+}
+
+template <typename T>
+static std::vector<types::RowCol<T> > computeHull(const std::vector<types::RowCol<T> >& points,
+                                                  size_t numThreads)
+{
+    std::vector<types::RowCol<T> > retval;
+    math::ConvexHull<T>(coda_oss::span<const types::RowCol<T> >(points.data(), points.size()),
+                        retval, numThreads);
+    return retval;
+}
+
+// Without any filtering or threads; the hull has to be exactly the same
+template <typename T>
+static std::vector<types::RowCol<T> > unfilteredHull(std::vector<types::RowCol<T> > points)
+{
+    std::sort(points.begin(), points.end(),
+              [](const types::RowCol<T>& lhs, const types::RowCol<T>& rhs) {
+                  return lhs.col < rhs.col || (lhs.col == rhs.col && lhs.row < rhs.row);
+              });
+    // Andrew's monotone chain, which is the same algorithm
+    const auto cross = [](const types::RowCol<T>& o, const types::RowCol<T>& a, const types::RowCol<T>& b) {
+        return (a.col - o.col) * (b.row - o.row) - (a.row - o.row) * (b.col - o.col);
+    };
+    std::vector<types::RowCol<T> > lower, upper;
+    for (const auto& p : points)
+    {
+        while (lower.size() >= 2 && cross(lower[lower.size() - 2], lower.back(), p) <= 0)
+            lower.pop_back();
+        lower.push_back(p);
+    }
+    for (auto it = points.rbegin(); it != points.rend(); ++it)
+    {
+        while (upper.size() >= 2 && cross(upper[upper.size() - 2], upper.back(), *it) <= 0)
+            upper.pop_back();
+        upper.push_back(*it);
+    }
+    // the same convention as ConvexHull: start at the left and repeat it at the end
+    std::vector<types::RowCol<T> > retval(lower.begin(), lower.end());
+    retval.insert(retval.end(), upper.begin() + 1, upper.end());
+    return retval;
+}
+
+TEST_CASE(testConvexHullFiltered)
+{
+    for (const size_t count : {3, 10, 100, 1000, 200000})
+    {
+        const auto points = makePoints<double>(count, static_cast<unsigned>(count));
+        const auto expected = unfilteredHull(points);
+        TEST_ASSERT(computeHull(points, 1) == expected);
+        TEST_ASSERT(computeHull(points, 4) == expected);
+        TEST_ASSERT(computeHull(points, 0) == expected); // one thread per CPU
+
+        const auto intPoints = makePoints<sys::Int64_T>(count, static_cast<unsigned>(count));
+        const auto intExpected = unfilteredHull(intPoints);
+        TEST_ASSERT(computeHull(intPoints, 1) == intExpected);
+        TEST_ASSERT(computeHull(intPoints, 4) == intExpected);
+
+        auto copy = intPoints;
+        std::vector<types::RowCol<sys::Int64_T> > hull;
+        math::ConvexHull<sys::Int64_T>(copy, hull);
+        TEST_ASSERT(hull == intExpected);
+    }
+}
+
+TEST_CASE(testConvexHullDegenerate)
+{
+    using RowCol = types::RowCol<sys::Int64_T>;
+
+    // points on a line; the octagon has no area so nothing is filtered
+    std::vector<RowCol> points;
+    for (sys::Int64_T ii = 0; ii < 10; ++ii)
+    {
+        points.push_back(RowCol(2 * ii, ii));
+    }
+    TEST_ASSERT(computeHull(points, 1) == unfilteredHull(points));
+    TEST_ASSERT_EQ(computeHull(points, 1).size(), static_cast<size_t>(3));
+
+    // lots of duplicates, including the corners
+    points.clear();
+    for (size_t ii = 0; ii < 100; ++ii)
+    {
+        points.push_back(RowCol(0, 0));
+        points.push_back(RowCol(10, 0));
+        points.push_back(RowCol(10, 10));
+        points.push_back(RowCol(0, 10));
+        points.push_back(RowCol(5, 5));
+        points.push_back(RowCol(5, 10)); // on an edge, but not on the hull
+    }
+    const auto hull = computeHull(points, 1);
+    TEST_ASSERT_EQ(hull.size(), static_cast<size_t>(5));
+    TEST_ASSERT(hull == unfilteredHull(points));
+
+    points.resize(2);
+    TEST_ASSERT(computeHull(points, 1) == unfilteredHull(points));
+    points.resize(1);
+    TEST_THROWS(computeHull(points, 1));
 }
 
 TEST_MAIN(
     TEST_CHECK(testConvexHull);
+    TEST_CHECK(testConvexHullFiltered);
+    TEST_CHECK(testConvexHullDegenerate);
 )
\ No newline at end of file
@@ -0,0 +1,85 @@
+/* =========================================================================
+ * This file is part of math-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * math-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include <math/Bessel.h>
+#include <math/KaiserWindow.h>
+
+#include "TestCase.h"
+
+TEST_CASE(testKaiserWindow)
+{
+    const double beta = 8.6;
+    std::vector<double> window(65);
+    math::kaiserWindow(beta, window);
+
+    TEST_ASSERT_ALMOST_EQ_EPS(window[32], 1.0, 1e-15); // peak in the middle
+    TEST_ASSERT_ALMOST_EQ_EPS(window[0], 1.0 / math::besselIOrderZero(beta), 1e-15);
+    for (size_t n = 0; n < window.size(); n++)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(window[n], window[window.size() - 1 - n], 1e-15);
+        TEST_ASSERT(window[n] > 0.0);
+        TEST_ASSERT(window[n] <= 1.0);
+    }
+
+    std::vector<double> one(1);
+    math::kaiserWindow(beta, one);
+    TEST_ASSERT_EQ(one[0], 1.0);
+
+    std::vector<double> rectangular(10);
+    math::kaiserWindow(0.0, rectangular);
+    for (const auto w : rectangular)
+    {
+        TEST_ASSERT_EQ(w, 1.0);
+    }
+}
+
+TEST_CASE(testKaiserWindowCache)
+{
+    const auto window = math::kaiserWindow(65, 8.6);
+    TEST_ASSERT_EQ(window->size(), static_cast<size_t>(65));
+
+    std::vector<double> expected(65);
+    math::kaiserWindow(8.6, expected);
+    TEST_ASSERT(*window == expected);
+
+    TEST_ASSERT(math::kaiserWindow(65, 8.6) == window); // same data, not recomputed
+    TEST_ASSERT(math::kaiserWindow(65, 8.7) != window);
+    TEST_ASSERT(math::kaiserWindow(64, 8.6) != window);
+
+    // push it out of the cache; the caller's copy is still good
+    for (size_t length = 1; length <= 100; length++)
+    {
+        std::ignore = math::kaiserWindow(length, 1.0);
+    }
+    TEST_ASSERT(*window == expected);
+    TEST_ASSERT(math::kaiserWindow(65, 8.6) != window);
+    TEST_ASSERT(*math::kaiserWindow(65, 8.6) == expected);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testKaiserWindow);
+    TEST_CHECK(testKaiserWindowCache);
+    )
@@ -0,0 +1,89 @@
+/* =========================================================================
+ * This file is part of math-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * math-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <math/Utilities.h>
+
+#include "TestCase.h"
+
+template <typename T>
+static std::vector<T> make_angles()
+{
+    // every quadrant, both signs, and a few the SIMD code hands to the scalar code
+    std::vector<T> retval;
+    for (int i = -4000; i <= 4000; i++)
+    {
+        retval.push_back(static_cast<T>(i) * static_cast<T>(0.0123));
+    }
+    retval.push_back(static_cast<T>(1e6));
+    retval.push_back(static_cast<T>(-0.0));
+    retval.push_back(static_cast<T>(1e9));
+    retval.push_back(std::numeric_limits<T>::infinity());
+    retval.push_back(std::numeric_limits<T>::quiet_NaN());
+    return retval;
+}
+
+template <typename T>
+static void test_SinCos(const std::string& testName, T tolerance)
+{
+    const auto angles = make_angles<T>();
+    std::vector<T> sin(angles.size()), cos(angles.size());
+    std::vector<T> sin_par(angles.size()), cos_par(angles.size());
+    math::SinCos(angles, sin, cos);
+    math::SinCos_par(angles, sin_par, cos_par, 4);
+    for (size_t i = 0; i < angles.size(); i++)
+    {
+        T expectedSin, expectedCos;
+        math::SinCos(angles[i], expectedSin, expectedCos);
+        if (std::isnan(expectedSin))
+        {
+            TEST_ASSERT(std::isnan(sin[i]));
+            TEST_ASSERT(std::isnan(cos[i]));
+            continue;
+        }
+        TEST_ASSERT_ALMOST_EQ_EPS(sin[i], expectedSin, tolerance);
+        TEST_ASSERT_ALMOST_EQ_EPS(cos[i], expectedCos, tolerance);
+        TEST_ASSERT_EQ(sin_par[i], sin[i]);
+        TEST_ASSERT_EQ(cos_par[i], cos[i]);
+    }
+
+    std::vector<T> tooSmall(angles.size() - 1);
+    TEST_THROWS(math::SinCos(angles, tooSmall, cos));
+    TEST_THROWS(math::SinCos_par(angles, sin, tooSmall));
+}
+
+TEST_CASE(testSinCosFloat)
+{
+    test_SinCos<float>(testName, 1e-6f);
+}
+TEST_CASE(testSinCosDouble)
+{
+    test_SinCos<double>(testName, 1e-15);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testSinCosFloat);
+    TEST_CHECK(testSinCosDouble);
+    )
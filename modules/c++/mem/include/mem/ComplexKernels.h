@@ -0,0 +1,93 @@
+/* =========================================================================
+ * This file is part of mem-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * mem-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_mem_ComplexKernels_h_INCLUDED_
+#define CODA_OSS_mem_ComplexKernels_h_INCLUDED_
+
+#include <complex>
+
+#include "config/Exports.h"
+#include "coda_oss/span.h"
+#include "sys/AbstractOS.h"
+#include "mem/ComplexView.h"
+
+/*!
+ * \file ComplexKernels.h
+ * \brief Vectorized loops over complex<float> data in either storage layout
+ *
+ * Each kernel is overloaded on the view type: ComplexInterleavedView
+ * (std::complex<float>, the "normal" C++ layout) writes interleaved results,
+ * ComplexParallelView (separate real and imaginary arrays) writes split
+ * results.  At run-time, AVX2 is used if the CPU has it (AVX-512 machines
+ * also get the AVX2 code); otherwise, or with CODA_OSS_DISABLE_SIMD, a plain
+ * loop is used that the compiler can vectorize for the baseline SSE2.
+ *
+ * Inputs and outputs must be the same size (std::invalid_argument is thrown
+ * otherwise); an output may be the same memory as an input, but must not
+ * partially overlap it.
+ */
+namespace mem
+{
+//! out[i] = a[i] * conj(b[i]), e.g., for correlation and interferograms
+CODA_OSS_API void conjMultiply(ComplexInterleavedView<float> a, ComplexInterleavedView<float> b,
+                               coda_oss::span<std::complex<float>> out);
+CODA_OSS_API void conjMultiply(ComplexParallelView<float> a, ComplexParallelView<float> b,
+                               coda_oss::span<float> outReals, coda_oss::span<float> outImags);
+
+//! out[i] = |z[i]|, computed as sqrt(re*re + im*im); no std::hypot() scaling
+CODA_OSS_API void magnitude(ComplexInterleavedView<float> z, coda_oss::span<float> out);
+CODA_OSS_API void magnitude(ComplexParallelView<float> z, coda_oss::span<float> out);
+
+//! out[i] = re*re + im*im, i.e., std::norm() or "power detection"
+CODA_OSS_API void power(ComplexInterleavedView<float> z, coda_oss::span<float> out);
+CODA_OSS_API void power(ComplexParallelView<float> z, coda_oss::span<float> out);
+
+//! out[i] = arg(z[i]) in [-pi, pi]; the SIMD code is within a few ULPs of std::atan2().
+CODA_OSS_API void phase(ComplexInterleavedView<float> z, coda_oss::span<float> out);
+CODA_OSS_API void phase(ComplexParallelView<float> z, coda_oss::span<float> out);
+
+//! accum[i] += scale * z[i]
+CODA_OSS_API void scaleAccumulate(ComplexInterleavedView<float> z, float scale,
+                                  coda_oss::span<std::complex<float>> accum);
+CODA_OSS_API void scaleAccumulate(ComplexParallelView<float> z, float scale,
+                                  coda_oss::span<float> accumReals, coda_oss::span<float> accumImags);
+
+//! Convert between layouts.
+CODA_OSS_API void deinterleave(ComplexInterleavedView<float> z,
+                               coda_oss::span<float> reals, coda_oss::span<float> imags);
+CODA_OSS_API void interleave(ComplexParallelView<float> z, coda_oss::span<std::complex<float>> out);
+
+namespace details
+{
+/*!
+ * The instruction set the kernels are using: AVX2 or Disabled (plain loops).
+ * Setting is for testing and benchmarking; it's not thread-safe with respect
+ * to kernels running at the same time.  Requesting an instruction set the
+ * CPU doesn't have falls back to plain loops.
+ */
+CODA_OSS_API sys::SIMDInstructionSet getComplexKernelsInstructionSet();
+CODA_OSS_API sys::SIMDInstructionSet setComplexKernelsInstructionSet(sys::SIMDInstructionSet);
+}
+}
+
+#endif  // CODA_OSS_mem_ComplexKernels_h_INCLUDED_
@@ -243,6 +243,12 @@ public:
         return std::vector<cxvalue_t_>(data_.begin(), data_.end());
     }
 
+    // The underlying storage (no copy) for code that needs it, e.g., SIMD kernels.
+    span_t_ values_span() const noexcept
+    {
+        return data_;
+    }
+
 private:
     span_t_ data_; // i.e., std::span<const std::complex<float>>
 };
@@ -343,6 +349,16 @@ struct ComplexParallelView final // Two parallel arrays, absolutely nothing to t
         return retval;
     }
 
+    // The underlying storage (no copy) for code that needs it, e.g., SIMD kernels.
+    span_t_ reals_span() const noexcept
+    {
+        return reals_;
+    }
+    span_t_ imags_span() const noexcept
+    {
+        return imags_;
+    }
+
 private:
     span_t_ reals_; // i.e., std::span<const float>
     span_t_ imags_;
@@ -26,12 +26,21 @@
 #include <cstddef>
 
 #include <sys/Conf.h>
+#include <sys/AllocationPolicy.h>
+#include <sys/MemoryAccounting.h>
 
 namespace mem
 {
     /*!
      *  \class ScopedAlignedArray
      *  \brief This class provides RAII for alignedAlloc() and alignedFree()
+     *
+     *  An AllocationPolicy can ask for huge pages and/or a NUMA node for
+     *  large arrays; see sys/AllocationPolicy.h.  The array remembers its
+     *  policy, so memory from release() has to be freed with
+     *  sys::alignedFree(p, getPolicy()) (call getPolicy() before reset()).  With memory accounting
+     *  enabled, the array counts toward "mem::ScopedAlignedArray" (or
+     *  another category, see setMemoryCategory()).
      */
     template <class T>
     struct ScopedAlignedArray
@@ -41,8 +50,18 @@ namespace mem
         explicit ScopedAlignedArray(
             size_t numElements = 0,
             size_t alignment = sys::SSE_INSTRUCTION_ALIGNMENT) :
-            mArray(allocate(numElements, alignment))
+            mArray(allocate(numElements, alignment)),
+            mAccounted(getMemoryCategory())
         {
+            mAccounted.set(numElements * sizeof(T));
+        }
+        ScopedAlignedArray(size_t numElements, size_t alignment,
+                           const sys::AllocationPolicy& policy) :
+            mArray(allocate(numElements, alignment, policy)),
+            mPolicy(policy),
+            mAccounted(getMemoryCategory())
+        {
+            mAccounted.set(numElements * sizeof(T));
         }
 
         ~ScopedAlignedArray()
@@ -53,7 +72,7 @@ namespace mem
                 // in case...
                 try
                 {
-                    sys::alignedFree(mArray);
+                    sys::alignedFree(mArray, mPolicy);
                 }
                 catch (...)
                 {
@@ -66,11 +85,30 @@ namespace mem
         {
             if (mArray)
             {
-                sys::alignedFree(mArray);
+                sys::alignedFree(mArray, mPolicy);
                 mArray = nullptr;
             }
 
+            mAccounted.set(0);
+
+            mPolicy = sys::AllocationPolicy();
             mArray = allocate(numElements, alignment);
+            mAccounted.set(numElements * sizeof(T));
+        }
+        void reset(size_t numElements, size_t alignment,
+                   const sys::AllocationPolicy& policy)
+        {
+            if (mArray)
+            {
+                sys::alignedFree(mArray, mPolicy);
+                mArray = nullptr;
+            }
+
+            mAccounted.set(0);
+
+            mArray = allocate(numElements, alignment, policy);
+            mPolicy = policy;
+            mAccounted.set(numElements * sizeof(T));
         }
 
         T& operator[](std::ptrdiff_t idx) const
@@ -87,21 +125,44 @@ namespace mem
         {
             T* const array = mArray;
             mArray = nullptr;
+            mAccounted.set(0);
             return array;
         }
 
+        //! How the array was allocated; free release()d memory with this
+        const sys::AllocationPolicy& getPolicy() const noexcept
+        {
+            return mPolicy;
+        }
+
+        //! Count this array (now and after any reset()) toward \p category
+        void setMemoryCategory(sys::MemoryCategory& category) noexcept
+        {
+            mAccounted.setCategory(category);
+        }
+
         ScopedAlignedArray(const ScopedAlignedArray&) = delete;
         ScopedAlignedArray& operator=(const ScopedAlignedArray&) = delete;
 
     private:
+        //! "mem::ScopedAlignedArray", for every T
+        static sys::MemoryCategory& getMemoryCategory()
+        {
+            static sys::MemoryCategory& category =
+                sys::getMemoryCategory("mem::ScopedAlignedArray");
+            return category;
+        }
+
         static
-        T* allocate(size_t numElements, size_t alignment)
+        T* allocate(size_t numElements, size_t alignment,
+                    const sys::AllocationPolicy& policy = sys::AllocationPolicy())
         {
             if (numElements > 0)
             {
                 const size_t numBytes(numElements * sizeof(T));
                 return static_cast<T *>(sys::alignedAlloc(numBytes, 
-                                                          alignment));
+                                                          alignment,
+                                                          policy));
             }
             else
             {
@@ -111,6 +172,8 @@ namespace mem
 
     private:
         T* mArray;
+        sys::AllocationPolicy mPolicy;
+        sys::AccountedBytes mAccounted;
     };
 }
 
@@ -33,6 +33,9 @@
 #include <except/Exception.h>
 #include <mem/BufferView.h>
 #include <sys/Conf.h>
+#include <sys/AllocationPolicy.h>
+#include <sys/MemoryAccounting.h>
+#include <mem/ScopedAlignedArray.h>
 #include <config/Exports.h>
 
 namespace mem
@@ -148,6 +151,15 @@ public:
     void setup(const BufferView<sys::ubyte>& scratchBuffer =
             BufferView<sys::ubyte>());
 
+    /*!
+     * \brief Set up with memory allocated internally according to the
+     *        policy, e.g., huge pages for a large scratch buffer.
+     *
+     * \param policy How to allocate the memory; see sys/AllocationPolicy.h.
+     *        The default policy is the same as setup().
+     */
+    void setup(const sys::AllocationPolicy& policy);
+
     /*!
      * \brief Get number of bytes needed to store scratch memory, including the
      *        maximum possible alignment overhead.
@@ -175,8 +187,15 @@ private:
     const Segment& lookupSegment(const std::string& key,
                                  size_t indexBuffer) const;
 
+    //! "mem::ScratchMemory", for memory allocated internally
+    static sys::MemoryCategory& getMemoryCategory();
+
     std::map<std::string, Segment> mSegments;
     std::vector<sys::ubyte> mStorage;
+    sys::AccountedBytes mStorageAccounted{ getMemoryCategory() };
+    ScopedAlignedArray<sys::ubyte> mPolicyStorage;
+    size_t mPolicyStorageSize = 0;
+    sys::AllocationPolicy mPolicy;
     std::vector<std::string> mKeyOrder;
     std::set<std::string> mReleasedKeys;
     std::set<std::string> mConnectedKeys;
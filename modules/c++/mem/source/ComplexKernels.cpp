@@ -0,0 +1,526 @@
+/* =========================================================================
+ * This file is part of mem-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * mem-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mem/ComplexKernels.h"
+
+#include <math.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "sys/OS.h"
+
+#if CODA_OSS_ENABLE_SIMD && (defined(__x86_64__) || defined(_M_X64))
+    #define CODA_OSS_mem_ComplexKernels_AVX2 1
+    #include <immintrin.h>
+    #if defined(__GNUC__) || defined(__clang__)
+        // Compile just these functions for AVX2; they're only called if the CPU has it.
+        #define CODA_OSS_mem_target_avx2 __attribute__((target("avx2")))
+    #else
+        #define CODA_OSS_mem_target_avx2 // MSVC allows AVX2 intrinsics anywhere
+    #endif
+#else
+    #define CODA_OSS_mem_ComplexKernels_AVX2 0
+#endif
+
+namespace
+{
+// Raw loops on pointers: "I" is interleaved (re, im, re, im, ...), "S" is split.
+// Sizes are the number of complex values.
+struct Kernels final
+{
+    void (*conjMultiplyI)(const float*, const float*, float*, size_t);
+    void (*conjMultiplyS)(const float*, const float*, const float*, const float*, float*, float*, size_t);
+    void (*magnitudeI)(const float*, float*, size_t);
+    void (*magnitudeS)(const float*, const float*, float*, size_t);
+    void (*powerI)(const float*, float*, size_t);
+    void (*powerS)(const float*, const float*, float*, size_t);
+    void (*phaseI)(const float*, float*, size_t);
+    void (*phaseS)(const float*, const float*, float*, size_t);
+    void (*scaleAccumulateI)(const float*, float, float*, size_t);
+    void (*scaleAccumulateS)(const float*, const float*, float, float*, float*, size_t);
+    void (*deinterleave)(const float*, float*, float*, size_t);
+    void (*interleave)(const float*, const float*, float*, size_t);
+};
+
+//**********************************************************************
+// Plain loops; simple enough for the compiler to vectorize (at least the split versions).
+
+void conjMultiplyI(const float* a, const float* b, float* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        const auto ar = a[2 * i], ai = a[2 * i + 1];
+        const auto br = b[2 * i], bi = b[2 * i + 1];
+        out[2 * i] = ar * br + ai * bi;
+        out[2 * i + 1] = ai * br - ar * bi;
+    }
+}
+void conjMultiplyS(const float* ar, const float* ai, const float* br, const float* bi, float* outR, float* outI, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        const auto re = ar[i] * br[i] + ai[i] * bi[i];
+        const auto im = ai[i] * br[i] - ar[i] * bi[i];
+        outR[i] = re;
+        outI[i] = im;
+    }
+}
+
+void powerI(const float* z, float* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = z[2 * i] * z[2 * i] + z[2 * i + 1] * z[2 * i + 1];
+    }
+}
+void powerS(const float* re, const float* im, float* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = re[i] * re[i] + im[i] * im[i];
+    }
+}
+
+void magnitudeI(const float* z, float* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = sqrtf(z[2 * i] * z[2 * i] + z[2 * i + 1] * z[2 * i + 1]);
+    }
+}
+void magnitudeS(const float* re, const float* im, float* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = sqrtf(re[i] * re[i] + im[i] * im[i]);
+    }
+}
+
+void phaseI(const float* z, float* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = atan2f(z[2 * i + 1], z[2 * i]);
+    }
+}
+void phaseS(const float* re, const float* im, float* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = atan2f(im[i], re[i]);
+    }
+}
+
+void scaleAccumulateI(const float* z, float scale, float* accum, size_t n)
+{
+    for (size_t i = 0; i < 2 * n; i++)
+    {
+        accum[i] += scale * z[i];
+    }
+}
+void scaleAccumulateS(const float* re, const float* im, float scale, float* accumR, float* accumI, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        accumR[i] += scale * re[i];
+        accumI[i] += scale * im[i];
+    }
+}
+
+void deinterleave(const float* z, float* re, float* im, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        re[i] = z[2 * i];
+        im[i] = z[2 * i + 1];
+    }
+}
+void interleave(const float* re, const float* im, float* z, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        z[2 * i] = re[i];
+        z[2 * i + 1] = im[i];
+    }
+}
+
+const Kernels& scalarKernels()
+{
+    static const Kernels retval{conjMultiplyI, conjMultiplyS, magnitudeI, magnitudeS, powerI, powerS, phaseI, phaseS,
+        scaleAccumulateI, scaleAccumulateS, deinterleave, interleave};
+    return retval;
+}
+
+#if CODA_OSS_mem_ComplexKernels_AVX2
+//**********************************************************************
+// AVX2: 8 complex values at a time; the scalar loops above finish any remainder.
+namespace avx2
+{
+// Load 8 interleaved complex values as 8 reals and 8 imaginaries.
+CODA_OSS_mem_target_avx2 inline void load(const float* z, __m256& re, __m256& im)
+{
+    const auto lo = _mm256_loadu_ps(z); // r0 i0 r1 i1 | r2 i2 r3 i3
+    const auto hi = _mm256_loadu_ps(z + 8); // r4 i4 r5 i5 | r6 i6 r7 i7
+    // r0 r1 r4 r5 | r2 r3 r6 r7, then put the 64-bit pairs back in order
+    re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+    im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+// Store 8 reals and 8 imaginaries as 8 interleaved complex values.
+CODA_OSS_mem_target_avx2 inline void store(float* z, __m256 re, __m256 im)
+{
+    const auto lo = _mm256_unpacklo_ps(re, im); // r0 i0 r1 i1 | r4 i4 r5 i5
+    const auto hi = _mm256_unpackhi_ps(re, im); // r2 i2 r3 i3 | r6 i6 r7 i7
+    _mm256_storeu_ps(z, _mm256_permute2f128_ps(lo, hi, 0x20));
+    _mm256_storeu_ps(z + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+}
+
+CODA_OSS_mem_target_avx2 inline __m256 power(__m256 re, __m256 im)
+{
+    return _mm256_add_ps(_mm256_mul_ps(re, re), _mm256_mul_ps(im, im));
+}
+
+// atan2(y, x) using the Cephes atanf() polynomial after reducing to [0, tan(pi/8)].
+CODA_OSS_mem_target_avx2 inline __m256 atan2(__m256 y, __m256 x)
+{
+    const auto signMask = _mm256_set1_ps(-0.0f);
+    const auto zero = _mm256_setzero_ps();
+    const auto ax = _mm256_andnot_ps(signMask, x);
+    const auto ay = _mm256_andnot_ps(signMask, y);
+    const auto mn = _mm256_min_ps(ax, ay);
+    const auto mx = _mm256_max_ps(ax, ay);
+
+    // a = min/max is in [0, 1]; atan2(0, 0) is 0
+    auto a = _mm256_div_ps(mn, mx);
+    a = _mm256_blendv_ps(a, zero, _mm256_cmp_ps(mx, zero, _CMP_EQ_OQ));
+
+    // atan(a) = pi/4 + atan((a - 1) / (a + 1)) for a > tan(pi/8)
+    const auto one = _mm256_set1_ps(1.0f);
+    const auto big = _mm256_cmp_ps(a, _mm256_set1_ps(0.414213562373095f), _CMP_GT_OQ);
+    a = _mm256_blendv_ps(a, _mm256_div_ps(_mm256_sub_ps(a, one), _mm256_add_ps(a, one)), big);
+    const auto offset = _mm256_and_ps(big, _mm256_set1_ps(0.785398163397448f));
+
+    const auto z = _mm256_mul_ps(a, a);
+    auto p = _mm256_set1_ps(8.05374449538e-2f);
+    p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(-1.38776856032e-1f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(1.99777106478e-1f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(-3.33329491539e-1f));
+    auto r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(p, z), a), a), offset);
+
+    // Undo the octant reduction: swap, then a negative x, then the sign of y.
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(1.57079632679490f), r), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(3.14159265358979f), r), x); // sign bit, so -0 too
+    return _mm256_or_ps(r, _mm256_and_ps(signMask, y));
+}
+
+CODA_OSS_mem_target_avx2 void conjMultiplyI(const float* a, const float* b, float* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 ar, ai, br, bi;
+        load(a + 2 * i, ar, ai);
+        load(b + 2 * i, br, bi);
+        const auto re = _mm256_add_ps(_mm256_mul_ps(ar, br), _mm256_mul_ps(ai, bi));
+        const auto im = _mm256_sub_ps(_mm256_mul_ps(ai, br), _mm256_mul_ps(ar, bi));
+        store(out + 2 * i, re, im);
+    }
+    ::conjMultiplyI(a + 2 * i, b + 2 * i, out + 2 * i, n - i);
+}
+CODA_OSS_mem_target_avx2 void conjMultiplyS(const float* ar, const float* ai, const float* br, const float* bi, float* outR, float* outI, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const auto ar_ = _mm256_loadu_ps(ar + i), ai_ = _mm256_loadu_ps(ai + i);
+        const auto br_ = _mm256_loadu_ps(br + i), bi_ = _mm256_loadu_ps(bi + i);
+        _mm256_storeu_ps(outR + i, _mm256_add_ps(_mm256_mul_ps(ar_, br_), _mm256_mul_ps(ai_, bi_)));
+        _mm256_storeu_ps(outI + i, _mm256_sub_ps(_mm256_mul_ps(ai_, br_), _mm256_mul_ps(ar_, bi_)));
+    }
+    ::conjMultiplyS(ar + i, ai + i, br + i, bi + i, outR + i, outI + i, n - i);
+}
+
+CODA_OSS_mem_target_avx2 void powerI(const float* z, float* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 re, im;
+        load(z + 2 * i, re, im);
+        _mm256_storeu_ps(out + i, power(re, im));
+    }
+    ::powerI(z + 2 * i, out + i, n - i);
+}
+CODA_OSS_mem_target_avx2 void powerS(const float* re, const float* im, float* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(out + i, power(_mm256_loadu_ps(re + i), _mm256_loadu_ps(im + i)));
+    }
+    ::powerS(re + i, im + i, out + i, n - i);
+}
+
+CODA_OSS_mem_target_avx2 void magnitudeI(const float* z, float* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 re, im;
+        load(z + 2 * i, re, im);
+        _mm256_storeu_ps(out + i, _mm256_sqrt_ps(power(re, im)));
+    }
+    ::magnitudeI(z + 2 * i, out + i, n - i);
+}
+CODA_OSS_mem_target_avx2 void magnitudeS(const float* re, const float* im, float* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(out + i, _mm256_sqrt_ps(power(_mm256_loadu_ps(re + i), _mm256_loadu_ps(im + i))));
+    }
+    ::magnitudeS(re + i, im + i, out + i, n - i);
+}
+
+CODA_OSS_mem_target_avx2 void phaseI(const float* z, float* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 re, im;
+        load(z + 2 * i, re, im);
+        _mm256_storeu_ps(out + i, atan2(im, re));
+    }
+    ::phaseI(z + 2 * i, out + i, n - i);
+}
+CODA_OSS_mem_target_avx2 void phaseS(const float* re, const float* im, float* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(out + i, atan2(_mm256_loadu_ps(im + i), _mm256_loadu_ps(re + i)));
+    }
+    ::phaseS(re + i, im + i, out + i, n - i);
+}
+
+CODA_OSS_mem_target_avx2 void scaleAccumulateI(const float* z, float scale, float* accum, size_t n)
+{
+    // The layout doesn't matter: every float is scaled the same.
+    const auto scale_ = _mm256_set1_ps(scale);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const auto sum = _mm256_add_ps(_mm256_loadu_ps(accum + 2 * i), _mm256_mul_ps(scale_, _mm256_loadu_ps(z + 2 * i)));
+        _mm256_storeu_ps(accum + 2 * i, sum);
+    }
+    ::scaleAccumulateI(z + 2 * i, scale, accum + 2 * i, n - i);
+}
+CODA_OSS_mem_target_avx2 void scaleAccumulateS(const float* re, const float* im, float scale, float* accumR, float* accumI, size_t n)
+{
+    const auto scale_ = _mm256_set1_ps(scale);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(accumR + i, _mm256_add_ps(_mm256_loadu_ps(accumR + i), _mm256_mul_ps(scale_, _mm256_loadu_ps(re + i))));
+        _mm256_storeu_ps(accumI + i, _mm256_add_ps(_mm256_loadu_ps(accumI + i), _mm256_mul_ps(scale_, _mm256_loadu_ps(im + i))));
+    }
+    ::scaleAccumulateS(re + i, im + i, scale, accumR + i, accumI + i, n - i);
+}
+
+CODA_OSS_mem_target_avx2 void deinterleave(const float* z, float* re, float* im, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 re_, im_;
+        load(z + 2 * i, re_, im_);
+        _mm256_storeu_ps(re + i, re_);
+        _mm256_storeu_ps(im + i, im_);
+    }
+    ::deinterleave(z + 2 * i, re + i, im + i, n - i);
+}
+CODA_OSS_mem_target_avx2 void interleave(const float* re, const float* im, float* z, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        store(z + 2 * i, _mm256_loadu_ps(re + i), _mm256_loadu_ps(im + i));
+    }
+    ::interleave(re + i, im + i, z + 2 * i, n - i);
+}
+}
+
+const Kernels& avx2Kernels()
+{
+    static const Kernels retval{avx2::conjMultiplyI, avx2::conjMultiplyS, avx2::magnitudeI, avx2::magnitudeS,
+        avx2::powerI, avx2::powerS, avx2::phaseI, avx2::phaseS, avx2::scaleAccumulateI, avx2::scaleAccumulateS,
+        avx2::deinterleave, avx2::interleave};
+    return retval;
+}
+#endif // CODA_OSS_mem_ComplexKernels_AVX2
+
+//**********************************************************************
+
+bool haveAVX2()
+{
+#if CODA_OSS_mem_ComplexKernels_AVX2
+    const auto instructionSet = sys::OS().getSIMDInstructionSet();
+    return (instructionSet == sys::SIMDInstructionSet::AVX2) || (instructionSet == sys::SIMDInstructionSet::AVX512F);
+#else
+    return false;
+#endif
+}
+
+const Kernels* findKernels(sys::SIMDInstructionSet instructionSet)
+{
+#if CODA_OSS_mem_ComplexKernels_AVX2
+    static const auto avx2 = haveAVX2();
+    if (avx2 && ((instructionSet == sys::SIMDInstructionSet::AVX2) || (instructionSet == sys::SIMDInstructionSet::AVX512F)))
+    {
+        return &avx2Kernels();
+    }
+#else
+    static_cast<void>(instructionSet);
+#endif
+    return &scalarKernels();
+}
+
+std::atomic<const Kernels*>& currentKernels()
+{
+    static std::atomic<const Kernels*> retval{findKernels(haveAVX2() ? sys::SIMDInstructionSet::AVX2 : sys::SIMDInstructionSet::Disabled)};
+    return retval;
+}
+const Kernels& kernels()
+{
+    return *currentKernels().load(std::memory_order_relaxed);
+}
+
+template <typename TSpan>
+float* data(TSpan s) // std::complex<float> is guaranteed to be float[2]
+{
+    return reinterpret_cast<float*>(s.data());
+}
+template <typename TSpan>
+const float* cdata(TSpan s)
+{
+    return reinterpret_cast<const float*>(s.data());
+}
+
+void checkSize(size_t expected, size_t actual)
+{
+    if (expected != actual)
+    {
+        throw std::invalid_argument("complex kernel inputs and outputs must be the same size.");
+    }
+}
+}
+
+//**********************************************************************
+
+void mem::conjMultiply(ComplexInterleavedView<float> a, ComplexInterleavedView<float> b, coda_oss::span<std::complex<float>> out)
+{
+    checkSize(a.size(), b.size());
+    checkSize(a.size(), out.size());
+    kernels().conjMultiplyI(cdata(a.values_span()), cdata(b.values_span()), data(out), a.size());
+}
+void mem::conjMultiply(ComplexParallelView<float> a, ComplexParallelView<float> b, coda_oss::span<float> outReals, coda_oss::span<float> outImags)
+{
+    checkSize(a.size(), b.size());
+    checkSize(a.size(), outReals.size());
+    checkSize(a.size(), outImags.size());
+    kernels().conjMultiplyS(a.reals_span().data(), a.imags_span().data(), b.reals_span().data(), b.imags_span().data(),
+        outReals.data(), outImags.data(), a.size());
+}
+
+void mem::magnitude(ComplexInterleavedView<float> z, coda_oss::span<float> out)
+{
+    checkSize(z.size(), out.size());
+    kernels().magnitudeI(cdata(z.values_span()), out.data(), z.size());
+}
+void mem::magnitude(ComplexParallelView<float> z, coda_oss::span<float> out)
+{
+    checkSize(z.size(), out.size());
+    kernels().magnitudeS(z.reals_span().data(), z.imags_span().data(), out.data(), z.size());
+}
+
+void mem::power(ComplexInterleavedView<float> z, coda_oss::span<float> out)
+{
+    checkSize(z.size(), out.size());
+    kernels().powerI(cdata(z.values_span()), out.data(), z.size());
+}
+void mem::power(ComplexParallelView<float> z, coda_oss::span<float> out)
+{
+    checkSize(z.size(), out.size());
+    kernels().powerS(z.reals_span().data(), z.imags_span().data(), out.data(), z.size());
+}
+
+void mem::phase(ComplexInterleavedView<float> z, coda_oss::span<float> out)
+{
+    checkSize(z.size(), out.size());
+    kernels().phaseI(cdata(z.values_span()), out.data(), z.size());
+}
+void mem::phase(ComplexParallelView<float> z, coda_oss::span<float> out)
+{
+    checkSize(z.size(), out.size());
+    kernels().phaseS(z.reals_span().data(), z.imags_span().data(), out.data(), z.size());
+}
+
+void mem::scaleAccumulate(ComplexInterleavedView<float> z, float scale, coda_oss::span<std::complex<float>> accum)
+{
+    checkSize(z.size(), accum.size());
+    kernels().scaleAccumulateI(cdata(z.values_span()), scale, data(accum), z.size());
+}
+void mem::scaleAccumulate(ComplexParallelView<float> z, float scale, coda_oss::span<float> accumReals, coda_oss::span<float> accumImags)
+{
+    checkSize(z.size(), accumReals.size());
+    checkSize(z.size(), accumImags.size());
+    kernels().scaleAccumulateS(z.reals_span().data(), z.imags_span().data(), scale, accumReals.data(), accumImags.data(), z.size());
+}
+
+void mem::deinterleave(ComplexInterleavedView<float> z, coda_oss::span<float> reals, coda_oss::span<float> imags)
+{
+    checkSize(z.size(), reals.size());
+    checkSize(z.size(), imags.size());
+    kernels().deinterleave(cdata(z.values_span()), reals.data(), imags.data(), z.size());
+}
+void mem::interleave(ComplexParallelView<float> z, coda_oss::span<std::complex<float>> out)
+{
+    checkSize(z.size(), out.size());
+    kernels().interleave(z.reals_span().data(), z.imags_span().data(), data(out), z.size());
+}
+
+sys::SIMDInstructionSet mem::details::getComplexKernelsInstructionSet()
+{
+#if CODA_OSS_mem_ComplexKernels_AVX2
+    if (&kernels() == &avx2Kernels())
+    {
+        return sys::SIMDInstructionSet::AVX2;
+    }
+#endif
+    return sys::SIMDInstructionSet::Disabled;
+}
+sys::SIMDInstructionSet mem::details::setComplexKernelsInstructionSet(sys::SIMDInstructionSet instructionSet)
+{
+    const auto retval = getComplexKernelsInstructionSet();
+    currentKernels().store(findKernels(instructionSet));
+    return retval;
+}
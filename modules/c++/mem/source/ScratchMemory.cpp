@@ -164,12 +164,50 @@ void ScratchMemory::release(const std::string& key)
     }
 }
 
+sys::MemoryCategory& ScratchMemory::getMemoryCategory()
+{
+    static sys::MemoryCategory& category = sys::getMemoryCategory("mem::ScratchMemory");
+    return category;
+}
+
+void ScratchMemory::setup(const sys::AllocationPolicy& policy)
+{
+    if (policy.isDefault())
+    {
+        setup();
+        return;
+    }
+
+    // Like mStorage, only reallocate to grow (or to change the policy).
+    if ((mPolicyStorageSize < mNumBytesNeeded) || (mPolicy != policy))
+    {
+        mPolicyStorage.setMemoryCategory(getMemoryCategory());
+        mPolicyStorage.reset(mNumBytesNeeded, sys::SSE_INSTRUCTION_ALIGNMENT, policy);
+        mPolicyStorageSize = mNumBytesNeeded;
+        mPolicy = policy;
+    }
+    std::vector<sys::ubyte>().swap(mStorage);
+    mStorageAccounted.set(0);
+
+    if (mNumBytesNeeded > 0)
+    {
+        setup(BufferView<sys::ubyte>(mPolicyStorage.get(), mPolicyStorageSize));
+    }
+    else
+    {
+        setup();
+    }
+}
+
 void ScratchMemory::setup(const BufferView<sys::ubyte>& scratchBuffer)
 {
     if (scratchBuffer.size == 0)
     {
+        mPolicyStorage.reset();
+        mPolicyStorageSize = 0;
         // allocate the storage internally
         mStorage.resize(mNumBytesNeeded);
+        mStorageAccounted.set(mStorage.capacity());
         mBuffer = mem::BufferView<sys::ubyte>(mStorage.data(), mStorage.size());
     }
     else
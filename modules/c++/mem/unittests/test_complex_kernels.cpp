@@ -0,0 +1,171 @@
+/* =========================================================================
+ * This file is part of mem-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * mem-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <mem/ComplexKernels.h>
+
+#include "TestCase.h"
+
+using cx_float = std::complex<float>;
+
+static std::vector<cx_float> make_data(size_t n, float seed)
+{
+    // hit all four quadrants, the axes and zero
+    std::vector<cx_float> retval(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        const auto angle = seed + static_cast<float>(i) * 0.7853981f * 0.5f;
+        const auto radius = (i % 11 == 0) ? 0.0f : static_cast<float>(i % 7) + 0.5f;
+        retval[i] = std::polar(radius, angle);
+    }
+    if (n > 3)
+    {
+        retval[1] = cx_float(-2.0f, 0.0f);
+        retval[2] = cx_float(0.0f, -3.0f);
+        retval[3] = cx_float(-1.0f, -0.0f);
+    }
+    return retval;
+}
+
+static void split(const std::vector<cx_float>& z, std::vector<float>& reals, std::vector<float>& imags)
+{
+    reals.resize(z.size());
+    imags.resize(z.size());
+    for (size_t i = 0; i < z.size(); i++)
+    {
+        reals[i] = z[i].real();
+        imags[i] = z[i].imag();
+    }
+}
+
+static void test_kernels(const std::string& testName, size_t n)
+{
+    const auto a = make_data(n, 0.1f);
+    const auto b = make_data(n, -0.3f);
+    std::vector<float> aReals, aImags, bReals, bImags;
+    split(a, aReals, aImags);
+    split(b, bReals, bImags);
+    const auto aI = mem::make_ComplexInterleavedView(a);
+    const auto bI = mem::make_ComplexInterleavedView(b);
+    const auto aS = mem::make_ComplexParallelView(aReals, aImags);
+    const auto bS = mem::make_ComplexParallelView(bReals, bImags);
+
+    std::vector<cx_float> outI(n);
+    std::vector<float> outR(n), outIm(n), out(n), out2(n);
+    const auto tolerance = 1e-5f;
+
+    mem::conjMultiply(aI, bI, outI);
+    mem::conjMultiply(aS, bS, outR, outIm);
+    for (size_t i = 0; i < n; i++)
+    {
+        const auto expected = a[i] * std::conj(b[i]);
+        TEST_ASSERT_ALMOST_EQ_EPS(outI[i].real(), expected.real(), tolerance);
+        TEST_ASSERT_ALMOST_EQ_EPS(outI[i].imag(), expected.imag(), tolerance);
+        TEST_ASSERT_EQ(outR[i], outI[i].real());
+        TEST_ASSERT_EQ(outIm[i], outI[i].imag());
+    }
+
+    mem::power(aI, out);
+    mem::power(aS, out2);
+    for (size_t i = 0; i < n; i++)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(out[i], std::norm(a[i]), tolerance);
+        TEST_ASSERT_EQ(out[i], out2[i]);
+    }
+
+    mem::magnitude(aI, out);
+    mem::magnitude(aS, out2);
+    for (size_t i = 0; i < n; i++)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(out[i], std::abs(a[i]), tolerance);
+        TEST_ASSERT_EQ(out[i], out2[i]);
+    }
+
+    mem::phase(aI, out);
+    mem::phase(aS, out2);
+    for (size_t i = 0; i < n; i++)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(out[i], std::arg(a[i]), 1e-6f);
+        TEST_ASSERT_EQ(out[i], out2[i]);
+    }
+
+    std::vector<cx_float> accumI(b);
+    std::vector<float> accumR(bReals), accumIm(bImags);
+    mem::scaleAccumulate(aI, 0.5f, accumI);
+    mem::scaleAccumulate(aS, 0.5f, accumR, accumIm);
+    for (size_t i = 0; i < n; i++)
+    {
+        const auto expected = b[i] + 0.5f * a[i];
+        TEST_ASSERT_ALMOST_EQ_EPS(accumI[i].real(), expected.real(), tolerance);
+        TEST_ASSERT_ALMOST_EQ_EPS(accumI[i].imag(), expected.imag(), tolerance);
+        TEST_ASSERT_EQ(accumR[i], accumI[i].real());
+        TEST_ASSERT_EQ(accumIm[i], accumI[i].imag());
+    }
+
+    mem::deinterleave(aI, outR, outIm);
+    TEST_ASSERT(outR == aReals);
+    TEST_ASSERT(outIm == aImags);
+    mem::interleave(aS, outI);
+    TEST_ASSERT(outI == a);
+}
+
+static void test_all_sizes(const std::string& testName)
+{
+    // exercise both the vectorized loops and the scalar remainders
+    for (const size_t n : {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 100, 1001})
+    {
+        test_kernels(testName, n);
+    }
+}
+
+TEST_CASE(testComplexKernelsScalar)
+{
+    const auto previous = mem::details::setComplexKernelsInstructionSet(sys::SIMDInstructionSet::Disabled);
+    TEST_ASSERT(mem::details::getComplexKernelsInstructionSet() == sys::SIMDInstructionSet::Disabled);
+    test_all_sizes(testName);
+    mem::details::setComplexKernelsInstructionSet(previous);
+}
+
+TEST_CASE(testComplexKernelsSIMD)
+{
+    const auto previous = mem::details::setComplexKernelsInstructionSet(sys::SIMDInstructionSet::AVX2);
+    test_all_sizes(testName); // plain loops if AVX2 isn't available
+    mem::details::setComplexKernelsInstructionSet(previous);
+}
+
+TEST_CASE(testComplexKernelsSize)
+{
+    const auto a = make_data(10, 0.0f);
+    std::vector<cx_float> out(9);
+    TEST_THROWS(mem::conjMultiply(mem::make_ComplexInterleavedView(a), mem::make_ComplexInterleavedView(a), out));
+    std::vector<float> mag(11);
+    TEST_THROWS(mem::magnitude(mem::make_ComplexInterleavedView(a), mag));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testComplexKernelsScalar);
+    TEST_CHECK(testComplexKernelsSIMD);
+    TEST_CHECK(testComplexKernelsSize);
+    )
@@ -621,6 +621,33 @@ TEST_CASE(testScratchMemory)
     TEST_EXCEPTION(scratch.setup(invalidBuffer));
 }
 
+TEST_CASE(testSetupWithPolicy)
+{
+    mem::ScratchMemory scratch;
+    scratch.put<float>("buf0", 1024 * 1024, 2, 64);
+    scratch.put<int>("buf1", 100);
+
+    sys::AllocationPolicy policy;
+    policy.hugePages = sys::HugePages::Transparent;
+    policy.prefault = true;
+    scratch.setup(policy);
+    float* const pBuf0 = scratch.get<float>("buf0", 1);
+    int* const pBuf1 = scratch.get<int>("buf1");
+    TEST_ASSERT_EQ(reinterpret_cast<size_t>(pBuf0) % 64, static_cast<size_t>(0));
+    TEST_ASSERT_EQ(pBuf0[1024 * 1024 - 1], 0.0f);
+    TEST_ASSERT_EQ(pBuf1[99], 0);
+    pBuf0[0] = 1.0f;
+
+    // same size and policy: same memory
+    scratch.setup(policy);
+    TEST_ASSERT_EQ(scratch.get<float>("buf0", 1), pBuf0);
+    TEST_ASSERT_EQ(pBuf0[0], 1.0f);
+
+    // back to the default
+    scratch.setup(sys::AllocationPolicy());
+    TEST_ASSERT_EQ(scratch.get<int>("buf1")[99], 0);
+}
+
 TEST_MAIN(
     TEST_CHECK(testScratchMemory);
     TEST_CHECK(testReleaseSingleEndBuffer);
@@ -630,4 +657,5 @@ TEST_MAIN(
     TEST_CHECK(testReleaseConcurrentKeys);
     TEST_CHECK(testReleaseConnectedKeys);
     TEST_CHECK(testGenerateBuffersForRelease);
+    TEST_CHECK(testSetupWithPolicy);
     )
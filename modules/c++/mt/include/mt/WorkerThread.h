@@ -26,6 +26,7 @@
 
 
 #include "sys/Thread.h"
+#include "sys/Trace.h"
 #include "mt/RequestQueue.h"
 
 
@@ -72,6 +73,7 @@ public:
             // Pull a runnable off the queue
             Request_T req;
             mRequestQueue->dequeue(req);
+            CODA_OSS_TRACE_ZONE("mt::WorkerThread::performTask");
             performTask(req);
         }
     }
@@ -22,6 +22,7 @@
 
 
 #include "mt/GenerationThreadPool.h"
+#include "sys/Trace.h"
 #if !defined(__APPLE_CC__)
 
 mt::TiedRequestHandler::~TiedRequestHandler() 
@@ -56,7 +57,10 @@ void mt::TiedRequestHandler::run()
 	if (!handler) return;
 	
 	// Run the runnable that we pulled off the queue
-	handler->run();
+	{
+	    CODA_OSS_TRACE_ZONE("mt::TiedRequestHandler::run");
+	    handler->run();
+	}
 	
 	// Delete the runnable we pulled off the queue
 	delete handler;
@@ -23,6 +23,7 @@
 #include <memory>
 
 #include "mt/GenericRequestHandler.h"
+#include "sys/Trace.h"
 
 void mt::GenericRequestHandler::run()
 {
@@ -39,6 +40,7 @@ void mt::GenericRequestHandler::run()
         // Run the runnable that we pulled off the queue
         // It will get deleted when it goes out of scope below
         std::unique_ptr<sys::Runnable> scopedHandler(handler);
+        CODA_OSS_TRACE_ZONE("mt::GenericRequestHandler::run");
         scopedHandler->run();
     }
 }
@@ -23,6 +23,7 @@
 
 #include <mt/ThreadGroup.h>
 #include <mt/CriticalSection.h>
+#include <sys/Trace.h>
 
 namespace mt
 {
@@ -144,6 +145,7 @@ void ThreadGroup::ThreadGroupRunnable::run()
         {
             mCPUInit->initialize();
         }
+        CODA_OSS_TRACE_ZONE("mt::ThreadGroup::run");
         mRunnable->run();
     }
     catch(const except::Exception& ex)
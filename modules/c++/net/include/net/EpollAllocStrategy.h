@@ -0,0 +1,129 @@
+/* =========================================================================
+ * This file is part of net-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * net-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+#ifndef CODA_OSS_net_EpollAllocStrategy_h_INCLUDED_
+#define CODA_OSS_net_EpollAllocStrategy_h_INCLUDED_
+
+// epoll(7) is Linux-only
+#if defined(__linux__)
+
+#include <stddef.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "sys/Mutex.h"
+#include "mt/RequestQueue.h"
+#include "net/NetConnection.h"
+#include "net/AllocStrategy.h"
+#include "net/RequestHandler.h"
+
+namespace net
+{
+/*!
+ *  \class EpollAllocStrategy
+ *  \brief Event-driven AllocStrategy for many mostly idle connections
+ *
+ *  The other strategies tie up a thread for as long as a request handler
+ *  is blocked on its connection.  Here, connections are instead watched
+ *  by a few I/O threads, each with its own epoll instance, and only when
+ *  a connection has data waiting is it queued for a (fixed size) pool of
+ *  workers.  Each worker has its own RequestHandler, as with
+ *  ThreadPoolAllocStrategy.
+ *
+ *  A handler is called once per request, not once per connection: after
+ *  it returns, the connection goes back to its I/O thread to wait for
+ *  the next request.  A connection is deleted once the peer closes it,
+ *  the handler closes it, or the handler throws.
+ *
+ *  Sockets stay in blocking mode so that existing handlers work as-is;
+ *  the I/O threads only ever do non-blocking peeks.  So that a peer that
+ *  sends only part of a request can't hold a worker forever, accepted
+ *  sockets get a receive timeout (SO_RCVTIMEO): a blocked recv() then
+ *  fails instead of waiting.  Since the handler may have given up
+ *  part-way through a request, a connection whose exchange took longer
+ *  than the timeout is closed rather than watched again.
+ *
+ *  Destroying the strategy shuts down every open connection, so handlers
+ *  still blocked on one return promptly; requests not yet answered are
+ *  dropped.
+ */
+class EpollAllocStrategy : public AllocStrategy
+{
+public:
+    /*!
+     *  \param numIOThreads  Number of threads waiting on connections
+     *  \param numWorkers  Number of threads running request handlers
+     *  \param readTimeout  How long a handler may block waiting on its
+     *         peer; zero for no limit
+     */
+    EpollAllocStrategy(unsigned short numIOThreads, unsigned short numWorkers,
+                       std::chrono::milliseconds readTimeout = std::chrono::seconds(30));
+
+    //! Stops all of the threads and closes any remaining connections
+    ~EpollAllocStrategy();
+
+    EpollAllocStrategy(const EpollAllocStrategy&) = delete;
+    EpollAllocStrategy& operator=(const EpollAllocStrategy&) = delete;
+
+    void initialize() override;
+
+    /*!
+     *  Start watching a connection; this never blocks.  We take ownership
+     *  of the connection.
+     *
+     *  \param conn The connection
+     */
+    void handleConnection(net::NetConnection* conn) override;
+
+    //! Number of connections currently open
+    size_t getNumConnections() const;
+
+private:
+    class IOThread;
+    class WorkerThread;
+    struct Connection;
+
+    void watch(Connection* conn);
+    void release(Connection* conn);
+
+    const unsigned short mNumIOThreads;
+    const unsigned short mNumWorkers;
+    const std::chrono::milliseconds mReadTimeout;
+
+    std::vector<std::unique_ptr<IOThread> > mIOThreads;
+    std::vector<std::unique_ptr<WorkerThread> > mWorkers;
+    mt::RequestQueue<Connection*> mReady;
+    std::atomic<size_t> mNextIOThread{0};
+
+    mutable sys::Mutex mConnectionsLock;
+    std::unordered_set<Connection*> mConnections;
+};
+}
+
+#endif // __linux__
+#endif // CODA_OSS_net_EpollAllocStrategy_h_INCLUDED_
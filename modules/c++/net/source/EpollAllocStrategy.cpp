@@ -0,0 +1,387 @@
+/* =========================================================================
+ * This file is part of net-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * net-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "net/EpollAllocStrategy.h"
+
+#if defined(__linux__)
+
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#include "sys/SystemException.h"
+#include "sys/Thread.h"
+#include "mt/CriticalSection.h"
+
+namespace net
+{
+struct EpollAllocStrategy::Connection final
+{
+    std::unique_ptr<NetConnection> conn;
+    IOThread* ioThread;
+};
+
+/*!
+ *  Waits on an epoll instance and queues connections that have data.
+ *  Connections are registered with EPOLLONESHOT, so a connection isn't
+ *  reported again until a worker is done with it and re-arms it.
+ */
+class EpollAllocStrategy::IOThread final : public sys::Thread
+{
+public:
+    explicit IOThread(EpollAllocStrategy& strategy) :
+        mStrategy(strategy),
+        mEpoll(::epoll_create1(EPOLL_CLOEXEC)),
+        mWakeup(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+    {
+        if (mEpoll < 0 || mWakeup < 0)
+        {
+            closeHandles();
+            throw sys::SystemException(Ctxt("Unable to create epoll instance"));
+        }
+
+        // A null pointer marks the wakeup event
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        if (::epoll_ctl(mEpoll, EPOLL_CTL_ADD, mWakeup, &event) != 0)
+        {
+            closeHandles();
+            throw sys::SystemException(Ctxt("Unable to watch eventfd"));
+        }
+    }
+
+    ~IOThread()
+    {
+        closeHandles();
+    }
+
+    IOThread(const IOThread&) = delete;
+    IOThread& operator=(const IOThread&) = delete;
+
+    bool add(Connection* conn)
+    {
+        return control(EPOLL_CTL_ADD, conn);
+    }
+
+    bool rearm(Connection* conn)
+    {
+        return control(EPOLL_CTL_MOD, conn);
+    }
+
+    void remove(Connection* conn)
+    {
+        const auto fd = conn->conn->getSocket()->getHandle();
+        if (fd != INVALID_SOCKET)
+        {
+            epoll_event event{};
+            ::epoll_ctl(mEpoll, EPOLL_CTL_DEL, fd, &event);
+        }
+    }
+
+    void stop()
+    {
+        const uint64_t one = 1;
+        if (::write(mWakeup, &one, sizeof(one)) < 0)
+        {
+            throw sys::SystemException(Ctxt("Unable to wake I/O thread"));
+        }
+    }
+
+    void run() override
+    {
+        epoll_event events[64];
+        while (true)
+        {
+            const int numEvents = ::epoll_wait(mEpoll, events, 64, -1);
+            if (numEvents < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return;
+            }
+
+            for (int ii = 0; ii < numEvents; ++ii)
+            {
+                auto conn = static_cast<Connection*>(events[ii].data.ptr);
+                if (conn == nullptr)
+                {
+                    return;
+                }
+                dispatch(conn);
+            }
+        }
+    }
+
+private:
+    bool control(int op, Connection* conn)
+    {
+        const auto fd = conn->conn->getSocket()->getHandle();
+        if (fd == INVALID_SOCKET)
+        {
+            return false;
+        }
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        event.data.ptr = conn;
+        return ::epoll_ctl(mEpoll, op, fd, &event) == 0;
+    }
+
+    // Hand the connection to a worker if there's a request waiting, drop it
+    // if the peer went away.
+    void dispatch(Connection* conn)
+    {
+        const auto fd = conn->conn->getSocket()->getHandle();
+        char c;
+        const auto rv = ::recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+        if (rv > 0)
+        {
+            mStrategy.mReady.enqueue(conn);
+        }
+        else if (rv < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+        {
+            if (!rearm(conn))
+            {
+                mStrategy.release(conn);
+            }
+        }
+        else
+        {
+            mStrategy.release(conn);
+        }
+    }
+
+    void closeHandles()
+    {
+        if (mWakeup >= 0)
+        {
+            ::close(mWakeup);
+            mWakeup = -1;
+        }
+        if (mEpoll >= 0)
+        {
+            ::close(mEpoll);
+            mEpoll = -1;
+        }
+    }
+
+    EpollAllocStrategy& mStrategy;
+    int mEpoll;
+    int mWakeup;
+};
+
+/*!
+ *  Runs requests with its own RequestHandler, then hands the connection
+ *  back to its I/O thread.  A null connection tells the thread to exit.
+ */
+class EpollAllocStrategy::WorkerThread final : public sys::Thread
+{
+public:
+    WorkerThread(EpollAllocStrategy& strategy, RequestHandler* handler) :
+        mStrategy(strategy), mHandler(handler)
+    {
+    }
+
+    WorkerThread(const WorkerThread&) = delete;
+    WorkerThread& operator=(const WorkerThread&) = delete;
+
+    void run() override
+    {
+        while (true)
+        {
+            Connection* conn = nullptr;
+            mStrategy.mReady.dequeue(conn);
+            if (conn == nullptr)
+            {
+                return;
+            }
+
+            bool keep = true;
+            const auto start = std::chrono::steady_clock::now();
+            try
+            {
+                (*mHandler)(conn->conn.get());
+            }
+            catch (...)
+            {
+                // There's nobody to report this to; the best we can do
+                // is not leave the peer waiting on a broken exchange.
+                keep = false;
+            }
+
+            // A recv() may have timed out part-way through the request, in
+            // which case the rest of it would be read as the next one.
+            const auto timeout = mStrategy.mReadTimeout;
+            if (timeout.count() > 0 &&
+                std::chrono::steady_clock::now() - start >= timeout)
+            {
+                keep = false;
+            }
+            if (!keep || !conn->ioThread->rearm(conn))
+            {
+                mStrategy.release(conn);
+            }
+        }
+    }
+
+private:
+    EpollAllocStrategy& mStrategy;
+    std::unique_ptr<RequestHandler> mHandler;
+};
+
+EpollAllocStrategy::EpollAllocStrategy(unsigned short numIOThreads,
+                                       unsigned short numWorkers,
+                                       std::chrono::milliseconds readTimeout) :
+    mNumIOThreads(numIOThreads == 0 ? 1 : numIOThreads),
+    mNumWorkers(numWorkers == 0 ? 1 : numWorkers),
+    mReadTimeout(readTimeout.count() < 0 ? std::chrono::milliseconds(0) : readTimeout)
+{
+}
+
+EpollAllocStrategy::~EpollAllocStrategy()
+{
+    try
+    {
+        // Stop watching first so nothing else is queued for the workers.
+        for (auto& ioThread : mIOThreads)
+        {
+            ioThread->stop();
+        }
+        for (auto& ioThread : mIOThreads)
+        {
+            ioThread->join();
+        }
+
+        // A handler may be blocked on a peer that never sends anything
+        // more; shutting the sockets down makes its recv() return.
+        // Connections are only deleted after they're erased from the set,
+        // so everything in it is still valid while we hold the lock.
+        {
+            mt::CriticalSection<sys::Mutex> lock(&mConnectionsLock);
+            for (auto conn : mConnections)
+            {
+                const auto fd = conn->conn->getSocket()->getHandle();
+                if (fd != INVALID_SOCKET)
+                {
+                    ::shutdown(fd, SHUT_RDWR);
+                }
+            }
+        }
+
+        for (size_t ii = 0; ii < mWorkers.size(); ++ii)
+        {
+            mReady.enqueue(nullptr);
+        }
+        for (auto& worker : mWorkers)
+        {
+            worker->join();
+        }
+    }
+    catch (...)
+    {
+    }
+
+    for (auto conn : mConnections)
+    {
+        delete conn;
+    }
+}
+
+void EpollAllocStrategy::initialize()
+{
+    if (mRequestHandlerFactory == nullptr)
+    {
+        throw except::NullPointerReference(Ctxt("No request handler factory"));
+    }
+
+    for (unsigned short ii = 0; ii < mNumWorkers; ++ii)
+    {
+        mWorkers.emplace_back(new WorkerThread(*this, mRequestHandlerFactory->create()));
+        mWorkers.back()->start();
+    }
+    for (unsigned short ii = 0; ii < mNumIOThreads; ++ii)
+    {
+        mIOThreads.emplace_back(new IOThread(*this));
+        mIOThreads.back()->start();
+    }
+}
+
+void EpollAllocStrategy::handleConnection(NetConnection* conn)
+{
+    std::unique_ptr<Connection> connection(new Connection());
+    connection->conn.reset(conn);
+    if (mIOThreads.empty())
+    {
+        throw except::Exception(Ctxt("initialize() has not been called"));
+    }
+    if (mReadTimeout.count() > 0)
+    {
+        timeval timeout{};
+        timeout.tv_sec = static_cast<time_t>(mReadTimeout.count() / 1000);
+        timeout.tv_usec = static_cast<suseconds_t>((mReadTimeout.count() % 1000) * 1000);
+        conn->getSocket()->setOption(SOL_SOCKET, SO_RCVTIMEO, timeout);
+    }
+    connection->ioThread = mIOThreads[mNextIOThread++ % mIOThreads.size()].get();
+    watch(connection.release());
+}
+
+void EpollAllocStrategy::watch(Connection* conn)
+{
+    {
+        mt::CriticalSection<sys::Mutex> lock(&mConnectionsLock);
+        mConnections.insert(conn);
+    }
+
+    // Once it's added, an I/O thread may already be using it
+    if (!conn->ioThread->add(conn))
+    {
+        const sys::SystemException ex(Ctxt("Unable to watch connection"));
+        release(conn);
+        throw ex;
+    }
+}
+
+void EpollAllocStrategy::release(Connection* conn)
+{
+    conn->ioThread->remove(conn);
+    {
+        mt::CriticalSection<sys::Mutex> lock(&mConnectionsLock);
+        mConnections.erase(conn);
+    }
+    delete conn;
+}
+
+size_t EpollAllocStrategy::getNumConnections() const
+{
+    mt::CriticalSection<sys::Mutex> lock(&mConnectionsLock);
+    return mConnections.size();
+}
+}
+
+#endif // __linux__
@@ -0,0 +1,222 @@
+/* =========================================================================
+ * This file is part of net-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * net-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*!
+ *  \file
+ *  \brief Loopback load test of net::EpollAllocStrategy
+ *
+ *  Opens many connections to an echo server, holds them all open, then
+ *  sends requests round-robin across them.  Reports the rate at which
+ *  connections were accepted and the request latency percentiles.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <str/Convert.h>
+#include <sys/Conf.h>
+#include <sys/OS.h>
+#include <sys/Path.h>
+#include <sys/Thread.h>
+#include <mt/Runnable1D.h>
+#include <net/ClientSocketFactory.h>
+#include <net/ServerSocketFactory.h>
+#include <net/EpollAllocStrategy.h>
+
+#if defined(__linux__)
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+// Reads a length-prefixed message and echoes it back
+class EchoHandler final : public net::RequestHandler
+{
+public:
+    void operator()(net::NetConnection* conn) override
+    {
+        auto socket = conn->getSocket();
+        uint32_t length;
+        socket->recv(&length, sizeof(length), MSG_WAITALL);
+        mBuffer.resize(sizeof(length) + length);
+        memcpy(mBuffer.data(), &length, sizeof(length));
+        socket->recv(mBuffer.data() + sizeof(length), length, MSG_WAITALL);
+
+        // One send, so that Nagle's algorithm doesn't hold up the reply
+        socket->send(mBuffer.data(), mBuffer.size());
+    }
+
+private:
+    std::vector<sys::ubyte> mBuffer;
+};
+
+// Accepts a fixed number of connections, then exits
+class Acceptor final : public sys::Thread
+{
+public:
+    Acceptor(net::Socket& server, net::AllocStrategy& strategy, size_t numConnections) :
+        mServer(server), mStrategy(strategy), mNumConnections(numConnections)
+    {
+    }
+
+    void run() override
+    {
+        for (size_t ii = 0; ii < mNumConnections; ++ii)
+        {
+            net::SocketAddress client;
+            mStrategy.handleConnection(new net::NetConnection(mServer.accept(client)));
+        }
+    }
+
+private:
+    net::Socket& mServer;
+    net::AllocStrategy& mStrategy;
+    const size_t mNumConnections;
+};
+
+double getPercentile(const std::vector<double>& sorted, double percentile)
+{
+    const auto index = static_cast<size_t>(percentile / 100 * (sorted.size() - 1));
+    return sorted[index];
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        if (argc > 7)
+        {
+            std::cerr << "Usage: " << sys::Path::basename(argv[0])
+                      << " [connections (1000)] [client threads (8)]"
+                      << " [requests per connection (10)] [I/O threads (2)]"
+                      << " [workers (4)] [port (8642)]\n";
+            return 1;
+        }
+        const size_t numConnections = argc > 1 ? str::toType<size_t>(argv[1]) : 1000;
+        const size_t numClientThreads = argc > 2 ? str::toType<size_t>(argv[2]) : 8;
+        const size_t numRequests = argc > 3 ? str::toType<size_t>(argv[3]) : 10;
+        const auto numIOThreads = argc > 4 ? str::toType<unsigned short>(argv[4]) : 2;
+        const auto numWorkers = argc > 5 ? str::toType<unsigned short>(argv[5]) : 4;
+        const int port = argc > 6 ? str::toType<int>(argv[6]) : 8642;
+
+        std::unique_ptr<net::Socket> server =
+                net::TCPServerSocketFactory(SOMAXCONN).create(net::SocketAddress(port));
+        net::EpollAllocStrategy strategy(numIOThreads, numWorkers);
+        strategy.setRequestHandlerFactory(
+                new net::DefaultRequestHandlerFactory<EchoHandler>());
+        strategy.initialize();
+
+        // Open all of the connections and leave them idle
+        const auto connectStart = Clock::now();
+        Acceptor acceptor(*server, strategy, numConnections);
+        acceptor.start();
+        std::vector<std::unique_ptr<net::Socket> > clients(numConnections);
+        const net::SocketAddress address("localhost", port);
+        mt::run1D(numConnections, numClientThreads, [&](size_t ii) {
+            clients[ii] = net::TCPClientSocketFactory().create(address);
+        });
+        acceptor.join();
+        const std::chrono::duration<double> connectTime = Clock::now() - connectStart;
+        const size_t numOpen = strategy.getNumConnections();
+
+        // Send requests round-robin over each thread's connections
+        std::vector<std::vector<double> > latencies(numClientThreads);
+        const uint32_t messageLength = 64;
+        std::vector<char> message(sizeof(messageLength) + messageLength, 'x');
+        memcpy(message.data(), &messageLength, sizeof(messageLength));
+        const auto requestStart = Clock::now();
+        mt::run1D(numClientThreads, numClientThreads, [&](size_t thread) {
+            std::vector<char> response(messageLength);
+            for (size_t request = 0; request < numRequests; ++request)
+            {
+                for (size_t ii = thread; ii < numConnections; ii += numClientThreads)
+                {
+                    const auto start = Clock::now();
+                    clients[ii]->send(message.data(), message.size());
+                    uint32_t length;
+                    clients[ii]->recv(&length, sizeof(length), MSG_WAITALL);
+                    clients[ii]->recv(response.data(), response.size(), MSG_WAITALL);
+                    const std::chrono::duration<double, std::micro> latency = Clock::now() - start;
+                    latencies[thread].push_back(latency.count());
+                }
+            }
+        });
+        const std::chrono::duration<double> requestTime = Clock::now() - requestStart;
+
+        std::vector<double> sorted;
+        for (const auto& threadLatencies : latencies)
+        {
+            sorted.insert(sorted.end(), threadLatencies.begin(), threadLatencies.end());
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        std::cout << "Connections: " << numConnections << " (" << numOpen
+                  << " open on the server)\n"
+                  << "Connections / s: " << numConnections / connectTime.count() << "\n"
+                  << "Requests: " << sorted.size() << "\n"
+                  << "Requests / s: " << sorted.size() / requestTime.count() << "\n";
+        if (!sorted.empty())
+        {
+            std::cout << "Latency (us): p50 " << getPercentile(sorted, 50)
+                      << ", p99 " << getPercentile(sorted, 99)
+                      << ", max " << sorted.back() << "\n";
+        }
+
+        // The server should notice every connection closing
+        clients.clear();
+        for (size_t ii = 0; ii < 100 && strategy.getNumConnections() != 0; ++ii)
+        {
+            sys::OS().millisleep(10);
+        }
+        std::cout << "Open after closing: " << strategy.getNumConnections() << "\n";
+        return (numOpen == numConnections && strategy.getNumConnections() == 0) ? 0 : 1;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << std::endl;
+        return 1;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception\n";
+        return 1;
+    }
+}
+#else
+int main()
+{
+    std::cerr << "EpollLoadTest requires epoll (Linux)\n";
+    return 0;
+}
+#endif
@@ -0,0 +1,219 @@
+/* =========================================================================
+ * This file is part of net-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * net-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/OS.h>
+#include <mt/Runnable1D.h>
+#include <net/ClientSocketFactory.h>
+#include <net/ServerSocketFactory.h>
+#include <net/EpollAllocStrategy.h>
+
+#include "TestCase.h"
+
+#if defined(__linux__)
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+// Reads a length-prefixed message and echoes it back
+class EchoHandler final : public net::RequestHandler
+{
+public:
+    void operator()(net::NetConnection* conn) override
+    {
+        auto socket = conn->getSocket();
+        uint32_t length;
+        recvAll(*socket, &length, sizeof(length));
+        std::vector<char> buffer(sizeof(length) + length);
+        memcpy(buffer.data(), &length, sizeof(length));
+        recvAll(*socket, buffer.data() + sizeof(length), length);
+        socket->send(buffer.data(), buffer.size());
+    }
+
+private:
+    static void recvAll(net::Socket& socket, void* data, size_t length)
+    {
+        if (length != 0 && socket.recv(data, length, MSG_WAITALL) != length)
+        {
+            throw except::Exception(Ctxt("Short read"));
+        }
+    }
+};
+
+// A listening socket on an ephemeral port, and a strategy serving it
+struct Server final
+{
+    Server(unsigned short numIOThreads, unsigned short numWorkers,
+           std::chrono::milliseconds readTimeout) :
+        socket(net::TCPServerSocketFactory(SOMAXCONN).create(net::SocketAddress(0))),
+        strategy(new net::EpollAllocStrategy(numIOThreads, numWorkers, readTimeout))
+    {
+        sockaddr_in address{};
+        socklen_t length = sizeof(address);
+        ::getsockname(socket->getHandle(), reinterpret_cast<sockaddr*>(&address), &length);
+        port = ntohs(address.sin_port);
+
+        strategy->setRequestHandlerFactory(
+                new net::DefaultRequestHandlerFactory<EchoHandler>());
+        strategy->initialize();
+    }
+
+    // The peer's connect() completes before accept(), so there's no need
+    // for a separate accepting thread.
+    std::unique_ptr<net::Socket> connect()
+    {
+        auto client = net::TCPClientSocketFactory().create(
+                net::SocketAddress("localhost", port));
+        net::SocketAddress peer;
+        strategy->handleConnection(new net::NetConnection(socket->accept(peer)));
+        return client;
+    }
+
+    bool waitForConnections(size_t numConnections)
+    {
+        for (size_t ii = 0; ii < 500; ++ii)
+        {
+            if (strategy->getNumConnections() == numConnections)
+            {
+                return true;
+            }
+            sys::OS().millisleep(10);
+        }
+        return false;
+    }
+
+    std::unique_ptr<net::Socket> socket;
+    std::unique_ptr<net::EpollAllocStrategy> strategy;
+    int port = 0;
+};
+
+std::vector<char> makeRequest(const std::string& payload)
+{
+    const auto length = static_cast<uint32_t>(payload.size());
+    std::vector<char> request(sizeof(length) + length);
+    memcpy(request.data(), &length, sizeof(length));
+    memcpy(request.data() + sizeof(length), payload.data(), length);
+    return request;
+}
+
+std::string echo(net::Socket& client, const std::string& payload)
+{
+    const auto request = makeRequest(payload);
+    client.send(request.data(), request.size());
+    std::vector<char> response(request.size());
+    if (client.recv(response.data(), response.size(), MSG_WAITALL) != response.size())
+    {
+        return "";
+    }
+    return std::string(response.begin() + sizeof(uint32_t), response.end());
+}
+}
+
+TEST_CASE(testConcurrentClients)
+{
+    Server server(2, 4, std::chrono::seconds(30));
+    const size_t numClients = 8;
+    std::vector<std::unique_ptr<net::Socket> > clients;
+    for (size_t ii = 0; ii < numClients; ++ii)
+    {
+        clients.push_back(server.connect());
+    }
+    TEST_ASSERT_EQ(server.strategy->getNumConnections(), numClients);
+
+    std::vector<size_t> numEchoed(numClients, 0);
+    mt::run1D(numClients, numClients, [&](size_t ii) {
+        for (size_t request = 0; request < 20; ++request)
+        {
+            const auto payload = std::to_string(ii) + ":" + std::to_string(request);
+            if (echo(*clients[ii], payload) == payload)
+            {
+                ++numEchoed[ii];
+            }
+        }
+    });
+    for (size_t ii = 0; ii < numClients; ++ii)
+    {
+        TEST_ASSERT_EQ(numEchoed[ii], static_cast<size_t>(20));
+    }
+
+    clients.clear();
+    TEST_ASSERT_TRUE(server.waitForConnections(0));
+}
+
+TEST_CASE(testHalfSentRequest)
+{
+    // With a single worker, a stalled request would otherwise block
+    // everyone else.
+    Server server(1, 1, std::chrono::milliseconds(200));
+    auto stalled = server.connect();
+    auto request = makeRequest("never finished");
+    stalled->send(request.data(), sizeof(uint32_t) + 2);
+    sys::OS().millisleep(50);
+
+    auto other = server.connect();
+    TEST_ASSERT_EQ(echo(*other, "hello"), std::string("hello"));
+    TEST_ASSERT_EQ(echo(*other, "again"), std::string("again"));
+
+    // The stalled connection is closed rather than read out of step
+    char c;
+    TEST_ASSERT_EQ(::recv(stalled->getHandle(), &c, 1, 0), static_cast<ssize_t>(0));
+    TEST_ASSERT_TRUE(server.waitForConnections(1));
+}
+
+TEST_CASE(testDestroyWhileConnected)
+{
+    // No read timeout, so only the destructor can free the worker
+    Server server(1, 1, std::chrono::milliseconds(0));
+    auto idle = server.connect();
+    auto busy = server.connect();
+    TEST_ASSERT_EQ(echo(*idle, "idle"), std::string("idle"));
+
+    auto request = makeRequest("never finished");
+    busy->send(request.data(), sizeof(uint32_t) + 2);
+    sys::OS().millisleep(100);
+
+    const auto start = Clock::now();
+    server.strategy.reset();
+    TEST_ASSERT_TRUE(Clock::now() - start < std::chrono::seconds(5));
+
+    char c;
+    TEST_ASSERT_EQ(::recv(idle->getHandle(), &c, 1, 0), static_cast<ssize_t>(0));
+    TEST_ASSERT_EQ(::recv(busy->getHandle(), &c, 1, 0), static_cast<ssize_t>(0));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testConcurrentClients);
+    TEST_CHECK(testHalfSentRequest);
+    TEST_CHECK(testDestroyWhileConnected);
+    )
+#else
+TEST_MAIN()
+#endif
@@ -25,6 +25,7 @@
 
 #include "plugin/ErrorHandler.h"
 #include "plugin/PluginDefines.h"
+#include "plugin/PluginManifest.h"
 #include "plugin/BasicPluginManager.h"
 
 #endif
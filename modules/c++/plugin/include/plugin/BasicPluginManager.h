@@ -25,7 +25,10 @@
 
 #include <vector>
 #include <map>
+#include <set>
 #include<memory>
+#include <mutex>
+#include <iterator>
 
 #include <import/sys.h>
 #include <import/str.h>
@@ -35,6 +38,7 @@
 
 #include "plugin/PluginDefines.h"
 #include "plugin/ErrorHandler.h"
+#include "plugin/PluginManifest.h"
 
 namespace plugin
 {
@@ -80,6 +84,12 @@ namespace plugin
  *  2) a creator (factory) pattern
  *  3) a worker class that inherits an interface which performs
  *  the tasks required of the plugin
+ *
+ *  Loading every plugin to find out what it provides can dominate start-up
+ *  when there are many plugins.  With setManifest(), load() records each
+ *  plugin's identity in a PluginManifest and, for plugins whose entry is
+ *  current, only notes which operations they provide; such a plugin is
+ *  loaded by the first getHandler() (or getAllHandlers()) call needing it.
  */
 template<typename T> class BasicPluginManager
 {
@@ -136,12 +146,18 @@ public:
      *  Load a set of plugins from the path specified.
      *
      *  \param path      The path of directories to load plugins from
-     *  \param eh        An error handler to pass
+     *  \param eh        An error handler to pass.  With a manifest (see
+     *                   setManifest()), it's also used when a plugin that
+     *                   was put off is loaded by getHandler(name) or
+     *                   getAllHandlers(), so it must outlive those calls
+     *                   (or the next load() or unload()).
      */
     void load(const std::vector<std::string>& path, 
               ErrorHandler* eh)
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
         sys::OS os;
+        mPendingErrorHandler = eh;
 
         //! throw if not present
         for (size_t i = 0; i < path.size(); ++i)
@@ -155,12 +171,54 @@ public:
         //! load all the shared libraries found
         std::vector<std::string> sharedLibs = 
             os.search(path, "", PLUGIN_DSO_EXTENSION, false);
+        if (mManifestPathname.empty())
+        {
+            for (size_t i = 0; i < sharedLibs.size(); ++i)
+            {
+                loadPlugin(sharedLibs[i], eh);
+            }
+            return;
+        }
+
+        mManifest.read(mManifestPathname);
+        mManifest.removeMissing();
         for (size_t i = 0; i < sharedLibs.size(); ++i)
         {
-            loadPlugin(sharedLibs[i], eh);
+            if (!addFromManifest(sharedLibs[i], eh))
+            {
+                loadPlugin(sharedLibs[i], eh);
+            }
+        }
+        if (mManifest.isModified())
+        {
+            try
+            {
+                mManifest.write(mManifestPathname);
+            }
+            catch (const except::Exception& ex)
+            {
+                // Not fatal; the plugins will just be loaded next time too.
+                except::Context context(Ctxt(ex.getMessage()));
+                eh->onPluginError(context);
+            }
         }
     }
 
+    /*!
+     *  Use (and maintain) the plugin manifest at pathname: plugins recorded
+     *  in it aren't loaded by load(), but when first needed.  The file is
+     *  written by load() whenever a plugin has to be loaded to find out what
+     *  it provides.
+     *
+     *  \param pathname  The manifest file; empty (the default) loads every
+     *                   plugin right away.
+     */
+    void setManifest(const std::string& pathname)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+        mManifestPathname = pathname;
+    }
+
     /*!
      *  Two iterations.  First, go through and use each plugin identity
      *  to destroy the plugin class.  Then re-run through the list,
@@ -169,6 +227,10 @@ public:
      */
     void unload()
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+        mPending.clear();
+        mPendingErrorHandler = nullptr;
+
         typename HandlerRegistry::iterator it;
         for (it = mHandlers.begin(); it != mHandlers.end(); ++it)
         {
@@ -186,19 +248,29 @@ public:
     }
 
     /*!
-     *  Get the plugin (handler) identified by the name.
+     *  Get the plugin (handler) identified by the name, loading the plugin
+     *  if need be (see setManifest()).
      *
      *  \param name The name of the plugin to retrieve.
+     *  \param eh   The error handler to use if the plugin has to be loaded;
+     *              without it, the one given to load()
      *  \return The plugin handler
      */
-    T* getHandler(const std::string& name)
+    T* getHandler(const std::string& name, ErrorHandler* eh)
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+        loadPending(name, eh);
+
         typename HandlerRegistry::const_iterator it =
             mHandlers.find( name );
         if ( it != mHandlers.end() )
             return it->second.first;
         return nullptr;
     }
+    T* getHandler(const std::string& name)
+    {
+        return getHandler(name, mPendingErrorHandler);
+    }
 
     /*!
      *  Syntactic sugar alternative to getHandler.  Overloaded [] op.
@@ -220,6 +292,7 @@ public:
      */
     void getNames(const T* handler, std::vector<std::string>& names) const
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
         names.clear();
 
         for (typename HandlerRegistry::const_iterator iter = mHandlers.begin();
@@ -241,6 +314,12 @@ public:
      */
     bool exists(const std::string& name) const
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+        if (mPending.find(name) != mPending.end())
+        {
+            return true;
+        }
+
         typename HandlerRegistry::const_iterator it =
             mHandlers.find( name );
         return ( it != mHandlers.end() );
@@ -257,6 +336,7 @@ public:
     virtual void addHandler(std::shared_ptr<PluginIdentity<T> > identity,
                             ErrorHandler* eh)
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
         try
         {
             /*
@@ -286,6 +366,13 @@ public:
 
             for (size_t i = 0; ops[i] != nullptr; ++i)
             {
+                // A plugin loaded on first use doesn't take back operations
+                // that a plugin later in the search order provides.
+                if ((mLoadingOps != nullptr) && (mLoadingOps->count(ops[i]) == 0))
+                {
+                    continue;
+                }
+
                 T* pluginHandler = identity->spawnHandler();
                 if (! pluginHandler )
                 {
@@ -295,6 +382,7 @@ public:
                 }
                 mHandlers[ops[i]].first = pluginHandler;
                 mHandlers[ops[i]].second = identity;
+                mPending.erase(ops[i]); // the last plugin loaded wins
             }
         }
         catch (const except::Exception& ex)
@@ -313,6 +401,7 @@ public:
      */
     virtual void loadPlugin(const std::string& file, ErrorHandler* eh)
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
         try
         {
             sys::DLL* dso = nullptr;
@@ -363,6 +452,10 @@ public:
             const SharedPluginIdentity* const plugin =
                 static_cast<const SharedPluginIdentity*>((*ident)());
 
+            if (!mManifestPathname.empty())
+            {
+                recordInManifest(file, **plugin);
+            }
             addHandler(*plugin, eh);
         }
         catch (const except::Exception& ex)
@@ -373,6 +466,12 @@ public:
 
     void getAllHandlers(std::vector<T*>& handlers)
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+        while (!mPending.empty())
+        {
+            loadPending(mPending.begin()->first, mPendingErrorHandler);
+        }
+
         typename HandlerRegistry::const_iterator p;
 
         for (p = mHandlers.begin(); p != mHandlers.end(); ++p)
@@ -382,12 +481,20 @@ public:
     }
     void getAllKeys(std::vector<std::string>& handlerKeys)
     {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
         typename HandlerRegistry::const_iterator p;
 
         for (p = mHandlers.begin(); p != mHandlers.end(); ++p)
         {
             handlerKeys.push_back(p->first);
         }
+        for (const auto& pending : mPending)
+        {
+            if (mHandlers.find(pending.first) == mHandlers.end())
+            {
+                handlerKeys.push_back(pending.first);
+            }
+        }
     }
 
     /*!
@@ -430,8 +537,120 @@ protected:
     int mMinorVersion;
 
 private:
+    /*!
+     *  If the manifest has a current entry for the plugin, note what it
+     *  provides without loading it.
+     *
+     *  \return false if the plugin has to be loaded after all
+     */
+    bool addFromManifest(const std::string& file, ErrorHandler* eh)
+    {
+        const PluginManifestEntry* entry = nullptr;
+        try
+        {
+            sys::OS os;
+            entry = mManifest.find(file, os.getSize(file), os.getLastModifiedTime(file));
+        }
+        catch (const except::Exception&)
+        {
+        }
+        if (entry == nullptr)
+        {
+            return false;
+        }
+
+        if (!pluginVersionSupported(entry->majorVersion, entry->minorVersion))
+        {
+            std::ostringstream oss;
+            for (const auto& op : entry->operations)
+                oss << op << ":";
+            auto unsupported = str::Format("For plugin supporting ops %s version ", oss.str());
+            unsupported += str::Format("[%d.%d] not supported (%d.%d)", entry->majorVersion, entry->minorVersion, mMajorVersion, mMinorVersion);
+            eh->onPluginVersionUnsupported(unsupported);
+            return true;
+        }
+
+        for (const auto& op : entry->operations)
+        {
+            mPending[op] = file;
+        }
+        return true;
+    }
+
+    void recordInManifest(const std::string& file, PluginIdentity<T>& identity)
+    {
+        PluginManifestEntry entry;
+        try
+        {
+            sys::OS os;
+            entry.size = os.getSize(file);
+            entry.lastModifiedTime = os.getLastModifiedTime(file);
+        }
+        catch (const except::Exception&)
+        {
+            mManifest.remove(file);
+            return;
+        }
+        entry.pathname = file;
+        entry.majorVersion = identity.getMajorVersion();
+        entry.minorVersion = identity.getMinorVersion();
+        const char** ops = identity.getOperations();
+        for (size_t i = 0; ops[i] != nullptr; ++i)
+        {
+            entry.operations.push_back(ops[i]);
+        }
+        mManifest.update(entry);
+    }
+
+    //! Load the plugin providing "name" if it was put off by load()
+    void loadPending(const std::string& name, ErrorHandler* eh)
+    {
+        const auto it = mPending.find(name);
+        if (it == mPending.end())
+        {
+            return;
+        }
+
+        // Forget all of the plugin's operations first so a failure isn't
+        // retried.  Only these are registered: the plugin's other operations
+        // were taken over by plugins later in the search order.
+        const std::string file = it->second;
+        std::set<std::string> ops;
+        for (auto p = mPending.begin(); p != mPending.end();)
+        {
+            if (p->second == file)
+            {
+                ops.insert(p->first);
+                p = mPending.erase(p);
+            }
+            else
+            {
+                ++p;
+            }
+        }
+
+        mLoadingOps = &ops;
+        try
+        {
+            loadPlugin(file, eh);
+        }
+        catch (...)
+        {
+            mLoadingOps = nullptr;
+            throw;
+        }
+        mLoadingOps = nullptr;
+    }
+
     HandlerRegistry        mHandlers;
     std::vector<sys::DLL*> mDSOs;
+
+    std::string mManifestPathname;
+    PluginManifest mManifest;
+    std::map<std::string, std::string> mPending; //!< operation -> plugin not yet loaded
+    const std::set<std::string>* mLoadingOps = nullptr; //!< set while loadPending() loads a plugin
+    ErrorHandler* mPendingErrorHandler = nullptr; //!< from load(), for the plugins it put off
+    mutable std::recursive_mutex mMutex;
 };
 
 }
@@ -0,0 +1,121 @@
+/* =========================================================================
+ * This file is part of plugin-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * plugin-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_plugin_PluginManifest_h_INCLUDED_
+#define CODA_OSS_plugin_PluginManifest_h_INCLUDED_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "config/Exports.h"
+#include "sys/Conf.h"
+
+namespace plugin
+{
+/*!
+ *  \struct PluginManifestEntry
+ *  \brief What a plugin provides, recorded without having to load it
+ */
+struct CODA_OSS_API PluginManifestEntry final
+{
+    std::string pathname;
+    sys::Off_T size = 0;
+    sys::Off_T lastModifiedTime = 0; //!< as from sys::OS::getLastModifiedTime()
+    int majorVersion = 0;
+    int minorVersion = 0;
+    std::vector<std::string> operations;
+};
+
+/*!
+ *  \class PluginManifest
+ *  \brief An on-disk cache of plugin identities
+ *
+ *  BasicPluginManager::setManifest() uses this to put off loading a plugin
+ *  until one of its operations is needed.  An entry is only used while the
+ *  plugin's size and modification time match what was recorded.
+ *
+ *  The file is just a cache: one that's missing, unreadable or written by
+ *  another version of this class is treated as empty.  Pathnames and
+ *  operation names containing tabs or newlines aren't cached.
+ */
+class CODA_OSS_API PluginManifest final
+{
+public:
+    PluginManifest() = default;
+
+    /*!
+     *  Replace the contents with those of the manifest file.
+     *
+     *  \param pathname  The manifest file
+     *  \return false, leaving the manifest empty, if the file doesn't exist
+     *          or isn't a manifest
+     */
+    bool read(const std::string& pathname);
+
+    /*!
+     *  Write the manifest to a temporary file and rename it into place, so
+     *  another process never sees half of it.  The temporary's name is
+     *  unique to this process (and call), so concurrent writers don't
+     *  clobber each other's; the last rename wins.
+     *
+     *  \param pathname  The manifest file
+     *  \throw except::IOException if the file can't be written
+     */
+    void write(const std::string& pathname) const;
+
+    /*!
+     *  \return The entry for the plugin if it's still current, i.e., the size
+     *          and modification time match; otherwise nullptr
+     */
+    const PluginManifestEntry* find(const std::string& pathname,
+                                    sys::Off_T size,
+                                    sys::Off_T lastModifiedTime) const;
+
+    //! Add (or replace) the entry for entry.pathname
+    void update(const PluginManifestEntry& entry);
+
+    //! Remove the entry for the plugin, if there is one
+    void remove(const std::string& pathname);
+
+    //! Remove the entries for plugins that no longer exist
+    void removeMissing();
+
+    size_t size() const
+    {
+        return mEntries.size();
+    }
+
+    //! Has update() or remove() changed anything since read()?
+    bool isModified() const
+    {
+        return mModified;
+    }
+
+private:
+    std::map<std::string, PluginManifestEntry> mEntries;
+    bool mModified = false;
+};
+}
+
+#endif  // CODA_OSS_plugin_PluginManifest_h_INCLUDED_
@@ -0,0 +1,178 @@
+/* =========================================================================
+ * This file is part of plugin-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * plugin-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "plugin/PluginManifest.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+
+#include <except/Exception.h>
+#include <str/Convert.h>
+#include <str/Manip.h>
+#include <sys/OS.h>
+
+// The first line of the file; change the version if the format changes.
+static const char manifestHeader[] = "# coda-oss plugin manifest 1";
+
+static bool isCacheable(const std::string& s)
+{
+    return !s.empty() && (s.find_first_of("\t\n\r") == std::string::npos);
+}
+
+bool plugin::PluginManifest::read(const std::string& pathname)
+{
+    mEntries.clear();
+    mModified = false;
+
+    std::ifstream input(pathname.c_str());
+    std::string line;
+    if (!std::getline(input, line) || (line != manifestHeader))
+    {
+        return false;
+    }
+
+    // size, modification time, major version, minor version, pathname, operations...
+    std::map<std::string, PluginManifestEntry> entries;
+    while (std::getline(input, line))
+    {
+        const auto fields = str::split(line, "\t");
+        if (fields.size() < 5)
+        {
+            return false;
+        }
+
+        PluginManifestEntry entry;
+        try
+        {
+            entry.size = str::toType<sys::Off_T>(fields[0]);
+            entry.lastModifiedTime = str::toType<sys::Off_T>(fields[1]);
+            entry.majorVersion = str::toType<int>(fields[2]);
+            entry.minorVersion = str::toType<int>(fields[3]);
+        }
+        catch (const except::Exception&)
+        {
+            return false;
+        }
+        entry.pathname = fields[4];
+        entry.operations.assign(fields.begin() + 5, fields.end());
+        entries[entry.pathname] = std::move(entry);
+    }
+
+    mEntries = std::move(entries);
+    return true;
+}
+
+void plugin::PluginManifest::write(const std::string& pathname) const
+{
+    // Unique per process and per call, so concurrent writers each rename
+    // a complete file into place.
+    static std::atomic<unsigned> counter{0};
+    const auto tempPathname = pathname + "." + str::toString(sys::OS().getProcessId()) +
+            "." + str::toString(counter++) + ".tmp";
+    {
+        std::ofstream output(tempPathname.c_str(), std::ios::trunc);
+        output << manifestHeader << "\n";
+        for (const auto& it : mEntries)
+        {
+            const auto& entry = it.second;
+            output << entry.size << "\t" << entry.lastModifiedTime << "\t"
+                   << entry.majorVersion << "\t" << entry.minorVersion << "\t"
+                   << entry.pathname;
+            for (const auto& op : entry.operations)
+            {
+                output << "\t" << op;
+            }
+            output << "\n";
+        }
+        output.flush();
+        if (!output)
+        {
+            output.close();
+            ::remove(tempPathname.c_str());
+            throw except::IOException(Ctxt("Unable to write plugin manifest " + tempPathname));
+        }
+    }
+
+#ifdef _WIN32
+    ::remove(pathname.c_str()); // rename() won't replace an existing file
+#endif
+    if (::rename(tempPathname.c_str(), pathname.c_str()) != 0)
+    {
+        ::remove(tempPathname.c_str());
+        throw except::IOException(Ctxt("Unable to rename " + tempPathname + " to " + pathname));
+    }
+}
+
+const plugin::PluginManifestEntry* plugin::PluginManifest::find(const std::string& pathname,
+                                                                 sys::Off_T size,
+                                                                 sys::Off_T lastModifiedTime) const
+{
+    const auto it = mEntries.find(pathname);
+    if ((it == mEntries.end()) || (it->second.size != size) ||
+        (it->second.lastModifiedTime != lastModifiedTime))
+    {
+        return nullptr;
+    }
+    return &(it->second);
+}
+
+void plugin::PluginManifest::update(const PluginManifestEntry& entry)
+{
+    const auto cacheable = isCacheable(entry.pathname) &&
+            std::all_of(entry.operations.begin(), entry.operations.end(), isCacheable);
+    if (!cacheable)
+    {
+        remove(entry.pathname);
+        return;
+    }
+
+    mEntries[entry.pathname] = entry;
+    mModified = true;
+}
+
+void plugin::PluginManifest::remove(const std::string& pathname)
+{
+    if (mEntries.erase(pathname) > 0)
+    {
+        mModified = true;
+    }
+}
+
+void plugin::PluginManifest::removeMissing()
+{
+    const sys::OS os;
+    for (auto it = mEntries.begin(); it != mEntries.end();)
+    {
+        if (os.exists(it->first))
+        {
+            ++it;
+        }
+        else
+        {
+            it = mEntries.erase(it);
+            mModified = true;
+        }
+    }
+}
@@ -0,0 +1,372 @@
+/* =========================================================================
+ * This file is part of plugin-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * plugin-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/OS.h>
+#include <plugin/BasicPluginManager.h>
+#include <plugin/PluginManifest.h>
+
+#include "TestCase.h"
+
+namespace
+{
+struct Handler final
+{
+};
+
+struct CountingErrorHandler final : public plugin::ErrorHandler
+{
+    void onPluginDirectoryNotFound(const std::string&) override { }
+    void onPluginLoadedAlready(const std::string&) override { }
+    void onPluginLoadFailed(const std::string&) override
+    {
+        ++loadFailed;
+    }
+    void onPluginVersionUnsupported(const std::string&) override
+    {
+        ++versionUnsupported;
+    }
+    void onPluginError(except::Context&) override { }
+
+    size_t loadFailed = 0;
+    size_t versionUnsupported = 0;
+};
+
+// A directory holding a "plugin" that can't actually be loaded, so any
+// attempt to load it shows up as onPluginLoadFailed().
+struct PluginDirectory final
+{
+    explicit PluginDirectory(const std::string& name = "test_plugin_manifest_dir") :
+        dirname(name)
+    {
+        const sys::OS os;
+        os.makeDirectory(dirname);
+        std::ofstream(dirname + "/fake" PLUGIN_DSO_EXTENSION) << "not a shared library";
+        pathname = os.search(std::vector<std::string>{dirname}, "", PLUGIN_DSO_EXTENSION, false).at(0);
+    }
+    ~PluginDirectory()
+    {
+        const sys::OS os;
+        for (const auto& path : {manifest, dirname})
+        {
+            if (os.exists(path))
+            {
+                os.remove(path);
+            }
+        }
+    }
+
+    plugin::PluginManifestEntry makeEntry(const std::vector<std::string>& operations = {"fake", "fake2"}) const
+    {
+        const sys::OS os;
+        plugin::PluginManifestEntry entry;
+        entry.pathname = pathname;
+        entry.size = os.getSize(pathname);
+        entry.lastModifiedTime = os.getLastModifiedTime(pathname);
+        entry.majorVersion = PLUGIN_API_MAJOR_VERSION;
+        entry.minorVersion = PLUGIN_API_MINOR_VERSION;
+        entry.operations = operations;
+        return entry;
+    }
+
+    const std::string dirname;
+    const std::string manifest = "test_plugin_manifest.txt";
+    std::string pathname;
+};
+
+// Provides the given operations, all with the same handler
+struct Identity final : public plugin::PluginIdentity<Handler>
+{
+    explicit Identity(std::vector<const char*> ops) : mOps(std::move(ops))
+    {
+        mOps.push_back(nullptr);
+    }
+    const char** getOperations() override
+    {
+        return mOps.data();
+    }
+    int getMajorVersion() override
+    {
+        return PLUGIN_API_MAJOR_VERSION;
+    }
+    int getMinorVersion() override
+    {
+        return PLUGIN_API_MINOR_VERSION;
+    }
+    Handler* spawnHandler() override
+    {
+        return &handler;
+    }
+    void destroyHandler(Handler*&) override { }
+
+    Handler handler;
+
+private:
+    std::vector<const char*> mOps;
+};
+
+// "Loads" a plugin by adding the identity registered for its pathname
+struct FakeLoadingPluginManager final : public plugin::BasicPluginManager<Handler>
+{
+    void loadPlugin(const std::string& file, plugin::ErrorHandler* eh) override
+    {
+        addHandler(identities.at(file), eh);
+    }
+
+    std::map<std::string, std::shared_ptr<plugin::PluginIdentity<Handler> > > identities;
+};
+}
+
+TEST_CASE(testManifestRoundTrip)
+{
+    const PluginDirectory dir;
+    plugin::PluginManifest manifest;
+    const auto entry = dir.makeEntry();
+    manifest.update(entry);
+    auto other = entry;
+    other.pathname = "other.so";
+    other.operations.clear();
+    manifest.update(other);
+    TEST_ASSERT_TRUE(manifest.isModified());
+    manifest.write(dir.manifest);
+
+    plugin::PluginManifest reread;
+    TEST_ASSERT_TRUE(reread.read(dir.manifest));
+    TEST_ASSERT_FALSE(reread.isModified());
+    TEST_ASSERT_EQ(reread.size(), static_cast<size_t>(2));
+    const auto found = reread.find(entry.pathname, entry.size, entry.lastModifiedTime);
+    TEST_ASSERT(found != nullptr);
+    TEST_ASSERT_EQ(found->majorVersion, entry.majorVersion);
+    TEST_ASSERT_EQ(found->minorVersion, entry.minorVersion);
+    TEST_ASSERT(found->operations == entry.operations);
+    TEST_ASSERT(reread.find("other.so", other.size, other.lastModifiedTime) != nullptr);
+
+    // a plugin that has changed isn't in the manifest
+    TEST_ASSERT_NULL(reread.find(entry.pathname, entry.size + 1, entry.lastModifiedTime));
+    TEST_ASSERT_NULL(reread.find(entry.pathname, entry.size, entry.lastModifiedTime + 1000));
+    TEST_ASSERT_NULL(reread.find("missing.so", entry.size, entry.lastModifiedTime));
+
+    reread.remove("other.so");
+    TEST_ASSERT_TRUE(reread.isModified());
+    TEST_ASSERT_EQ(reread.size(), static_cast<size_t>(1));
+}
+
+TEST_CASE(testManifestInvalid)
+{
+    const PluginDirectory dir;
+    plugin::PluginManifest manifest;
+    TEST_ASSERT_FALSE(manifest.read("does_not_exist.txt"));
+
+    std::ofstream(dir.manifest) << "# coda-oss plugin manifest 0\n1\t2\t1\t0\tx.so\top\n";
+    TEST_ASSERT_FALSE(manifest.read(dir.manifest));
+    std::ofstream(dir.manifest) << "# coda-oss plugin manifest 1\nsize\t2\t1\t0\tx.so\top\n";
+    TEST_ASSERT_FALSE(manifest.read(dir.manifest));
+    TEST_ASSERT_EQ(manifest.size(), static_cast<size_t>(0));
+
+    // names that can't be written aren't cached
+    auto entry = dir.makeEntry();
+    entry.operations.push_back("with\ttab");
+    manifest.update(entry);
+    TEST_ASSERT_EQ(manifest.size(), static_cast<size_t>(0));
+}
+
+TEST_CASE(testLoadWithoutManifest)
+{
+    const PluginDirectory dir;
+    CountingErrorHandler eh;
+    plugin::BasicPluginManager<Handler> manager;
+    manager.load(std::vector<std::string>{dir.dirname}, &eh);
+    TEST_ASSERT_EQ(eh.loadFailed, static_cast<size_t>(1));
+    TEST_ASSERT_FALSE(manager.exists("fake"));
+}
+
+TEST_CASE(testLoadFromManifest)
+{
+    const PluginDirectory dir;
+    plugin::PluginManifest manifest;
+    manifest.update(dir.makeEntry());
+    manifest.write(dir.manifest);
+
+    CountingErrorHandler eh;
+    plugin::BasicPluginManager<Handler> manager;
+    manager.setManifest(dir.manifest);
+    manager.load(std::vector<std::string>{dir.dirname}, &eh);
+    TEST_ASSERT_EQ(eh.loadFailed, static_cast<size_t>(0)); // nothing loaded yet
+    TEST_ASSERT_TRUE(manager.exists("fake"));
+    TEST_ASSERT_TRUE(manager.exists("fake2"));
+    std::vector<std::string> keys;
+    manager.getAllKeys(keys);
+    TEST_ASSERT_EQ(keys.size(), static_cast<size_t>(2));
+
+    // The first use loads the plugin (which fails), once.
+    TEST_ASSERT_NULL(manager.getHandler("fake2", &eh));
+    TEST_ASSERT_EQ(eh.loadFailed, static_cast<size_t>(1));
+    TEST_ASSERT_NULL(manager.getHandler("fake", &eh));
+    TEST_ASSERT_EQ(eh.loadFailed, static_cast<size_t>(1));
+    TEST_ASSERT_FALSE(manager.exists("fake"));
+}
+
+TEST_CASE(testDeferredLoadUsesLoadErrorHandler)
+{
+    const PluginDirectory dir;
+    plugin::PluginManifest manifest;
+    manifest.update(dir.makeEntry());
+    manifest.write(dir.manifest);
+
+    // Without an error handler of their own, getHandler() and
+    // getAllHandlers() report to the one given to load().
+    CountingErrorHandler eh;
+    {
+        plugin::BasicPluginManager<Handler> manager;
+        manager.setManifest(dir.manifest);
+        manager.load(std::vector<std::string>{dir.dirname}, &eh);
+        TEST_ASSERT_NULL(manager.getHandler("fake"));
+        TEST_ASSERT_EQ(eh.loadFailed, static_cast<size_t>(1));
+    }
+    {
+        plugin::BasicPluginManager<Handler> manager;
+        manager.setManifest(dir.manifest);
+        manager.load(std::vector<std::string>{dir.dirname}, &eh);
+        std::vector<Handler*> handlers;
+        manager.getAllHandlers(handlers);
+        TEST_ASSERT_TRUE(handlers.empty());
+        TEST_ASSERT_EQ(eh.loadFailed, static_cast<size_t>(2));
+    }
+}
+
+TEST_CASE(testLoadFromStaleManifest)
+{
+    const PluginDirectory dir;
+    plugin::PluginManifest manifest;
+    auto entry = dir.makeEntry();
+    entry.size += 1;
+    manifest.update(entry);
+    manifest.write(dir.manifest);
+
+    CountingErrorHandler eh;
+    plugin::BasicPluginManager<Handler> manager;
+    manager.setManifest(dir.manifest);
+    manager.load(std::vector<std::string>{dir.dirname}, &eh);
+    TEST_ASSERT_EQ(eh.loadFailed, static_cast<size_t>(1)); // loaded right away
+    TEST_ASSERT_FALSE(manager.exists("fake"));
+
+    entry = dir.makeEntry();
+    entry.majorVersion += 1;
+    manifest.update(entry);
+    manifest.write(dir.manifest);
+    manager.load(std::vector<std::string>{dir.dirname}, &eh);
+    TEST_ASSERT_EQ(eh.loadFailed, static_cast<size_t>(1));
+    TEST_ASSERT_EQ(eh.versionUnsupported, static_cast<size_t>(1));
+    TEST_ASSERT_FALSE(manager.exists("fake"));
+}
+
+TEST_CASE(testDeferredLoadKeepsLaterEagerPlugin)
+{
+    // A (deferred) provides x and y; B, later in the search order and
+    // loaded right away, provides y.
+    const PluginDirectory dirA("test_plugin_manifest_a");
+    const PluginDirectory dirB("test_plugin_manifest_b");
+    plugin::PluginManifest manifest;
+    manifest.update(dirA.makeEntry({"x", "y"}));
+    manifest.write(dirA.manifest);
+
+    auto a = std::make_shared<Identity>(std::vector<const char*>{"x", "y"});
+    auto b = std::make_shared<Identity>(std::vector<const char*>{"y"});
+    CountingErrorHandler eh;
+    FakeLoadingPluginManager manager;
+    manager.identities[dirA.pathname] = a;
+    manager.identities[dirB.pathname] = b;
+    manager.setManifest(dirA.manifest);
+    manager.load(std::vector<std::string>{dirA.dirname}, &eh);
+    manager.load(std::vector<std::string>{dirB.dirname}, &eh);
+    TEST_ASSERT(manager.getHandler("y", &eh) == &b->handler);
+
+    TEST_ASSERT(manager.getHandler("x", &eh) == &a->handler);
+    TEST_ASSERT(manager.getHandler("y", &eh) == &b->handler);
+    TEST_ASSERT_EQ(eh.loadFailed, static_cast<size_t>(0));
+}
+
+TEST_CASE(testDeferredLoadKeepsLaterDeferredPlugin)
+{
+    // Both deferred: A provides x and y, B (later) provides y.
+    const PluginDirectory dirA("test_plugin_manifest_a");
+    const PluginDirectory dirB("test_plugin_manifest_b");
+    plugin::PluginManifest manifest;
+    manifest.update(dirA.makeEntry({"x", "y"}));
+    manifest.update(dirB.makeEntry({"y"}));
+    manifest.write(dirA.manifest);
+
+    auto a = std::make_shared<Identity>(std::vector<const char*>{"x", "y"});
+    auto b = std::make_shared<Identity>(std::vector<const char*>{"y"});
+    CountingErrorHandler eh;
+    FakeLoadingPluginManager manager;
+    manager.identities[dirA.pathname] = a;
+    manager.identities[dirB.pathname] = b;
+    manager.setManifest(dirA.manifest);
+    manager.load(std::vector<std::string>{dirA.dirname}, &eh);
+    manager.load(std::vector<std::string>{dirB.dirname}, &eh);
+
+    TEST_ASSERT(manager.getHandler("y", &eh) == &b->handler);
+    TEST_ASSERT(manager.getHandler("x", &eh) == &a->handler);
+    TEST_ASSERT(manager.getHandler("y", &eh) == &b->handler);
+    std::vector<std::string> names;
+    manager.getNames(&a->handler, names);
+    TEST_ASSERT(names == std::vector<std::string>{"x"});
+}
+
+TEST_CASE(testLoadPrunesMissingPlugins)
+{
+    const PluginDirectory dir;
+    plugin::PluginManifest manifest;
+    manifest.update(dir.makeEntry());
+    auto missing = dir.makeEntry();
+    missing.pathname = dir.pathname + ".missing";
+    manifest.update(missing);
+    manifest.write(dir.manifest);
+
+    CountingErrorHandler eh;
+    plugin::BasicPluginManager<Handler> manager;
+    manager.setManifest(dir.manifest);
+    manager.load(std::vector<std::string>{dir.dirname}, &eh);
+
+    plugin::PluginManifest reread;
+    TEST_ASSERT_TRUE(reread.read(dir.manifest));
+    TEST_ASSERT_EQ(reread.size(), static_cast<size_t>(1));
+    TEST_ASSERT_NULL(reread.find(missing.pathname, missing.size, missing.lastModifiedTime));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testManifestRoundTrip);
+    TEST_CHECK(testManifestInvalid);
+    TEST_CHECK(testLoadWithoutManifest);
+    TEST_CHECK(testLoadFromManifest);
+    TEST_CHECK(testDeferredLoadUsesLoadErrorHandler);
+    TEST_CHECK(testLoadFromStaleManifest);
+    TEST_CHECK(testDeferredLoadKeepsLaterEagerPlugin);
+    TEST_CHECK(testDeferredLoadKeepsLaterDeferredPlugin);
+    TEST_CHECK(testLoadPrunesMissingPlugins);
+    )
@@ -106,9 +106,10 @@ PolygonMask::PolygonMask(const std::vector<types::RowCol<double> >& points,
         // Need to get the convex hull of the input points,
         // because the code currently cannot handle more
         // than two intersections (left and right) per row.
-        std::vector<types::RowCol<double> > rawPoints = points;
         std::vector<types::RowCol<double> > convexHullPoints;
-        math::ConvexHull<double> convexHull(rawPoints, convexHullPoints);
+        math::ConvexHull<double> convexHull(
+                coda_oss::span<const types::RowCol<double> >(points.data(), points.size()),
+                convexHullPoints);
             
         const Intersections<double>
                 intersections(convexHullPoints, mDims, offset);
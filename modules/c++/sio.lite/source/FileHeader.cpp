@@ -146,11 +146,10 @@ void sio::lite::FileHeader::to(size_t numBands, io::OutputStream& os)
     //construct the magic byte
     int magic = (255 - version) | 127 << 8 | version << 16 | 255 << 24;
 
-    os.write((const sys::byte*)&magic, 4);
-    os.write((const sys::byte*)&nl, 4);
-    os.write((const sys::byte*)&ne, 4);
-    os.write((const sys::byte*)&elementType, 4);
-    os.write((const sys::byte*)&elementSize, 4);
+    // one write for the fixed-size part of the header, not five
+    const int header[] = { magic, nl, ne, elementType, elementSize };
+    static_assert(sizeof(header) == 20, "sio.lite header is five 4-byte ints");
+    os.write(header, sizeof(header));
 
     if (version > 1)
         writeUserData(os);
@@ -101,6 +101,7 @@ CODA_OSS_disable_warning_system_header_push
 #include <coda_oss/optional.h>
 #include <coda_oss/span.h>
 #include <coda_oss/string.h>
+#include <coda_oss/string_view.h>
 #include <coda_oss/type_traits.h>
 #include <coda_oss/mdspan.h>
 
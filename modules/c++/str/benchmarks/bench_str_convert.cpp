@@ -0,0 +1,139 @@
+/* =========================================================================
+ * This file is part of str-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * str-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Users guide
+
+    Times the str:: routines that show up when reading and writing text
+    metadata: toString()/toType() for int and double, lower()/upper(),
+    split() and trim().  Items are values (or strings) per second.
+
+    ./bench_str_convert [--filter=<name>] [--json=<file>] [--quick] ...
+
+*/
+
+/*  Results (-O2, a 1-CPU VM), median:
+    toString   int 303 ns, double 931 ns per value
+    toType     int 415 ns, double 722 ns per value
+    lower/upper 8.7 us for 20000 chars, 2.3 GB/s
+    split      26 ns per token
+    trim       107 ns
+*/
+
+#include <string>
+#include <vector>
+
+#include <str/Convert.h>
+#include <str/Manip.h>
+
+#include "Benchmark.h"
+
+static constexpr size_t numValues = 1000;
+
+BENCHMARK_CASE(toString)
+{
+    state.setItemsPerIteration(numValues);
+    state.run("int", [&]() {
+        for (size_t i = 0; i < numValues; i++)
+        {
+            benchmark::doNotOptimize(str::toString(static_cast<int>(i * 7919)));
+        }
+    });
+    state.run("double", [&]() {
+        for (size_t i = 0; i < numValues; i++)
+        {
+            benchmark::doNotOptimize(str::toString(static_cast<double>(i) * 0.1234567));
+        }
+    });
+}
+
+BENCHMARK_CASE(toType)
+{
+    std::vector<std::string> ints, doubles;
+    for (size_t i = 0; i < numValues; i++)
+    {
+        ints.push_back(str::toString(static_cast<int>(i * 7919)));
+        doubles.push_back(str::toString(static_cast<double>(i) * 0.1234567));
+    }
+
+    state.setItemsPerIteration(numValues);
+    state.run("int", [&]() {
+        for (const auto& s : ints)
+        {
+            benchmark::doNotOptimize(str::toType<int>(s));
+        }
+    });
+    state.run("double", [&]() {
+        for (const auto& s : doubles)
+        {
+            benchmark::doNotOptimize(str::toType<double>(s));
+        }
+    });
+}
+
+BENCHMARK_CASE(changeCase)
+{
+    std::string s;
+    for (size_t i = 0; i < numValues; i++)
+    {
+        s += "The Quick Brown Fox ";
+    }
+
+    state.setBytesPerIteration(static_cast<double>(s.size()));
+    state.run("lower", [&]() {
+        str::lower(s);
+        benchmark::doNotOptimize(s);
+    });
+    state.run("upper", [&]() {
+        str::upper(s);
+        benchmark::doNotOptimize(s);
+    });
+}
+
+BENCHMARK_CASE(split)
+{
+    std::string s;
+    for (size_t i = 0; i < numValues; i++)
+    {
+        s += str::toString(i) + ", ";
+    }
+
+    state.setItemsPerIteration(numValues);
+    state.run([&]() {
+        benchmark::doNotOptimize(str::split(s, ", "));
+    });
+}
+
+BENCHMARK_CASE(trim)
+{
+    const std::string padded = "   \t some value with spaces \t  \n";
+    state.run([&]() {
+        benchmark::doNotOptimize(str::trim(padded));
+    });
+}
+
+BENCHMARK_MAIN(
+    BENCHMARK_CHECK(toString);
+    BENCHMARK_CHECK(toType);
+    BENCHMARK_CHECK(changeCase);
+    BENCHMARK_CHECK(split);
+    BENCHMARK_CHECK(trim);
+    )
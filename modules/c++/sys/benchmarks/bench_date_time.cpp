@@ -0,0 +1,139 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/* Users guide
+
+    Times parsing and formatting 1000 UTC timestamps
+    ("2011-10-19T11:59:46.123Z") with the general strptime()/strftime()
+    path, i.e., UTCDateTime(string) and format(), and with the fixed-format
+    parseISO8601()/formatISO8601().
+
+    ./bench_date_time [--filter=<name>] [--json=<file>] [--quick] ...
+
+*/
+
+/*  Results (-O3, a 1-CPU VM), median per iteration:
+              general   ISO8601
+    parse     2.61 ms   67.8 us
+    format     191 us   35.0 us
+*/
+
+#include <string>
+#include <vector>
+
+#include <sys/Conf.h>
+#include <sys/UTCDateTime.h>
+
+#include "Benchmark.h"
+
+static constexpr size_t numTimes = 1000;
+
+// A timestamp every ~11 minutes, starting in 2011
+static std::vector<sys::UTCDateTime> makeTimes()
+{
+    std::vector<sys::UTCDateTime> retval;
+    retval.reserve(numTimes);
+    for (size_t ii = 0; ii < numTimes; ++ii)
+    {
+        retval.emplace_back(1318000000000.0 + static_cast<double>(ii) * 654321.0);
+    }
+    return retval;
+}
+
+BENCHMARK_CASE(parse)
+{
+    // a third of them with milliseconds
+    std::vector<std::string> strings;
+    for (const auto& dt : makeTimes())
+    {
+        auto str = dt.format();
+        if (strings.size() % 3 == 0)
+        {
+            str.pop_back();
+            str += "." + std::to_string(strings.size() % 1000) + "Z";
+        }
+        strings.push_back(std::move(str));
+    }
+
+    double sumGeneral = 0.0;
+    double sumISO8601 = 0.0;
+    for (const auto& str : strings)
+    {
+        sumGeneral += sys::UTCDateTime(str).getTimeInMillis();
+        sys::UTCDateTime parsed;
+        parsed.parseISO8601(str);
+        sumISO8601 += parsed.getTimeInMillis();
+    }
+    if (sumGeneral != sumISO8601)
+    {
+        throw except::Exception(Ctxt("The two parsers don't agree"));
+    }
+
+    state.setItemsPerIteration(static_cast<double>(strings.size()));
+    state.run("general", [&]() {
+        double sum = 0.0;
+        for (const auto& str : strings)
+        {
+            sum += sys::UTCDateTime(str).getTimeInMillis();
+        }
+        benchmark::doNotOptimize(sum);
+    });
+    state.run("ISO8601", [&]() {
+        double sum = 0.0;
+        sys::UTCDateTime parsed;
+        for (const auto& str : strings)
+        {
+            parsed.parseISO8601(str);
+            sum += parsed.getTimeInMillis();
+        }
+        benchmark::doNotOptimize(sum);
+    });
+}
+
+BENCHMARK_CASE(format)
+{
+    const auto times = makeTimes();
+    state.setItemsPerIteration(static_cast<double>(times.size()));
+    state.run("general", [&]() {
+        size_t length = 0;
+        for (const auto& dt : times)
+        {
+            length += dt.format().length();
+        }
+        benchmark::doNotOptimize(length);
+    });
+    state.run("ISO8601", [&]() {
+        size_t length = 0;
+        char buffer[32];
+        for (const auto& dt : times)
+        {
+            length += dt.formatISO8601(buffer, sizeof(buffer));
+        }
+        benchmark::doNotOptimize(length);
+    });
+}
+
+BENCHMARK_MAIN(
+    BENCHMARK_CHECK(parse);
+    BENCHMARK_CHECK(format);
+    )
@@ -0,0 +1,167 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/* Users guide
+
+    Times normalizePath(), joinPaths(), splitPath() and separate() on 1000
+    typical paths, with the std::string routines and with the string_view
+    ones (normalizePath()/joinPaths() into a buffer on the stack,
+    splitPathView() and components()).  The string_view routines are
+    checked not to allocate.
+
+    ./bench_path [--filter=<name>] [--json=<file>] [--quick] ...
+
+*/
+
+/*  Results (-O3, a 1-CPU VM), median per iteration:
+                    string    view / components
+    normalizePath   135 us    110 us
+    joinPaths      41.5 us   17.4 us
+    splitPath      43.6 us   11.1 us
+    separate        267 us   60.2 us
+*/
+
+#include <stdlib.h>
+
+#include <new>
+#include <string>
+#include <vector>
+
+#include <sys/Path.h>
+
+#include "Benchmark.h"
+
+static size_t numAllocations = 0;
+void* operator new(size_t size)
+{
+    ++numAllocations;
+    if (void* p = malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+// Something like what a catalog might have
+static std::vector<std::string> makePaths()
+{
+    std::vector<std::string> paths;
+    for (size_t ii = 0; ii < 1000; ++ii)
+    {
+        paths.push_back("/data/collections/" + std::to_string(ii % 97) + "//products/./level1/../level2/image_" +
+                        std::to_string(ii) + ".ntf");
+    }
+    return paths;
+}
+
+/*
+ *  Time f() over all of the paths; "allocates" is whether f() may use the
+ *  heap.
+ */
+template <typename TFunc>
+static void run(benchmark::State& state, const std::string& label, bool allocates, TFunc f)
+{
+    static const auto paths = makePaths();
+    const auto allocations = numAllocations;
+    size_t total = 0;
+    for (const auto& path : paths)
+    {
+        total += f(path);
+    }
+    if (!allocates && (numAllocations != allocations))
+    {
+        throw except::Exception(Ctxt(state.getName() + "/" + label + " allocated memory"));
+    }
+
+    state.setItemsPerIteration(static_cast<double>(paths.size()));
+    state.run(label, [&]() {
+        total = 0;
+        for (const auto& path : paths)
+        {
+            total += f(path);
+        }
+        benchmark::doNotOptimize(total);
+    });
+}
+
+BENCHMARK_CASE(normalizePath)
+{
+    run(state, "string", true, [](const std::string& path) {
+        return sys::Path::normalizePath(path).size();
+    });
+    run(state, "view", false, [](const std::string& path) {
+        char buffer[256];
+        return sys::Path::normalizePath(path, buffer).size();
+    });
+}
+
+BENCHMARK_CASE(joinPaths)
+{
+    run(state, "string", true, [](const std::string& path) {
+        return sys::Path::joinPaths(path, "metadata.xml").size();
+    });
+    run(state, "view", false, [](const std::string& path) {
+        char buffer[256];
+        return sys::Path::joinPaths(path, "metadata.xml", buffer).size();
+    });
+}
+
+BENCHMARK_CASE(splitPath)
+{
+    run(state, "string", true, [](const std::string& path) {
+        return sys::Path::splitPath(path).second.size();
+    });
+    run(state, "view", false, [](const std::string& path) {
+        return sys::Path::splitPathView(path).second.size();
+    });
+}
+
+BENCHMARK_CASE(separate)
+{
+    run(state, "string", true, [](const std::string& path) {
+        return sys::Path::separate(path).size();
+    });
+    run(state, "components", false, [](const std::string& path) {
+        size_t retval = 0;
+        for (const auto component : sys::Path::components(path))
+        {
+            retval += component.size();
+        }
+        return retval;
+    });
+}
+
+BENCHMARK_MAIN(
+    BENCHMARK_CHECK(normalizePath);
+    BENCHMARK_CHECK(joinPaths);
+    BENCHMARK_CHECK(splitPath);
+    BENCHMARK_CHECK(separate);
+    )
@@ -24,6 +24,7 @@
 #ifndef CODA_OSS_import_sys_h_INCLUDED_
 #define CODA_OSS_import_sys_h_INCLUDED_
 
+#include "sys/AllocationPolicy.h"
 #include "sys/AtomicCounter.h"
 #include "sys/ConditionVar.h"
 #include "sys/Conf.h"
@@ -38,14 +39,18 @@
 #include "sys/LocalDateTime.h"
 #include "sys/Mutex.h"
 #include "sys/OS.h"
+#include "sys/Parallel.h"
 #include "sys/Path.h"
 #include "sys/ReadWriteMutex.h"
+#include "sys/StripedReadWriteMutex.h"
 #include "sys/Runnable.h"
 #include "sys/Semaphore.h"
 #include "sys/StopWatch.h"
 #include "sys/SystemException.h"
 #include "sys/TimeStamp.h"
 #include "sys/Thread.h"
+#include "sys/Trace.h"
+#include "sys/MemoryAccounting.h"
 #include "sys/UTCDateTime.h"
 //#include "sys/Process.h"
 
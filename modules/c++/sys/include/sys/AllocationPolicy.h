@@ -0,0 +1,108 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_sys_AllocationPolicy_h_INCLUDED_
+#define CODA_OSS_sys_AllocationPolicy_h_INCLUDED_
+
+#include <stddef.h>
+
+#include "config/Exports.h"
+#include "sys/Conf.h"
+
+/*!
+ * \file AllocationPolicy.h
+ * \brief Huge pages and NUMA placement for large alignedAlloc() buffers
+ *
+ * For buffers of hundreds of MB or more, TLB misses and memory on a remote
+ * NUMA node can cost as much as the computation.  An allocation with a
+ * policy other than the default is mapped directly from the OS (mmap() on
+ * Linux) so it can use huge pages and be bound to a node; it's returned
+ * zero-filled and has to be released with alignedFree(p, policy) rather
+ * than the plain alignedFree(), which stays a bare free().
+ *
+ * A policy is a request, not a requirement: huge pages that aren't
+ * available or a node that doesn't exist fall back to what the OS gives by
+ * default.  On Windows, policies are currently ignored.
+ */
+namespace sys
+{
+enum class HugePages
+{
+    Off,         //!< normal pages
+    Transparent, //!< madvise(MADV_HUGEPAGE): the kernel uses huge pages as it can
+    Explicit     //!< MAP_HUGETLB from the reserved pool, else Transparent
+};
+
+struct CODA_OSS_API AllocationPolicy final
+{
+    HugePages hugePages = HugePages::Off;
+
+    //! Preferred NUMA node (mbind(MPOL_PREFERRED)); -1 leaves placement to
+    //! "first touch," i.e., the node of the thread that first writes a page.
+    int numaNode = -1;
+
+    //! Touch every page now, on this thread, rather than on first use.
+    bool prefault = false;
+
+    bool isDefault() const noexcept
+    {
+        return (hugePages == HugePages::Off) && (numaNode < 0) && !prefault;
+    }
+};
+inline bool operator==(const AllocationPolicy& lhs, const AllocationPolicy& rhs) noexcept
+{
+    return (lhs.hugePages == rhs.hugePages) && (lhs.numaNode == rhs.numaNode) &&
+            (lhs.prefault == rhs.prefault);
+}
+inline bool operator!=(const AllocationPolicy& lhs, const AllocationPolicy& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+/*!
+ *  alignedAlloc() with an allocation policy; the default policy is the
+ *  same as alignedAlloc(size, alignment).
+ *
+ *  \throw except::Exception if the memory can't be allocated
+ */
+CODA_OSS_API void* alignedAlloc(size_t size, size_t alignment, const AllocationPolicy& policy);
+
+/*!
+ *  Free memory from alignedAlloc(size, alignment, policy), given the same
+ *  policy; with the default policy, this is just alignedFree(p).
+ */
+CODA_OSS_API void alignedFree(void* p, const AllocationPolicy& policy) noexcept;
+
+/*!
+ *  \return How the huge-page part of the policy was carried out for memory
+ *          from alignedAlloc(); HugePages::Off for anything else.
+ *          "Transparent" means the memory was madvise()d; whether the
+ *          kernel actually used huge pages isn't known.
+ */
+CODA_OSS_API HugePages getHugePages(const void* p) noexcept;
+
+//! The size of a huge page, e.g., 2 MiB on x86-64
+CODA_OSS_API size_t getHugePageSize() noexcept;
+}
+
+#endif  // CODA_OSS_sys_AllocationPolicy_h_INCLUDED_
@@ -37,6 +37,8 @@
 #include "sys/Path.h"
 #include "sys/filesystem.h"
 #include "config/Exports.h"
+#include "coda_oss/span.h"
+#include "coda_oss/cstddef.h"
 
 #ifdef _WIN32
 #    define _SYS_SEEK_CUR FILE_CURRENT
@@ -219,6 +221,16 @@ struct CODA_OSS_API File
     void writeFrom(const void* buffer,
                    size_t size);
 
+    /*!
+     *  Write several buffers, in order, with as few OS level write
+     *  operations as possible (writev() on POSIX, one WriteFile() per
+     *  buffer on Windows).
+     *  Blocks.
+     *
+     *  \param buffers The buffers to write out
+     */
+    void writeFrom(coda_oss::span<const coda_oss::span<const coda_oss::byte>> buffers);
+
     /*!
      *  Seek to the specified offset, relative to 'whence.'
      *  Valid values are FROM_START, FROM_CURRENT, FROM_END.
@@ -161,6 +161,23 @@ struct CODA_OSS_API FileFinder final
         const FilePredicate& filter,
         const std::vector<std::string>& searchPaths, 
         bool recursive = false);
+
+    /**
+     * Perform the search, passing each match to 'onMatch' as it's found
+     * rather than collecting them all first.
+     *
+     * With numThreads != 1 (0 for the number of CPUs) directories are read
+     * in parallel: matches arrive in no particular order, and 'filter' is
+     * called from several threads at once (the predicates above are fine
+     * with that).  Calls to 'onMatch' are never concurrent.  An exception
+     * from either stops the search and is re-thrown.
+     */
+    static void search(
+        const FilePredicate& filter,
+        const std::vector<std::string>& searchPaths,
+        bool recursive,
+        const std::function<void(const std::string&)>& onMatch,
+        size_t numThreads = 1);
 };
 
 // Recurssively search the entire directory structure, starting at "startingDirectory", for the given file.
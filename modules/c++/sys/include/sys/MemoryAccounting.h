@@ -0,0 +1,242 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+#ifndef CODA_OSS_sys_MemoryAccounting_h_INCLUDED_
+#define CODA_OSS_sys_MemoryAccounting_h_INCLUDED_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "config/Exports.h"
+
+/*!
+ * \file MemoryAccounting.h
+ * \brief Current and peak bytes held by the library's large buffers
+ *
+ * Buffers such as mem::ScopedAlignedArray, mem::ScratchMemory,
+ * io::ByteStream and the io stream buffers report what they hold to a named
+ * MemoryCategory, which keeps the current total, the high-water mark and
+ * the number of allocations.  Every category also feeds a process-wide
+ * total.
+ *
+ * Accounting is off until enableMemoryAccounting() is called; until then,
+ * a buffer that (re)allocates pays a single relaxed atomic load.  Buffers
+ * are counted from their first allocation after accounting is enabled, and
+ * stop being counted at their first change after it's disabled.
+ *
+ * \code
+    sys::enableMemoryAccounting();
+    sys::MemoryUsageReporter reporter(std::chrono::seconds(10),
+        [](const std::vector<sys::MemoryUsage>& usage)
+        {
+            sys::writeMemoryUsage(std::clog, usage);
+        });
+    process();
+    sys::writeMemoryUsage(std::cout, sys::getMemoryUsage());
+ * \endcode
+ */
+namespace sys
+{
+struct MemoryUsage final
+{
+    std::string name; //!< The category name, e.g., "io::ByteStream"
+    uint64_t currentBytes = 0;
+    uint64_t peakBytes = 0; //!< Since creation or resetPeakMemoryUsage()
+    uint64_t allocations = 0; //!< The number of times bytes were added
+};
+
+namespace details
+{
+extern CODA_OSS_API std::atomic<bool> memoryAccountingEnabled;
+}
+
+//! Start (or stop) counting allocations, in every thread.
+CODA_OSS_API void enableMemoryAccounting(bool enable = true);
+
+inline bool isMemoryAccountingEnabled() noexcept
+{
+    return details::memoryAccountingEnabled.load(std::memory_order_relaxed);
+}
+
+/*!
+ *  \class MemoryCategory
+ *  \brief Thread-safe current/peak byte counters for one kind of buffer
+ *
+ *  Categories are created by getMemoryCategory() and live until the
+ *  process exits.
+ */
+class CODA_OSS_API MemoryCategory final
+{
+public:
+    MemoryCategory(const std::string& name, MemoryCategory* total);
+
+    MemoryCategory(const MemoryCategory&) = delete;
+    MemoryCategory& operator=(const MemoryCategory&) = delete;
+
+    const std::string& getName() const noexcept
+    {
+        return mName;
+    }
+
+    void add(uint64_t numBytes) noexcept;
+    void subtract(uint64_t numBytes) noexcept;
+
+    MemoryUsage getUsage() const;
+
+    //! Make the peak the current number of bytes.
+    void resetPeak() noexcept;
+
+private:
+    const std::string mName;
+    MemoryCategory* const mTotal; //!< nullptr for the total itself
+    std::atomic<uint64_t> mCurrent{ 0 };
+    std::atomic<uint64_t> mPeak{ 0 };
+    std::atomic<uint64_t> mAllocations{ 0 };
+};
+
+//! The category with this name, created the first time it's asked for
+CODA_OSS_API MemoryCategory& getMemoryCategory(const std::string& name);
+
+//! Every category that has been created, sorted by name
+CODA_OSS_API std::vector<MemoryUsage> getMemoryUsage();
+
+//! The sum over all categories; its peak is the process-wide high-water mark.
+CODA_OSS_API MemoryUsage getTotalMemoryUsage();
+
+//! Reset the peak of every category (and the total) to its current value.
+CODA_OSS_API void resetPeakMemoryUsage();
+
+/*!
+ *  Write one line per category, followed by the total, e.g.
+ *      io::ByteStream: 12.0 MiB (peak 48.0 MiB, 7 allocations)
+ */
+CODA_OSS_API void writeMemoryUsage(std::ostream& os, const std::vector<MemoryUsage>& usage);
+
+/*!
+ *  \class AccountedBytes
+ *  \brief The number of bytes one buffer has reported to its category
+ *
+ *  An owner calls set() with its new size whenever it (re)allocates; the
+ *  bytes are returned to the category when this is destroyed.  Copies
+ *  count the same number of bytes as the original.
+ */
+class CODA_OSS_API AccountedBytes final
+{
+public:
+    explicit AccountedBytes(MemoryCategory& category) noexcept :
+        mCategory(&category)
+    {
+    }
+    AccountedBytes(const AccountedBytes& other) noexcept :
+        mCategory(other.mCategory)
+    {
+        set(other.mNumBytes);
+    }
+    AccountedBytes& operator=(const AccountedBytes& other) noexcept
+    {
+        if (this != &other)
+        {
+            set(0);
+            mCategory = other.mCategory;
+            set(other.mNumBytes);
+        }
+        return *this;
+    }
+    ~AccountedBytes()
+    {
+        set(0);
+    }
+
+    void set(uint64_t numBytes) noexcept
+    {
+        // Nothing to do in the usual case, with accounting disabled
+        if (numBytes != mNumBytes &&
+            (mNumBytes != 0 || isMemoryAccountingEnabled()))
+        {
+            update(numBytes);
+        }
+    }
+
+    uint64_t get() const noexcept
+    {
+        return mNumBytes;
+    }
+
+    //! Move whatever is counted to another category.
+    void setCategory(MemoryCategory& category) noexcept;
+
+private:
+    void update(uint64_t numBytes) noexcept;
+
+    MemoryCategory* mCategory;
+    uint64_t mNumBytes = 0;
+};
+
+/*!
+ *  \class MemoryUsageReporter
+ *  \brief Calls a function with getMemoryUsage() every so often, from a
+ *   thread of its own, until destroyed
+ *
+ *  The function is also called once more on destruction, so the final
+ *  high-water marks are always reported.  Exceptions it throws are
+ *  ignored.
+ */
+class CODA_OSS_API MemoryUsageReporter final
+{
+public:
+    using Callback = std::function<void(const std::vector<MemoryUsage>&)>;
+
+    MemoryUsageReporter(std::chrono::milliseconds period, Callback callback);
+    ~MemoryUsageReporter();
+
+    MemoryUsageReporter(const MemoryUsageReporter&) = delete;
+    MemoryUsageReporter& operator=(const MemoryUsageReporter&) = delete;
+
+    //! Call the function now, from this thread.
+    void report();
+
+private:
+    void run();
+
+    const std::chrono::milliseconds mPeriod;
+    const Callback mCallback;
+    std::mutex mMutex; // serializes calls to mCallback
+    std::mutex mStopMutex;
+    std::condition_variable mStopCondition;
+    bool mStop = false;
+    std::thread mThread;
+};
+}
+
+#endif  // CODA_OSS_sys_MemoryAccounting_h_INCLUDED_
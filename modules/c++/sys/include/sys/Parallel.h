@@ -0,0 +1,136 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+#ifndef CODA_OSS_sys_Parallel_h_INCLUDED_
+#define CODA_OSS_sys_Parallel_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <utility>
+#include <vector>
+
+#include "sys/OS.h"
+
+/*!
+ * \file Parallel.h
+ * \brief Splitting work across a few short-lived threads
+ *
+ * For modules that can't use mt (which depends on them); c.f.,
+ * mt::Transform_par().
+ */
+namespace sys
+{
+typedef std::pair<size_t, size_t> ParallelPiece; //!< [begin, end)
+
+/*!
+ *  Split [0, n) into (at most) numThreads contiguous pieces of (about) the
+ *  same size, but with fewer pieces if they'd be smaller than
+ *  minimumPerThread: it's not worth starting a thread for less.  There is
+ *  always at least one piece, [0, 0) if n is 0.
+ *
+ *  \param numThreads Maximum number of pieces, 0 for the number of CPUs
+ */
+inline std::vector<ParallelPiece> splitForThreads(size_t n, size_t numThreads, size_t minimumPerThread)
+{
+    if (numThreads == 0)
+    {
+        numThreads = OS().getNumCPUs();
+    }
+    numThreads = std::max<size_t>(std::min(numThreads, n / std::max<size_t>(minimumPerThread, 1)), 1);
+    const size_t perThread = std::max<size_t>((n + numThreads - 1) / numThreads, 1);
+
+    std::vector<ParallelPiece> retval;
+    retval.reserve(numThreads);
+    size_t begin = 0;
+    do
+    {
+        retval.push_back(ParallelPiece(begin, std::min(n, begin + perThread)));
+        begin += perThread;
+    } while (begin < n);
+    return retval;
+}
+
+/*!
+ *  Call f(0) ... f(count - 1): f(0) on this thread and the others on their
+ *  own threads, with std::async().  Returns when they have all finished;
+ *  if any threw, the exception from the lowest index is re-thrown.
+ */
+template <typename TFunc>
+void parallel(size_t count, TFunc&& f)
+{
+    std::vector<std::future<void> > futures;
+    futures.reserve(count);
+    for (size_t ii = 1; ii < count; ++ii)
+    {
+        futures.push_back(std::async(std::launch::async, [&f, ii]() { f(ii); }));
+    }
+
+    std::exception_ptr error;
+    try
+    {
+        if (count > 0)
+        {
+            f(0);
+        }
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    for (auto& future : futures)
+    {
+        try
+        {
+            future.get();
+        }
+        catch (...)
+        {
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+/*!
+ *  Call f(begin, end) for each of splitForThreads(n, numThreads,
+ *  minimumPerThread), in parallel().
+ */
+template <typename TFunc>
+void parallelFor(size_t n, size_t numThreads, size_t minimumPerThread, TFunc&& f)
+{
+    const auto pieces = splitForThreads(n, numThreads, minimumPerThread);
+    parallel(pieces.size(), [&](size_t ii) { f(pieces[ii].first, pieces[ii].second); });
+}
+}
+
+#endif  // CODA_OSS_sys_Parallel_h_INCLUDED_
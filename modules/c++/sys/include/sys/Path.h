@@ -24,14 +24,18 @@
 #ifndef CODA_OSS_sys_Path_h_INCLUDED_
 #define CODA_OSS_sys_Path_h_INCLUDED_
 
+#include <stddef.h>
+
 #include <string>
 #include <deque>
+#include <iterator>
 #include <utility>
 #include <vector>
 
 #include "config/Exports.h"
 #include <import/str.h>
 #include "coda_oss/span.h"
+#include "coda_oss/string_view.h"
 
 #include "sys/OS.h"
 #include "sys/filesystem.h"
@@ -65,12 +69,23 @@ public:
     //! Shortcut for a std::pair of std::strings
     typedef std::pair<std::string, std::string> StringPair;
 
+    //! Views into a path rather than copies, for the "View" routines
+    using StringViewPair = std::pair<coda_oss::string_view, coda_oss::string_view>;
+
     /*!
      * Normalizes a pathname. Collapses redundant separators and up-level
      * references. On Windows, it converts forward slashes to backward slashes.
      */
     static std::string normalizePath(const std::string& path);
 
+    /*!
+     * Same as normalizePath(), but the result is written into 'buffer' (e.g.,
+     * a char[] on the stack) rather than allocated; 'buffer' must have room
+     * for at least path.size() + 1 characters.  The returned view is of
+     * 'buffer'; it is not NUL-terminated.
+     */
+    static coda_oss::string_view normalizePath(coda_oss::string_view path, coda_oss::span<char> buffer);
+
     inline std::string normalize() const
     {
         return normalizePath(mPathName);
@@ -90,6 +105,13 @@ public:
     static std::string joinPaths(const std::string& path1,
                                  const std::string& path2);
 
+    /*!
+     * Same as joinPaths(), but the result is written into 'buffer', which
+     * must have room for path1.size() + path2.size() + 1 characters.
+     */
+    static coda_oss::string_view joinPaths(coda_oss::string_view path1, coda_oss::string_view path2,
+                                           coda_oss::span<char> buffer);
+
     inline Path join(const std::string& path) const
     {
         return joinPaths(mPathName, path);
@@ -133,6 +155,97 @@ public:
         return separate(mPathName);
     }
 
+    /*!
+     *  The components of a path, the same ones separate() returns, as views
+     *  into the path rather than a vector of copies:
+     *      for (const auto component : sys::Path::components(path)) { ... }
+     */
+    class Components final
+    {
+        coda_oss::string_view mPath;
+
+    public:
+        class const_iterator final
+        {
+            coda_oss::string_view mPath;
+            size_t mBegin = 0;  // of the current component
+            size_t mEnd = 0;
+
+            static bool isDelimiter(char ch) noexcept
+            {
+#ifdef _WIN32
+                return (ch == '\\') || (ch == '/');
+#else
+                return ch == '/';
+#endif
+            }
+            void next() noexcept
+            {
+                mBegin = mEnd;
+                while ((mBegin < mPath.size()) && isDelimiter(mPath[mBegin]))
+                {
+                    ++mBegin;
+                }
+                mEnd = mBegin;
+                while ((mEnd < mPath.size()) && !isDelimiter(mPath[mEnd]))
+                {
+                    ++mEnd;
+                }
+            }
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = coda_oss::string_view;
+            using difference_type = ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = value_type;
+
+            const_iterator(coda_oss::string_view path, size_t pos) noexcept : mPath(path), mBegin(pos), mEnd(pos)
+            {
+                next();
+            }
+
+            value_type operator*() const noexcept
+            {
+                return mPath.substr(mBegin, mEnd - mBegin);
+            }
+            const_iterator& operator++() noexcept
+            {
+                next();
+                return *this;
+            }
+            const_iterator operator++(int) noexcept
+            {
+                auto retval = *this;
+                next();
+                return retval;
+            }
+            bool operator==(const const_iterator& rhs) const noexcept
+            {
+                return (mPath.data() == rhs.mPath.data()) && (mBegin == rhs.mBegin);
+            }
+            bool operator!=(const const_iterator& rhs) const noexcept
+            {
+                return !(*this == rhs);
+            }
+        };
+        using iterator = const_iterator;
+
+        explicit Components(coda_oss::string_view path) noexcept : mPath(path) { }
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(mPath, 0);
+        }
+        const_iterator end() const noexcept
+        {
+            return const_iterator(mPath, mPath.size());
+        }
+    };
+    static Components components(coda_oss::string_view path) noexcept
+    {
+        return Components(path);
+    }
+
     /*!
      *  Reverses separate()
      */
@@ -146,6 +259,9 @@ public:
      */
     static StringPair splitPath(const std::string& path);
 
+    //! Same as splitPath(), but views into 'path' rather than copies
+    static StringViewPair splitPathView(coda_oss::string_view path) noexcept;
+
     inline StringPair split() const
     {
         return splitPath(mPathName);
@@ -158,6 +274,7 @@ public:
      * be the empty string. drive + tail = path
      */
     static StringPair splitDrive(const std::string& path);
+    static StringViewPair splitDriveView(coda_oss::string_view path) noexcept;
 
     inline StringPair splitDrive() const
     {
@@ -172,6 +289,7 @@ public:
      * path.
      */
     static StringPair splitExt(const std::string& path);
+    static StringViewPair splitExtView(coda_oss::string_view path) noexcept;
 
     inline StringPair splitExt() const
     {
@@ -183,6 +301,7 @@ public:
      * pair returned by splitPath()
      */
     static std::string basename(const std::string& path, bool rmvExt = false);
+    static coda_oss::string_view basenameView(coda_oss::string_view path, bool rmvExt = false) noexcept;
 
     inline std::string getBasePath(bool removeExt = false) const
     {
@@ -0,0 +1,121 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_sys_StripedReadWriteMutex_h_INCLUDED_
+#define CODA_OSS_sys_StripedReadWriteMutex_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "config/Exports.h"
+
+namespace sys
+{
+/*!
+ *  \class StripedReadWriteMutex
+ *  \brief A reader-writer lock for read-mostly data
+ *
+ *  Readers count themselves in one of several "stripes" (each on its own
+ *  cache line, picked per thread) and only read a shared writer flag, so
+ *  uncontended reads don't bounce a cache line between cores; this is
+ *  unlike ReadWriteMutex, where every reader waits on one semaphore and a
+ *  writer waits on it once for each possible reader.
+ *
+ *  Writers are preferred: once one is waiting, new readers wait too.
+ *  Writers are comparatively expensive (they check every stripe), and
+ *  neither kind of lock is recursive.
+ *
+ *  lock()/unlock()/lock_shared()/unlock_shared() are provided so that
+ *  std::unique_lock and std::shared_lock work.
+ */
+struct CODA_OSS_API StripedReadWriteMutex final
+{
+    /*!
+     *  \param numStripes Reader counters; rounded up to a power of two,
+     *                    0 for the number of CPUs
+     */
+    explicit StripedReadWriteMutex(size_t numStripes = 0);
+    ~StripedReadWriteMutex();
+
+    StripedReadWriteMutex(const StripedReadWriteMutex&) = delete;
+    StripedReadWriteMutex& operator=(const StripedReadWriteMutex&) = delete;
+
+    //!  Lock for reading (no writes allowed)
+    void lockRead();
+
+    //!  Unlock for reading (writes allowed)
+    void unlockRead();
+
+    //!  Lock for writing (no reads/other writes allowed)
+    void lockWrite();
+
+    //!  Unlock for writing (reads allowed)
+    void unlockWrite();
+
+    void lock_shared()
+    {
+        lockRead();
+    }
+    void unlock_shared()
+    {
+        unlockRead();
+    }
+    void lock()
+    {
+        lockWrite();
+    }
+    void unlock()
+    {
+        unlockWrite();
+    }
+
+    size_t getNumStripes() const noexcept
+    {
+        return mMask + 1;
+    }
+
+private:
+    struct Stripe final
+    {
+        std::atomic<int> readers{ 0 };
+        char padding[64 - sizeof(std::atomic<int>)]; // one stripe per cache line
+    };
+
+    std::atomic<int>& readers();
+    bool noReaders() const;
+
+    std::unique_ptr<Stripe[]> mStripes;
+    size_t mMask;
+
+    std::atomic<int> mWriters{ 0 }; // waiting or writing
+    std::mutex mMutex; // for waiting, and for mWriting
+    std::condition_variable mCondition;
+    bool mWriting = false;
+};
+}
+
+#endif  // CODA_OSS_sys_StripedReadWriteMutex_h_INCLUDED_
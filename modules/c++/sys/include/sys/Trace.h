@@ -0,0 +1,168 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_sys_Trace_h_INCLUDED_
+#define CODA_OSS_sys_Trace_h_INCLUDED_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <vector>
+
+#include "config/Exports.h"
+
+/*!
+ * \file Trace.h
+ * \brief Scoped "trace zones" for seeing where wall time goes
+ *
+ * A zone records its name, thread, start and duration when it goes out of
+ * scope.  Each thread records into its own fixed-size ring buffer without
+ * locking (the oldest events are overwritten), and everything recorded so
+ * far can be written out in the Chrome trace format, which chrome://tracing
+ * and https://ui.perfetto.dev display as a timeline.
+ *
+ * Tracing is off until enableTracing() is called; until then, a zone costs
+ * a single relaxed atomic load.  Defining CODA_OSS_DISABLE_TRACING removes
+ * CODA_OSS_TRACE_ZONE() zones entirely.
+ *
+ * \code
+    void process()
+    {
+        CODA_OSS_TRACE_ZONE("process");
+        ...
+    }
+
+    sys::enableTracing();
+    process();
+    std::ofstream json("trace.json");
+    sys::writeChromeTrace(json);
+ * \endcode
+ */
+namespace sys
+{
+struct TraceEvent final
+{
+    const char* name; //!< As given to TraceZone
+    size_t threadIndex; //!< 0, 1, 2, ... in the order threads first record
+    int64_t start; //!< Nanoseconds on std::chrono::steady_clock
+    int64_t duration; //!< Nanoseconds
+};
+
+namespace details
+{
+extern CODA_OSS_API std::atomic<bool> tracingEnabled;
+
+inline int64_t traceNow() noexcept
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+CODA_OSS_API void recordTraceEvent(const char* name, int64_t start, int64_t end) noexcept;
+}
+
+//! Start (or stop) recording zones, in every thread.
+CODA_OSS_API void enableTracing(bool enable = true);
+
+inline bool isTracingEnabled() noexcept
+{
+    return details::tracingEnabled.load(std::memory_order_relaxed);
+}
+
+/*!
+ *  Set the number of events each thread keeps, for threads that start
+ *  recording after this; it's rounded up to a power of two.  The default
+ *  is 32768 events (768 KiB) per thread.
+ */
+CODA_OSS_API void setTraceBufferCapacity(size_t numEvents);
+
+/*!
+ *  Set how many exited threads' buffers are kept for getTraceEvents(); the
+ *  default is 64.  Beyond that, the oldest are freed as new threads start
+ *  recording, as are exited threads' buffers emptied by clearTraceEvents().
+ */
+CODA_OSS_API void setTraceRetiredThreadLimit(size_t numThreads);
+
+/*!
+ *  The events recorded so far (the most recent ones, for a thread that
+ *  has filled its buffer), ordered by start time.  This can be called
+ *  while other threads are recording, including threads that have exited.
+ */
+CODA_OSS_API std::vector<TraceEvent> getTraceEvents();
+
+//! Forget the events recorded so far.
+CODA_OSS_API void clearTraceEvents();
+
+/*!
+ *  Write getTraceEvents() as Chrome trace JSON: "complete" (ph "X") events
+ *  with microsecond times relative to the first event.
+ */
+CODA_OSS_API void writeChromeTrace(std::ostream& os);
+
+/*!
+ *  \class TraceZone
+ *  \brief Records an event from construction to destruction, if tracing
+ *   was enabled when it was constructed
+ *
+ *  The name isn't copied; it must last until the events are written
+ *  (e.g., a string literal).  Use CODA_OSS_TRACE_ZONE() rather than
+ *  creating these directly.
+ */
+class TraceZone final
+{
+public:
+    explicit TraceZone(const char* name) noexcept :
+        mName(name), mStart(isTracingEnabled() ? details::traceNow() : -1)
+    {
+    }
+    ~TraceZone()
+    {
+        if (mStart >= 0)
+        {
+            details::recordTraceEvent(mName, mStart, details::traceNow());
+        }
+    }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const char* mName;
+    int64_t mStart;
+};
+}
+
+#ifdef CODA_OSS_DISABLE_TRACING
+#define CODA_OSS_TRACE_ZONE(name) ((void)0)
+#else
+#define CODA_OSS_TRACE_ZONE_CAT_(a, b) a##b
+#define CODA_OSS_TRACE_ZONE_CAT(a, b) CODA_OSS_TRACE_ZONE_CAT_(a, b)
+//! A TraceZone for the rest of the enclosing scope
+#define CODA_OSS_TRACE_ZONE(name) \
+    const sys::TraceZone CODA_OSS_TRACE_ZONE_CAT(coda_oss_trace_zone_, __LINE__)(name)
+#endif
+
+#endif  // CODA_OSS_sys_Trace_h_INCLUDED_
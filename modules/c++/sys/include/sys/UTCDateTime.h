@@ -23,6 +23,8 @@
 #ifndef __SYS_UTC_DATE_TIME_H__
 #define __SYS_UTC_DATE_TIME_H__
 
+#include <stddef.h>
+
 #include <ostream>
 #include <istream>
 
@@ -46,6 +48,10 @@ protected:
     //! Given seconds since the epoch, provides the UTC time
     virtual void getTime(time_t numSecondsSinceEpoch, tm& t) const override;
 
+private:
+    //! Same as DateTime::fromMillis(), but without gmtime()
+    void fromMillisUTC();
+
 public:
     /*!
      *  Construct as current date and time (UTC).
@@ -84,6 +90,23 @@ public:
      *  2011-10-19T11:59:46Z
      */
     std::string format() const;
+
+    /*!
+     *  Fast path for the default format: "YYYY-MM-DDThh:mm:ss[.sss]Z" is
+     *  parsed without any allocations or libc time calls.  The result is
+     *  identical to UTCDateTime(time); anything else (leading white-space,
+     *  trailing text, out-of-range fields, ...) goes through that constructor.
+     */
+    void parseISO8601(const char* time, size_t length);
+    void parseISO8601(const std::string& time);
+
+    /*!
+     *  Write format() into 'buffer' (NUL-terminated) without any allocations
+     *  and return the length, not counting the NUL.  Years 1000-9999 need 21
+     *  characters; other years use format() itself.  Throws if 'size' is too
+     *  small.
+     */
+    size_t formatISO8601(char* buffer, size_t size) const;
 };
 
 std::ostream& operator<<(std::ostream& os, const UTCDateTime& dateTime);
@@ -0,0 +1,264 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "sys/AllocationPolicy.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include "sys/Trace.h"
+
+namespace
+{
+// Memory mapped by alignedAlloc() with a policy; alignedFree(p, policy)
+// needs the length to munmap() it.  Only those calls (and getHugePages())
+// look here, so plain alignedFree() never takes the lock.
+struct Mapping final
+{
+    size_t length;
+    sys::HugePages hugePages;
+};
+
+std::atomic<size_t> numMappings{0};
+
+// Never destroyed: static objects may free their buffers during exit.
+std::mutex& getMappingsMutex()
+{
+    static auto const mutex = new std::mutex();
+    return *mutex;
+}
+std::unordered_map<void*, Mapping>& getMappings()
+{
+    static auto const mappings = new std::unordered_map<void*, Mapping>();
+    return *mappings;
+}
+
+size_t readHugePageSize()
+{
+    constexpr size_t defaultSize = 2 * 1024 * 1024;
+#ifdef __linux__
+    std::ifstream meminfo("/proc/meminfo");
+    std::string name;
+    size_t kB = 0;
+    while (meminfo >> name)
+    {
+        if (name == "Hugepagesize:" && (meminfo >> kB) && (kB > 0))
+        {
+            return kB * 1024;
+        }
+        meminfo.ignore(256, '\n');
+    }
+#endif
+    return defaultSize;
+}
+
+inline size_t roundUp(size_t value, size_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+#ifndef _WIN32
+size_t getPageSize()
+{
+    static const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return pageSize;
+}
+
+/*
+ * mmap() "length" bytes (a multiple of "granularity", which is what mmap()
+ * aligns to given these flags) aligned to "alignment", trimming any extra
+ * that had to be mapped to get that alignment.
+ */
+void* mapAligned(size_t length, size_t alignment, size_t granularity, int flags)
+{
+    const auto extra = (alignment > granularity) ? roundUp(alignment - granularity, granularity) : 0;
+    void* const mapped = mmap(nullptr, length + extra, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+    if (mapped == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    auto const base = static_cast<char*>(mapped);
+    auto const p = reinterpret_cast<char*>(roundUp(reinterpret_cast<size_t>(base), alignment));
+    const auto head = static_cast<size_t>(p - base);
+    if (head > 0)
+    {
+        munmap(base, head);
+    }
+    if (extra > head)
+    {
+        munmap(p + length, extra - head);
+    }
+    return p;
+}
+
+void bindToNode(void* p, size_t length, int node)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    constexpr int MPOL_PREFERRED_ = 1; // from <linux/mempolicy.h>
+    constexpr size_t bitsPerLong = sizeof(unsigned long) * 8;
+    const auto n = static_cast<size_t>(node);
+    std::vector<unsigned long> nodeMask(n / bitsPerLong + 1);
+    nodeMask[n / bitsPerLong] = 1ul << (n % bitsPerLong);
+    // It's only a preference: a node that doesn't exist is just ignored.
+    static_cast<void>(syscall(SYS_mbind, p, length, MPOL_PREFERRED_, nodeMask.data(),
+                              nodeMask.size() * bitsPerLong + 1, 0));
+#else
+    static_cast<void>(p);
+    static_cast<void>(length);
+    static_cast<void>(node);
+#endif
+}
+#endif
+}
+
+size_t sys::getHugePageSize() noexcept
+{
+    static const auto hugePageSize = readHugePageSize();
+    return hugePageSize;
+}
+
+void* sys::alignedAlloc(size_t size, size_t alignment, const AllocationPolicy& policy)
+{
+    if (policy.isDefault())
+    {
+        return alignedAlloc(size, alignment);
+    }
+    CODA_OSS_TRACE_ZONE("sys::alignedAlloc");
+
+#ifdef _WIN32
+    void* const p = alignedAlloc(size, alignment);
+    memset(p, 0, size);
+    return p;
+#else
+    const auto pageSize = getPageSize();
+    const auto hugePageSize = getHugePageSize();
+    size = (size == 0) ? 1 : size;
+
+    void* p = nullptr;
+    Mapping mapping{0, HugePages::Off};
+#ifdef MAP_HUGETLB
+    if (policy.hugePages == HugePages::Explicit)
+    {
+        mapping.length = roundUp(size, hugePageSize);
+        p = mapAligned(mapping.length, alignment, hugePageSize, MAP_HUGETLB);
+        mapping.hugePages = HugePages::Explicit;
+    }
+#endif
+    if (p == nullptr)
+    {
+        // Transparent huge pages only help a region with (aligned) huge pages in it.
+        const auto useHugePages = (policy.hugePages != HugePages::Off) && (size >= hugePageSize);
+        mapping.length = roundUp(size, useHugePages ? hugePageSize : pageSize);
+        p = mapAligned(mapping.length, useHugePages ? std::max(alignment, hugePageSize) : alignment,
+                       pageSize, 0);
+        if (p == nullptr)
+        {
+            throw except::Exception(Ctxt("Aligned allocation failure of size [" + std::to_string(size) + "] bytes"));
+        }
+        mapping.hugePages = HugePages::Off;
+#ifdef MADV_HUGEPAGE
+        if (useHugePages && (madvise(p, mapping.length, MADV_HUGEPAGE) == 0))
+        {
+            mapping.hugePages = HugePages::Transparent;
+        }
+#endif
+    }
+
+    if (policy.numaNode >= 0)
+    {
+        bindToNode(p, mapping.length, policy.numaNode);
+    }
+    if (policy.prefault)
+    {
+        const auto step = (mapping.hugePages == HugePages::Off) ? pageSize : hugePageSize;
+        for (size_t offset = 0; offset < mapping.length; offset += step)
+        {
+            static_cast<volatile char*>(p)[offset] = 0;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(getMappingsMutex());
+        getMappings()[p] = mapping;
+        ++numMappings;
+    }
+    return p;
+#endif
+}
+
+void sys::alignedFree(void* p, const AllocationPolicy& policy) noexcept
+{
+#ifndef _WIN32
+    if ((p != nullptr) && !policy.isDefault())
+    {
+        Mapping mapping{0, HugePages::Off};
+        {
+            std::lock_guard<std::mutex> lock(getMappingsMutex());
+            auto& mappings = getMappings();
+            const auto it = mappings.find(p);
+            if (it != mappings.end())
+            {
+                mapping = it->second;
+                mappings.erase(it);
+                --numMappings;
+            }
+        }
+        if (mapping.length > 0)
+        {
+            munmap(p, mapping.length);
+            return;
+        }
+    }
+#else
+    static_cast<void>(policy);
+#endif
+    alignedFree(p);
+}
+
+sys::HugePages sys::getHugePages(const void* p) noexcept
+{
+    if (numMappings.load(std::memory_order_relaxed) == 0)
+    {
+        return HugePages::Off;
+    }
+    std::lock_guard<std::mutex> lock(getMappingsMutex());
+    const auto& mappings = getMappings();
+    const auto it = mappings.find(const_cast<void*>(p));
+    return (it == mappings.end()) ? HugePages::Off : it->second.hugePages;
+}
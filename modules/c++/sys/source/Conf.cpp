@@ -32,6 +32,7 @@
 #include "coda_oss/span.h"
 
 #include "sys/Span.h"
+#include "sys/Trace.h"
 
 // https://en.cppreference.com/w/cpp/types/endian
 using endian = coda_oss::endian;
@@ -160,6 +161,7 @@ inline auto byteSwap_n(coda_oss::span<coda_oss::byte> buffer, size_t elemSize)
 }
 static coda_oss::span<const coda_oss::byte> byteSwap(coda_oss::span<coda_oss::byte> buffer, size_t elemSize, size_t numElems)
 {
+    CODA_OSS_TRACE_ZONE("sys::byteSwap");
     switch (elemSize)
     {
         case sizeof(uint16_t): return byteSwap_n<uint16_t>(buffer, elemSize);
@@ -249,6 +251,7 @@ static auto byteSwap(coda_oss::span<const coda_oss::byte> buffer,
                       size_t elemSize, size_t numElems,
                       coda_oss::span<coda_oss::byte> outputBuffer)
 {
+    CODA_OSS_TRACE_ZONE("sys::byteSwap");
     auto const bufferPtr = buffer.data();
     auto const outputBufferPtr = outputBuffer.data();
     switch (elemSize)
@@ -23,6 +23,7 @@
 
 #include <ctype.h>
 #include <errno.h>
+#include <cmath>
 
 #include <vector>
 #include <mutex>
@@ -365,8 +366,9 @@ void sys::DateTime::fromMillis(const tm& t)
     mHour = t.tm_hour;
     mMinute = t.tm_min;
 
-    const auto timeInSeconds = gsl::narrow_cast<size_t>(mTimeInMillis / 1000);
-    const auto timediff = (gsl::narrow_cast<double>(mTimeInMillis) / 1000.0) - gsl::narrow_cast<double>(timeInSeconds);
+    // Rounded down, as in getTime(), so times before 1970 work too
+    const auto timeInSeconds = std::floor(mTimeInMillis / 1000);
+    const auto timediff = (mTimeInMillis / 1000.0) - timeInSeconds;
     mSecond = t.tm_sec + timediff;
 }
 
@@ -411,7 +413,7 @@ void sys::DateTime::setNow()
 
 void sys::DateTime::getTime(tm& t) const
 {
-    getTime(static_cast<time_t>(mTimeInMillis / 1000), t);
+    getTime(static_cast<time_t>(std::floor(mTimeInMillis / 1000)), t);
 }
 
 std::string sys::DateTime::monthToString(int month)
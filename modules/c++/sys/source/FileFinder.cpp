@@ -21,12 +21,29 @@
  */
 #include "sys/FileFinder.h"
 
+#include <string.h>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <exception>
 #include <iterator>
+#include <mutex>
 #include <stdexcept>
 #include <tuple> // std::ignore
 #include <map>
 
 #include "sys/DirectoryEntry.h"
+#include "sys/OS.h"
+#include "sys/Parallel.h"
 #include "sys/Path.h"
 
 namespace fs = coda_oss::filesystem;
@@ -76,10 +93,10 @@ bool sys::ExtensionPredicate::operator()(const std::string& filename) const
     if (!sys::FileOnlyPredicate::operator()(filename))
         return false;
 
-    const std::string ext = sys::Path::splitExt(filename).second;
+    const auto ext = sys::Path::splitExtView(filename).second;
     if (mIgnoreCase)
     {
-        return str::eq(ext, mExt);
+        return str::eq(std::string(ext.data(), ext.size()), mExt);
     }
     else
         return ext == mExt;
@@ -153,52 +170,260 @@ std::vector<std::string> sys::FileFinder::search(
     const std::vector<std::string>& searchPaths, 
     bool recursive)
 {
-    // turn it into a list so we can queue additional entries
-    std::list < std::string > paths;
-    std::copy(searchPaths.begin(), searchPaths.end(), 
-              std::back_inserter(paths));
-
+    // One thread gives the same (breadth-first) order as always.
     std::vector <std::string> files;
-    size_t numInputPaths = searchPaths.size();
-    for (size_t pathIdx = 0; !paths.empty(); ++pathIdx)
+    search(filter, searchPaths, recursive,
+           [&](const std::string& path) { files.push_back(path); });
+    return files;
+}
+
+namespace
+{
+/*
+ * Breadth-first search with a queue of directories still to be read, shared
+ * by all of the threads: the time to read a directory swamps the time spent
+ * holding the lock, so there's little point in per-thread queues.
+ */
+class Traversal final
+{
+    const sys::FilePredicate& mFilter;
+    const std::function<void(const std::string&)>& mOnMatch;
+    const bool mRecursive;
+
+    std::mutex mMutex; // for everything below
+    std::condition_variable mCondition;
+    std::deque<std::string> mDirectories; // to be read
+    size_t mBusy = 0; // threads reading a directory
+    std::exception_ptr mError;
+
+    std::mutex mMatchMutex; // mOnMatch() is called one at a time
+    std::atomic<bool> mStopped{ false }; // after an exception
+
+    void push(std::vector<std::string>& directories)
+    {
+        if (!directories.empty())
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                std::move(directories.begin(), directories.end(), std::back_inserter(mDirectories));
+            }
+            mCondition.notify_all();
+            directories.clear();
+        }
+    }
+
+    static std::string join(const std::string& directory, const char* name)
     {
-        sys::Path path(paths.front());
-        paths.pop_front();
+        std::string retval;
+        retval.reserve(directory.size() + 1 + strlen(name));
+        retval = directory;
+        if (!str::endsWith(directory, sys::Path::delimiter()) && !str::endsWith(directory, "/"))
+        {
+            retval += sys::Path::delimiter();
+        }
+        retval += name;
+        return retval;
+    }
+
+    void readDirectory(const std::string& directory);
 
-        //! check if it exists
-        if (path.exists())
+    void work()
+    {
+        while (true)
         {
-            // check if this meets the criteria -- 
-            // we only need one to add it
-            if (filter(path.getPath()))
+            std::string directory;
             {
-                files.push_back(path.getPath());
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [&]() { return mError || !mDirectories.empty() || (mBusy == 0); });
+                if (mError || mDirectories.empty())
+                {
+                    return; // failed, or nothing to do and nobody can add more
+                }
+                directory = std::move(mDirectories.front());
+                mDirectories.pop_front();
+                ++mBusy;
             }
 
-            // if it's a directory we need to search its contents
-            if (path.isDirectory())
+            std::exception_ptr error;
+            try
             {
-                // If its an original directory or we are recursively searching
-                if (pathIdx < numInputPaths || recursive)
+                readDirectory(directory);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+                mStopped = true;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                --mBusy;
+                if (error && !mError)
                 {
-                    sys::DirectoryEntry d(path.getPath());
-                    for (sys::DirectoryEntry::Iterator p = d.begin(); 
-                         p != d.end(); ++p)
-                    {
-                        std::string fname(*p);
-                        if (fname != "." && fname != "..")
-                        {
-                            // add it to the list
-                            paths.push_back(sys::Path::joinPaths(path.getPath(),
-                                                                 fname));
-                        }
-                    }
+                    mError = error;
                 }
             }
+            mCondition.notify_all();
+        }
+    }
 
+public:
+    Traversal(const sys::FilePredicate& filter, const std::function<void(const std::string&)>& onMatch,
+              bool recursive) : mFilter(filter), mOnMatch(onMatch), mRecursive(recursive)
+    {
+    }
+
+    void match(const std::string& path)
+    {
+        if (!mStopped && mFilter(path))
+        {
+            std::lock_guard<std::mutex> lock(mMatchMutex);
+            if (mStopped)
+            {
+                return; // another thread failed while this one waited
+            }
+            try
+            {
+                mOnMatch(path);
+            }
+            catch (...)
+            {
+                mStopped = true;
+                throw;
+            }
         }
     }
-    return files;
+
+    void run(const std::vector<std::string>& searchPaths, size_t numThreads)
+    {
+        // The search paths themselves are always listed.
+        std::vector<std::string> directories;
+        for (const auto& searchPath : searchPaths)
+        {
+            const sys::Path path(searchPath);
+            if (path.exists())
+            {
+                match(searchPath);
+                if (path.isDirectory())
+                {
+                    directories.push_back(searchPath);
+                }
+            }
+        }
+        push(directories);
+
+        sys::parallel(numThreads, [&](size_t) { work(); });
+        if (mError)
+        {
+            std::rethrow_exception(mError);
+        }
+    }
+};
+
+#ifndef _WIN32
+// Whether an entry is a directory (following symbolic links, as
+// Path::isDirectory() does); false if it doesn't exist (a broken link).
+// readdir() usually says, so only links and "unknown" need fstatat().
+bool isDirectory(int directoryFd, const dirent& entry, bool& exists)
+{
+    exists = true;
+#ifdef _DIRENT_HAVE_D_TYPE
+    if (entry.d_type == DT_DIR)
+    {
+        return true;
+    }
+    if ((entry.d_type != DT_LNK) && (entry.d_type != DT_UNKNOWN))
+    {
+        return false;
+    }
+#endif
+    struct stat info;
+    if (::fstatat(directoryFd, entry.d_name, &info, 0) != 0)
+    {
+        exists = false;
+        return false;
+    }
+    return S_ISDIR(info.st_mode);
+}
+
+void Traversal::readDirectory(const std::string& directory)
+{
+    const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return; // e.g., no permission; DirectoryEntry would list nothing
+    }
+    DIR* const dir = ::fdopendir(fd);
+    if (dir == nullptr)
+    {
+        ::close(fd);
+        return;
+    }
+    std::unique_ptr<DIR, int(*)(DIR*)> closer(dir, ::closedir);
+
+    std::vector<std::string> subdirectories;
+    const dirent* entry;
+    while (!mStopped && ((entry = ::readdir(dir)) != nullptr))
+    {
+        const char* const name = entry->d_name;
+        if ((strcmp(name, ".") == 0) || (strcmp(name, "..") == 0))
+        {
+            continue;
+        }
+
+        bool exists;
+        const bool isDir = isDirectory(fd, *entry, exists);
+        if (!exists)
+        {
+            continue;
+        }
+        auto path = join(directory, name);
+        match(path);
+        if (isDir && mRecursive)
+        {
+            subdirectories.push_back(std::move(path));
+        }
+    }
+    push(subdirectories);
+}
+#else
+void Traversal::readDirectory(const std::string& directory)
+{
+    std::vector<std::string> subdirectories;
+    sys::DirectoryEntry d(directory);
+    for (sys::DirectoryEntry::Iterator p = d.begin(); p != d.end(); ++p)
+    {
+        std::string fname(*p);
+        if (fname != "." && fname != "..")
+        {
+            const sys::Path path(join(directory, fname.c_str()));
+            if (path.exists())
+            {
+                match(path.getPath());
+                if (mRecursive && path.isDirectory())
+                {
+                    subdirectories.push_back(path.getPath());
+                }
+            }
+        }
+    }
+    push(subdirectories);
+}
+#endif
+}
+
+void sys::FileFinder::search(
+    const FilePredicate& filter,
+    const std::vector<std::string>& searchPaths,
+    bool recursive,
+    const std::function<void(const std::string&)>& onMatch,
+    size_t numThreads)
+{
+    if (numThreads == 0)
+    {
+        numThreads = sys::OS().getNumCPUs();
+    }
+    Traversal(filter, onMatch, recursive).run(searchPaths, numThreads);
 }
 
 static fs::path parent_path(const fs::path& p)
@@ -27,6 +27,7 @@
 #include <unistd.h>
 #include <string.h>
 #include <errno.h>
+#include <sys/uio.h>
 
 _SYS_HANDLE_TYPE sys::File::createFile(const coda_oss::filesystem::path& str_, int accessFlags, int creationFlags) noexcept
 {
@@ -115,6 +116,59 @@ void sys::File::writeFrom(const void* buffer, size_t size)
     while (bytesActuallyWritten < size);
 }
 
+void sys::File::writeFrom(coda_oss::span<const coda_oss::span<const coda_oss::byte>> buffers)
+{
+    // A fixed number of iovecs at a time keeps this allocation-free.
+    constexpr size_t maxIovecs = 64;
+    iovec iov[maxIovecs];
+
+    size_t next = 0; // the next buffer to go into iov[]
+    size_t offset = 0; // bytes of buffers[next] already written
+    while (next < buffers.size())
+    {
+        size_t count = 0;
+        for (size_t ii = next; ii < buffers.size() && count < maxIovecs; ++ii)
+        {
+            const auto skip = (ii == next) ? offset : 0;
+            if (buffers[ii].size() > skip)
+            {
+                iov[count].iov_base = const_cast<coda_oss::byte*>(buffers[ii].data() + skip);
+                iov[count].iov_len = buffers[ii].size() - skip;
+                ++count;
+            }
+        }
+        if (count == 0)
+        {
+            break; // nothing but empty buffers left
+        }
+
+        auto bytesWritten = ::writev(mHandle, iov, static_cast<int>(count));
+        if (bytesWritten == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw sys::SystemException(Ctxt("Writing to file"));
+        }
+
+        // Advance past what was written; a partial write picks up in the
+        // middle of a buffer.
+        while (next < buffers.size())
+        {
+            const auto remaining = buffers[next].size() - offset;
+            if (static_cast<size_t>(bytesWritten) < remaining)
+            {
+                offset += static_cast<size_t>(bytesWritten);
+                break;
+            }
+            bytesWritten -= static_cast<SSize_T>(remaining);
+            offset = 0;
+            ++next;
+        }
+    }
+}
+
 sys::Off_T sys::File::seekTo(sys::Off_T offset, int whence)
 {
     sys::Off_T off = ::lseek(mHandle, offset, whence);
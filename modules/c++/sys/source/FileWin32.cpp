@@ -130,6 +130,15 @@ void sys::File::writeFrom(const void* buffer, size_t size)
     }
 }
 
+void sys::File::writeFrom(coda_oss::span<const coda_oss::span<const coda_oss::byte>> buffers)
+{
+    // WriteFileGather() requires unbuffered I/O and page-sized buffers
+    for (const auto& buffer : buffers)
+    {
+        writeFrom(buffer.data(), buffer.size());
+    }
+}
+
 sys::Off_T sys::File::seekTo(sys::Off_T offset, int whence)
 {
     /* Ahhh!!! */
@@ -0,0 +1,242 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "sys/MemoryAccounting.h"
+
+#include <stdio.h>
+
+#include <map>
+#include <memory>
+
+std::atomic<bool> sys::details::memoryAccountingEnabled(false);
+
+namespace
+{
+struct Registry final
+{
+    std::mutex mutex;
+    sys::MemoryCategory total{ "total", nullptr };
+    std::map<std::string, std::unique_ptr<sys::MemoryCategory>> categories;
+};
+Registry& getRegistry()
+{
+    // Never destroyed: buffers in other statics may outlive it otherwise.
+    static Registry* const registry = new Registry();
+    return *registry;
+}
+
+std::string formatBytes(uint64_t numBytes)
+{
+    static const char* const units[] = { "B", "KiB", "MiB", "GiB", "TiB" };
+    auto value = static_cast<double>(numBytes);
+    size_t unit = 0;
+    while (value >= 1024.0 && unit + 1 < sizeof(units) / sizeof(units[0]))
+    {
+        value /= 1024.0;
+        ++unit;
+    }
+
+    char buffer[32];
+    if (unit == 0)
+    {
+        snprintf(buffer, sizeof(buffer), "%llu B", static_cast<unsigned long long>(numBytes));
+    }
+    else
+    {
+        snprintf(buffer, sizeof(buffer), "%.1f %s", value, units[unit]);
+    }
+    return buffer;
+}
+
+void writeLine(std::ostream& os, const sys::MemoryUsage& usage)
+{
+    os << usage.name << ": " << formatBytes(usage.currentBytes)
+       << " (peak " << formatBytes(usage.peakBytes) << ", "
+       << usage.allocations << (usage.allocations == 1 ? " allocation)\n" : " allocations)\n");
+}
+}
+
+void sys::enableMemoryAccounting(bool enable)
+{
+    details::memoryAccountingEnabled.store(enable, std::memory_order_relaxed);
+}
+
+sys::MemoryCategory::MemoryCategory(const std::string& name, MemoryCategory* total) :
+    mName(name), mTotal(total)
+{
+}
+
+void sys::MemoryCategory::add(uint64_t numBytes) noexcept
+{
+    const auto current = mCurrent.fetch_add(numBytes, std::memory_order_relaxed) + numBytes;
+    auto peak = mPeak.load(std::memory_order_relaxed);
+    while (current > peak &&
+           !mPeak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+    {
+    }
+    mAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (mTotal)
+    {
+        mTotal->add(numBytes);
+    }
+}
+
+void sys::MemoryCategory::subtract(uint64_t numBytes) noexcept
+{
+    mCurrent.fetch_sub(numBytes, std::memory_order_relaxed);
+    if (mTotal)
+    {
+        mTotal->subtract(numBytes);
+    }
+}
+
+sys::MemoryUsage sys::MemoryCategory::getUsage() const
+{
+    MemoryUsage retval;
+    retval.name = mName;
+    retval.currentBytes = mCurrent.load(std::memory_order_relaxed);
+    retval.peakBytes = mPeak.load(std::memory_order_relaxed);
+    retval.allocations = mAllocations.load(std::memory_order_relaxed);
+    return retval;
+}
+
+void sys::MemoryCategory::resetPeak() noexcept
+{
+    mPeak.store(mCurrent.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+sys::MemoryCategory& sys::getMemoryCategory(const std::string& name)
+{
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto& category = registry.categories[name];
+    if (!category)
+    {
+        category.reset(new MemoryCategory(name, &registry.total));
+    }
+    return *category;
+}
+
+std::vector<sys::MemoryUsage> sys::getMemoryUsage()
+{
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<MemoryUsage> retval;
+    retval.reserve(registry.categories.size());
+    for (const auto& category : registry.categories)
+    {
+        retval.push_back(category.second->getUsage());
+    }
+    return retval;
+}
+
+sys::MemoryUsage sys::getTotalMemoryUsage()
+{
+    return getRegistry().total.getUsage();
+}
+
+void sys::resetPeakMemoryUsage()
+{
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& category : registry.categories)
+    {
+        category.second->resetPeak();
+    }
+    registry.total.resetPeak();
+}
+
+void sys::writeMemoryUsage(std::ostream& os, const std::vector<MemoryUsage>& usage)
+{
+    for (const auto& category : usage)
+    {
+        writeLine(os, category);
+    }
+    writeLine(os, getTotalMemoryUsage());
+}
+
+void sys::AccountedBytes::update(uint64_t numBytes) noexcept
+{
+    if (mNumBytes != 0)
+    {
+        mCategory->subtract(mNumBytes);
+        mNumBytes = 0;
+    }
+    if (numBytes != 0 && isMemoryAccountingEnabled())
+    {
+        mCategory->add(numBytes);
+        mNumBytes = numBytes;
+    }
+}
+
+void sys::AccountedBytes::setCategory(MemoryCategory& category) noexcept
+{
+    if (&category != mCategory)
+    {
+        const auto numBytes = mNumBytes;
+        set(0);
+        mCategory = &category;
+        set(numBytes);
+    }
+}
+
+sys::MemoryUsageReporter::MemoryUsageReporter(std::chrono::milliseconds period, Callback callback) :
+    mPeriod(period), mCallback(std::move(callback))
+{
+    mThread = std::thread(&MemoryUsageReporter::run, this);
+}
+
+sys::MemoryUsageReporter::~MemoryUsageReporter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mStopMutex);
+        mStop = true;
+    }
+    mStopCondition.notify_one();
+    mThread.join();
+    report();
+}
+
+void sys::MemoryUsageReporter::report()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    try
+    {
+        mCallback(getMemoryUsage());
+    }
+    catch (...)
+    {
+    }
+}
+
+void sys::MemoryUsageReporter::run()
+{
+    std::unique_lock<std::mutex> lock(mStopMutex);
+    while (!mStopCondition.wait_for(lock, mPeriod, [this]() { return mStop; }))
+    {
+        lock.unlock();
+        report();
+        lock.lock();
+    }
+}
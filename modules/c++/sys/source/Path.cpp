@@ -62,94 +62,138 @@ Path::Path(const Path& path) :
 {
 }
 
-std::string Path::normalizePath(const std::string& path)
+static coda_oss::string_view delimiters()
 {
-    std::string osDelimStr(Path::delimiter());
-    std::string delimStr = osDelimStr;
+#ifdef _WIN32
+    return "\\/";  // forward slashes work too
+#else
+    return "/";
+#endif
+}
 
-    //if it's not a forward slash, add it as one of the options
-    if (delimStr != "/")
-        delimStr += "/";
+static bool startsWithDelimiter(coda_oss::string_view path)
+{
+    return !path.empty() && (path[0] == Path::delimiter()[0] || path[0] == '/');
+}
 
-    //get the drive parts, if any -- we will use the drive later
-    Path::StringPair driveParts = Path::splitDrive(path);
+static void checkBufferSize(coda_oss::span<char> buffer, size_t size)
+{
+    if (buffer.size() < size)
+    {
+        throw except::Exception(Ctxt("Buffer of " + std::to_string(buffer.size()) +
+                                     " characters is too small; need " + std::to_string(size)));
+    }
+}
 
-    std::vector<std::string> parts = str::Tokenizer(path, delimStr);
+static void append(char* buffer, size_t& length, coda_oss::string_view s)
+{
+    std::copy(s.begin(), s.end(), buffer + length);
+    length += s.size();
+}
 
-    int upCount = 0;
-    std::deque<std::string> pathDeque;
-    for (std::vector<std::string>::iterator it = parts.begin(); it
-            != parts.end(); ++it)
-    {
-        if (*it == ".")
+coda_oss::string_view Path::normalizePath(coda_oss::string_view path, coda_oss::span<char> buffer)
+{
+    // The result is never more than one character longer: a leading
+    // delimiter is added to relative paths.
+    checkBufferSize(buffer, path.size() + 1);
+    const char osDelim = Path::delimiter()[0];
+
+    //get the drive parts, if any -- we will use the drive later
+    const auto drive = Path::splitDriveView(path).first;
+
+    //only apply the beginning up directories if we didn't start at the root (/)
+    const bool applyUpCount = !startsWithDelimiter(path) && drive.empty();
+
+    // The result is built in place: the leading ".."s (which can only be
+    // added when there are no components yet), then the components, each
+    // with a leading delimiter (except the drive).
+    char* const out = buffer.data();
+    size_t length = 0;
+    size_t componentsBegin = 0;
+    size_t numComponents = 0;
+    for (const auto component : components(path))
+    {
+        if (component == ".")
             continue;
-        else if (*it == "..")
+        else if (component == "..")
         {
-            //we want to keep the drive, if there is one
-            if (pathDeque.size() == 1 && (*pathDeque.begin())
-                    == driveParts.first)
-                continue;
-            if (pathDeque.size() > 0)
-                pathDeque.pop_back();
-            else
-                upCount++;
+            if (numComponents == 1)
+            {
+                //we want to keep the drive, if there is one
+                const auto first = drive.empty() ? componentsBegin + 1 : componentsBegin;
+                if (coda_oss::string_view(out + first, length - first) == drive)
+                    continue;
+                length = componentsBegin;
+                numComponents = 0;
+            }
+            else if (numComponents > 1)
+            {
+                length = coda_oss::string_view(out, length).rfind(osDelim);
+                --numComponents;
+            }
+            else if (applyUpCount)
+            {
+                if (length > 0)
+                    out[length++] = osDelim;
+                append(out, length, "..");
+                componentsBegin = length;
+            }
         }
         else
-            pathDeque.push_back(*it);
+        {
+            //make sure we don't prepend the drive with a delimiter!
+            if ((numComponents > 0) || drive.empty())
+                out[length++] = osDelim;
+            append(out, length, component);
+            ++numComponents;
+        }
     }
+    return coda_oss::string_view(out, length);
+}
+std::string Path::normalizePath(const std::string& path)
+{
+    std::string retval(path.size() + 1, '\0');
+    const auto result = normalizePath(path, coda_oss::span<char>(&retval[0], retval.size()));
+    retval.resize(result.size());
+    return retval;
+}
 
-    //use the OS-specific delimiters
-    std::ostringstream out;
-    //only apply the beginning up directories if we didn't start at the root (/)
-    if (!str::startsWith(path, osDelimStr) && !str::startsWith(path, "/")
-            && driveParts.first.empty())
+coda_oss::string_view Path::joinPaths(coda_oss::string_view path1, coda_oss::string_view path2,
+                                      coda_oss::span<char> buffer)
+{
+    checkBufferSize(buffer, path1.size() + path2.size() + 1);
+    char* const out = buffer.data();
+    size_t length = 0;
+
+    //check to see if path2 is a root path
+    if (startsWithDelimiter(path2) || !Path::splitDriveView(path2).first.empty())
     {
-        if (upCount > 0)
-            out << "..";
-        for (int i = 1; i < upCount; ++i)
-            out << osDelimStr << "..";
+        append(out, length, path2);
+        return coda_oss::string_view(out, length);
     }
 
-    //make sure we don't prepend the drive with a delimiter!
-    std::deque<std::string>::iterator it = pathDeque.begin();
-    if (!driveParts.first.empty())
-        out << *it++;
-    for (; it != pathDeque.end(); ++it)
-        out << osDelimStr << *it;
-    return out.str();
+    append(out, length, path1);
+    if (path1.empty() || (path1.back() != Path::delimiter()[0] && path1.back() != '/'))
+        out[length++] = Path::delimiter()[0];
+    append(out, length, path2);
+    return coda_oss::string_view(out, length);
 }
-
 std::string Path::joinPaths(const std::string& path1,
                                  const std::string& path2)
 {
-    std::string osDelimStr(Path::delimiter());
-
-    //check to see if path2 is a root path
-    if (str::startsWith(path2, osDelimStr) || str::startsWith(path2, "/")
-            || !Path::splitDrive(path2).first.empty())
-        return path2;
-
-    std::ostringstream out;
-    out << path1;
-    if (!str::endsWith(path1, osDelimStr) && !str::endsWith(path1, "/"))
-        out << osDelimStr;
-    out << path2;
-    return out.str();
+    std::string retval(path1.size() + path2.size() + 1, '\0');
+    const auto result = joinPaths(path1, path2, coda_oss::span<char>(&retval[0], retval.size()));
+    retval.resize(result.size());
+    return retval;
 }
 
 std::vector<std::string> Path::separate(const std::string& path)
 {
-    Path workingPath = path;
     std::vector<std::string> pathList;
-    Path::StringPair pair;
-    while ((pair = workingPath.split()).first != workingPath.getPath())
+    for (const auto component : components(path))
     {
-        if (!pair.second.empty())
-            pathList.push_back(pair.second);
-        workingPath = pair.first;
+        pathList.emplace_back(component.data(), component.size());
     }
-
-    std::reverse(pathList.begin(), pathList.end());
     return pathList;
 }
 std::vector<std::string> Path::separate(const std::string& path, bool& isAbsolute)
@@ -195,63 +239,77 @@ bool Path::isAbsolutePath(const std::string& path)
 #endif
 }
 
-Path::StringPair Path::splitPath(const std::string& path)
+static Path::StringPair toStringPair(const Path::StringViewPair& views)
 {
-    std::string delimStr(Path::delimiter());
-
-    //if it's not a forward slash, add it as one of the options
-    if (delimStr != "/")
-        delimStr += "/";
+    return Path::StringPair(std::string(views.first.data(), views.first.size()),
+                            std::string(views.second.data(), views.second.size()));
+}
 
-    std::string::size_type pos = path.find_last_of(delimStr);
-    if (pos == std::string::npos)
-        return Path::StringPair("", path);
-    else if (!path.empty() && pos == path.length() - 1)
+Path::StringViewPair Path::splitPathView(coda_oss::string_view path) noexcept
+{
+    //ignore any trailing delimiters
+    auto pos = path.find_last_of(delimiters());
+    while (pos != coda_oss::string_view::npos && pos == path.length() - 1)
     {
-        // Just call ourselves again without the delimiter
-        return Path::splitPath(path.substr(0, path.length() - 1));
+        path.remove_suffix(1);
+        pos = path.find_last_of(delimiters());
     }
+    if (pos == coda_oss::string_view::npos)
+        return Path::StringViewPair(coda_oss::string_view(), path);
 
-    std::string::size_type lastRootPos = path.find_last_not_of(delimStr, pos);
-    std::string root;
-    if (lastRootPos == std::string::npos)
-        root = path.substr(0, pos + 1);
-    else
-        root = path.substr(0, lastRootPos + 1);
-    std::string base = path.substr(path.find_first_not_of(delimStr, pos));
-    return Path::StringPair(root, base);
+    const auto lastRootPos = path.find_last_not_of(delimiters(), pos);
+    const auto root = (lastRootPos == coda_oss::string_view::npos) ?
+        path.substr(0, pos + 1) : path.substr(0, lastRootPos + 1);
+    const auto base = path.substr(path.find_first_not_of(delimiters(), pos));
+    return Path::StringViewPair(root, base);
+}
+Path::StringPair Path::splitPath(const std::string& path)
+{
+    return toStringPair(splitPathView(path));
 }
 
+Path::StringViewPair Path::splitExtView(coda_oss::string_view path) noexcept
+{
+    const auto pos = path.rfind('.');
+    if (pos == coda_oss::string_view::npos)
+        return Path::StringViewPair(path, coda_oss::string_view());
+    return Path::StringViewPair(path.substr(0, pos), path.substr(pos));
+}
 Path::StringPair Path::splitExt(const std::string& path)
 {
-    std::string::size_type pos = path.rfind(".");
-    if (pos == std::string::npos)
-        return Path::StringPair(path, "");
-    return Path::StringPair(path.substr(0, pos), path.substr(pos));
+    return toStringPair(splitExtView(path));
 }
 
-std::string Path::basename(const std::string& path, bool removeExt)
+coda_oss::string_view Path::basenameView(coda_oss::string_view path, bool removeExt) noexcept
 {
-    std::string baseWithExtension = Path::splitPath(path).second;
+    const auto baseWithExtension = Path::splitPathView(path).second;
     if (removeExt)
     {
-        return Path::splitExt(baseWithExtension).first;
+        return Path::splitExtView(baseWithExtension).first;
     }
     return baseWithExtension;
-
+}
+std::string Path::basename(const std::string& path, bool removeExt)
+{
+    const auto result = basenameView(path, removeExt);
+    return std::string(result.data(), result.size());
 }
 
-Path::StringPair Path::splitDrive(const std::string& path)
+Path::StringViewPair Path::splitDriveView(coda_oss::string_view path) noexcept
 {
 #ifdef _WIN32
-    std::string::size_type pos = path.find(":");
+    const auto pos = path.find(':');
 #else
-    std::string::size_type pos = std::string::npos;
+    const auto pos = coda_oss::string_view::npos;
 #endif
 
-    if (pos == std::string::npos)
-        return Path::StringPair("", path);
-    return Path::StringPair(path.substr(0, pos + 1), path.substr(pos + 1));
+    if (pos == coda_oss::string_view::npos)
+        return Path::StringViewPair(coda_oss::string_view(), path);
+    return Path::StringViewPair(path.substr(0, pos + 1), path.substr(pos + 1));
+}
+Path::StringPair Path::splitDrive(const std::string& path)
+{
+    return toStringPair(splitDriveView(path));
 }
 
 const char* Path::delimiter()
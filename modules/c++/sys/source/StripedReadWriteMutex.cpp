@@ -0,0 +1,114 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "sys/StripedReadWriteMutex.h"
+
+#include "sys/OS.h"
+
+// Readers and writers both "announce, then check for the other" with
+// sequentially consistent operations, so at least one of them always sees
+// the other (as in Dekker's algorithm).
+
+sys::StripedReadWriteMutex::StripedReadWriteMutex(size_t numStripes)
+{
+    if (numStripes == 0)
+    {
+        numStripes = sys::OS().getNumCPUs();
+    }
+    size_t size = 1;
+    while (size < numStripes)
+    {
+        size *= 2;
+    }
+    mStripes.reset(new Stripe[size]);
+    mMask = size - 1;
+}
+
+sys::StripedReadWriteMutex::~StripedReadWriteMutex() = default;
+
+std::atomic<int>& sys::StripedReadWriteMutex::readers()
+{
+    // Threads take turns picking a stripe, so they're spread evenly.
+    static std::atomic<size_t> nextSlot{ 0 };
+    static thread_local const size_t slot = nextSlot++;
+    return mStripes[slot & mMask].readers;
+}
+
+bool sys::StripedReadWriteMutex::noReaders() const
+{
+    // The total, not each stripe: a std::shared_lock could be unlocked on
+    // a different thread (and so stripe) than it was locked on.
+    long total = 0;
+    for (size_t ii = 0; ii <= mMask; ++ii)
+    {
+        total += mStripes[ii].readers.load();
+    }
+    return total == 0;
+}
+
+void sys::StripedReadWriteMutex::lockRead()
+{
+    auto& count = readers();
+    while (true)
+    {
+        ++count;
+        if (mWriters.load() == 0)
+        {
+            return; // the usual case: no writers
+        }
+
+        // Back out, let the writer know, and wait for it to finish.
+        std::unique_lock<std::mutex> lock(mMutex);
+        --count;
+        mCondition.notify_all();
+        mCondition.wait(lock, [&]() { return mWriters.load() == 0; });
+    }
+}
+
+void sys::StripedReadWriteMutex::unlockRead()
+{
+    --readers();
+    if (mWriters.load() != 0)
+    {
+        // A writer may be waiting for this reader.
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCondition.notify_all();
+    }
+}
+
+void sys::StripedReadWriteMutex::lockWrite()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    ++mWriters; // from now on, new readers wait
+    mCondition.wait(lock, [&]() { return !mWriting && noReaders(); });
+    mWriting = true;
+}
+
+void sys::StripedReadWriteMutex::unlockWrite()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mWriting = false;
+        --mWriters;
+    }
+    mCondition.notify_all();
+}
@@ -0,0 +1,315 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "sys/Trace.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#include "sys/OS.h"
+
+std::atomic<bool> sys::details::tracingEnabled(false);
+
+namespace
+{
+// Each field is atomic (and written/read relaxed) so a reader racing with
+// the thread that owns the buffer doesn't read torn values; events it
+// might have read while they were being overwritten are discarded.
+struct Slot final
+{
+    std::atomic<const char*> name;
+    std::atomic<int64_t> start;
+    std::atomic<int64_t> duration;
+};
+
+// Written only by its thread; read by anyone holding the registry lock.
+struct ThreadBuffer final
+{
+    ThreadBuffer(size_t index_, size_t capacity) :
+        index(index_), mask(capacity - 1), slots(new Slot[capacity])
+    {
+    }
+
+    void record(const char* name, int64_t start, int64_t duration) noexcept
+    {
+        const auto h = head.load(std::memory_order_relaxed);
+
+        // A reader that sees any of these writes also sees claimed == h + 1,
+        // so it knows the event h - capacity might be torn.
+        claimed.store(h + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        Slot& slot = slots[h & mask];
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start.store(start, std::memory_order_relaxed);
+        slot.duration.store(duration, std::memory_order_relaxed);
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    void read(std::vector<sys::TraceEvent>& events) const
+    {
+        const uint64_t capacity = mask + 1;
+        const auto h1 = head.load(std::memory_order_acquire);
+        auto first = std::max(h1 > capacity ? h1 - capacity : 0,
+                              cleared.load(std::memory_order_relaxed));
+
+        const auto size = events.size();
+        for (auto i = first; i < h1; i++)
+        {
+            const Slot& slot = slots[i & mask];
+            events.push_back({ slot.name.load(std::memory_order_relaxed), index,
+                               slot.start.load(std::memory_order_relaxed),
+                               slot.duration.load(std::memory_order_relaxed) });
+        }
+
+        // Drop whatever the owner might have overwritten meanwhile.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto h2 = claimed.load(std::memory_order_relaxed);
+        if (h2 > first + capacity)
+        {
+            const auto numTorn = std::min(h2 - capacity - first, h1 - first);
+            events.erase(events.begin() + size, events.begin() + size + numTorn);
+        }
+    }
+
+    const size_t index;
+    const uint64_t mask;
+    const std::unique_ptr<Slot[]> slots;
+    std::atomic<uint64_t> head{ 0 }; // the number of events recorded
+    std::atomic<uint64_t> claimed{ 0 }; // head, or head + 1 while recording
+    std::atomic<uint64_t> cleared{ 0 }; // events before this are forgotten
+    std::atomic<bool> retired{ false }; // the thread has exited
+};
+
+struct Registry final
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    size_t numThreads = 0;
+    size_t capacity = 32768;
+    size_t retiredLimit = 64;
+};
+Registry& getRegistry()
+{
+    // Never destroyed: threads may still be exiting when statics are.
+    static Registry* const registry = new Registry();
+    return *registry;
+}
+
+// Free the buffers of exited threads that have nothing left to read, and the
+// oldest others beyond the limit; called with the registry locked.
+void pruneRetired(Registry& registry)
+{
+    auto& buffers = registry.buffers;
+    size_t numRetired = 0;
+    for (const auto& buffer : buffers)
+    {
+        numRetired += buffer->retired.load(std::memory_order_acquire) ? 1 : 0;
+    }
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                 [&](const std::unique_ptr<ThreadBuffer>& buffer) {
+                                     if (!buffer->retired.load(std::memory_order_acquire))
+                                     {
+                                         return false;
+                                     }
+                                     const auto head = buffer->head.load(std::memory_order_relaxed);
+                                     if (numRetired > registry.retiredLimit ||
+                                         buffer->cleared.load(std::memory_order_relaxed) >= head)
+                                     {
+                                         numRetired--;
+                                         return true;
+                                     }
+                                     return false;
+                                 }),
+                  buffers.end());
+}
+
+// Trivially destructible, so still usable from thread_local destructors
+// that run after ~ThreadBufferRetirer().
+thread_local ThreadBuffer* threadBuffer = nullptr;
+thread_local bool threadExited = false;
+
+struct ThreadBufferRetirer final
+{
+    ~ThreadBufferRetirer()
+    {
+        // Forget the buffer before handing it over: once it's retired, it
+        // can be freed, and zones from here on don't record.
+        auto buffer = threadBuffer;
+        threadBuffer = nullptr;
+        threadExited = true;
+        if (buffer)
+        {
+            buffer->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+thread_local ThreadBufferRetirer threadBufferRetirer;
+
+ThreadBuffer* getThreadBuffer() noexcept
+{
+    if (!threadBuffer && !threadExited)
+    {
+        try
+        {
+            auto& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            pruneRetired(registry);
+            registry.buffers.emplace_back(new ThreadBuffer(registry.numThreads++, registry.capacity));
+            (void)&threadBufferRetirer; // constructed now, so destroyed when the thread exits
+            threadBuffer = registry.buffers.back().get();
+        }
+        catch (...) // out of memory; don't record
+        {
+        }
+    }
+    return threadBuffer;
+}
+
+void appendEscaped(std::string& json, const char* s)
+{
+    for (; *s != '\0'; ++s)
+    {
+        const auto ch = static_cast<unsigned char>(*s);
+        if (ch == '"' || ch == '\\')
+        {
+            json += '\\';
+            json += *s;
+        }
+        else if (ch < 0x20)
+        {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+            json += escaped;
+        }
+        else
+        {
+            json += *s;
+        }
+    }
+}
+}
+
+
+void sys::details::recordTraceEvent(const char* name, int64_t start, int64_t end) noexcept
+{
+    if (auto buffer = getThreadBuffer())
+    {
+        buffer->record(name, start, end - start);
+    }
+}
+
+void sys::enableTracing(bool enable)
+{
+    details::tracingEnabled.store(enable, std::memory_order_relaxed);
+}
+
+void sys::setTraceBufferCapacity(size_t numEvents)
+{
+    size_t capacity = 1;
+    while (capacity < numEvents)
+    {
+        capacity <<= 1;
+    }
+
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.capacity = capacity;
+}
+
+void sys::setTraceRetiredThreadLimit(size_t numThreads)
+{
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.retiredLimit = numThreads;
+    pruneRetired(registry);
+}
+
+std::vector<sys::TraceEvent> sys::getTraceEvents()
+{
+    std::vector<TraceEvent> retval;
+    {
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto& buffer : registry.buffers)
+        {
+            buffer->read(retval);
+        }
+    }
+    std::stable_sort(retval.begin(), retval.end(),
+                     [](const TraceEvent& a, const TraceEvent& b) { return a.start < b.start; });
+    return retval;
+}
+
+void sys::clearTraceEvents()
+{
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    // Buffers of threads that have exited can go; the others are just marked.
+    auto& buffers = registry.buffers;
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                 [](const std::unique_ptr<ThreadBuffer>& buffer) {
+                                     return buffer->retired.load(std::memory_order_acquire);
+                                 }),
+                  buffers.end());
+    for (auto& buffer : buffers)
+    {
+        buffer->cleared.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+void sys::writeChromeTrace(std::ostream& os)
+{
+    const auto events = getTraceEvents();
+    const auto origin = events.empty() ? 0 : events.front().start;
+    const auto pid = static_cast<long long>(sys::OS().getProcessId());
+
+    // Formatted a block at a time; much faster than operator<< per field.
+    std::string json = "{\"traceEvents\":[";
+    char fields[160];
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const auto& event = events[i];
+        json += (i == 0) ? "\n{\"name\":\"" : ",\n{\"name\":\"";
+        appendEscaped(json, event.name);
+
+        // microseconds, to the nanosecond
+        const auto start = event.start - origin;
+        snprintf(fields, sizeof(fields),
+                 "\",\"cat\":\"coda-oss\",\"ph\":\"X\",\"ts\":%lld.%03d,\"dur\":%lld.%03d,\"pid\":%lld,\"tid\":%llu}",
+                 static_cast<long long>(start / 1000), static_cast<int>(start % 1000),
+                 static_cast<long long>(event.duration / 1000), static_cast<int>(event.duration % 1000),
+                 pid, static_cast<unsigned long long>(event.threadIndex));
+        json += fields;
+
+        if (json.size() > 65536)
+        {
+            os.write(json.data(), json.size());
+            json.clear();
+        }
+    }
+    json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    os.write(json.data(), json.size());
+}
@@ -21,16 +21,21 @@
  */
 #include <sys/UTCDateTime.h>
 
+#include <stdint.h>
+#include <string.h>
+
+#include <cmath>
+
 #include <sys/Conf.h>
 #include <except/Exception.h>
 #include <str/Convert.h>
 #include <str/Manip.h>
+#include <gsl/gsl.h>
 
 namespace
 {
 // These constants and functions were taken from the NRT DateTime.c implementation
 
-const long UNIX_EPOCH_YEAR(1970); // EPOCH = Jan 1 1970 00:00:00
 const double SECS_IN_MIN(60.0);
 const double SECS_IN_HOUR(60.0 * SECS_IN_MIN);
 const double SECS_IN_DAY(24.0 * SECS_IN_HOUR);
@@ -43,10 +48,6 @@ const int CUMULATIVE_DAYS_PER_MONTH[2][12] =
     {31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366}
 };
 
-// The number of days in a year.  Index 0 is for non-leap years, index 1 is
-// for leap years
-const int DAYS_PER_YEAR[2] = {365, 366};
-
 // Returns the appropriate index into CUMULATIVE_DAYS_PER_MONTH based on
 // whether 'year' is a leap year or not
 constexpr int yearIndex(int year)
@@ -70,6 +71,97 @@ int getNumFullDaysInYearSoFar(int year, int month, int dayOfMonth)
     numFullDays += dayOfMonth - 1;
     return numFullDays;
 }
+
+// The number of days from Jan 1 1970 to the given (proleptic Gregorian) date;
+// 'month' and 'day' are 1-based.  This is days_from_civil() from
+// http://howardhinnant.github.io/date_algorithms.html
+int64_t daysFromCivil(int64_t year, int month, int day)
+{
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const auto yearOfEra = year - era * 400;  // [0, 399]
+    const auto dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;  // [0, 365]
+    const auto dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;  // [0, 146096]
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// The broken-down UTC time gmtime() would return, but without any libc calls
+struct CivilTime final
+{
+    int64_t year;
+    int month;  // 1-based
+    int day;  // 1-based
+    int dayOfWeek;  // 0 is Sunday
+    int dayOfYear;  // 0-based
+    int hour;
+    int minute;
+    int second;
+};
+CivilTime civilFromSeconds(int64_t numSecondsSinceEpoch)
+{
+    auto days = numSecondsSinceEpoch / 86400;
+    auto seconds = numSecondsSinceEpoch % 86400;
+    if (seconds < 0)
+    {
+        seconds += 86400;
+        --days;
+    }
+
+    CivilTime retval;
+    retval.hour = static_cast<int>(seconds / 3600);
+    retval.minute = static_cast<int>((seconds % 3600) / 60);
+    retval.second = static_cast<int>(seconds % 60);
+
+    /* January 1, 1970 was a Thursday (4) */
+    retval.dayOfWeek = static_cast<int>(((days + 4) % 7 + 7) % 7);
+
+    // civil_from_days(), from the same reference as daysFromCivil()
+    const auto z = days + 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const auto dayOfEra = z - era * 146097;  // [0, 146096]
+    const auto yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;  // [0, 399]
+    const auto dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);  // [0, 365], from Mar 1
+    const auto mp = (5 * dayOfYear + 2) / 153;  // [0, 11], from March
+    retval.day = static_cast<int>(dayOfYear - (153 * mp + 2) / 5 + 1);
+    retval.month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    retval.year = yearOfEra + era * 400 + (retval.month <= 2);
+    retval.dayOfYear = static_cast<int>(days - daysFromCivil(retval.year, 1, 1));
+    return retval;
+}
+
+// Parse exactly 'n' digits; no sign, no white-space
+inline bool parseDigits(const char* p, size_t n, int64_t& result)
+{
+    result = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const auto digit = static_cast<unsigned>(p[i]) - '0';
+        if (digit > 9)
+        {
+            return false;
+        }
+        result = result * 10 + digit;
+    }
+    return true;
+}
+
+inline char* writeDigits(char* p, int value, size_t n)
+{
+    for (size_t i = n; i > 0; --i)
+    {
+        p[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return p + n;
+}
+
+// Exact powers of ten: the fraction is an integer < 10^15 < 2^53, so dividing
+// by one of these is correctly rounded, just like str::toType<double>().
+const double POWERS_OF_TEN[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+};
+constexpr size_t MAX_FRACTION_DIGITS = 15;
 }
 
 static const char DEFAULT_DATETIME_FORMAT[] = "%Y-%m-%dT%H:%M:%SZ";
@@ -104,16 +196,7 @@ void UTCDateTime::toMillis()
      * to mktime() that allows you to pass in the timezone you want.
      */
     long numDaysThisYear = getNumFullDaysInYearSoFar(mYear, mMonth, mDayOfMonth);
-    long numDaysSinceEpoch = 0;
-
-    /* Count up the # of days for all the years prior to this one
-     * TODO: This could be implemented more efficiently - see reference
-     * implementation above. */
-    for (int i = UNIX_EPOCH_YEAR; i < mYear; ++i)
-    {
-        numDaysSinceEpoch += DAYS_PER_YEAR[yearIndex(i)];
-    }
-    numDaysSinceEpoch += numDaysThisYear;
+    long numDaysSinceEpoch = static_cast<long>(daysFromCivil(mYear, 1, 1)) + numDaysThisYear;
 
     mTimeInMillis = (mSecond + mMinute * SECS_IN_MIN +
             mHour * SECS_IN_HOUR + numDaysSinceEpoch * SECS_IN_DAY) * 1000.0;
@@ -133,6 +216,21 @@ void UTCDateTime::getTime(time_t numSecondsSinceEpoch, tm& t) const
     DateTime::gmtime(numSecondsSinceEpoch, t);
 }
 
+void UTCDateTime::fromMillisUTC()
+{
+    // Rounded down (not toward zero) so times before 1970 work too
+    const auto timeInSeconds = std::floor(mTimeInMillis / 1000);
+    const auto t = civilFromSeconds(static_cast<int64_t>(timeInSeconds));
+    mYear = static_cast<int>(t.year);
+    mMonth = t.month;
+    mDayOfMonth = t.day;
+    mDayOfWeek = t.dayOfWeek + 1;
+    mDayOfYear = t.dayOfYear + 1;
+    mHour = t.hour;
+    mMinute = t.minute;
+    mSecond = t.second + ((mTimeInMillis / 1000.0) - timeInSeconds);
+}
+
 UTCDateTime::UTCDateTime()
 {
     setNow();
@@ -199,9 +297,102 @@ std::string UTCDateTime::format() const
     return format(DEFAULT_DATETIME_FORMAT);
 }
 
+void UTCDateTime::parseISO8601(const char* time, size_t length)
+{
+    // "YYYY-MM-DDThh:mm:ssZ" or "YYYY-MM-DDThh:mm:ss.sssZ"; the fixed widths
+    // and ranges are the same as the %Y, %m, %d, %H, %M and %S in strptime().
+    int64_t year, month, day, hour, minute, second;
+    const bool fixedFields = (length >= 20) &&
+        parseDigits(time, 4, year) && (time[4] == '-') &&
+        parseDigits(time + 5, 2, month) && (time[7] == '-') &&
+        parseDigits(time + 8, 2, day) && (time[10] == 'T') &&
+        parseDigits(time + 11, 2, hour) && (time[13] == ':') &&
+        parseDigits(time + 14, 2, minute) && (time[16] == ':') &&
+        parseDigits(time + 17, 2, second) &&
+        (month >= 1) && (month <= 12) && (day >= 1) && (day <= 31) &&
+        (hour <= 23) && (minute <= 59) && (second <= 61);
+
+    double millis = 0.0;
+    bool valid = fixedFields && (time[length - 1] == 'Z');
+    if (valid && (length > 20))
+    {
+        const auto numDigits = length - 21;  // less the '.' and 'Z'
+        int64_t fraction;
+        valid = (time[19] == '.') && (numDigits >= 1) && (numDigits <= MAX_FRACTION_DIGITS) &&
+            parseDigits(time + 20, numDigits, fraction);
+        if (valid)
+        {
+            millis = (static_cast<double>(fraction) / POWERS_OF_TEN[numDigits]) * 1000;
+        }
+    }
+    if (!valid)
+    {
+        *this = UTCDateTime(std::string(time, length));
+        return;
+    }
+
+    // What setTime() and then fromMillis() do with the strptime() results
+    mYear = static_cast<int>(year);
+    mMonth = static_cast<int>(month);
+    mDayOfMonth = static_cast<int>(day);
+    mDayOfWeek = mDayOfYear = 1;
+    mHour = static_cast<int>(hour);
+    mMinute = static_cast<int>(minute);
+    mTimeInMillis = millis;
+    const auto timeInSeconds = gsl::narrow_cast<size_t>(mTimeInMillis / 1000);
+    const auto timediff = (gsl::narrow_cast<double>(mTimeInMillis) / 1000.0) - gsl::narrow_cast<double>(timeInSeconds);
+    mSecond = static_cast<int>(second) + timediff;
+
+    toMillis();
+    fromMillisUTC();
+}
+void UTCDateTime::parseISO8601(const std::string& time)
+{
+    parseISO8601(time.c_str(), time.length());
+}
+
+size_t UTCDateTime::formatISO8601(char* buffer, size_t size) const
+{
+    // format() uses gmtime() on the whole seconds
+    const auto t = civilFromSeconds(static_cast<int64_t>(std::floor(mTimeInMillis / 1000)));
+    if ((t.year < 1000) || (t.year > 9999))
+    {
+        // strftime()'s %Y isn't always four digits; let it worry about that
+        const auto result = format();
+        if (result.length() >= size)
+        {
+            throw except::Exception(Ctxt("Buffer too small for " + result));
+        }
+        memcpy(buffer, result.c_str(), result.length() + 1);
+        return result.length();
+    }
+
+    constexpr size_t length = 20;  // "YYYY-MM-DDThh:mm:ssZ"
+    if (size <= length)
+    {
+        throw except::Exception(Ctxt("Buffer too small: " + std::to_string(size)));
+    }
+    auto p = writeDigits(buffer, static_cast<int>(t.year), 4);
+    *p++ = '-';
+    p = writeDigits(p, t.month, 2);
+    *p++ = '-';
+    p = writeDigits(p, t.day, 2);
+    *p++ = 'T';
+    p = writeDigits(p, t.hour, 2);
+    *p++ = ':';
+    p = writeDigits(p, t.minute, 2);
+    *p++ = ':';
+    p = writeDigits(p, t.second, 2);
+    *p++ = 'Z';
+    *p = '\0';
+    return length;
+}
+
 std::ostream& operator<<(std::ostream& os, const UTCDateTime& dateTime)
 {
-    os << dateTime.format().c_str();
+    char buffer[64];
+    dateTime.formatISO8601(buffer, sizeof(buffer));
+    os << buffer;
     return os;
 }
 
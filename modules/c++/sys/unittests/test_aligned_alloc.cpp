@@ -23,6 +23,7 @@
 #include <iostream>
 
 #include <sys/Conf.h>
+#include <sys/AllocationPolicy.h>
 #include <sys/Path.h>
 #include <except/Exception.h>
 #include <str/Convert.h>
@@ -74,10 +75,60 @@ TEST_CASE(testAlignedAlloc128)
     TEST_ASSERT(testAlignedAlloc(numBytes, 128));
 }
 
+static void testPolicy(const std::string& testName, const sys::AllocationPolicy& policy, size_t numBytes)
+{
+    for (const size_t alignment : {size_t(64), size_t(4096), size_t(1) << 22})
+    {
+        auto const p = static_cast<unsigned char*>(sys::alignedAlloc(numBytes, alignment, policy));
+        TEST_ASSERT_EQ(reinterpret_cast<size_t>(p) % alignment, static_cast<size_t>(0));
+        if (!policy.isDefault())
+        {
+            // from mmap(), so zero-filled; plain alignedAlloc() promises nothing
+            TEST_ASSERT_EQ(p[0], 0);
+            TEST_ASSERT_EQ(p[numBytes - 1], 0);
+        }
+        p[0] = p[numBytes - 1] = 1;
+
+        const auto hugePages = sys::getHugePages(p);
+        if (policy.hugePages == sys::HugePages::Off)
+        {
+            TEST_ASSERT(hugePages == sys::HugePages::Off);
+        }
+        sys::alignedFree(p, policy);
+        TEST_ASSERT(sys::getHugePages(p) == sys::HugePages::Off);
+    }
+}
+
+TEST_CASE(testAllocationPolicy)
+{
+    const auto hugePageSize = sys::getHugePageSize();
+    TEST_ASSERT(hugePageSize > 4096);
+
+    sys::AllocationPolicy policy;
+    TEST_ASSERT_TRUE(policy.isDefault());
+    testPolicy(testName, policy, 16384); // plain alignedAlloc()
+
+    policy.prefault = true;
+    testPolicy(testName, policy, 100000);
+
+    policy.hugePages = sys::HugePages::Transparent;
+    testPolicy(testName, policy, 3 * hugePageSize + 1);
+    testPolicy(testName, policy, 100); // too small for a huge page
+
+    policy.hugePages = sys::HugePages::Explicit; // probably none reserved; falls back
+    testPolicy(testName, policy, 2 * hugePageSize);
+
+    policy.numaNode = 0;
+    testPolicy(testName, policy, 2 * hugePageSize);
+    policy.numaNode = 1000; // doesn't exist: ignored
+    testPolicy(testName, policy, 100000);
+}
+
 TEST_MAIN(
     TEST_CHECK(testAlignedAlloc8);
     TEST_CHECK(testAlignedAlloc16);
     TEST_CHECK(testAlignedAlloc32);
     TEST_CHECK(testAlignedAlloc64);
     TEST_CHECK(testAlignedAlloc128);
+    TEST_CHECK(testAllocationPolicy);
 )
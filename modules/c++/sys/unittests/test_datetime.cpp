@@ -196,9 +196,103 @@ TEST_CASE(testGetTimeInMillis)
     TEST_ASSERT_LESSER_EQ(result, far_into_the_future);
 }
 
+static void testSameUTCDateTime(const std::string& testName, const sys::UTCDateTime& expected, const sys::UTCDateTime& actual)
+{
+    TEST_ASSERT_EQ(actual.getYear(), expected.getYear());
+    TEST_ASSERT_EQ(actual.getMonth(), expected.getMonth());
+    TEST_ASSERT_EQ(actual.getDayOfMonth(), expected.getDayOfMonth());
+    TEST_ASSERT_EQ(actual.getDayOfWeek(), expected.getDayOfWeek());
+    TEST_ASSERT_EQ(actual.getDayOfYear(), expected.getDayOfYear());
+    TEST_ASSERT_EQ(actual.getHour(), expected.getHour());
+    TEST_ASSERT_EQ(actual.getMinute(), expected.getMinute());
+    TEST_ASSERT_EQ(actual.getSecond(), expected.getSecond());  // exactly, not "almost"
+    TEST_ASSERT_EQ(actual.getTimeInMillis(), expected.getTimeInMillis());
+}
+TEST_CASE(testISO8601)
+{
+    // every ~9.3 days (so all days of the week/month/year show up) from 1902
+    // to 2037; toMillis() gives the epoch for years before 1970, but
+    // UTCDateTime(double) doesn't go through that
+    const char* fractions[] = { "", ".5", ".123", ".999", ".000001", ".123456789012345" };
+    char buffer[32];
+    size_t count = 0;
+    for (double millis = -2145916800000.0; millis < 2145916800000.0; millis += 803012345.0)
+    {
+        const sys::UTCDateTime dt(millis);
+        const auto formatted = dt.format();
+        const auto length = dt.formatISO8601(buffer, sizeof(buffer));
+        TEST_ASSERT_EQ(std::string(buffer, length), formatted);
+
+        auto str = formatted;
+        str.pop_back();  // 'Z'
+        str += fractions[count++ % (sizeof(fractions) / sizeof(fractions[0]))];
+        str += 'Z';
+        sys::UTCDateTime parsed;
+        parsed.parseISO8601(str);
+        testSameUTCDateTime(testName, sys::UTCDateTime(str), parsed);
+    }
+
+    // not the fixed format: same as the string constructor
+    for (const std::string str : { " 2011-10-19T11:59:46Z", "2011-10-19", "2011-10-19T11:59:46.Z", "2011-10-19T11:59:46Zoo",
+                                   "2011-10-19T11:59:46.1234567890123456Z" })
+    {
+        sys::UTCDateTime parsed;
+        parsed.parseISO8601(str);
+        testSameUTCDateTime(testName, sys::UTCDateTime(str), parsed);
+    }
+
+    // the fixed format, but a leap second or a year toMillis() doesn't handle:
+    // the epoch, like the string constructor
+    for (const std::string str : { "2011-10-19T11:59:60Z", "1969-12-31T23:59:58.5Z", "1960-02-31T11:59:59Z",
+                                   "2040-01-01T00:00:00Z" })
+    {
+        sys::UTCDateTime parsed;
+        parsed.parseISO8601(str);
+        testSameUTCDateTime(testName, sys::UTCDateTime(str), parsed);
+        TEST_ASSERT_EQ(parsed.getTimeInMillis(), 0.0);
+        TEST_ASSERT_EQ(parsed.getYear(), 1970);
+    }
+
+    // days past the end of the month roll over into the next one
+    sys::UTCDateTime rolledOver;
+    rolledOver.parseISO8601("2011-02-31T11:59:59Z");
+    testSameUTCDateTime(testName, sys::UTCDateTime("2011-02-31T11:59:59Z"), rolledOver);
+    TEST_ASSERT_EQ(rolledOver.getMonth(), 3);
+    TEST_ASSERT_EQ(rolledOver.getDayOfMonth(), 3);
+    sys::UTCDateTime parsed;
+    TEST_EXCEPTION(parsed.parseISO8601("2011-13-19T11:59:46Z"));
+    TEST_EXCEPTION(parsed.parseISO8601("2011-10-19T24:59:46Z"));
+
+    // before 1970 (only from millis), the seconds are rounded down
+    const sys::UTCDateTime beforeEpoch(-1500.0);
+    TEST_ASSERT_EQ(beforeEpoch.getYear(), 1969);
+    TEST_ASSERT_EQ(beforeEpoch.getMonth(), 12);
+    TEST_ASSERT_EQ(beforeEpoch.getDayOfMonth(), 31);
+    TEST_ASSERT_EQ(beforeEpoch.getHour(), 23);
+    TEST_ASSERT_EQ(beforeEpoch.getMinute(), 59);
+    TEST_ASSERT_EQ(beforeEpoch.getSecond(), 58.5);
+    TEST_ASSERT_EQ(beforeEpoch.getDayOfWeek(), 4);  // a Wednesday
+    TEST_ASSERT_EQ(beforeEpoch.getDayOfYear(), 365);
+    TEST_ASSERT_EQ(beforeEpoch.format(), "1969-12-31T23:59:58Z");
+    TEST_ASSERT_EQ(std::string(buffer, beforeEpoch.formatISO8601(buffer, sizeof(buffer))), beforeEpoch.format());
+
+    // and toMillis() still gives the epoch for them
+    sys::UTCDateTime setBeforeEpoch(1970, 1, 1, 0, 0, 0.0);
+    setBeforeEpoch.setYear(1969);
+    TEST_ASSERT_EQ(setBeforeEpoch.getTimeInMillis(), 0.0);
+    TEST_ASSERT_EQ(sys::UTCDateTime(1969, 12, 31, 23, 59, 58.5).getTimeInMillis(), 0.0);
+
+    // before the year 1000, and a buffer that's too small
+    const sys::UTCDateTime past(-40000000000000.0);
+    const auto length = past.formatISO8601(buffer, sizeof(buffer));
+    TEST_ASSERT_EQ(std::string(buffer, length), past.format());
+    TEST_EXCEPTION(sys::UTCDateTime(0.0).formatISO8601(buffer, 20));
+}
+
 TEST_MAIN(
     TEST_CHECK(testDefaultConstructor);
     TEST_CHECK(testParameterizedConstructor);
     TEST_CHECK(testDateTimeDetails);
     TEST_CHECK(testGetTimeInMillis);
+    TEST_CHECK(testISO8601);
 )
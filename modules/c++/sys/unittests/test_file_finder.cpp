@@ -0,0 +1,176 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <sys/FileFinder.h>
+#include <sys/OS.h>
+#include <sys/Path.h>
+#include "TestCase.h"
+
+namespace
+{
+// dirs/d<i>/d<j>/f<k>.txt and a few .dat files; removed at the end
+struct Tree final
+{
+    const sys::OS os;
+    const sys::Path root{ "file_finder_tree" };
+
+    Tree()
+    {
+        if (os.exists(root))
+        {
+            os.remove(root);
+        }
+        os.makeDirectory(root);
+        for (int ii = 0; ii < 3; ++ii)
+        {
+            const sys::Path d(root, "d" + std::to_string(ii));
+            os.makeDirectory(d);
+            std::ofstream(d.join("top.dat").getPath());
+            for (int jj = 0; jj < 4; ++jj)
+            {
+                const sys::Path dd(d, "d" + std::to_string(jj));
+                os.makeDirectory(dd);
+                for (int kk = 0; kk < 5; ++kk)
+                {
+                    std::ofstream(dd.join("f" + std::to_string(kk) + ".txt").getPath());
+                }
+            }
+        }
+    }
+    ~Tree()
+    {
+        try
+        {
+            os.remove(root);
+        }
+        catch (...)
+        {
+        }
+    }
+};
+
+std::vector<std::string> sorted(std::vector<std::string> v)
+{
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+std::vector<std::string> searchWithCallback(const sys::FilePredicate& filter,
+                                            const std::vector<std::string>& searchPaths,
+                                            bool recursive, size_t numThreads)
+{
+    std::vector<std::string> retval;
+    sys::FileFinder::search(filter, searchPaths, recursive,
+                            [&](const std::string& path) { retval.push_back(path); }, numThreads);
+    return retval;
+}
+}
+
+TEST_CASE(testFileFinderSearch)
+{
+    const Tree tree;
+    const std::vector<std::string> searchPaths{ tree.root.getPath() };
+
+    const sys::ExtensionPredicate txt(".txt");
+    const auto files = sys::FileFinder::search(txt, searchPaths, true);
+    TEST_ASSERT_EQ(files.size(), static_cast<size_t>(3 * 4 * 5));
+    TEST_ASSERT(searchWithCallback(txt, searchPaths, true, 1) == files);
+    TEST_ASSERT(sorted(searchWithCallback(txt, searchPaths, true, 4)) == sorted(files));
+
+    // breadth-first
+    const sys::ExistsPredicate all;
+    const auto everything = sys::FileFinder::search(all, searchPaths, true);
+    TEST_ASSERT_EQ(everything.size(), static_cast<size_t>(1 + 3 + 3 + 3 * 4 + 3 * 4 * 5));
+    TEST_ASSERT_EQ(everything[0], tree.root.getPath());
+    TEST_ASSERT_EQ(sys::Path::splitPath(everything[1]).first, tree.root.getPath());
+    TEST_ASSERT(sorted(searchWithCallback(all, searchPaths, true, 0)) == sorted(everything));
+
+    // not recursive: the search path and what's in it
+    const sys::DirectoryOnlyPredicate dirs;
+    const auto topLevel = sys::FileFinder::search(dirs, searchPaths, false);
+    TEST_ASSERT_EQ(topLevel.size(), static_cast<size_t>(1 + 3));
+    TEST_ASSERT(sorted(searchWithCallback(dirs, searchPaths, false, 3)) == sorted(topLevel));
+
+    // files as search paths, and ones that don't exist
+    const std::vector<std::string> mixed{ sys::Path(tree.root, "d1").join("top.dat").getPath(), "no_such_path" };
+    TEST_ASSERT_EQ(searchWithCallback(all, mixed, true, 2).size(), static_cast<size_t>(1));
+}
+
+TEST_CASE(testFileFinderLinks)
+{
+#ifndef _WIN32
+    const Tree tree;
+    const std::vector<std::string> searchPaths{ tree.root.getPath() };
+    const sys::ExtensionPredicate txt(".txt");
+
+    // Links are followed; broken ones are skipped.
+    const auto linked = ::symlink("d0/d0", sys::Path(tree.root, "link").getPath().c_str());
+    TEST_ASSERT_EQ(linked, 0);
+    const auto broken = ::symlink("nowhere", sys::Path(tree.root, "broken").getPath().c_str());
+    TEST_ASSERT_EQ(broken, 0);
+
+    const auto files = sys::FileFinder::search(txt, searchPaths, true);
+    TEST_ASSERT_EQ(files.size(), static_cast<size_t>(3 * 4 * 5 + 5));
+    TEST_ASSERT(sorted(searchWithCallback(txt, searchPaths, true, 4)) == sorted(files));
+
+    const sys::ExistsPredicate all;
+    const auto everything = searchWithCallback(all, searchPaths, false, 1);
+    TEST_ASSERT(std::find(everything.begin(), everything.end(), sys::Path(tree.root, "broken").getPath()) == everything.end());
+    TEST_ASSERT(std::find(everything.begin(), everything.end(), sys::Path(tree.root, "link").getPath()) != everything.end());
+
+    // Don't let removing the tree follow the link
+    ::unlink(sys::Path(tree.root, "link").getPath().c_str());
+    ::unlink(sys::Path(tree.root, "broken").getPath().c_str());
+#endif
+}
+
+TEST_CASE(testFileFinderThrows)
+{
+    const Tree tree;
+    const std::vector<std::string> searchPaths{ tree.root.getPath() };
+    const sys::FileOnlyPredicate files;
+    size_t count = 0;
+    const auto onMatch = [&](const std::string&) {
+        if (++count == 10)
+        {
+            throw std::runtime_error("enough");
+        }
+    };
+    TEST_THROWS(sys::FileFinder::search(files, searchPaths, true, onMatch, 4));
+    TEST_ASSERT_EQ(count, static_cast<size_t>(10));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testFileFinderSearch);
+    TEST_CHECK(testFileFinderLinks);
+    TEST_CHECK(testFileFinderThrows);
+    )
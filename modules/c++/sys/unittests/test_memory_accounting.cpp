@@ -0,0 +1,194 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <stdint.h>
+
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/MemoryAccounting.h>
+#include "TestCase.h"
+
+static sys::MemoryUsage find(const std::string& name)
+{
+    for (const auto& usage : sys::getMemoryUsage())
+    {
+        if (usage.name == name)
+        {
+            return usage;
+        }
+    }
+    return sys::MemoryUsage();
+}
+
+TEST_CASE(testDisabled)
+{
+    sys::enableMemoryAccounting(false);
+    auto& category = sys::getMemoryCategory("test::disabled");
+    TEST_ASSERT_EQ(&category, &sys::getMemoryCategory("test::disabled"));
+    {
+        sys::AccountedBytes bytes(category);
+        bytes.set(1000);
+        TEST_ASSERT_EQ(bytes.get(), static_cast<uint64_t>(0));
+    }
+    const auto usage = find("test::disabled");
+    TEST_ASSERT_EQ(usage.name, "test::disabled");
+    TEST_ASSERT_EQ(usage.peakBytes, static_cast<uint64_t>(0));
+    TEST_ASSERT_EQ(usage.allocations, static_cast<uint64_t>(0));
+}
+
+TEST_CASE(testCurrentAndPeak)
+{
+    sys::enableMemoryAccounting();
+    auto& category = sys::getMemoryCategory("test::peak");
+    const auto totalBefore = sys::getTotalMemoryUsage().currentBytes;
+    {
+        sys::AccountedBytes a(category);
+        a.set(1000);
+        sys::AccountedBytes b(category);
+        b.set(3000);
+        a.set(500);
+        TEST_ASSERT_EQ(sys::getTotalMemoryUsage().currentBytes, totalBefore + 3500);
+
+        const auto copy(b);
+        auto usage = category.getUsage();
+        TEST_ASSERT_EQ(usage.currentBytes, static_cast<uint64_t>(6500));
+        TEST_ASSERT_EQ(usage.peakBytes, static_cast<uint64_t>(6500));
+        TEST_ASSERT_EQ(usage.allocations, static_cast<uint64_t>(4));
+    }
+    auto usage = category.getUsage();
+    TEST_ASSERT_EQ(usage.currentBytes, static_cast<uint64_t>(0));
+    TEST_ASSERT_EQ(usage.peakBytes, static_cast<uint64_t>(6500));
+    TEST_ASSERT_EQ(sys::getTotalMemoryUsage().currentBytes, totalBefore);
+    TEST_ASSERT(sys::getTotalMemoryUsage().peakBytes >= 6500);
+
+    sys::resetPeakMemoryUsage();
+    TEST_ASSERT_EQ(category.getUsage().peakBytes, static_cast<uint64_t>(0));
+
+    // Moving to another category takes the bytes along
+    auto& other = sys::getMemoryCategory("test::other");
+    sys::AccountedBytes c(category);
+    c.set(10);
+    c.setCategory(other);
+    TEST_ASSERT_EQ(category.getUsage().currentBytes, static_cast<uint64_t>(0));
+    TEST_ASSERT_EQ(other.getUsage().currentBytes, static_cast<uint64_t>(10));
+}
+
+TEST_CASE(testToggle)
+{
+    // Bytes counted while enabled are always given back.
+    auto& category = sys::getMemoryCategory("test::toggle");
+    sys::enableMemoryAccounting(false);
+    {
+        sys::AccountedBytes bytes(category);
+        bytes.set(100);
+        sys::enableMemoryAccounting();
+        bytes.set(200);
+        TEST_ASSERT_EQ(category.getUsage().currentBytes, static_cast<uint64_t>(200));
+        sys::enableMemoryAccounting(false);
+        TEST_ASSERT_EQ(category.getUsage().currentBytes, static_cast<uint64_t>(200));
+        bytes.set(300);
+        TEST_ASSERT_EQ(category.getUsage().currentBytes, static_cast<uint64_t>(0));
+        sys::enableMemoryAccounting();
+    }
+    TEST_ASSERT_EQ(category.getUsage().currentBytes, static_cast<uint64_t>(0));
+}
+
+TEST_CASE(testThreads)
+{
+    sys::enableMemoryAccounting();
+    auto& category = sys::getMemoryCategory("test::threads");
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&category]()
+        {
+            for (uint64_t i = 1; i <= 1000; i++)
+            {
+                sys::AccountedBytes bytes(category);
+                bytes.set(i);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    const auto usage = category.getUsage();
+    TEST_ASSERT_EQ(usage.currentBytes, static_cast<uint64_t>(0));
+    TEST_ASSERT_EQ(usage.allocations, static_cast<uint64_t>(4000));
+    TEST_ASSERT(usage.peakBytes >= 1000);
+    TEST_ASSERT(usage.peakBytes <= 4000);
+}
+
+TEST_CASE(testReporter)
+{
+    sys::enableMemoryAccounting();
+    sys::AccountedBytes bytes(sys::getMemoryCategory("test::reporter"));
+    bytes.set(2 * 1024 * 1024);
+
+    std::mutex mutex;
+    size_t numReports = 0;
+    std::string last;
+    {
+        sys::MemoryUsageReporter reporter(std::chrono::milliseconds(1),
+            [&](const std::vector<sys::MemoryUsage>& usage)
+            {
+                std::ostringstream os;
+                sys::writeMemoryUsage(os, usage);
+                std::lock_guard<std::mutex> lock(mutex);
+                ++numReports;
+                last = os.str();
+            });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    TEST_ASSERT(numReports >= 1); // at least the one on destruction
+    TEST_ASSERT(last.find("test::reporter: 2.0 MiB (peak 2.0 MiB, 1 allocation)\n") != std::string::npos);
+    TEST_ASSERT(last.find("\ntotal: ") != std::string::npos);
+
+    // The callback throwing doesn't stop the reporter
+    size_t numCalls = 0;
+    {
+        sys::MemoryUsageReporter reporter(std::chrono::hours(1),
+            [&](const std::vector<sys::MemoryUsage>&)
+            {
+                ++numCalls;
+                throw std::runtime_error("oops");
+            });
+        reporter.report();
+    }
+    TEST_ASSERT_EQ(numCalls, static_cast<size_t>(2));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testDisabled);
+    TEST_CHECK(testCurrentAndPeak);
+    TEST_CHECK(testToggle);
+    TEST_CHECK(testThreads);
+    TEST_CHECK(testReporter);
+    )
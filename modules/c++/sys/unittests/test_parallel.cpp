@@ -0,0 +1,124 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <sys/Parallel.h>
+#include "TestCase.h"
+
+TEST_CASE(testSplitForThreads)
+{
+    using Pieces = std::vector<sys::ParallelPiece>;
+
+    // pieces of about the same size that cover everything, in order
+    TEST_ASSERT(sys::splitForThreads(10, 3, 1) == Pieces({ { 0, 4 }, { 4, 8 }, { 8, 10 } }));
+    TEST_ASSERT(sys::splitForThreads(10, 4, 1) == Pieces({ { 0, 3 }, { 3, 6 }, { 6, 9 }, { 9, 10 } }));
+
+    // not worth a thread for less than the minimum
+    TEST_ASSERT(sys::splitForThreads(10, 4, 5) == Pieces({ { 0, 5 }, { 5, 10 } }));
+    TEST_ASSERT(sys::splitForThreads(10, 4, 100) == Pieces({ { 0, 10 } }));
+    TEST_ASSERT(sys::splitForThreads(10, 1, 1) == Pieces({ { 0, 10 } }));
+
+    // always at least one piece
+    TEST_ASSERT(sys::splitForThreads(0, 4, 1) == Pieces({ { 0, 0 } }));
+    TEST_ASSERT(sys::splitForThreads(0, 4, 0) == Pieces({ { 0, 0 } }));
+
+    // 0 threads is the number of CPUs
+    const auto pieces = sys::splitForThreads(1000000, 0, 1);
+    TEST_ASSERT_EQ(pieces.size(), sys::OS().getNumCPUs());
+    TEST_ASSERT_EQ(pieces.back().second, static_cast<size_t>(1000000));
+}
+
+TEST_CASE(testParallel)
+{
+    std::mutex mutex;
+    std::set<size_t> indices;
+    std::set<std::thread::id> threads;
+    sys::parallel(4, [&](size_t ii) {
+        std::lock_guard<std::mutex> lock(mutex);
+        indices.insert(ii);
+        threads.insert(std::this_thread::get_id());
+    });
+    TEST_ASSERT(indices == std::set<size_t>({ 0, 1, 2, 3 }));
+    TEST_ASSERT(threads.count(std::this_thread::get_id()) == 1); // f(0) runs here
+
+    size_t calls = 0;
+    sys::parallel(0, [&](size_t) { ++calls; });
+    TEST_ASSERT_EQ(calls, static_cast<size_t>(0));
+}
+
+TEST_CASE(testParallelExceptions)
+{
+    // every call finishes, and the exception from the lowest index wins
+    std::atomic<size_t> finished{ 0 };
+    try
+    {
+        sys::parallel(4, [&](size_t ii) {
+            ++finished;
+            if (ii >= 2)
+            {
+                throw std::runtime_error(std::to_string(ii));
+            }
+        });
+        TEST_FAIL_MSG("Expected an exception");
+    }
+    catch (const std::runtime_error& ex)
+    {
+        TEST_ASSERT_EQ(std::string(ex.what()), "2");
+    }
+    TEST_ASSERT_EQ(finished.load(), static_cast<size_t>(4));
+
+    TEST_THROWS(sys::parallel(2, [](size_t ii) {
+        if (ii == 0)
+        {
+            throw std::runtime_error("this thread");
+        }
+    }));
+}
+
+TEST_CASE(testParallelFor)
+{
+    std::vector<int> values(100000, 0);
+    sys::parallelFor(values.size(), 4, 1000, [&](size_t begin, size_t end) {
+        for (size_t ii = begin; ii < end; ++ii)
+        {
+            values[ii] += static_cast<int>(ii % 7);
+        }
+    });
+    for (size_t ii = 0; ii < values.size(); ++ii)
+    {
+        TEST_ASSERT_EQ(values[ii], static_cast<int>(ii % 7));
+    }
+}
+
+TEST_MAIN(
+    TEST_CHECK(testSplitForThreads);
+    TEST_CHECK(testParallel);
+    TEST_CHECK(testParallelExceptions);
+    TEST_CHECK(testParallelFor);
+)
@@ -83,6 +83,58 @@ TEST_CASE(testPathMerge)
     TEST_ASSERT_EQ(result, path);
 }
 
+static std::string toString(coda_oss::string_view view)
+{
+    return std::string(view.data(), view.size());
+}
+TEST_CASE(testPathViews)
+{
+    // The string_view routines should give the same results as the std::string ones
+    const char* paths[] = { "", "/", "//", ".", "..", "a", "a/", "/a", "a//b", "a/./b", "a/../b", "a/b/../..",
+                            "../../a", "/../a", "/a/../..", "./a/./b/.", "a.b/c", "dir/.hidden",
+                            "/data/nitf///data/../vendor1.ntf", "c:/data/nitf/data/vendor1.ntf", "C:a/../..", "x//y//" };
+    char buffer[64];
+    for (const std::string path : paths)
+    {
+        TEST_ASSERT_EQ(toString(sys::Path::normalizePath(path, buffer)), sys::Path::normalizePath(path));
+        for (const std::string other : { "", "x", "/x", "x/", "C:x" })
+        {
+            TEST_ASSERT_EQ(toString(sys::Path::joinPaths(path, other, buffer)), sys::Path::joinPaths(path, other));
+            TEST_ASSERT_EQ(toString(sys::Path::joinPaths(other, path, buffer)), sys::Path::joinPaths(other, path));
+        }
+
+        const auto splitPath = sys::Path::splitPathView(path);
+        TEST_ASSERT_EQ(toString(splitPath.first), sys::Path::splitPath(path).first);
+        TEST_ASSERT_EQ(toString(splitPath.second), sys::Path::splitPath(path).second);
+        const auto splitExt = sys::Path::splitExtView(path);
+        TEST_ASSERT_EQ(toString(splitExt.first), sys::Path::splitExt(path).first);
+        TEST_ASSERT_EQ(toString(splitExt.second), sys::Path::splitExt(path).second);
+        TEST_ASSERT_EQ(toString(sys::Path::basenameView(path, true)), sys::Path::basename(path, true));
+
+        std::vector<std::string> components;
+        for (const auto component : sys::Path::components(path))
+        {
+            components.push_back(toString(component));
+        }
+        TEST_ASSERT(components == sys::Path::separate(path));
+    }
+
+    // views are into the original path
+    const std::string path = "/data/nitf///data/../vendor1.ntf";
+    const auto basename = sys::Path::basenameView(path);
+    TEST_ASSERT_EQ(basename.data(), path.data() + path.find("vendor1"));
+    auto it = sys::Path::components(path).begin();
+    const auto first = *it++;
+    TEST_ASSERT_EQ(toString(first), "data");
+    const auto second = *it++;
+    TEST_ASSERT_EQ(toString(second), "nitf");
+    TEST_ASSERT_EQ((*it).data(), path.data() + 13);
+
+    // the result can be one character longer, e.g., "a" => "/a"
+    TEST_THROWS(sys::Path::normalizePath(path, coda_oss::span<char>(buffer, path.size())));
+    TEST_THROWS(sys::Path::joinPaths(path, path, coda_oss::span<char>(buffer, sizeof(buffer))));
+}
+
 TEST_CASE(test_std_filesystem_is_absolute)
 {
     std::filesystem::path path
@@ -380,6 +432,7 @@ TEST_CASE(testModifyVar2)
 
 TEST_MAIN(
     TEST_CHECK(testPathMerge);
+    TEST_CHECK(testPathViews);
     TEST_CHECK(test_std_filesystem_is_absolute);
     TEST_CHECK(testExpandEnvTilde);
     TEST_CHECK(testExpandEnv);
@@ -0,0 +1,110 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include <sys/StripedReadWriteMutex.h>
+#include "TestCase.h"
+
+TEST_CASE(testStripes)
+{
+    TEST_ASSERT_EQ(sys::StripedReadWriteMutex(1).getNumStripes(), static_cast<size_t>(1));
+    TEST_ASSERT_EQ(sys::StripedReadWriteMutex(5).getNumStripes(), static_cast<size_t>(8));
+    TEST_ASSERT(sys::StripedReadWriteMutex().getNumStripes() >= 1);
+}
+
+TEST_CASE(testReadersAndWriters)
+{
+    sys::StripedReadWriteMutex mutex(4);
+    long first = 0, second = 0; // always equal, except while writing
+    std::atomic<bool> mismatch{ false };
+    std::atomic<long> reads{ 0 };
+
+    std::vector<std::thread> threads;
+    for (int ii = 0; ii < 6; ++ii)
+    {
+        threads.emplace_back([&]() {
+            for (int jj = 0; jj < 2000; ++jj)
+            {
+                std::shared_lock<sys::StripedReadWriteMutex> lock(mutex);
+                if (first != second)
+                {
+                    mismatch = true;
+                }
+                ++reads;
+            }
+        });
+    }
+    for (int ii = 0; ii < 2; ++ii)
+    {
+        threads.emplace_back([&]() {
+            for (int jj = 0; jj < 500; ++jj)
+            {
+                std::unique_lock<sys::StripedReadWriteMutex> lock(mutex);
+                ++first;
+                std::this_thread::yield();
+                ++second;
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    TEST_ASSERT_FALSE(mismatch.load());
+    TEST_ASSERT_EQ(reads.load(), 6L * 2000);
+    TEST_ASSERT_EQ(first, 1000L);
+    TEST_ASSERT_EQ(second, 1000L);
+}
+
+TEST_CASE(testReadersShare)
+{
+    // Both readers have to be in at once for either to finish.
+    sys::StripedReadWriteMutex mutex;
+    std::atomic<int> inside{ 0 };
+    const auto reader = [&]() {
+        mutex.lockRead();
+        ++inside;
+        while (inside.load() < 2)
+        {
+            std::this_thread::yield();
+        }
+        mutex.unlockRead();
+    };
+    std::thread other(reader);
+    reader();
+    other.join();
+
+    mutex.lockWrite(); // no readers left
+    mutex.unlockWrite();
+    TEST_ASSERT_EQ(inside.load(), 2);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testStripes);
+    TEST_CHECK(testReadersAndWriters);
+    TEST_CHECK(testReadersShare);
+    )
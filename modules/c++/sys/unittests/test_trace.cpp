@@ -0,0 +1,230 @@
+/* =========================================================================
+ * This file is part of sys-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * sys-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string.h>
+
+#include <atomic>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/Conf.h>
+#include <sys/Trace.h>
+#include "TestCase.h"
+
+static size_t count(const std::vector<sys::TraceEvent>& events, const char* name)
+{
+    size_t retval = 0;
+    for (const auto& event : events)
+    {
+        retval += (strcmp(event.name, name) == 0) ? 1 : 0;
+    }
+    return retval;
+}
+
+TEST_CASE(testZones)
+{
+    sys::clearTraceEvents();
+    {
+        CODA_OSS_TRACE_ZONE("disabled");
+    }
+
+    sys::enableTracing();
+    {
+        CODA_OSS_TRACE_ZONE("outer");
+        {
+            CODA_OSS_TRACE_ZONE("inner");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    uint16_t values[] = { 0x0102, 0x0304 };
+    sys::byteSwap(values, sizeof(values[0]), 2);
+    sys::enableTracing(false);
+
+    const auto events = sys::getTraceEvents();
+    TEST_ASSERT_EQ(count(events, "disabled"), static_cast<size_t>(0));
+    TEST_ASSERT_EQ(count(events, "sys::byteSwap"), static_cast<size_t>(1));
+    TEST_ASSERT_EQ(events.size(), static_cast<size_t>(3));
+
+    // ordered by start, so the outer zone is first
+    TEST_ASSERT_EQ(std::string(events[0].name), "outer");
+    TEST_ASSERT_EQ(std::string(events[1].name), "inner");
+    TEST_ASSERT(events[1].duration >= 2000000);
+    TEST_ASSERT(events[0].start <= events[1].start);
+    TEST_ASSERT(events[0].duration >= events[1].duration);
+    TEST_ASSERT_EQ(events[0].threadIndex, events[1].threadIndex);
+
+    sys::clearTraceEvents();
+    TEST_ASSERT(sys::getTraceEvents().empty());
+}
+
+TEST_CASE(testThreads)
+{
+    sys::clearTraceEvents();
+    sys::setTraceBufferCapacity(100); // rounded up to 128
+    sys::enableTracing();
+
+    // the buffers outlive the threads, and only keep the latest events
+    std::vector<std::thread> threads;
+    for (int ii = 0; ii < 4; ++ii)
+    {
+        threads.emplace_back([]() {
+            for (int jj = 0; jj < 1000; ++jj)
+            {
+                CODA_OSS_TRACE_ZONE("work");
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    sys::enableTracing(false);
+    sys::setTraceBufferCapacity(32768);
+
+    const auto events = sys::getTraceEvents();
+    TEST_ASSERT_EQ(count(events, "work"), static_cast<size_t>(4 * 128));
+    std::set<size_t> threadIndices;
+    for (const auto& event : events)
+    {
+        threadIndices.insert(event.threadIndex);
+    }
+    TEST_ASSERT_EQ(threadIndices.size(), static_cast<size_t>(4));
+
+    sys::clearTraceEvents();
+    TEST_ASSERT(sys::getTraceEvents().empty());
+}
+
+TEST_CASE(testRetiredThreadLimit)
+{
+    sys::clearTraceEvents();
+    sys::setTraceRetiredThreadLimit(2);
+    sys::enableTracing();
+
+    // the buffers of exited threads beyond the limit are freed, oldest first
+    for (int ii = 0; ii < 5; ++ii)
+    {
+        std::thread([]() { CODA_OSS_TRACE_ZONE("work"); }).join();
+    }
+    std::thread([]() {}).join(); // never records, so keeps no buffer
+    std::thread([]() { CODA_OSS_TRACE_ZONE("last"); }).join();
+    sys::enableTracing(false);
+
+    const auto events = sys::getTraceEvents();
+    TEST_ASSERT_EQ(events.size(), static_cast<size_t>(3));
+    TEST_ASSERT_EQ(count(events, "work"), static_cast<size_t>(2));
+    TEST_ASSERT_EQ(count(events, "last"), static_cast<size_t>(1));
+
+    sys::setTraceRetiredThreadLimit(1);
+    TEST_ASSERT_EQ(sys::getTraceEvents().size(), static_cast<size_t>(1));
+    sys::setTraceRetiredThreadLimit(64);
+    sys::clearTraceEvents();
+}
+
+// Destroyed after the thread's trace buffer has been retired.
+struct LateZone final
+{
+    ~LateZone()
+    {
+        CODA_OSS_TRACE_ZONE("late");
+    }
+};
+
+TEST_CASE(testZoneAfterThreadExit)
+{
+    sys::clearTraceEvents();
+    sys::enableTracing();
+    std::thread([]() {
+        static thread_local LateZone lateZone;
+        (void)&lateZone; // constructed before the buffer, so destroyed after
+        CODA_OSS_TRACE_ZONE("early");
+    }).join();
+    sys::enableTracing(false);
+
+    const auto events = sys::getTraceEvents();
+    TEST_ASSERT_EQ(count(events, "early"), static_cast<size_t>(1));
+    TEST_ASSERT_EQ(count(events, "late"), static_cast<size_t>(0));
+    sys::clearTraceEvents();
+}
+
+TEST_CASE(testConcurrentRead)
+{
+    sys::clearTraceEvents();
+    sys::setTraceBufferCapacity(64);
+    sys::enableTracing();
+
+    // read while another thread wraps its buffer around many times
+    std::atomic<bool> done{ false };
+    std::thread writer([&]() {
+        while (!done)
+        {
+            CODA_OSS_TRACE_ZONE("writer");
+        }
+    });
+    for (int ii = 0; ii < 200; ++ii)
+    {
+        for (const auto& event : sys::getTraceEvents())
+        {
+            TEST_ASSERT_EQ(std::string(event.name), "writer");
+            TEST_ASSERT(event.duration >= 0);
+        }
+    }
+    done = true;
+    writer.join();
+    sys::enableTracing(false);
+    sys::setTraceBufferCapacity(32768);
+    sys::clearTraceEvents();
+}
+
+TEST_CASE(testChromeTrace)
+{
+    sys::clearTraceEvents();
+    sys::enableTracing();
+    {
+        CODA_OSS_TRACE_ZONE("quote\"d");
+    }
+    sys::enableTracing(false);
+
+    std::ostringstream os;
+    sys::writeChromeTrace(os);
+    const auto json = os.str();
+    TEST_ASSERT_EQ(json.find("{\"traceEvents\":[\n{\"name\":\"quote\\\"d\",\"cat\":\"coda-oss\",\"ph\":\"X\",\"ts\":0.000,\"dur\":"),
+                   static_cast<size_t>(0));
+    TEST_ASSERT(json.find("\"tid\":") != std::string::npos);
+    TEST_ASSERT(json.find("\n],\"displayTimeUnit\":\"ms\"}\n") != std::string::npos);
+    sys::clearTraceEvents();
+
+    std::ostringstream empty;
+    sys::writeChromeTrace(empty);
+    TEST_ASSERT_EQ(empty.str(), "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+TEST_MAIN(
+    TEST_CHECK(testZones);
+    TEST_CHECK(testThreads);
+    TEST_CHECK(testRetiredThreadLimit);
+    TEST_CHECK(testZoneAfterThreadExit);
+    TEST_CHECK(testConcurrentRead);
+    TEST_CHECK(testChromeTrace);
+    )
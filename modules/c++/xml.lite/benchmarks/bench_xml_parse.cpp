@@ -0,0 +1,108 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Users guide
+
+    Times parsing a generated document of 1000 small elements (about 60 KiB)
+    from memory with xml::lite::MinidomParser, finding elements by tag name,
+    and printing the document back out.
+
+    ./bench_xml_parse [--filter=<name>] [--json=<file>] [--quick] ...
+
+*/
+
+/*  Results: not yet measured; xml.lite needs Xerces, which the machine
+    these benchmarks were written on didn't have.
+*/
+
+#include <string>
+
+#include <io/StringStream.h>
+#include <str/Convert.h>
+#include <xml/lite/MinidomParser.h>
+
+#include "Benchmark.h"
+
+static constexpr size_t numElements = 1000;
+
+static std::string makeXml()
+{
+    std::string retval = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<root>\n";
+    for (size_t i = 0; i < numElements; i++)
+    {
+        const auto index = str::toString(i);
+        retval += "  <item index=\"" + index + "\" type=\"value\">";
+        retval += "<name>item" + index + "</name><value>" + str::toString(i * 0.5) + "</value>";
+        retval += "</item>\n";
+    }
+    retval += "</root>\n";
+    return retval;
+}
+
+BENCHMARK_CASE(parse)
+{
+    const auto xml = makeXml();
+    state.setBytesPerIteration(static_cast<double>(xml.size()));
+    state.run([&]() {
+        io::StringStream input;
+        input.stream() << xml;
+        xml::lite::MinidomParser parser;
+        parser.parse(input);
+        benchmark::doNotOptimize(parser.getDocument());
+    });
+}
+
+BENCHMARK_CASE(getElementsByTagName)
+{
+    io::StringStream input;
+    input.stream() << makeXml();
+    xml::lite::MinidomParser parser;
+    parser.parse(input);
+    const auto& root = *(parser.getDocument()->getRootElement());
+
+    state.run([&]() {
+        benchmark::doNotOptimize(root.getElementsByTagName("value", true /*recurse*/));
+    });
+}
+
+BENCHMARK_CASE(print)
+{
+    const auto xml = makeXml();
+    io::StringStream input;
+    input.stream() << xml;
+    xml::lite::MinidomParser parser;
+    parser.parse(input);
+    const auto& root = *(parser.getDocument()->getRootElement());
+
+    state.setBytesPerIteration(static_cast<double>(xml.size()));
+    state.run([&]() {
+        io::StringStream output;
+        root.print(output);
+        benchmark::doNotOptimize(output);
+    });
+}
+
+BENCHMARK_MAIN(
+    BENCHMARK_CHECK(parse);
+    BENCHMARK_CHECK(getElementsByTagName);
+    BENCHMARK_CHECK(print);
+    )
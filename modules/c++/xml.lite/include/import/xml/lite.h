@@ -34,6 +34,8 @@
 #include "xml/lite/XMLReader.h"
 #include "xml/lite/MinidomHandler.h"
 #include "xml/lite/MinidomParser.h"
+#include "xml/lite/PathFilterHandler.h"
+#include "xml/lite/PathFilterParser.h"
 #include "xml/lite/Serializable.h"
 #include "xml/lite/Validator.h"
 
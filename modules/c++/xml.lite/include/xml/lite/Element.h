@@ -28,7 +28,10 @@
 #include <string>
 #include <new> // std::nothrow_t
 #include <coda_oss/string.h>
+#include <atomic>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include <config/Exports.h>
 #include <io/InputStream.h>
@@ -63,6 +66,11 @@ struct AttributeNode;
  *
  * This class stores all of the element information about an XML
  * document.
+ *
+ * The getElement[s]ByTagName() lookups build an index of the children
+ * by local name on first use.  Concurrent const lookups on an unmodified
+ * element are safe: if two threads both build the index, one is kept.
+ * As usual, modifying an element concurrently with anything else isn't.
  */
 struct CODA_OSS_API Element  // SOAPElement derives :-(
 {
@@ -109,8 +117,8 @@ struct CODA_OSS_API Element  // SOAPElement derives :-(
     public:
     #endif
 
-    Element(Element&&) = default;
-    Element& operator=(Element&&) = default;
+    Element(Element&&);
+    Element& operator=(Element&&);
 
     Element& operator=(std::unique_ptr<Element>&&);  // setChild()
 
@@ -349,6 +357,7 @@ struct CODA_OSS_API Element  // SOAPElement derives :-(
     void setLocalName(const std::string& localName)
     {
         mName.setName(localName);
+        invalidateParentChildIndex();
     }
 
     /*!
@@ -367,10 +376,12 @@ struct CODA_OSS_API Element  // SOAPElement derives :-(
     void setQName(const std::string& qname)
     {
         mName.setQName(qname);
+        invalidateParentChildIndex();
     }
     void setQName(const xml::lite::QName& qname)
     {
         mName = qname;
+        invalidateParentChildIndex();
     }
     Element& operator=(const QName& qname)
     {
@@ -439,6 +450,14 @@ struct CODA_OSS_API Element  // SOAPElement derives :-(
      */
     #ifndef SWIG // SWIG doesn't like std::unique_ptr
     virtual Element& addChild(std::unique_ptr<Element>&& node);
+
+    /*!
+     *  Removes a child element WITHOUT destroying it; ownership
+     *  is transferred to the caller.
+     *  \param node the child element to remove
+     *  \return the removed child, NULL if it isn't a child of this element
+     */
+    std::unique_ptr<Element> removeChild(const Element& node);
     #endif // SWIG
 
     /*!
@@ -447,6 +466,7 @@ struct CODA_OSS_API Element  // SOAPElement derives :-(
      */
     std::vector<Element*>& getChildren()
     {
+        invalidateChildIndex(); // caller might modify mChildren
         return mChildren;
     }
 
@@ -465,6 +485,7 @@ struct CODA_OSS_API Element  // SOAPElement derives :-(
     void clearChildren()
     {
         mChildren.clear();
+        invalidateChildIndex();
     }
 
     Element* getParent() const
@@ -493,10 +514,32 @@ private:
 
     void depthPrint(io::OutputStream& stream, int depth, const std::string& formatter, bool isConsoleOutput = false) const;
 
+    using ChildIndex = std::unordered_map<std::string, std::vector<Element*>>;
+    const ChildIndex& getChildIndex() const;
+    template <typename TFunc>
+    bool forEachChild(const std::string& localName, TFunc f) const;
+    template <typename TFunc>
+    bool forEachElement(const std::string& localName, bool recurse, TFunc f) const;
+
+    void invalidateChildIndex() noexcept
+    {
+        delete mChildIndex.exchange(nullptr, std::memory_order_acq_rel);
+    }
+    void invalidateParentChildIndex() noexcept
+    {
+        if (mParent != nullptr)
+        {
+            mParent->invalidateChildIndex();
+        }
+    }
+
     Element* mParent = nullptr;
     //! The attributes for this element
     xml::lite::Attributes mAttributes;
     coda_oss::u8string mCharacterData;
+
+    //! mChildren by local name, built on demand by getChildIndex(); owned
+    mutable std::atomic<ChildIndex*> mChildIndex{ nullptr };
 };
 
 CODA_OSS_API Element& add(const xml::lite::QName&, const std::string& value, Element& parent);
@@ -0,0 +1,168 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_xml_lite_PathFilterHandler_h_INCLUDED_
+#define CODA_OSS_xml_lite_PathFilterHandler_h_INCLUDED_
+
+/*!
+ *  \file PathFilterHandler.h
+ *  \brief Build only the parts of a document that are actually needed.
+ *
+ *  MinidomHandler builds the entire Document tree, which is wasteful when
+ *  only a handful of values are needed from a (very) large XML file.  This
+ *  handler is given a set of XPath-like paths; only elements matching those
+ *  paths (along with their children) are materialized.  Everything else is
+ *  discarded as it streams by, so memory use is proportional to the size of
+ *  the matched subtrees rather than that of the document.
+ */
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include "coda_oss/string.h"
+
+#include <config/Exports.h>
+#include "xml/lite/ContentHandler.h"
+#include "xml/lite/Element.h"
+
+namespace xml
+{
+namespace lite
+{
+/*!
+ * \class PathFilterHandler
+ * \brief A ContentHandler that materializes only matching subtrees.
+ *
+ * Paths are a (very) small subset of XPath and are matched against
+ * local names:
+ *  - "/a/b/c" is an absolute path, starting at the root element.
+ *  - "//b/c" (or just "b/c") matches a "c" child of a "b" anywhere.
+ *  - a step of "*" matches any element.
+ *
+ * A matching element is fully built, including all of its children, and
+ * handed off when its end-tag is seen.  Elements nested inside an already
+ * matching element are part of that subtree; they aren't reported again.
+ * When an element matches more than one path, the path registered first
+ * wins: the element goes only to that path's callback.
+ */
+struct CODA_OSS_API PathFilterHandler final : public ContentHandler
+{
+    /*!
+     * Called with each matching element; the callback owns the element,
+     * it is destroyed upon return unless moved elsewhere.
+     */
+    using Callback = std::function<void(std::unique_ptr<Element>&&)>;
+
+    PathFilterHandler() = default;
+    ~PathFilterHandler() = default;
+    PathFilterHandler(const PathFilterHandler&) = delete;
+    PathFilterHandler& operator=(const PathFilterHandler&) = delete;
+    PathFilterHandler(PathFilterHandler&&) = delete;  // addPath() callbacks may refer to "this"
+    PathFilterHandler& operator=(PathFilterHandler&&) = delete;
+
+    /*!
+     * Register a path; matching elements are passed to the callback,
+     * unless a path registered earlier also matches.
+     * \param path  The XPath-like path to match
+     * \param callback  Invoked with each matching element
+     * \throw std::invalid_argument if the path is malformed
+     */
+    void addPath(const std::string& path, Callback callback);
+
+    /*!
+     * Register a path; matching elements are kept, see getElements().
+     * \param path  The XPath-like path to match
+     */
+    void addPath(const std::string& path);
+
+    /*!
+     * Elements matching paths registered without a callback, in document order.
+     */
+    std::vector<std::unique_ptr<Element>>& getElements()
+    {
+        return mElements;
+    }
+    const std::vector<std::unique_ptr<Element>>& getElements() const
+    {
+        return mElements;
+    }
+
+    //! Discards partial state left by a previous parse that threw
+    void startDocument() override;
+
+    void characters(const char* value, int length) override;
+    bool vcharacters(const void /*XMLCh*/*, size_t length) override;
+
+    void startElement(const std::string& uri,
+                      const std::string& localName,
+                      const std::string& qname,
+                      const Attributes& atts) override;
+
+    void endElement(const std::string& uri,
+                    const std::string& localName,
+                    const std::string& qname) override;
+
+    /*!
+     * Discard any elements and partial state from a previous parse;
+     * the registered paths are kept.
+     */
+    void clear();
+
+    /*!
+     * @see MinidomHandler::preserveCharacterData
+     */
+    void preserveCharacterData(bool preserve)
+    {
+        mPreserveCharData = preserve;
+    }
+
+private:
+    struct Path final
+    {
+        bool absolute = false;
+        std::vector<std::string> steps;
+        Callback callback;
+    };
+    bool findMatch(size_t& pathIndex) const;
+    void characters(coda_oss::u8string&&);
+
+    std::vector<Path> mPaths;
+    std::vector<std::unique_ptr<Element>> mElements;
+
+    //! local names of all the currently open elements, "/" to here
+    std::vector<std::string> mLocation;
+
+    //! The matching subtree being built, if any
+    std::unique_ptr<Element> mSubtree;
+    size_t mSubtreePath = 0;
+    //! open elements within mSubtree, along with their character data
+    std::vector<Element*> mNodeStack;
+    std::vector<coda_oss::u8string> mCharacterData;
+
+    bool mPreserveCharData = false;
+};
+}
+}
+
+#endif  // CODA_OSS_xml_lite_PathFilterHandler_h_INCLUDED_
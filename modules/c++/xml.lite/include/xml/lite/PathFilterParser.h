@@ -0,0 +1,129 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_xml_lite_PathFilterParser_h_INCLUDED_
+#define CODA_OSS_xml_lite_PathFilterParser_h_INCLUDED_
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <config/Exports.h>
+
+#include "xml/lite/XMLReader.h"
+#include "xml/lite/Element.h"
+#include "xml/lite/PathFilterHandler.h"
+
+/*!
+ * \file PathFilterParser.h
+ * \brief Pull a few elements out of a (very) large XML document.
+ *
+ * Like MinidomParser, this pairs a content handler with a SAX driver; but
+ * only elements matching registered paths are built and the input is
+ * streamed to the parser rather than first being read into memory.
+ */
+
+namespace xml
+{
+namespace lite
+{
+/*!
+ * \class PathFilterParser
+ * \brief Parse only the matching parts of a document.
+ *
+ * \code
+    xml::lite::PathFilterParser parser;
+    parser.addPath("/SICD/ImageData/NumRows");
+    parser.addPath("//GeoData", [&](std::unique_ptr<xml::lite::Element>&& geoData) { ... });
+    parser.parse(inputStream);
+    auto&& numRows = parser.getElements();
+ * \endcode
+ */
+struct CODA_OSS_API PathFilterParser final
+{
+    PathFilterParser();
+    ~PathFilterParser() = default;
+
+    PathFilterParser(const PathFilterParser&) = delete;
+    PathFilterParser& operator=(const PathFilterParser&) = delete;
+    PathFilterParser(PathFilterParser&&) = delete;
+    PathFilterParser& operator=(PathFilterParser&&) = delete;
+
+    /*!
+     * @see PathFilterHandler::addPath
+     */
+    void addPath(const std::string& path, PathFilterHandler::Callback callback);
+    void addPath(const std::string& path);
+
+    /*!
+     *  Stream the input through the parser, see XMLReaderXerces::parseStream().
+     *  \param is  This is the input stream to feed the parser
+     *  \param pEncoding  The encoding of the stream; NULL to try UTF-8
+     *  (auto-detection), then Windows-1252.
+     */
+    void parse(io::InputStream& is, const void* pEncoding = nullptr);
+
+    /*!
+     * @see PathFilterHandler::getElements
+     */
+    std::vector<std::unique_ptr<Element>>& getElements()
+    {
+        return mHandler.getElements();
+    }
+    const std::vector<std::unique_ptr<Element>>& getElements() const
+    {
+        return mHandler.getElements();
+    }
+
+    /*!
+     * @see PathFilterHandler::clear
+     */
+    void clear();
+
+    /*!
+     * @see MinidomHandler::preserveCharacterData
+     */
+    void preserveCharacterData(bool preserve);
+
+    const XMLReader& getReader() const
+    {
+        return mReader;
+    }
+    XMLReader& getReader()
+    {
+        return mReader;
+    }
+    PathFilterHandler& getHandler()
+    {
+        return mHandler;
+    }
+
+private:
+    PathFilterHandler mHandler;
+    XMLReader mReader;
+};
+
+}
+}
+
+#endif  // CODA_OSS_xml_lite_PathFilterParser_h_INCLUDED_
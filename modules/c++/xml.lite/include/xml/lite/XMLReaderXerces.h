@@ -105,6 +105,24 @@ public:
     void parse(bool storeEncoding, io::InputStream& is, int size = io::InputStream::IS_END);
     void parse(io::InputStream& is, const void*pInitialEncoding, const void* pFallbackEncoding,
         int size = io::InputStream::IS_END);
+
+    /*!
+     *  Parse directly from the stream as Xerces needs more input, rather
+     *  than first reading everything into memory as parse() does.
+     *
+     *  Errors are reported as by parse().  Like parse(), if the input turns
+     *  out not to be in the initial encoding it's parsed again using the
+     *  fallback encoding; only the first bytes read are kept for this, as
+     *  that's where Xerces detects a bad encoding (before any content is
+     *  reported).
+     *  \param is  The stream to parse
+     *  \param pInitialEncoding  The encoding of the stream, e.g.,
+     *  getWindows1252Encoding(); NULL for auto-detection.
+     *  \param pFallbackEncoding  The encoding to try next; NULL for none.
+     */
+    void parseStream(io::InputStream& is, const void* pInitialEncoding, const void* pFallbackEncoding);
+    //! Try UTF-8 (auto-detection) first, then Windows-1252; see parse().
+    void parseStream(io::InputStream& is);
     
     //! Method to create an xml reader
     void create() override;
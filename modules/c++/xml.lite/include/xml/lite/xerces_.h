@@ -65,6 +65,8 @@ CODA_OSS_disable_warning(-Walloc-size-larger-than=)
 #include <xercesc/dom/impl/DOMLSInputImpl.hpp>
 
 #include <xercesc/framework/MemBufInputSource.hpp>
+#include <xercesc/sax/InputSource.hpp>
+#include <xercesc/util/BinInputStream.hpp>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <xercesc/util/XMLString.hpp>
 
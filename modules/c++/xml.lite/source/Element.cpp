@@ -23,6 +23,7 @@
 
 #include <assert.h>
 
+#include <algorithm>
 #include <stdexcept>
 #include <tuple>
 #include <std/string>
@@ -54,11 +55,43 @@ xml::lite::Element& xml::lite::Element::operator=(const xml::lite::Element& node
 {
     if (this != &node)
     {
+        invalidateParentChildIndex();  // our name might change
+
         mName = node.mName;
         mCharacterData = node.mCharacterData;
         mAttributes = node.mAttributes;
         mChildren = node.mChildren;
         mParent = node.mParent;
+        invalidateChildIndex();
+    }
+    return *this;
+}
+
+xml::lite::Element::Element(xml::lite::Element&& node) :
+    mChildren(std::move(node.mChildren)),
+    mName(std::move(node.mName)),
+    mParent(node.mParent),
+    mAttributes(std::move(node.mAttributes)),
+    mCharacterData(std::move(node.mCharacterData))
+{
+    node.invalidateParentChildIndex();  // `node` no longer has its name
+    node.invalidateChildIndex();  // ... or its children
+}
+xml::lite::Element& xml::lite::Element::operator=(xml::lite::Element&& node)
+{
+    if (this != &node)
+    {
+        invalidateParentChildIndex();  // our name might change
+        node.invalidateParentChildIndex();
+
+        mName = std::move(node.mName);
+        mCharacterData = std::move(node.mCharacterData);
+        mAttributes = std::move(node.mAttributes);
+        mChildren = std::move(node.mChildren);
+        node.mChildren.clear();
+        mParent = node.mParent;
+        invalidateChildIndex();
+        node.invalidateChildIndex();
     }
     return *this;
 }
@@ -80,65 +113,116 @@ void xml::lite::Element::clone(const xml::lite::Element& node)
     }
 }
 
-bool xml::lite::Element::hasElement(const QName& qname) const
-{
-    const auto uri = qname.getUri().value;
-    const auto localName = qname.getName();
+// Below this many children, a linear search is cheaper than building (and keeping) an index.
+static constexpr size_t childIndexThreshold = 8;
 
-    for (unsigned int i = 0; i < mChildren.size(); i++)
+const xml::lite::Element::ChildIndex& xml::lite::Element::getChildIndex() const
+{
+    auto index = mChildIndex.load(std::memory_order_acquire);
+    if (index == nullptr)
     {
-        if (mChildren[i]->getUri() == uri&& mChildren[i]->getLocalName()
-                == localName)
-            return true;
+        // Const lookups can race to get here; the first index published wins.
+        auto newIndex = std::make_unique<ChildIndex>();
+        for (auto&& child : mChildren)
+        {
+            (*newIndex)[child->getLocalName()].push_back(child);
+        }
+        if (mChildIndex.compare_exchange_strong(index, newIndex.get(), std::memory_order_acq_rel))
+        {
+            index = newIndex.release();
+        }
     }
-    return false;
+    return *index;
 }
 
-bool xml::lite::Element::hasElement(const std::string& localName) const
+template <typename TFunc>
+bool xml::lite::Element::forEachChild(const std::string& localName, TFunc f) const
 {
+    if (mChildren.size() < childIndexThreshold)
+    {
+        for (auto&& child : mChildren)
+        {
+            if ((child->getLocalName() == localName) && !f(child))
+                return false;
+        }
+        return true;
+    }
 
-    for (unsigned int i = 0; i < mChildren.size(); i++)
+    const auto& index = getChildIndex();
+    const auto it = index.find(localName);
+    if (it != index.end())
     {
-        if (mChildren[i]->getLocalName() == localName)
-            return true;
+        for (auto&& child : it->second)
+        {
+            if (!f(child))
+                return false;
+        }
     }
-    return false;
+    return true;
 }
 
-void xml::lite::Element::getElementsByTagName(const QName& n, std::vector<Element*>& elements, bool recurse) const
+// Call f() on each element (in document order) named `localName`; stop as soon as f() returns false.
+template <typename TFunc>
+bool xml::lite::Element::forEachElement(const std::string& localName, bool recurse, TFunc f) const
 {
-    const auto uri = n.getUri().value;
-    const auto localName = n.getName();
+    if (!recurse)
+    {
+        return forEachChild(localName, f);
+    }
 
-    elements.reserve(mChildren.size());
-    for (unsigned int i = 0; i < mChildren.size(); i++)
+    for (auto&& child : mChildren)
     {
-        if (mChildren[i]->getUri() == uri && mChildren[i]->getLocalName()
-                == localName)
-            elements.push_back(mChildren[i]);
-        if (recurse)
-            mChildren[i]->getElementsByTagName(uri, localName, elements, recurse);
+        if ((child->getLocalName() == localName) && !f(child))
+            return false;
+        if (!child->forEachElement(localName, recurse, f))
+            return false;
     }
+    return true;
+}
+
+bool xml::lite::Element::hasElement(const QName& qname) const
+{
+    const auto& uri = qname.getUri().value;
+    bool found = false;
+    std::ignore = forEachElement(qname.getName(), false /*recurse*/, [&](const Element* e) {
+        found = e->mName.getUri().value == uri;
+        return !found; });
+    return found;
 }
 
-template <typename TGetElements>
-std::tuple<xml::lite::Element*, std::string> getElement(TGetElements getElements)
+bool xml::lite::Element::hasElement(const std::string& localName) const
 {
-    auto elements = getElements();
-    if (elements.size() == 1)
-    {
-        return std::make_tuple(elements[0], "");
-    }
-    return std::make_tuple(nullptr, std::to_string(elements.size()));
+    // any match will do, so stop at the first one
+    return !forEachElement(localName, false /*recurse*/, [](const Element*) { return false; });
+}
+
+void xml::lite::Element::getElementsByTagName(const QName& n, std::vector<Element*>& elements, bool recurse) const
+{
+    const auto& uri = n.getUri().value;
+    std::ignore = forEachElement(n.getName(), recurse, [&](Element* e) {
+        if (e->mName.getUri().value == uri)
+            elements.push_back(e);
+        return true; });
+}
+
+// Find exactly one element, without building a std::vector<> of all the matches.
+template <typename TForEachElement>
+static xml::lite::Element* getElement(TForEachElement forEachElement)
+{
+    xml::lite::Element* retval = nullptr;
+    size_t count = 0;
+    std::ignore = forEachElement([&](xml::lite::Element* e) {
+        retval = e;
+        return ++count < 2; });  // no need to keep looking once there's a duplicate
+    return count == 1 ? retval : nullptr;
 }
 template <typename TGetElements, typename TMakeContext>
-xml::lite::Element& getElement(TGetElements getElements, TMakeContext makeContext)
+static xml::lite::Element& getElement(xml::lite::Element* pElement, TGetElements getElements, TMakeContext makeContext)
 {
-    auto result = getElement(getElements);
-    auto pElement = std::get<0>(result);
-    if (pElement  == nullptr)
+    if (pElement == nullptr)
     {
-        const auto ctxt = makeContext(std::get<1>(result));
+        // Only now that we're going to throw, get all the matches for the error message.
+        const auto ctxt = makeContext(std::to_string(getElements().size()));
         throw xml::lite::XMLException(ctxt);
     }
     return *pElement;
@@ -146,8 +230,10 @@ xml::lite::Element& getElement(TGetElements getElements, TMakeContext makeContex
 
 xml::lite::Element* xml::lite::Element::getElementByTagName(std::nothrow_t, const QName& n, bool recurse) const
 {
-    auto getElements = [&]() { return getElementsByTagName(n, recurse); };
-    return std::get<0>(getElement(getElements));
+    const auto& uri = n.getUri().value;
+    return getElement([&](auto f) {
+        return forEachElement(n.getName(), recurse, [&](Element* e) {
+            return (e->mName.getUri().value == uri) ? f(e) : true; }); });
 }
 xml::lite::Element& xml::lite::Element::getElementByTagName(const QName& n, bool recurse) const
 {
@@ -156,28 +242,22 @@ xml::lite::Element& xml::lite::Element::getElementByTagName(const QName& n, bool
         const auto uri = n.getUri().value;
         const auto localName = n.getName();
        return Ctxt("Expected exactly one '" + localName + "' (uri=" + uri + "); but got " + sz); };
-    return getElement(getElements, makeContext);
+    return getElement(getElementByTagName(std::nothrow, n, recurse), getElements, makeContext);
 }
 
 void xml::lite::Element::getElementsByTagName(const std::string& localName,
                                               std::vector<Element*>& elements,
                                               bool recurse) const 
 {
-    elements.reserve(mChildren.size());
-    for (unsigned int i = 0; i < mChildren.size(); i++)
-    {
-        if (mChildren[i]->getLocalName() == localName)
-            elements.push_back(mChildren[i]);
-        if (recurse)
-            mChildren[i]->getElementsByTagName(localName, elements, recurse);
-    }
+    std::ignore = forEachElement(localName, recurse, [&](Element* e) {
+        elements.push_back(e);
+        return true; });
 }
 
 xml::lite::Element* xml::lite::Element::getElementByTagName(std::nothrow_t,
     const std::string& localName, bool recurse) const
 {
-    auto getElements = [&]() { return getElementsByTagName(localName, recurse); };
-    return std::get<0>(getElement(getElements));
+    return getElement([&](auto f) { return forEachElement(localName, recurse, f); });
 }
 xml::lite::Element& xml::lite::Element::getElementByTagName(
     const std::string& localName, bool recurse) const
@@ -185,29 +265,32 @@ xml::lite::Element& xml::lite::Element::getElementByTagName(
     auto getElements = [&]() { return getElementsByTagName(localName, recurse); };
     auto makeContext = [&](const std::string& sz) {
        return Ctxt("Expected exactly one '" + localName + "'; but got " + sz); };
-    return getElement(getElements, makeContext);
+    return getElement(getElementByTagName(std::nothrow, localName, recurse), getElements, makeContext);
 }
 
+// The local name of a "prefix:localName" string, see QName::setQName()
+static std::string localNameOf(const std::string& qname)
+{
+    const auto x = qname.find_first_of(':');
+    return x == std::string::npos ? qname : qname.substr(x + 1);
+}
 
 void xml::lite::Element::getElementsByTagNameNS(const std::string& qname,
                                                 std::vector<Element*>& elements,
                                                 bool recurse) const
 {
-    elements.reserve(mChildren.size());
-    for (unsigned int i = 0; i < mChildren.size(); i++)
-    {
-        if (mChildren[i]->mName.toString() == qname)
-            elements.push_back(mChildren[i]);
-        if (recurse)
-            mChildren[i]->getElementsByTagNameNS(qname, elements, recurse);
-    }
+    std::ignore = forEachElement(localNameOf(qname), recurse, [&](Element* e) {
+        if (e->mName.toString() == qname)
+            elements.push_back(e);
+        return true; });
 }
 
 xml::lite::Element* xml::lite::Element::getElementByTagNameNS(std::nothrow_t,
     const std::string& qname, bool recurse) const
 {
-    auto getElements = [&]() { return getElementsByTagNameNS(qname, recurse); };
-    return std::get<0>(getElement(getElements));
+    return getElement([&](auto f) {
+        return forEachElement(localNameOf(qname), recurse, [&](Element* e) {
+            return (e->mName.toString() == qname) ? f(e) : true; }); });
 }
 xml::lite::Element& xml::lite::Element::getElementByTagNameNS(
     const std::string& qname, bool recurse) const
@@ -215,12 +298,14 @@ xml::lite::Element& xml::lite::Element::getElementByTagNameNS(
     auto getElements = [&]() { return getElementsByTagNameNS(qname, recurse); };
     auto makeContext = [&](const std::string& sz) {
         return Ctxt("Expected exactly one '" + qname + "'; but got " + sz); };
-    return getElement(getElements, makeContext);
+    return getElement(getElementByTagNameNS(std::nothrow, qname, recurse), getElements, makeContext);
 }
 
 
 void xml::lite::Element::destroyChildren()
 {
+    invalidateChildIndex();
+
     // While something is in vector
     while (mChildren.size())
     {
@@ -352,6 +437,7 @@ void xml::lite::Element::addChild(xml::lite::Element * node)
 {
     mChildren.push_back(node);
     node->setParent(this);
+    invalidateChildIndex();
 }
 
 xml::lite::Element& xml::lite::Element::addChild(std::unique_ptr<xml::lite::Element>&& node)
@@ -361,6 +447,21 @@ xml::lite::Element& xml::lite::Element::addChild(std::unique_ptr<xml::lite::Elem
     return *retval;
 }
 
+std::unique_ptr<xml::lite::Element> xml::lite::Element::removeChild(const Element& node)
+{
+    const auto it = std::find(mChildren.begin(), mChildren.end(), &node);
+    if (it == mChildren.end())
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<Element> retval(*it);
+    mChildren.erase(it);
+    invalidateChildIndex();
+    retval->setParent(nullptr);
+    return retval;
+}
+
 void xml::lite::Element::changePrefix(Element* element,
     const std::string& prefix, const std::string& uri)
 {
@@ -0,0 +1,218 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "xml/lite/PathFilterHandler.h"
+
+#include <assert.h>
+
+#include <stdexcept>
+#include <utility>
+#include <std/string>
+
+#include "str/Manip.h"
+#include "str/Encoding.h"
+
+void xml::lite::PathFilterHandler::addPath(const std::string& path_, Callback callback)
+{
+    if (!callback)
+    {
+        throw std::invalid_argument("'callback' is empty.");
+    }
+
+    Path path;
+    std::string remaining;
+    if (str::startsWith(path_, "//"))
+    {
+        remaining = path_.substr(2);
+    }
+    else if (str::startsWith(path_, "/"))
+    {
+        path.absolute = true;
+        remaining = path_.substr(1);
+    }
+    else
+    {
+        remaining = path_;  // relative paths match anywhere, just like "//"
+    }
+
+    if (remaining.empty())
+    {
+        throw std::invalid_argument("path '" + path_ + "' has no steps.");
+    }
+    // str::split() skips empty tokens, so check for them explicitly
+    if (str::startsWith(remaining, "/") || str::endsWith(remaining, "/") || str::contains(remaining, "//"))
+    {
+        throw std::invalid_argument("path '" + path_ + "' has an empty step.");
+    }
+    path.steps = str::split(remaining, "/");
+
+    path.callback = std::move(callback);
+    mPaths.push_back(std::move(path));
+}
+void xml::lite::PathFilterHandler::addPath(const std::string& path)
+{
+    addPath(path, [&](std::unique_ptr<Element>&& element) {
+        mElements.push_back(std::move(element)); });
+}
+
+void xml::lite::PathFilterHandler::clear()
+{
+    mElements.clear();
+    startDocument();
+}
+
+void xml::lite::PathFilterHandler::startDocument()
+{
+    mLocation.clear();
+    mSubtree.reset();
+    mNodeStack.clear();
+    mCharacterData.clear();
+}
+
+// The first path (in the order they were added) that matches mLocation
+bool xml::lite::PathFilterHandler::findMatch(size_t& pathIndex) const
+{
+    for (pathIndex = 0; pathIndex < mPaths.size(); pathIndex++)
+    {
+        const auto& path = mPaths[pathIndex];
+        const auto& steps = path.steps;
+        if ((steps.size() > mLocation.size()) ||
+            (path.absolute && (steps.size() != mLocation.size())))
+        {
+            continue;
+        }
+
+        // compare from the end: the last step must be the current element
+        auto location = mLocation.rbegin();
+        bool matches = true;
+        for (auto step = steps.rbegin(); step != steps.rend(); ++step, ++location)
+        {
+            if ((*step != "*") && (*step != *location))
+            {
+                matches = false;
+                break;
+            }
+        }
+        if (matches)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void xml::lite::PathFilterHandler::characters(coda_oss::u8string&& s)
+{
+    assert(!mCharacterData.empty());
+    mCharacterData.back() += std::move(s);
+}
+void xml::lite::PathFilterHandler::characters(const char* value, int length)
+{
+    if (mSubtree != nullptr)  // otherwise, we don't care about this data
+    {
+        // see MinidomHandler::characters()
+        characters(str::u8FromNative(std::string(value, length)));
+    }
+}
+bool xml::lite::PathFilterHandler::vcharacters(const void /*XMLCh*/* chars_, size_t length)
+{
+    if (mSubtree == nullptr)
+    {
+        return true;  // "processed" by ignoring it; no need to convert anything
+    }
+
+    if (chars_ == nullptr)
+    {
+        throw std::invalid_argument("chars_ is NULL.");
+    }
+    if (length == 0)
+    {
+        throw std::invalid_argument("length is 0.");
+    }
+
+    // XMLCh is 16-bits, see MinidomHandler::vcharacters()
+    auto pChars16 = static_cast<const char16_t*>(chars_);
+    characters(str::to_u8string(pChars16, length));
+    return true;
+}
+
+void xml::lite::PathFilterHandler::startElement(const std::string& uri,
+                                                const std::string& localName,
+                                                const std::string& qname,
+                                                const Attributes& atts)
+{
+    mLocation.push_back(localName);
+
+    if (mSubtree == nullptr)
+    {
+        if (!findMatch(mSubtreePath))
+        {
+            return;  // not interested in this element
+        }
+    }
+
+    auto element = Element::create(qname, uri);
+    element->setAttributes(atts);
+    Element* current = element.get();
+    if (mSubtree == nullptr)
+    {
+        mSubtree = std::move(element);
+    }
+    else
+    {
+        assert(!mNodeStack.empty());
+        std::ignore = mNodeStack.back()->addChild(std::move(element));
+    }
+    mNodeStack.push_back(current);
+    mCharacterData.emplace_back();
+}
+
+void xml::lite::PathFilterHandler::endElement(const std::string& /*uri*/,
+                                              const std::string& /*localName*/,
+                                              const std::string& /*qname*/)
+{
+    assert(!mLocation.empty());
+    mLocation.pop_back();
+
+    if (mSubtree == nullptr)
+    {
+        return;
+    }
+
+    auto characterData = std::move(mCharacterData.back());
+    mCharacterData.pop_back();
+    if (!mPreserveCharData && !characterData.empty())
+    {
+        str::trim(characterData);
+    }
+    mNodeStack.back()->setCharacterData(std::move(characterData));
+    mNodeStack.pop_back();
+
+    if (mNodeStack.empty())
+    {
+        // Done with this subtree; let the callback have it.  Note that the callback
+        // might register more paths, so don't hold onto a reference.
+        auto callback = mPaths[mSubtreePath].callback;
+        callback(std::move(mSubtree));
+        mSubtree.reset();
+    }
+}
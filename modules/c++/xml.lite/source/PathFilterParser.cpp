@@ -0,0 +1,61 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "xml/lite/PathFilterParser.h"
+
+#include <utility>
+
+xml::lite::PathFilterParser::PathFilterParser()
+{
+    mReader.setContentHandler(&mHandler);
+}
+
+void xml::lite::PathFilterParser::addPath(const std::string& path, PathFilterHandler::Callback callback)
+{
+    mHandler.addPath(path, std::move(callback));
+}
+void xml::lite::PathFilterParser::addPath(const std::string& path)
+{
+    mHandler.addPath(path);
+}
+
+void xml::lite::PathFilterParser::parse(io::InputStream& is, const void* pEncoding)
+{
+    if (pEncoding == nullptr)
+    {
+        mReader.parseStream(is);
+    }
+    else
+    {
+        mReader.parseStream(is, pEncoding, nullptr /*pFallbackEncoding*/);
+    }
+}
+
+void xml::lite::PathFilterParser::clear()
+{
+    mHandler.clear();
+}
+
+void xml::lite::PathFilterParser::preserveCharacterData(bool preserve)
+{
+    mHandler.preserveCharacterData(preserve);
+}
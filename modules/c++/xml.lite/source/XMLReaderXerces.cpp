@@ -23,6 +23,7 @@
 
 #include <assert.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "xml/lite/XMLReader.h"
@@ -54,6 +55,12 @@ static void parse(SAX2XMLReader& parser, const std::vector<sys::byte>& buffer, c
     }
     parser.parse(memBuffer);
 }
+// Is this the error for input that isn't in the encoding it was parsed with?
+static bool isEncodingError(const except::Error& e)
+{
+    return e.getMessage() == " (1,1): invalid byte 'X' at position 2 of a 2-byte sequence";
+}
+
 static void parse(SAX2XMLReader& parser, const std::vector<sys::byte>& buffer,
     const XMLCh* pInitialEncoding, const XMLCh* pFallbackEncoding)
 {
@@ -64,8 +71,7 @@ static void parse(SAX2XMLReader& parser, const std::vector<sys::byte>& buffer,
     }
     catch (const except::Error& e)
     {
-        const auto msg = e.getMessage();
-        if (msg != " (1,1): invalid byte 'X' at position 2 of a 2-byte sequence")
+        if (!isEncodingError(e))
         {
             throw;
         }
@@ -104,6 +110,151 @@ void xml::lite::XMLReaderXerces::parse(io::InputStream& is, int size)
     parse(is, nullptr /*pInitialEncoding*/, getWindows1252Encoding(), size);
 }
 
+namespace
+{
+// An io::InputStream that keeps the first bytes read, so that parsing can
+// start over (with another encoding) as long as no more than that was read.
+struct ReplayableStream final
+{
+    explicit ReplayableStream(io::InputStream& is) : stream(is) { }
+
+    io::InputStream& stream;
+    std::vector<XMLByte> head;
+    size_t numRead = 0;
+
+    static constexpr size_t maxHeadSize = 64 * 1024;
+    bool canReplay() const
+    {
+        return numRead == head.size();
+    }
+};
+
+// Let Xerces pull bytes from an io::InputStream as it needs them.
+class IOBinInputStream final : public BinInputStream
+{
+    ReplayableStream& mStream;
+    XMLFilePos mPos = 0;
+
+public:
+    IOBinInputStream(ReplayableStream& is) : mStream(is) { }
+
+    XMLFilePos curPos() const override
+    {
+        return mPos;
+    }
+
+    XMLSize_t readBytes(XMLByte* const toFill, const XMLSize_t maxToRead) override
+    {
+        auto& head = mStream.head;
+        if (mPos < head.size())  // starting over; re-read what was kept
+        {
+            const auto count = std::min(static_cast<size_t>(maxToRead), head.size() - static_cast<size_t>(mPos));
+            std::copy(head.begin() + static_cast<ptrdiff_t>(mPos), head.begin() + static_cast<ptrdiff_t>(mPos + count), toFill);
+            mPos += count;
+            return count;
+        }
+
+        const auto bytesRead = mStream.stream.read(toFill, maxToRead);
+        if (bytesRead <= 0)
+        {
+            return 0; // EOF
+        }
+        if (mStream.canReplay())
+        {
+            if (head.size() + bytesRead <= ReplayableStream::maxHeadSize)
+            {
+                head.insert(head.end(), toFill, toFill + bytesRead);
+            }
+            else
+            {
+                std::vector<XMLByte>().swap(head); // too late to start over
+            }
+        }
+        mStream.numRead += bytesRead;
+        mPos += bytesRead;
+        return static_cast<XMLSize_t>(bytesRead);
+    }
+
+    const XMLCh* getContentType() const override
+    {
+        return nullptr;
+    }
+};
+
+class IOInputSource final : public InputSource
+{
+    ReplayableStream& mStream;
+
+public:
+    IOInputSource(ReplayableStream& is) :
+        InputSource(xml::lite::XMLReaderXerces::MEM_BUFFER_ID()), mStream(is) { }
+
+    BinInputStream* makeStream() const override
+    {
+        return new IOBinInputStream(mStream);  // Xerces takes ownership
+    }
+};
+}
+
+static void parseStream(SAX2XMLReader& parser, ReplayableStream& is, const XMLCh* pEncoding)
+{
+    IOInputSource source(is);
+    if (pEncoding != nullptr)
+    {
+        source.setEncoding(pEncoding);
+    }
+
+    // Nothing is read up-front as with parse(), so errors reading the
+    // stream come from Xerces.
+    try
+    {
+        parser.parse(source);
+    }
+    catch (const ::XMLException& e)
+    {
+        throw xml::lite::XMLParseException(Ctxt(xml::lite::XercesLocalString(e.getMessage()).str()));
+    }
+    catch (const ::SAXException& e)
+    {
+        throw xml::lite::XMLParseException(Ctxt(xml::lite::XercesLocalString(e.getMessage()).str()));
+    }
+}
+
+void xml::lite::XMLReaderXerces::parseStream(io::InputStream& is, const void* pInitialEncoding_, const void* pFallbackEncoding_)
+{
+    const auto pInitialEncoding = static_cast<const XMLCh*>(pInitialEncoding_);
+    const auto pFallbackEncoding = static_cast<const XMLCh*>(pFallbackEncoding_);
+
+    ReplayableStream stream(is);
+    try
+    {
+        ::parseStream(*mNative, stream, pInitialEncoding);
+        return; // successful parse
+    }
+    catch (const except::Error& e)
+    {
+        if (stream.numRead == 0)
+        {
+            throw xml::lite::XMLParseException(Ctxt("No stream available"));
+        }
+
+        // See ::parse(); only an error in the first buffer Xerces reads
+        // (when no content has been reported yet) is an encoding error.
+        if (!isEncodingError(e) || (pFallbackEncoding == nullptr) ||
+            (pFallbackEncoding == pInitialEncoding) || !stream.canReplay())
+        {
+            throw;
+        }
+    }
+
+    // Try again using the fallback encoding
+    ::parseStream(*mNative, stream, pFallbackEncoding);
+}
+void xml::lite::XMLReaderXerces::parseStream(io::InputStream& is)
+{
+    parseStream(is, nullptr /*pInitialEncoding*/, getWindows1252Encoding());
+}
+
 // This function creates the parser
 void xml::lite::XMLReaderXerces::create()
 {
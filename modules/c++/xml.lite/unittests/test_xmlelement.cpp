@@ -22,6 +22,8 @@
 
 #include <std/string>
 #include <std/span>
+#include <thread>
+#include <vector>
 #include "coda_oss/CPlusPlus.h"
 #include "io/StringStream.h"
 #include <TestCase.h>
@@ -202,6 +204,84 @@ TEST_CASE(test_getElementByTagName_throw)
     TEST_SPECIFIC_EXCEPTION(doc.getElementByTagName("duplicate"), xml::lite::XMLException);
 }
 
+TEST_CASE(test_getElementByTagName_indexed)
+{
+    // enough children to trigger building the index
+    xml::lite::Element root("root");
+    for (size_t i = 0; i < 20; i++)
+    {
+        std::ignore = addChild(root, "child" + std::to_string(i));
+    }
+    std::ignore = root.addChild(xml::lite::Element::create("ns:child0", "urn:example.com"));
+
+    TEST_ASSERT_EQ(std::ssize(root.getElementsByTagName("child0")), 2);
+    TEST_ASSERT_NULL(root.getElementByTagName(std::nothrow, "child0"));
+    TEST_ASSERT_EQ(std::ssize(root.getElementsByTagNameNS("ns:child0")), 1);
+    TEST_ASSERT_EQ(root.getElementByTagName(xml::lite::QName(xml::lite::Uri("urn:example.com"), "child0")).getQName(), "ns:child0");
+    TEST_ASSERT_TRUE(root.hasElement("child19"));
+    TEST_ASSERT_FALSE(root.hasElement("child20"));
+
+    // the index must be updated when the children change ...
+    auto& child20 = addChild(root, "child20");
+    TEST_ASSERT_EQ(&root.getElementByTagName("child20"), &child20);
+    auto removed = root.removeChild(child20);
+    TEST_ASSERT_EQ(removed.get(), &child20);
+    TEST_ASSERT_NULL(removed->getParent());
+    TEST_ASSERT_FALSE(root.hasElement("child20"));
+    TEST_ASSERT_NULL(root.removeChild(child20).get());
+
+    // ... or are renamed
+    auto& child1 = root.getElementByTagName("child1");
+    child1.setLocalName("renamed");
+    TEST_ASSERT_FALSE(root.hasElement("child1"));
+    TEST_ASSERT_EQ(&root.getElementByTagName("renamed"), &child1);
+}
+
+TEST_CASE(test_getElementsByTagName_concurrent)
+{
+    // const lookups build the index; racing to do so must be safe
+    for (size_t n = 0; n < 50; n++)
+    {
+        xml::lite::Element root("root");
+        for (size_t i = 0; i < 20; i++)
+        {
+            std::ignore = addChild(root, "child" + std::to_string(i % 10));
+        }
+
+        const auto& croot = root;
+        std::vector<size_t> counts(4);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < counts.size(); t++)
+        {
+            threads.emplace_back([&croot, &counts, t]() {
+                counts[t] = croot.getElementsByTagName("child" + std::to_string(t)).size(); });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        for (const auto count : counts)
+        {
+            TEST_ASSERT_EQ(count, static_cast<size_t>(2));
+        }
+    }
+}
+
+TEST_CASE(test_moveAssign_indexed)
+{
+    xml::lite::Element root("root");
+    for (size_t i = 0; i < 20; i++)
+    {
+        std::ignore = addChild(root, "child" + std::to_string(i));
+    }
+    auto& child5 = root.getElementByTagName("child5"); // builds the index
+
+    // moving into a child renames it; the parent's index must notice
+    child5 = xml::lite::Element("moved");
+    TEST_ASSERT_FALSE(root.hasElement("child5"));
+    TEST_ASSERT_EQ(&root.getElementByTagName("moved"), &child5);
+}
+
 TEST_CASE(test_getValue)
 {
     test_MinidomParser xmlParser;
@@ -363,6 +443,9 @@ int main(int, char**)
     TEST_CHECK(test_getElementByTagName);
     TEST_CHECK(test_getElementByTagName_nothrow);    
     TEST_CHECK(test_getElementByTagName_throw);
+    TEST_CHECK(test_getElementByTagName_indexed);
+    TEST_CHECK(test_getElementsByTagName_concurrent);
+    TEST_CHECK(test_moveAssign_indexed);
 
     TEST_CHECK(test_getValue);
     TEST_CHECK(test_getValueFailure);
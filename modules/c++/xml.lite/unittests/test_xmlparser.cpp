@@ -35,6 +35,7 @@
 #include <TestCase.h>
 
 #include "xml/lite/MinidomParser.h"
+#include "xml/lite/PathFilterParser.h"
 #include "xml/lite/Validator.h"
 #include "xml/lite/QName.h"
 
@@ -129,6 +130,95 @@ TEST_CASE(testXmlParseSimple)
     test_a_element(testName, *docElements[0]);
 }
 
+TEST_CASE(testXmlPathFilter)
+{
+    static const std::string strXml_ = "<root><doc><a>A1</a><b><a>A2</a></b></doc><skip><a>A3</a></skip></root>";
+
+    xml::lite::PathFilterParser xmlParser;
+    xmlParser.addPath("/root/doc/a");
+    std::vector<std::string> anywhere;
+    xmlParser.addPath("//a", [&](std::unique_ptr<xml::lite::Element>&& a) {
+        anywhere.push_back(a->getCharacterData()); });
+    size_t bCount = 0;
+    xmlParser.addPath("/root/*/b", [&](std::unique_ptr<xml::lite::Element>&& b) {
+        TEST_ASSERT_EQ(b->getElementByTagName("a").getCharacterData(), "A2");
+        bCount++; });
+
+    io::StringStream ss;
+    ss.stream() << strXml_;
+    xmlParser.parse(ss);
+
+    // paths are checked in the order they were added
+    const auto& elements = xmlParser.getElements();
+    TEST_ASSERT_EQ(std::ssize(elements), 1);
+    TEST_ASSERT_EQ(elements[0]->getCharacterData(), "A1");
+    TEST_ASSERT_EQ(std::ssize(anywhere), 1);
+    TEST_ASSERT_EQ(anywhere[0], "A3");  // "A2" is part of the "b" subtree
+    TEST_ASSERT_EQ(bCount, static_cast<size_t>(1));
+
+    TEST_THROWS(xmlParser.addPath(""));
+    TEST_THROWS(xmlParser.addPath("/root//a"));
+    TEST_THROWS(xmlParser.addPath("/root/"));
+}
+
+TEST_CASE(testXmlPathFilterOverlapping)
+{
+    static const std::string strXml_ = "<root><doc><a>A1</a></doc></root>";
+
+    // an element matching several paths goes only to the first one added
+    for (const bool absoluteFirst : { true, false })
+    {
+        std::vector<std::string> absolute, anywhere;
+        const auto addAbsolute = [&](xml::lite::PathFilterParser& parser) {
+            parser.addPath("/root/doc/a", [&](std::unique_ptr<xml::lite::Element>&& a) {
+                absolute.push_back(a->getCharacterData()); }); };
+        const auto addAnywhere = [&](xml::lite::PathFilterParser& parser) {
+            parser.addPath("//a", [&](std::unique_ptr<xml::lite::Element>&& a) {
+                anywhere.push_back(a->getCharacterData()); }); };
+
+        xml::lite::PathFilterParser xmlParser;
+        if (absoluteFirst)
+        {
+            addAbsolute(xmlParser);
+            addAnywhere(xmlParser);
+        }
+        else
+        {
+            addAnywhere(xmlParser);
+            addAbsolute(xmlParser);
+        }
+
+        io::StringStream ss;
+        ss.stream() << strXml_;
+        xmlParser.parse(ss);
+        TEST_ASSERT_EQ(std::ssize(absolute), absoluteFirst ? 1 : 0);
+        TEST_ASSERT_EQ(std::ssize(anywhere), absoluteFirst ? 0 : 1);
+    }
+}
+
+TEST_CASE(testXmlPathFilterAfterThrow)
+{
+    xml::lite::PathFilterParser xmlParser;
+    xmlParser.addPath("/doc/a");
+
+    // stops in the middle of a matching element
+    io::StringStream truncated;
+    truncated.stream() << "<doc><a>A";
+    TEST_EXCEPTION(xmlParser.parse(truncated));
+
+    // nothing from the failed parse is left over
+    io::StringStream ss;
+    ss.stream() << "<doc><a>A2</a></doc>";
+    xmlParser.parse(ss);
+    const auto& elements = xmlParser.getElements();
+    TEST_ASSERT_EQ(std::ssize(elements), 1);
+    TEST_ASSERT_EQ(elements[0]->getCharacterData(), "A2");
+    TEST_ASSERT_EQ(std::ssize(elements[0]->getChildren()), 0);
+
+    io::StringStream empty;
+    TEST_SPECIFIC_EXCEPTION(xmlParser.parse(empty), xml::lite::XMLParseException);
+}
+
 TEST_CASE(testXmlPreserveCharacterData)
 {
     io::StringStream stream;
@@ -507,6 +597,9 @@ TEST_CASE(testValidateXmlFile)
 int main(int, char**)
 {
     TEST_CHECK(testXmlParseSimple);
+    TEST_CHECK(testXmlPathFilter);
+    TEST_CHECK(testXmlPathFilterOverlapping);
+    TEST_CHECK(testXmlPathFilterAfterThrow);
     TEST_CHECK(testXmlPreserveCharacterData);
     TEST_CHECK(testXmlUtf8);
     TEST_CHECK(testXmlUtf8_u8string);    
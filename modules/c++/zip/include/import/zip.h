@@ -23,9 +23,12 @@
 #ifndef __IMPORT_ZIP_H__
 #define __IMPORT_ZIP_H__
 
+#include "zip/BlockGZipInputStream.h"
+#include "zip/BlockGZipOutputStream.h"
 #include "zip/GZipInputStream.h"
 #include "zip/GZipOutputStream.h"
 #include "zip/ZipEntry.h"
+#include "zip/ZipEntryInputStream.h"
 #include "zip/ZipFile.h"
 #include "zip/ZipOutputStream.h"
 
@@ -0,0 +1,113 @@
+/* =========================================================================
+ * This file is part of zip-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * zip-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_zip_BlockGZipInputStream_h_INCLUDED_
+#define CODA_OSS_zip_BlockGZipInputStream_h_INCLUDED_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "config/Exports.h"
+#include "sys/Conf.h"
+#include "sys/File.h"
+#include "io/SeekableStreams.h"
+
+#include "zip/Types.h"
+
+namespace zip
+{
+/*!
+ *  \class BlockGZipInputStream
+ *  \brief Random-access reads of a file from BlockGZipOutputStream
+ *
+ *  On construction, the header of each gzip member is read to build an
+ *  index of the blocks; nothing is decompressed.  Reads then decompress
+ *  only the blocks that are needed, several at a time in parallel.
+ *  seek() and tell() are in terms of the uncompressed data.
+ */
+class CODA_OSS_API BlockGZipInputStream : public io::SeekableInputStream
+{
+public:
+    //! Location of one block, both in the file and in the uncompressed data
+    struct Block final
+    {
+        sys::Off_T compressedOffset;
+        size_t compressedSize;
+        sys::Off_T uncompressedOffset;
+        size_t uncompressedSize;
+    };
+
+    /*!
+     *  \param file  A file written by BlockGZipOutputStream
+     *  \param numThreads  Threads to decompress with; 0 to use all CPUs
+     *  \throw except::IOException if the file isn't blocked gzip
+     */
+    BlockGZipInputStream(const std::string& file, size_t numThreads = 0);
+
+    BlockGZipInputStream(const BlockGZipInputStream&) = delete;
+    BlockGZipInputStream& operator=(const BlockGZipInputStream&) = delete;
+
+    //! The block index built from the member headers
+    const std::vector<Block>& getIndex() const
+    {
+        return mIndex;
+    }
+
+    //! Total size of the uncompressed data
+    sys::Off_T getUncompressedSize() const;
+
+    //! Uncompressed bytes remaining from the current position
+    virtual sys::Off_T available() override;
+
+    //! Seek within the uncompressed data
+    virtual sys::Off_T seek(sys::Off_T offset, Whence whence) override;
+    virtual sys::Off_T tell() override
+    {
+        return mPosition;
+    }
+
+    void close();
+
+protected:
+    virtual sys::SSize_T readImpl(void* buffer, size_t len) override;
+
+private:
+    void buildIndex();
+    size_t findBlock(sys::Off_T position) const;
+    void decompressBlocks(size_t firstBlock);
+
+    sys::File mFile;
+    const size_t mNumThreads;
+    std::vector<Block> mIndex;
+    sys::Off_T mPosition = 0;
+
+    //! Decompressed blocks [mFirstBlock, mFirstBlock + mBlocks.size())
+    size_t mFirstBlock = 0;
+    std::vector<std::vector<sys::ubyte> > mBlocks;
+    std::vector<sys::ubyte> mCompressed;
+};
+}
+
+#endif  // CODA_OSS_zip_BlockGZipInputStream_h_INCLUDED_
@@ -0,0 +1,107 @@
+/* =========================================================================
+ * This file is part of zip-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * zip-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_zip_BlockGZipOutputStream_h_INCLUDED_
+#define CODA_OSS_zip_BlockGZipOutputStream_h_INCLUDED_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "config/Exports.h"
+#include "sys/Conf.h"
+#include "io/FileOutputStream.h"
+
+#include "zip/Types.h"
+
+namespace zip
+{
+/*!
+ *  \class BlockGZipOutputStream
+ *  \brief Write a gzip file, compressing blocks in parallel
+ *
+ *  The input is split into fixed-size blocks, each of which is compressed
+ *  independently (on multiple threads) as its own gzip member.  Concatenated
+ *  members are still a valid gzip file, so the result can be read with
+ *  GZipInputStream, gunzip, etc.  Each member records its size in the gzip
+ *  header (see Types.h), which BlockGZipInputStream uses for random access.
+ *
+ *  Smaller blocks allow finer-grained seeking; larger blocks compress (a
+ *  bit) better and have less per-block overhead.
+ */
+class CODA_OSS_API BlockGZipOutputStream : public io::OutputStream
+{
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+    /*!
+     *  \param file  The file to create
+     *  \param numThreads  Threads to compress with; 0 to use all CPUs
+     *  \param blockSize  Size of each (uncompressed) block
+     *  \param level  zlib compression level
+     */
+    BlockGZipOutputStream(const std::string& file,
+                          size_t numThreads = 0,
+                          size_t blockSize = DEFAULT_BLOCK_SIZE,
+                          int level = Z_DEFAULT_COMPRESSION);
+
+    //! Any buffered data is written, but errors are ignored; call close().
+    virtual ~BlockGZipOutputStream();
+
+    BlockGZipOutputStream(const BlockGZipOutputStream&) = delete;
+    BlockGZipOutputStream& operator=(const BlockGZipOutputStream&) = delete;
+
+    using OutputStream::write;
+
+    /*!
+     *  Buffer len bytes; once there's a full block for every thread,
+     *  they're compressed (in parallel) and written.
+     */
+    virtual void write(const void* buffer, size_t len) override;
+
+    /*!
+     *  Compress and write all buffered data, even if that
+     *  results in a short block.
+     */
+    virtual void flush() override;
+
+    /*!
+     *  Flush and close the file.
+     */
+    virtual void close() override;
+
+private:
+    void compressAndWrite();
+
+    io::FileOutputStream mFile;
+    const size_t mNumThreads;
+    const size_t mBlockSize;
+    const int mLevel;
+    std::vector<sys::ubyte> mBuffer; // up to mNumThreads blocks
+    std::vector<std::vector<sys::ubyte> > mMembers;
+    size_t mBlocksWritten = 0;
+};
+}
+
+#endif  // CODA_OSS_zip_BlockGZipOutputStream_h_INCLUDED_
@@ -41,6 +41,23 @@ enum
     ENTRY_LEN = 46,
     LFH_SIZE = 30
 };
+
+/*!
+ *  Blocked gzip (see BlockGZipOutputStream) is a series of gzip members.
+ *  The header of each member has an "extra" field, ID 'C' 'Z', holding the
+ *  total (compressed) size of the member and the size of the uncompressed
+ *  block; both are 32-bit little-endian.  That lets a reader build an index
+ *  by hopping from header to header.
+ */
+enum
+{
+    BGZ_SI1 = 'C',
+    BGZ_SI2 = 'Z',
+    BGZ_SLEN = 8,
+    BGZ_XLEN = 4 + BGZ_SLEN,
+    BGZ_HEADER_LEN = 10 + 2 + BGZ_XLEN,
+    BGZ_TRAILER_LEN = 8
+};
 }
 
 #endif  // CODA_OSS_zip_Types_h_INCLUDED_
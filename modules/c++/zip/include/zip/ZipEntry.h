@@ -23,6 +23,8 @@
 #ifndef __ZIP_ZIP_ENTRY_H__
 #define __ZIP_ZIP_ENTRY_H__
 
+#include <memory>
+
 #include "zip/Types.h"
 
 namespace zip
@@ -36,11 +38,13 @@ namespace zip
  */
 class ZipEntry
 {
+public:
     enum CompressionMethod
     {
         COMP_STORED = 0, COMP_DEFLATED = 8
     };
 
+private:
     sys::ubyte* mCompressedData;
     sys::Size_T mCompressedSize;
     sys::Size_T mUncompressedSize;
@@ -89,6 +93,18 @@ public:
     sys::ubyte* decompress();
     void decompress(sys::ubyte* out, sys::Size_T outLen);
 
+    /*!
+     *  Stream the uncompressed data rather than decompressing it all at
+     *  once; see ZipEntryInputStream.  The ZipFile must outlive the stream.
+     */
+    std::unique_ptr<io::InputStream> openInputStream() const;
+
+    //! The (still compressed) data for this entry, inside the ZipFile
+    const sys::ubyte* getCompressedData() const
+    {
+        return mCompressedData;
+    }
+
     sys::Uint16_T getVersionMadeBy() const
     {
         return mVersionMadeBy;
@@ -0,0 +1,82 @@
+/* =========================================================================
+ * This file is part of zip-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * zip-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+#ifndef CODA_OSS_zip_ZipEntryInputStream_h_INCLUDED_
+#define CODA_OSS_zip_ZipEntryInputStream_h_INCLUDED_
+
+#include "config/Exports.h"
+#include "sys/Conf.h"
+#include "io/InputStream.h"
+
+#include "zip/Types.h"
+
+namespace zip
+{
+class ZipEntry;
+
+/*!
+ *  \class ZipEntryInputStream
+ *  \brief Streams the uncompressed contents of a single ZipEntry
+ *
+ *  Data is inflated directly into the buffer passed to read(), so the
+ *  only memory used is zlib's own window; there is never a copy of the
+ *  whole entry.  The CRC is checked once all of the data has been read.
+ *
+ *  The ZipFile the entry came from must outlive this stream.
+ */
+class CODA_OSS_API ZipEntryInputStream final : public io::InputStream
+{
+public:
+    /*!
+     *  \param entry  A stored or deflated entry of a ZipFile
+     *  \throw except::IOException for other compression methods
+     */
+    explicit ZipEntryInputStream(const ZipEntry& entry);
+    ~ZipEntryInputStream();
+
+    ZipEntryInputStream(const ZipEntryInputStream&) = delete;
+    ZipEntryInputStream& operator=(const ZipEntryInputStream&) = delete;
+
+    //! Uncompressed bytes remaining
+    virtual sys::Off_T available() override;
+
+protected:
+    virtual sys::SSize_T readImpl(void* buffer, size_t len) override;
+
+private:
+    void checkCRC() const;
+
+    const sys::ubyte* const mCompressedData;
+    const size_t mCompressedSize;
+    const size_t mUncompressedSize;
+    const sys::Uint32_T mExpectedCRC;
+    const bool mStored;
+
+    z_stream mZStream;
+    size_t mPosition = 0;
+    uLong mCRC;
+};
+}
+
+#endif  // CODA_OSS_zip_ZipEntryInputStream_h_INCLUDED_
@@ -23,6 +23,9 @@
 #ifndef __ZIP_ZIP_FILE_H__
 #define __ZIP_ZIP_FILE_H__
 
+#include <memory>
+#include <string>
+
 #include "gsl/gsl.h"
 
 #include "zip/ZipEntry.h"
@@ -59,10 +62,14 @@ class ZipFile
     //!  Zip (apparently) is little-endian
     bool mSwapBytes;
 
-    //!  Compressed data buffer (yes we eat the whole file)
+    //!  Compressed data buffer (yes we eat the whole file) ...
     sys::ubyte* mCompressed;
     sys::Size_T mCompressedLength;
 
+    //!  ... unless it's memory-mapped, in which case this owns the mapping
+    struct Mapping;
+    std::unique_ptr<Mapping> mMapping;
+
     sys::Uint16_T mDiskNum;
     sys::Uint16_T mDiskWithCentralDir;
 
@@ -99,16 +106,20 @@ public:
      *  This stream should be already initialized, since we
      *  are planning on reading from it immediately
      */
-    ZipFile(io::InputStream* inputStream) :
-        mCompressed(nullptr)
-    {
-        mSwapBytes = sys::isBigEndianSystem();
-        mCompressedLength = inputStream->available();
-        mCompressed = new sys::ubyte[mCompressedLength];
-        inputStream->read((sys::byte*) mCompressed, mCompressedLength);
+    ZipFile(io::InputStream* inputStream);
 
-        readCentralDir();
-    }
+    /*!
+     *  Memory-map the archive rather than reading all of it.  Only the
+     *  central directory is parsed here; the data for an entry isn't
+     *  touched (and so isn't paged in) until it is decompressed, which
+     *  makes reading one small entry from a huge archive cheap.
+     *
+     *  \param pathname  The zip file
+     */
+    explicit ZipFile(const std::string& pathname);
+
+    ZipFile(const ZipFile&) = delete;
+    ZipFile& operator=(const ZipFile&) = delete;
 
     /*!
      *  When the ZipFile object goes out of scope, that
@@ -151,6 +162,18 @@ public:
         return gsl::narrow<unsigned long>(mEntries.size());
     }
 
+    /*!
+     *  Extract every entry below \p directory, creating subdirectories as
+     *  needed.  Entries are streamed (see ZipEntry::openInputStream()) to
+     *  their files \p numThreads at a time.
+     *
+     *  \param directory  Existing directory to extract into
+     *  \param numThreads  Number of threads to use; 0 to use all CPUs
+     *  \throw except::IOException if an entry's name is absolute or
+     *         contains "..", as it would be written outside \p directory
+     */
+    void extractAll(const std::string& directory, size_t numThreads = 0) const;
+
 };
 
 /*!
@@ -0,0 +1,225 @@
+/* =========================================================================
+ * This file is part of zip-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * zip-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "zip/BlockGZipInputStream.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "except/Exception.h"
+#include "sys/OS.h"
+#include "mt/Runnable1D.h"
+
+static uint32_t getUInt16(const sys::ubyte* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8);
+}
+static uint32_t getUInt32(const sys::ubyte* p)
+{
+    return getUInt16(p) | (getUInt16(p + 2) << 16);
+}
+
+// Inflate a single gzip member written by BlockGZipOutputStream, checking the CRC and size.
+static void decompressMember(const sys::ubyte* member, size_t memberSize,
+                             std::vector<sys::ubyte>& block)
+{
+    const auto compressedSize = memberSize - zip::BGZ_HEADER_LEN - zip::BGZ_TRAILER_LEN;
+    const auto pTrailer = member + zip::BGZ_HEADER_LEN + compressedSize;
+
+    z_stream zstream;
+    memset(&zstream, 0, sizeof(zstream));
+    if (inflateInit2(&zstream, -MAX_WBITS) != Z_OK) // raw deflate data
+    {
+        throw except::IOException(Ctxt("inflateInit2() failed"));
+    }
+    zstream.next_in = const_cast<sys::ubyte*>(member + zip::BGZ_HEADER_LEN);
+    zstream.avail_in = static_cast<uInt>(compressedSize);
+    zstream.next_out = block.data();
+    zstream.avail_out = static_cast<uInt>(block.size());
+    const auto rv = inflate(&zstream, Z_FINISH);
+    const auto uncompressedSize = static_cast<size_t>(zstream.total_out);
+    inflateEnd(&zstream);
+
+    if ((rv != Z_STREAM_END) || (uncompressedSize != block.size()) ||
+        (getUInt32(pTrailer + 4) != static_cast<uint32_t>(block.size())))
+    {
+        throw except::IOException(Ctxt("Failed to inflate block"));
+    }
+    const auto crc = crc32(crc32(0L, nullptr, 0), block.data(), static_cast<uInt>(block.size()));
+    if (getUInt32(pTrailer) != static_cast<uint32_t>(crc))
+    {
+        throw except::IOException(Ctxt("CRC mismatch in block"));
+    }
+}
+
+zip::BlockGZipInputStream::BlockGZipInputStream(const std::string& file, size_t numThreads) :
+    mFile(file),
+    mNumThreads(numThreads == 0 ? sys::OS().getNumCPUs() : numThreads)
+{
+    buildIndex();
+}
+
+void zip::BlockGZipInputStream::buildIndex()
+{
+    const auto fileSize = mFile.length();
+    sys::Off_T compressedOffset = 0;
+    sys::Off_T uncompressedOffset = 0;
+    sys::ubyte header[BGZ_HEADER_LEN];
+    while (compressedOffset < fileSize)
+    {
+        if (fileSize - compressedOffset < BGZ_HEADER_LEN + BGZ_TRAILER_LEN)
+        {
+            throw except::IOException(Ctxt("Truncated gzip member"));
+        }
+        mFile.seekTo(compressedOffset, sys::File::FROM_START);
+        mFile.readInto(header, sizeof(header));
+
+        if ((header[0] != 0x1f) || (header[1] != 0x8b) || (header[2] != Z_DEFLATED) ||
+            ((header[3] & 0x04) == 0) || (getUInt16(header + 10) != BGZ_XLEN) ||
+            (header[12] != BGZ_SI1) || (header[13] != BGZ_SI2) || (getUInt16(header + 14) != BGZ_SLEN))
+        {
+            throw except::IOException(Ctxt("Not a blocked gzip file, see BlockGZipOutputStream"));
+        }
+
+        Block block;
+        block.compressedOffset = compressedOffset;
+        block.compressedSize = getUInt32(header + 16);
+        block.uncompressedOffset = uncompressedOffset;
+        block.uncompressedSize = getUInt32(header + 20);
+        if ((block.compressedSize < BGZ_HEADER_LEN + BGZ_TRAILER_LEN) ||
+            (static_cast<sys::Off_T>(block.compressedSize) > fileSize - compressedOffset))
+        {
+            throw except::IOException(Ctxt("Invalid gzip member size"));
+        }
+        mIndex.push_back(block);
+
+        compressedOffset += block.compressedSize;
+        uncompressedOffset += block.uncompressedSize;
+    }
+}
+
+sys::Off_T zip::BlockGZipInputStream::getUncompressedSize() const
+{
+    if (mIndex.empty())
+    {
+        return 0;
+    }
+    const auto& last = mIndex.back();
+    return last.uncompressedOffset + last.uncompressedSize;
+}
+
+sys::Off_T zip::BlockGZipInputStream::available()
+{
+    return getUncompressedSize() - mPosition;
+}
+
+sys::Off_T zip::BlockGZipInputStream::seek(sys::Off_T offset, Whence whence)
+{
+    sys::Off_T position;
+    switch (whence)
+    {
+    case START:
+        position = offset;
+        break;
+    case END:
+        position = getUncompressedSize() + offset;
+        break;
+    case CURRENT:
+    default:
+        position = mPosition + offset;
+    }
+
+    // A failed seek leaves the position alone
+    if ((position < 0) || (position > getUncompressedSize()))
+    {
+        throw except::IOException(Ctxt("Attempting to seek outside of the uncompressed data"));
+    }
+    mPosition = position;
+    return mPosition;
+}
+
+size_t zip::BlockGZipInputStream::findBlock(sys::Off_T position) const
+{
+    // the last block that starts at (or before) position
+    auto it = std::upper_bound(mIndex.begin(), mIndex.end(), position,
+                               [](sys::Off_T value, const Block& block) {
+                                   return value < block.uncompressedOffset; });
+    return static_cast<size_t>(std::distance(mIndex.begin(), it)) - 1;
+}
+
+void zip::BlockGZipInputStream::decompressBlocks(size_t firstBlock)
+{
+    const auto numBlocks = std::min(mNumThreads, mIndex.size() - firstBlock);
+    const auto& first = mIndex[firstBlock];
+    const auto& last = mIndex[firstBlock + numBlocks - 1];
+
+    // the members are contiguous, so read them all at once
+    mCompressed.resize(static_cast<size_t>(last.compressedOffset - first.compressedOffset) + last.compressedSize);
+    mFile.seekTo(first.compressedOffset, sys::File::FROM_START);
+    mFile.readInto(mCompressed.data(), mCompressed.size());
+
+    mFirstBlock = firstBlock;
+    mBlocks.resize(numBlocks);
+    const auto decompress = [&](size_t ii) {
+        const auto& block = mIndex[firstBlock + ii];
+        mBlocks[ii].resize(block.uncompressedSize);
+        const auto offset = static_cast<size_t>(block.compressedOffset - first.compressedOffset);
+        decompressMember(mCompressed.data() + offset, block.compressedSize, mBlocks[ii]);
+    };
+    mt::run1D(numBlocks, numBlocks, decompress);
+}
+
+sys::SSize_T zip::BlockGZipInputStream::readImpl(void* buffer, size_t len)
+{
+    auto p = static_cast<sys::ubyte*>(buffer);
+    size_t bytesRead = 0;
+    while ((bytesRead < len) && (mPosition < getUncompressedSize()))
+    {
+        const auto blockNum = findBlock(mPosition);
+        if ((blockNum < mFirstBlock) || (blockNum >= mFirstBlock + mBlocks.size()))
+        {
+            decompressBlocks(blockNum);
+        }
+
+        const auto& block = mIndex[blockNum];
+        const auto& data = mBlocks[blockNum - mFirstBlock];
+        const auto offset = static_cast<size_t>(mPosition - block.uncompressedOffset);
+        const auto n = std::min(len - bytesRead, data.size() - offset);
+        memcpy(p + bytesRead, data.data() + offset, n);
+        bytesRead += n;
+        mPosition += n;
+    }
+
+    if ((bytesRead == 0) && (len > 0))
+    {
+        return io::InputStream::IS_EOF;
+    }
+    return static_cast<sys::SSize_T>(bytesRead);
+}
+
+void zip::BlockGZipInputStream::close()
+{
+    mFile.close();
+    mBlocks.clear();
+    mCompressed.clear();
+}
@@ -0,0 +1,187 @@
+/* =========================================================================
+ * This file is part of zip-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * zip-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "zip/BlockGZipOutputStream.h"
+
+#include <string.h>
+
+#include <limits>
+
+#include "except/Exception.h"
+#include "sys/OS.h"
+#include "mt/Runnable1D.h"
+
+constexpr size_t zip::BlockGZipOutputStream::DEFAULT_BLOCK_SIZE;
+
+static void putUInt16(sys::ubyte* p, uint32_t value)
+{
+    p[0] = static_cast<sys::ubyte>(value & 0xff);
+    p[1] = static_cast<sys::ubyte>((value >> 8) & 0xff);
+}
+static void putUInt32(sys::ubyte* p, uint32_t value)
+{
+    putUInt16(p, value & 0xffff);
+    putUInt16(p + 2, value >> 16);
+}
+
+// Compress a single block into a complete gzip member (header, raw deflate data, trailer).
+static void compressBlock(const sys::ubyte* block, size_t blockSize, int level,
+                          std::vector<sys::ubyte>& member)
+{
+    z_stream zstream;
+    memset(&zstream, 0, sizeof(zstream));
+    // negative windowBits: raw deflate data, we write the gzip header/trailer ourselves
+    if (deflateInit2(&zstream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        throw except::IOException(Ctxt("deflateInit2() failed"));
+    }
+
+    const auto bound = deflateBound(&zstream, static_cast<uLong>(blockSize));
+    member.resize(zip::BGZ_HEADER_LEN + bound + zip::BGZ_TRAILER_LEN);
+
+    zstream.next_in = const_cast<sys::ubyte*>(block);
+    zstream.avail_in = static_cast<uInt>(blockSize);
+    zstream.next_out = member.data() + zip::BGZ_HEADER_LEN;
+    zstream.avail_out = static_cast<uInt>(bound);
+    const auto rv = deflate(&zstream, Z_FINISH);
+    const auto compressedSize = static_cast<size_t>(zstream.total_out);
+    deflateEnd(&zstream);
+    if (rv != Z_STREAM_END)
+    {
+        throw except::IOException(Ctxt("deflate() failed to compress block"));
+    }
+
+    const auto memberSize = zip::BGZ_HEADER_LEN + compressedSize + zip::BGZ_TRAILER_LEN;
+    member.resize(memberSize);
+
+    auto p = member.data();
+    p[0] = 0x1f; // ID1
+    p[1] = 0x8b; // ID2
+    p[2] = Z_DEFLATED; // CM
+    p[3] = 0x04; // FLG.FEXTRA
+    putUInt32(p + 4, 0); // MTIME
+    p[8] = 0; // XFL
+    p[9] = 0xff; // OS: unknown
+    putUInt16(p + 10, zip::BGZ_XLEN);
+    p[12] = zip::BGZ_SI1;
+    p[13] = zip::BGZ_SI2;
+    putUInt16(p + 14, zip::BGZ_SLEN);
+    putUInt32(p + 16, static_cast<uint32_t>(memberSize));
+    putUInt32(p + 20, static_cast<uint32_t>(blockSize));
+
+    auto pTrailer = p + zip::BGZ_HEADER_LEN + compressedSize;
+    const auto crc = crc32(crc32(0L, nullptr, 0), block, static_cast<uInt>(blockSize));
+    putUInt32(pTrailer, static_cast<uint32_t>(crc));
+    putUInt32(pTrailer + 4, static_cast<uint32_t>(blockSize)); // ISIZE
+}
+
+zip::BlockGZipOutputStream::BlockGZipOutputStream(const std::string& file,
+                                                  size_t numThreads,
+                                                  size_t blockSize,
+                                                  int level) :
+    mFile(file),
+    mNumThreads(numThreads == 0 ? sys::OS().getNumCPUs() : numThreads),
+    mBlockSize(blockSize),
+    mLevel(level)
+{
+    // leave plenty of room for a compressed block that's bigger than the input
+    if ((mBlockSize == 0) || (mBlockSize > std::numeric_limits<uint32_t>::max() / 2))
+    {
+        throw except::InvalidArgumentException(Ctxt(
+                "Invalid block size: " + std::to_string(mBlockSize)));
+    }
+    mBuffer.reserve(mNumThreads * mBlockSize);
+    mMembers.resize(mNumThreads);
+}
+
+zip::BlockGZipOutputStream::~BlockGZipOutputStream()
+{
+    try
+    {
+        if (mFile.isOpen())
+        {
+            close();
+        }
+    }
+    catch (...)
+    {
+    }
+}
+
+void zip::BlockGZipOutputStream::write(const void* buffer, size_t len)
+{
+    auto p = static_cast<const sys::ubyte*>(buffer);
+    const auto batchSize = mNumThreads * mBlockSize;
+    while (len > 0)
+    {
+        const auto n = std::min(len, batchSize - mBuffer.size());
+        mBuffer.insert(mBuffer.end(), p, p + n);
+        p += n;
+        len -= n;
+
+        if (mBuffer.size() == batchSize)
+        {
+            compressAndWrite();
+        }
+    }
+}
+
+void zip::BlockGZipOutputStream::compressAndWrite()
+{
+    const auto numBlocks = (mBuffer.size() + mBlockSize - 1) / mBlockSize;
+    const auto compress = [&](size_t ii) {
+        const auto offset = ii * mBlockSize;
+        const auto blockSize = std::min(mBlockSize, mBuffer.size() - offset);
+        compressBlock(mBuffer.data() + offset, blockSize, mLevel, mMembers[ii]);
+    };
+    mt::run1D(numBlocks, std::min(numBlocks, mNumThreads), compress);
+
+    // members must be written in order
+    for (size_t ii = 0; ii < numBlocks; ++ii)
+    {
+        mFile.write(mMembers[ii].data(), mMembers[ii].size());
+    }
+    mBuffer.clear();
+    mBlocksWritten += numBlocks;
+}
+
+void zip::BlockGZipOutputStream::flush()
+{
+    if (!mBuffer.empty())
+    {
+        compressAndWrite();
+    }
+    mFile.flush();
+}
+
+void zip::BlockGZipOutputStream::close()
+{
+    flush();
+    if (mBlocksWritten == 0)
+    {
+        // an empty file isn't valid gzip; write a single empty member
+        std::vector<sys::ubyte> member;
+        compressBlock(mBuffer.data(), 0, mLevel, member);
+        mFile.write(member.data(), member.size());
+    }
+    mFile.close();
+}
@@ -21,6 +21,7 @@
  */
 
 #include "zip/ZipEntry.h"
+#include "zip/ZipEntryInputStream.h"
 #undef Z_NULL
 #define Z_NULL nullptr
 
@@ -93,6 +94,11 @@ void ZipEntry::decompress(sys::ubyte* out, sys::Size_T outLen)
     }
 }
 
+std::unique_ptr<io::InputStream> ZipEntry::openInputStream() const
+{
+    return std::make_unique<ZipEntryInputStream>(*this);
+}
+
 std::ostream& operator<<(std::ostream& os, const zip::ZipEntry& ze)
 {
     const char* madeBy = ze.getVersionMadeByString();
@@ -0,0 +1,138 @@
+/* =========================================================================
+ * This file is part of zip-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * zip-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "zip/ZipEntryInputStream.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include "except/Exception.h"
+#include "str/Format.h"
+#include "zip/ZipEntry.h"
+
+zip::ZipEntryInputStream::ZipEntryInputStream(const ZipEntry& entry) :
+    mCompressedData(entry.getCompressedData()),
+    mCompressedSize(entry.getCompressedSize()),
+    mUncompressedSize(entry.getUncompressedSize()),
+    mExpectedCRC(entry.getCRC32()),
+    mStored(entry.getCompressionMethod() == ZipEntry::COMP_STORED),
+    mCRC(crc32(0L, nullptr, 0))
+{
+    memset(&mZStream, 0, sizeof(mZStream));
+    if (mStored)
+    {
+        // Stored data is copied as-is, so both sizes must agree; otherwise,
+        // a corrupt header would have us read past the entry.
+        if (mCompressedSize != mUncompressedSize)
+        {
+            throw except::IOException(Ctxt("Stored zip entry " + entry.getFileName() +
+                    " has compressed size " + std::to_string(mCompressedSize) +
+                    " but uncompressed size " + std::to_string(mUncompressedSize)));
+        }
+        return;
+    }
+    if (entry.getCompressionMethod() != ZipEntry::COMP_DEFLATED)
+    {
+        throw except::IOException(Ctxt(str::Format(
+                "Unsupported compression method %d for %s",
+                entry.getCompressionMethod(), entry.getFileName())));
+    }
+
+    const int zerr = inflateInit2(&mZStream, -MAX_WBITS); // raw deflate data
+    if (zerr != Z_OK)
+    {
+        throw except::IOException(Ctxt(str::Format("inflateInit2 failed [%d]", zerr)));
+    }
+    mZStream.next_in = const_cast<sys::ubyte*>(mCompressedData);
+    mZStream.avail_in = static_cast<uInt>(mCompressedSize);
+}
+
+zip::ZipEntryInputStream::~ZipEntryInputStream()
+{
+    if (!mStored)
+    {
+        inflateEnd(&mZStream);
+    }
+}
+
+sys::Off_T zip::ZipEntryInputStream::available()
+{
+    return static_cast<sys::Off_T>(mUncompressedSize - mPosition);
+}
+
+void zip::ZipEntryInputStream::checkCRC() const
+{
+    if (mCRC != mExpectedCRC)
+    {
+        throw except::IOException(Ctxt("CRC mismatch in zip entry"));
+    }
+}
+
+sys::SSize_T zip::ZipEntryInputStream::readImpl(void* buffer, size_t len)
+{
+    if (mPosition == mUncompressedSize)
+    {
+        return io::InputStream::IS_END;
+    }
+
+    // zlib counts in uInt
+    len = std::min(len, mUncompressedSize - mPosition);
+    len = std::min(len, static_cast<size_t>(std::numeric_limits<uInt>::max()));
+    auto out = static_cast<sys::ubyte*>(buffer);
+
+    if (mStored)
+    {
+        len = std::min(len, mCompressedSize - mPosition);
+        if (len == 0)
+        {
+            throw except::IOException(Ctxt("Truncated zip entry"));
+        }
+        memcpy(out, mCompressedData + mPosition, len);
+    }
+    else
+    {
+        mZStream.next_out = out;
+        mZStream.avail_out = static_cast<uInt>(len);
+        const int zerr = inflate(&mZStream, Z_NO_FLUSH);
+        if ((zerr != Z_OK) && (zerr != Z_STREAM_END))
+        {
+            throw except::IOException(Ctxt(str::Format("inflate failed [%d]", zerr)));
+        }
+        len -= mZStream.avail_out;
+        if ((len == 0) || ((zerr == Z_STREAM_END) && (mPosition + len != mUncompressedSize)))
+        {
+            throw except::IOException(Ctxt("Truncated zip entry"));
+        }
+    }
+
+    mCRC = crc32(mCRC, out, static_cast<uInt>(len));
+    mPosition += len;
+    if (mPosition == mUncompressedSize)
+    {
+        checkCRC();
+    }
+    return static_cast<sys::SSize_T>(len);
+}
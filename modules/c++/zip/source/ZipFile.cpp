@@ -22,11 +22,108 @@
 
 #include "zip/ZipFile.h"
 
+#include <algorithm>
+#include <set>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "sys/File.h"
+#include "sys/OS.h"
+#include "sys/Path.h"
+#include "str/Manip.h"
+#include "io/FileOutputStream.h"
+#include "mt/Runnable1D.h"
+
 #define Z_READ_SHORT_INC(BUF, OFF) readShort(&BUF[OFF]); OFF += 2
 #define Z_READ_INT_INC(BUF, OFF) readInt(&BUF[OFF]); OFF += 4
 
 namespace zip
 {
+//!  A read-only mapping of an entire file
+struct ZipFile::Mapping final
+{
+    explicit Mapping(const std::string& pathname) :
+        mFile(pathname)
+    {
+        length = static_cast<size_t>(mFile.length());
+        if (length == 0)
+        {
+            return; // can't map an empty file, readCentralDir() will complain
+        }
+#ifdef _WIN32
+        mHandle = CreateFileMapping(mFile.getHandle(), nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mHandle == nullptr)
+        {
+            throw except::IOException(Ctxt("Unable to map " + pathname));
+        }
+        data = static_cast<sys::ubyte*>(MapViewOfFile(mHandle, FILE_MAP_READ, 0, 0, 0));
+        if (data == nullptr)
+        {
+            CloseHandle(mHandle);
+            throw except::IOException(Ctxt("Unable to map " + pathname));
+        }
+#else
+        void* const p = mmap(nullptr, length, PROT_READ, MAP_SHARED, mFile.getHandle(), 0);
+        if (p == MAP_FAILED)
+        {
+            throw except::IOException(Ctxt("Unable to map " + pathname));
+        }
+        data = static_cast<sys::ubyte*>(p);
+#endif
+    }
+
+    ~Mapping()
+    {
+        if (data != nullptr)
+        {
+#ifdef _WIN32
+            UnmapViewOfFile(data);
+            CloseHandle(mHandle);
+#else
+            munmap(data, length);
+#endif
+        }
+    }
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    sys::ubyte* data = nullptr;
+    size_t length = 0;
+
+private:
+    sys::File mFile;
+#ifdef _WIN32
+    HANDLE mHandle = nullptr;
+#endif
+};
+
+ZipFile::ZipFile(io::InputStream* inputStream) :
+    mCompressed(nullptr)
+{
+    mSwapBytes = sys::isBigEndianSystem();
+    mCompressedLength = inputStream->available();
+    mCompressed = new sys::ubyte[mCompressedLength];
+    inputStream->read((sys::byte*) mCompressed, mCompressedLength);
+
+    readCentralDir();
+}
+
+ZipFile::ZipFile(const std::string& pathname) :
+    mCompressed(nullptr),
+    mMapping(new Mapping(pathname))
+{
+    mSwapBytes = sys::isBigEndianSystem();
+    mCompressedLength = mMapping->length;
+    mCompressed = mMapping->data;
+
+    readCentralDir();
+}
+
 ZipFile::~ZipFile()
 {
     for (size_t i = 0; i < mEntries.size(); ++i)
@@ -35,7 +132,7 @@ ZipFile::~ZipFile()
         delete mEntries[i];
     }
 
-    if (mCompressed)
+    if (mCompressed && !mMapping)
         delete[] mCompressed;
 }
 
@@ -179,12 +276,19 @@ ZipEntry* ZipFile::newCentralDirEntry(sys::ubyte** buf, sys::SSize_T len)
 
     *buf = p;
 
+    // Entries aren't read until they're decompressed (which, for a mapped
+    // file, is when they're paged in), so make sure they're in bounds now.
+    if (static_cast<sys::Size_T>(localHeaderRelOffset) + LFH_SIZE > mCompressedLength)
+        throw except::IOException(Ctxt("Local header is past the end of the file"));
+
     p = mCompressed + localHeaderRelOffset;
 
     extraFieldLength = readShort(&p[0x1c]);
 
     sys::Size_T dataOffset = localHeaderRelOffset + LFH_SIZE + fileNameLength
             + extraFieldLength;
+    if (dataOffset + compressedSize > mCompressedLength)
+        throw except::IOException(Ctxt("Entry data is past the end of the file"));
 
     return new ZipEntry(mCompressed + dataOffset, compressedSize,
             uncompressedSize, fileName, fileComment, versionMadeBy,
@@ -229,6 +333,82 @@ void ZipFile::readCentralDirValues(sys::ubyte* buf, sys::SSize_T len)
     mComment = std::string((const char*) (buf + EOCD_LEN), commentLength);
 }
 
+// Where to extract an entry named fileName, refusing to go outside of directory.
+static std::string getExtractPath(const std::string& directory,
+                                  const std::string& fileName)
+{
+    const std::vector<std::string> parts = str::split(fileName, "/");
+    const bool isAbsolute = str::startsWith(fileName, "/") ||
+            (fileName.find(':') != std::string::npos) || (fileName.find('\\') != std::string::npos);
+    if (isAbsolute || (std::find(parts.begin(), parts.end(), "..") != parts.end()))
+    {
+        throw except::IOException(Ctxt("Refusing to extract " + fileName));
+    }
+
+    std::string pathname = directory;
+    for (const auto& part : parts)
+    {
+        pathname = sys::Path::joinPaths(pathname, part);
+    }
+    return pathname;
+}
+
+// Create pathname and any missing parents, all of which are within directory.
+static void makeDirectories(const sys::OS& os, const std::string& directory,
+                            const std::string& pathname)
+{
+    if (pathname.empty() || (pathname == directory) || os.isDirectory(pathname))
+    {
+        return;
+    }
+    makeDirectories(os, directory, sys::Path::splitPath(pathname).first);
+    if (!os.makeDirectory(pathname) && !os.isDirectory(pathname))
+    {
+        throw except::IOException(Ctxt("Unable to create directory " + pathname));
+    }
+}
+
+void ZipFile::extractAll(const std::string& directory, size_t numThreads) const
+{
+    const sys::OS os;
+
+    // Create all of the directories up front; after that, each entry is
+    // written to its own file so they can be extracted in parallel.
+    std::vector<const ZipEntry*> files;
+    std::vector<std::string> pathnames;
+    std::set<std::string> directories;
+    for (const ZipEntry* entry : mEntries)
+    {
+        const std::string fileName = entry->getFileName();
+        const std::string pathname = getExtractPath(directory, fileName);
+        if (str::endsWith(fileName, "/"))
+        {
+            directories.insert(pathname);
+        }
+        else
+        {
+            directories.insert(sys::Path::splitPath(pathname).first);
+            files.push_back(entry);
+            pathnames.push_back(pathname);
+        }
+    }
+    for (const auto& pathname : directories)
+    {
+        makeDirectories(os, directory, pathname);
+    }
+
+    const auto extract = [&](size_t ii) {
+        io::FileOutputStream output(pathnames[ii]);
+        files[ii]->openInputStream()->streamTo(output);
+        output.close();
+    };
+    if (numThreads == 0)
+    {
+        numThreads = os.getNumCPUs();
+    }
+    mt::run1D(files.size(), std::min(numThreads, files.size()), extract);
+}
+
 std::ostream& operator<<(std::ostream& os, const ZipFile& zf)
 {
     os << "central directory length: " << zf.getCentralDirSize() << std::endl;
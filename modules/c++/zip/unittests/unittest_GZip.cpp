@@ -107,7 +107,62 @@ TEST_CASE(gunzip)
     remove(outputPath);
 }
 
+TEST_CASE(blockGZip)
+{
+    static const auto inputPath = find_unittest_file("text.txt");
+    const auto pid = sys::OS().getSpecialEnv("PID");
+    const auto outputPath = inputPath.parent_path() / ("TEST_blockGZip" + pid + "_TMP.gz"); // see .gitignore
+
+    std::string data;
+    for (size_t ii = 0; ii < 1000; ++ii)
+    {
+        data += "Hello World! " + std::to_string(ii) + "\n";
+    }
+    {
+        // small blocks so that there are lots of them
+        zip::BlockGZipOutputStream output(outputPath.string(), 4 /*numThreads*/, 1000 /*blockSize*/);
+        output.write(data.substr(0, 123));
+        output.write(data.substr(123));
+        output.close();
+    }
+
+    // A regular gzip reader can read the (multi-member) file ...
+    {
+        zip::GZipInputStream input(outputPath.string());
+        io::StringStream output;
+        while (input.streamTo(output, 8192)) ;
+        input.close();
+        TEST_ASSERT_EQ(output.stream().str(), data);
+    }
+
+    // ... as can the blocked reader, with random access
+    zip::BlockGZipInputStream input(outputPath.string(), 3 /*numThreads*/);
+    TEST_ASSERT_EQ(input.getIndex().size(), (data.size() + 999) / 1000);
+    TEST_ASSERT_EQ(input.getUncompressedSize(), static_cast<sys::Off_T>(data.size()));
+    {
+        io::StringStream output;
+        input.streamTo(output);
+        TEST_ASSERT_EQ(output.stream().str(), data);
+    }
+
+    const auto offset = data.size() - 2345;
+    input.seek(static_cast<sys::Off_T>(offset), io::Seekable::START);
+    std::string buffer(2000, ' ');
+    input.read(&buffer[0], buffer.size(), true /*verifyFullRead*/);
+    TEST_ASSERT_EQ(buffer, data.substr(offset, buffer.size()));
+    TEST_ASSERT_EQ(input.available(), static_cast<sys::Off_T>(345));
+
+    // a seek outside of the data fails, and doesn't move
+    TEST_EXCEPTION(input.seek(1000, io::Seekable::CURRENT));
+    TEST_EXCEPTION(input.seek(-1, io::Seekable::START));
+    TEST_ASSERT_EQ(input.available(), static_cast<sys::Off_T>(345));
+    input.close();
+
+    remove(outputPath);
+}
+
 TEST_MAIN(
     TEST_CHECK(gzip);
     TEST_CHECK(gunzip);
+    TEST_CHECK(blockGZip);
 )
\ No newline at end of file
@@ -0,0 +1,189 @@
+/* =========================================================================
+ * This file is part of zip-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2024, Maxar Technologies, Inc.
+ *
+ * zip-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string.h>
+
+#include <stdexcept>
+#include <vector>
+#include <std/filesystem>
+
+#include <import/sys.h>
+#include <import/io.h>
+#include <import/zip.h>
+#include <io/ReadUtils.h>
+#include <io/TempFile.h>
+
+#include <TestCase.h>
+
+static std::filesystem::path find_unittest_file(const std::filesystem::path& name)
+{
+    static const auto unittests = std::filesystem::path("modules") / "c++" / "zip" / "unittests";
+    return sys::test::findGITModuleFile("coda-oss", unittests, name);
+}
+
+static std::string readEntry(const zip::ZipEntry& entry, size_t chunkSize)
+{
+    const auto input = entry.openInputStream();
+    std::string retval;
+    std::vector<char> buffer(chunkSize);
+    sys::SSize_T numRead;
+    while ((numRead = input->read(buffer.data(), buffer.size())) != io::InputStream::IS_END)
+    {
+        retval.append(buffer.data(), static_cast<size_t>(numRead));
+    }
+    return retval;
+}
+
+static std::string makeText(size_t numLines)
+{
+    std::string retval;
+    for (size_t ii = 0; ii < numLines; ++ii)
+    {
+        retval += "line " + std::to_string(ii) + " of some highly compressible text\n";
+    }
+    return retval;
+}
+
+static void addEntry(zip::ZipOutputStream& output,
+                     const std::string& pathname,
+                     const std::string& contents)
+{
+    output.createFileInZip(pathname);
+    output.write(contents.data(), contents.size());
+    output.closeFileInZip();
+}
+
+// io::TempFile creates a file, replace it with a directory
+static void makeDirectory(const std::string& pathname)
+{
+    const sys::OS os;
+    os.remove(pathname);
+    os.makeDirectory(pathname);
+}
+
+TEST_CASE(zipFileMapped)
+{
+    static const auto inputPath = find_unittest_file("test.zip");
+
+    io::FileInputStream input(inputPath.string());
+    const zip::ZipFile readZip(&input);
+    const zip::ZipFile mappedZip(inputPath.string());
+    TEST_ASSERT_EQ(readZip.getNumEntries(), 1);
+    TEST_ASSERT_EQ(mappedZip.getNumEntries(), 1);
+
+    const auto& entry = **mappedZip.lookup("text.txt");
+    TEST_ASSERT_EQ(entry.getUncompressedSize(), 12);
+
+    std::string expected(entry.getUncompressedSize(), '\0');
+    (*readZip.begin())->decompress(reinterpret_cast<sys::ubyte*>(&expected[0]), expected.size());
+    TEST_ASSERT_EQ(expected, "Hello World!");
+    TEST_ASSERT_EQ(readEntry(entry, 5), expected);
+}
+
+// Find the (only) central directory entry, "PK\1\2"
+static size_t findCentralDirEntry(const std::vector<sys::ubyte>& zipData)
+{
+    for (size_t ii = zipData.size() - 4; ii > 0; --ii)
+    {
+        if ((zipData[ii] == 'P') && (zipData[ii + 1] == 'K') && (zipData[ii + 2] == 1) && (zipData[ii + 3] == 2))
+        {
+            return ii;
+        }
+    }
+    throw std::logic_error("no central directory entry");
+}
+
+TEST_CASE(zipFileCorruptStoredEntry)
+{
+    static const auto inputPath = find_unittest_file("test.zip");
+    std::vector<coda_oss::byte> contents;
+    io::readFileContents(inputPath, contents);
+    std::vector<sys::ubyte> zipData(contents.size());
+    memcpy(zipData.data(), contents.data(), contents.size());
+
+    // Claim the (deflated) entry is stored and much bigger than it is
+    const auto entryOffset = findCentralDirEntry(zipData);
+    zipData[entryOffset + 10] = zip::ZipEntry::COMP_STORED;
+    zipData[entryOffset + 11] = 0;
+    const sys::ubyte uncompressedSize[] = { 0x00, 0x00, 0x10, 0x00 }; // 1 MiB, little-endian
+    memcpy(&zipData[entryOffset + 24], uncompressedSize, sizeof(uncompressedSize));
+
+    io::ByteStream input(std::move(zipData));
+    const zip::ZipFile corruptZip(&input);
+    const auto& entry = **corruptZip.lookup("text.txt");
+    TEST_ASSERT_EQ(entry.getCompressionMethod(), zip::ZipEntry::COMP_STORED);
+    TEST_ASSERT(entry.getUncompressedSize() > entry.getCompressedSize());
+    TEST_EXCEPTION(entry.openInputStream());
+}
+
+TEST_CASE(zipFileExtractAll)
+{
+    const auto small = makeText(1);
+    const auto large = makeText(10000);
+
+    const io::TempFile zipPathname;
+    {
+        zip::ZipOutputStream output(zipPathname.pathname());
+        addEntry(output, "small.txt", small);
+        addEntry(output, "sub/dir/large.txt", large);
+        addEntry(output, "sub/empty.txt", "");
+        output.close();
+    }
+
+    const zip::ZipFile archive(zipPathname.pathname());
+    TEST_ASSERT_EQ(archive.getNumEntries(), 3);
+    const auto& entry = **archive.lookup("sub/dir/large.txt");
+    TEST_ASSERT_EQ(entry.getUncompressedSize(), large.size());
+    TEST_ASSERT(entry.getCompressedSize() < large.size());
+    TEST_ASSERT_EQ(readEntry(entry, 1000), large);
+
+    const io::TempFile directory;
+    makeDirectory(directory.pathname());
+    archive.extractAll(directory.pathname(), 2);
+
+    const sys::Path root(directory.pathname());
+    TEST_ASSERT_EQ(io::readFileContents(root.join("small.txt").getPath()), small);
+    TEST_ASSERT_EQ(io::readFileContents(root.join("sub").join("dir").join("large.txt").getPath()), large);
+    TEST_ASSERT_EQ(io::readFileContents(root.join("sub").join("empty.txt").getPath()), "");
+}
+
+TEST_CASE(zipFileExtractOutside)
+{
+    const io::TempFile zipPathname;
+    {
+        zip::ZipOutputStream output(zipPathname.pathname());
+        addEntry(output, "../outside.txt", "should not be written");
+        output.close();
+    }
+
+    const zip::ZipFile archive(zipPathname.pathname());
+    const io::TempFile directory;
+    makeDirectory(directory.pathname());
+    TEST_THROWS(archive.extractAll(directory.pathname()));
+}
+
+TEST_MAIN(
+    TEST_CHECK(zipFileMapped);
+    TEST_CHECK(zipFileCorruptStoredEntry);
+    TEST_CHECK(zipFileExtractAll);
+    TEST_CHECK(zipFileExtractOutside);
+    )